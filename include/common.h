@@ -33,6 +33,10 @@ enum class RadiationType
     ALPHA
 };
 
+// Noms des types de radiation (fichiers de scène et de données) ; analyse insensible à la casse
+const char* radiationTypeName(RadiationType type);
+bool parseRadiationType(const std::string& name, RadiationType& type);
+
 // -----------------
 // Types d'interaction
 // -----------------
@@ -64,6 +68,7 @@ namespace Physics
     constexpr double SPEED_OF_LIGHT = 2.99792458e8;     // m/s
     constexpr double PLANCK = 6.62607015e-34;           // J·s
     constexpr double ELECTRON_CHARGE = 1.602176634e-19; // C
+    constexpr double ELECTRON_MASS_KEV = 510.99895;     // keV/c²
 }
 
 // -------------------------------------
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "common.h"
+
+// Découpage linéaire ou logarithmique d'un axe, recherche du groupe en O(1)
+class Binning {
+public:
+    enum class Scale { LINEAR, LOG };
+
+    Binning() = default; // Axe non découpé : un groupe unique
+    static Binning linear(float min, float max, uint32_t count);
+    static Binning logarithmic(float min, float max, uint32_t count);
+
+    bool isEnabled() const { return m_count > 0; }
+    Scale getScale() const { return m_scale; }
+    uint32_t getCount() const { return std::max(1u, m_count); }
+    float getMin() const { return m_min; }
+    float getMax() const { return m_max; }
+
+    int index(float value) const; // -1 hors bornes
+    float lowerEdge(uint32_t bin) const;
+    float upperEdge(uint32_t bin) const { return lowerEdge(bin + 1); }
+
+private:
+    Scale m_scale = Scale::LINEAR;
+    float m_min = 0.0f;
+    float m_max = 0.0f;
+    uint32_t m_count = 0;
+    float m_offset = 0.0f;   // min ou log(min)
+    float m_invWidth = 0.0f; // Inverse de la largeur (linéaire ou logarithmique)
+};
+
+// Histogramme énergie × temps par thread, fusionné en fin de lot ;
+// la variance par groupe provient de la dispersion entre lots
+class BinnedTally {
+public:
+    void configure(const Binning& energyBins, const Binning& timeBins);
+    bool isEnabled() const { return m_energyBins.isEnabled() || m_timeBins.isEnabled(); }
+
+    const Binning& getEnergyBins() const { return m_energyBins; }
+    const Binning& getTimeBins() const { return m_timeBins; }
+    uint32_t getBinCount() const { return m_energyBins.getCount() * m_timeBins.getCount(); }
+
+    // Accumulation (thread = emplacement réservé par ensureThreadSlots)
+    void ensureThreadSlots(uint32_t threadCount);
+    void score(uint32_t threadSlot, float energy, float time, double value);
+    void endBatch(uint32_t threadSlot, uint64_t histories);
+    void clear();
+
+    // Résultats par histoire
+    uint64_t getHistories() const;
+    uint32_t getBatchCount() const;
+    double getMean(uint32_t energyBin, uint32_t timeBin = 0) const;
+    double getVarianceOfMean(uint32_t energyBin, uint32_t timeBin = 0) const;
+    double getRelativeError(uint32_t energyBin, uint32_t timeBin = 0) const;
+
+    // Cumuls par groupe (sérialisation, fusion de runs indépendants : simple somme)
+    struct State {
+        std::vector<double> sum;
+        std::vector<double> sumSqOverN;
+        uint64_t histories = 0;
+        uint32_t batches = 0;
+    };
+    State getState() const;
+    void addState(const State& state); // Même découpage requis
+
+private:
+    struct ThreadBuffer {
+        std::vector<double> values;
+        bool dirty = false;
+    };
+
+    Binning m_energyBins;
+    Binning m_timeBins;
+
+    std::vector<ThreadBuffer> m_threadBuffers;
+    std::vector<double> m_sum;         // Σ des lots
+    std::vector<double> m_sumSqOverN;  // Σ (somme du lot)² / histoires du lot
+    uint64_t m_histories = 0;
+    uint32_t m_batches = 0;
+    mutable std::mutex m_mutex;
+
+    uint32_t flatIndex(uint32_t energyBin, uint32_t timeBin) const {
+        return energyBin * m_timeBins.getCount() + timeBin;
+    }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "common.h"
+#include "core/Material.h"
+#include "utils/MappedFile.h"
+
+// Format binaire de bibliothèque de sections efficaces (.rxs)
+// Petit-boutiste, versionné, chaque section alignée sur 64 octets :
+//   en-tête | grilles unionisées par rayonnement | enregistrements matériaux |
+//   compositions | tables (colonnes μ, μ/ρ, σ puis voies, sur la grille unionisée) | noms
+namespace XsFormat {
+    constexpr char MAGIC[8] = {'R', 'A', 'D', 'X', 'S', 'L', 'I', 'B'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t ENDIAN_TAG = 0x01020304;
+    constexpr uint64_t ALIGNMENT = 64;
+
+    // Colonnes d'une table : μ (cm⁻¹), μ/ρ (cm²/g), σ (barns), puis une par voie
+    constexpr uint32_t COLUMN_LINEAR = 0;
+    constexpr uint32_t COLUMN_MASS = 1;
+    constexpr uint32_t COLUMN_CROSS_SECTION = 2;
+    constexpr uint32_t COLUMN_FIRST_CHANNEL = 3;
+    constexpr uint32_t COLUMN_COUNT = COLUMN_FIRST_CHANNEL + INTERACTION_CHANNEL_COUNT;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t endianTag;
+        uint32_t gridCount;
+        uint32_t materialCount;
+        uint64_t gridsOffset;
+        uint64_t materialsOffset;
+        uint64_t stringsOffset;
+        uint64_t fileSize;
+        uint8_t reserved[8];
+    };
+
+    struct GridRecord {
+        uint32_t radiationType;
+        uint32_t pointCount;
+        uint64_t energiesOffset; // float[pointCount], keV croissants
+        uint8_t reserved[16];
+    };
+
+    struct MaterialRecord {
+        uint64_t nameOffset; // Relatif à stringsOffset, UTF-8 sans terminateur
+        uint32_t nameLength;
+        float density;       // g/cm³
+        uint64_t elementsOffset;
+        uint32_t elementCount;
+        uint32_t tableCount;
+        uint64_t tablesOffset;
+        uint8_t reserved[24];
+    };
+
+    struct ElementRecord {
+        int32_t atomicNumber;
+        float massFraction;
+        float atomicMass;
+        char symbol[4];
+    };
+
+    struct TableRecord {
+        uint32_t radiationType;
+        uint32_t gridIndex;
+        uint64_t columnsOffset; // COLUMN_COUNT colonnes float[pointCount]
+        uint64_t columnStride;  // Octets entre deux colonnes (multiple de 64)
+        uint8_t reserved[8];
+    };
+
+    static_assert(sizeof(Header) == 64, "En-tête .rxs de 64 octets");
+    static_assert(sizeof(GridRecord) == 32, "GridRecord de 32 octets");
+    static_assert(sizeof(MaterialRecord) == 64, "MaterialRecord de 64 octets");
+    static_assert(sizeof(ElementRecord) == 16, "ElementRecord de 16 octets");
+    static_assert(sizeof(TableRecord) == 32, "TableRecord de 32 octets");
+}
+
+// Bibliothèque projetée en lecture seule : les données restent dans le cache de pages,
+// partagé par les processus d'un même nœud (tableaux de jobs parallèles)
+class CrossSectionLibrary {
+public:
+    // Écriture (grilles unionisées par type de rayonnement)
+    static void write(const std::string& filename, const std::vector<std::shared_ptr<Material>>& materials);
+
+    // Ouverture par mmap, avec validation de l'en-tête et des bornes
+    static std::shared_ptr<const CrossSectionLibrary> open(const std::string& filename);
+
+    uint32_t getMaterialCount() const { return m_header->materialCount; }
+    std::string getMaterialName(uint32_t index) const;
+    int findMaterial(const std::string& name) const; // -1 si absent
+
+    // Matériau finalisé construit depuis les données projetées
+    std::shared_ptr<Material> createMaterial(uint32_t index) const;
+
+    // Accès direct aux données projetées (nullptr si absent)
+    const float* getEnergyGrid(RadiationType type, uint32_t& pointCount) const;
+    const float* getColumn(uint32_t material, RadiationType type, uint32_t column) const;
+
+    bool isMapped() const { return m_file.isMapped(); }
+
+    // Conversion hors ligne depuis une table texte de type NIST XCOM (CSV)
+    static std::shared_ptr<Material> importCsv(const std::string& filename);
+
+private:
+    explicit CrossSectionLibrary(MappedFile file);
+
+    MappedFile m_file;
+    const XsFormat::Header* m_header = nullptr;
+
+    template <typename T>
+    const T* at(uint64_t offset, uint64_t count = 1) const;
+
+    const XsFormat::MaterialRecord& materialRecord(uint32_t index) const;
+    const XsFormat::GridRecord* findGrid(RadiationType type, uint32_t* gridIndex = nullptr) const;
+    const XsFormat::Header* validate() const;
+    // Nom d'un matériau dans la table des chaînes (décalages vérifiés sans débordement)
+    const char* materialName(const XsFormat::Header& header, const XsFormat::MaterialRecord& record) const;
+};
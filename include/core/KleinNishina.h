@@ -0,0 +1,38 @@
+#pragma once
+
+#include "common.h"
+
+// Diffusion Compton de Klein-Nishina (électrons libres)
+// Échantillonnage par table d'inverse de CDF en (énergie, ξ) : un tirage uniforme,
+// choix stochastique de la ligne d'énergie et interpolation linéaire en ξ.
+class KleinNishina {
+public:
+    static const KleinNishina& getInstance();
+
+    // Tirage de cos θ pour un photon incident d'énergie donnée (keV)
+    float sampleCosTheta(float energy) const;
+    float sampleCosTheta(float energy, float xiRow, float xi) const;
+
+    // Variante par lots (noyaux événementiels) : cos θ et énergie diffusée
+    void sampleBatch(const float* energies, float* cosTheta, float* scatteredEnergies, size_t count) const;
+
+    // Cinématique et densités
+    static float scatteredEnergy(float energy, float cosTheta);
+    static double angularPdf(float energy, float cosTheta); // sr⁻¹, normalisée sur 4π
+    static double totalCrossSectionRatio(float energy);     // σ_KN / σ_Thomson
+
+    static constexpr float MIN_ENERGY = 1.0f;     // keV
+    static constexpr float MAX_ENERGY = 100000.0f; // keV
+
+private:
+    KleinNishina();
+
+    static constexpr uint32_t ENERGY_POINTS = 128;
+    static constexpr uint32_t CDF_POINTS = 513;
+
+    float m_logMinEnergy;
+    float m_invLogStep;
+    std::vector<float> m_inverseCdf; // [énergie][ξ] → cos θ
+
+    static double differentialCrossSection(float energy, float cosTheta); // dσ/dΩ / r_e²
+};
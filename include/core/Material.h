@@ -8,8 +8,31 @@ struct AttenuationData {
     float massCoeff = 0.0f;        // Coefficient d'atténuation massique μ/ρ (cm²/g)
     float crossSection = 0.0f;     // Section efficace pour neutrons (barns)
     float energy = 0.0f;           // Énergie associée (keV)
+
+    // Sections efficaces partielles par voie (cm⁻¹, seules les proportions comptent ;
+    // toutes nulles : répartition par défaut du type de rayonnement)
+    float photoelectric = 0.0f;
+    float compton = 0.0f;          // Diffusion incohérente
+    float pair = 0.0f;             // Création de paires
+    float elastic = 0.0f;          // Diffusion élastique (neutrons, cohérente)
+    float capture = 0.0f;          // Capture radiative (neutrons)
+
+    float partialSum() const { return photoelectric + compton + pair + elastic + capture; }
+};
+
+// Voies d'interaction d'une collision
+enum class InteractionChannel : uint8_t {
+    PHOTOELECTRIC,
+    COMPTON,
+    PAIR,
+    ELASTIC,
+    CAPTURE
 };
 
+constexpr uint32_t INTERACTION_CHANNEL_COUNT = 5;
+
+class StoppingPowerTable;
+
 // Structure pour la composition chimique
 struct ElementComposition {
     int atomicNumber = 0;
@@ -39,12 +62,37 @@ public:
     float getMassAttenuation(RadiationType type, float energy) const;
     float getLinearAttenuationPerMeter(RadiationType type, float energy) const;
     float getCrossSection(RadiationType type, float energy) const;
+    void addAttenuationData(RadiationType type, const AttenuationData& data);
+    const std::vector<AttenuationData>* getAttenuationTable(RadiationType type) const;
+    std::vector<RadiationType> getRadiationTypes() const;
+    AttenuationData getAttenuationData(RadiationType type, float energy) const; // Tous champs interpolés
+    // Minorant de μ (m⁻¹) sur toutes les énergies jusqu'à energy : photons et neutrons n'en gagnent pas
+    float getMinimumAttenuationPerMeter(RadiationType type, float energy) const;
+
+    // Tables d'alias par intervalle d'énergie (à appeler une fois les données chargées)
+    void finalize();
+    bool isFinalized() const { return m_finalized; }
 
     // Interaction des particules
     InteractionType sampleInteraction(RadiationType type, float energy) const;
+    InteractionChannel sampleChannel(RadiationType type, float energy) const;
+    static InteractionType channelOutcome(InteractionChannel channel);
     float getMeanFreePath(RadiationType type, float energy) const;
     glm::vec3 sampleScattering(const glm::vec3& incident, RadiationType type, float energy) const;
 
+    // Lois utilisées par l'estimateur next-event (cohérentes avec l'échantillonnage)
+    float getScatteringProbability(RadiationType type, float energy) const;
+    float getScatteringPdf(RadiationType type, float energy, float cosTheta) const; // sr⁻¹
+
+    // Émissions secondaires d'après la composition (keV ; 0 : aucune émission)
+    float sampleFluorescence(float photonEnergy) const; // Raie K après absorption photoélectrique
+    float sampleCaptureGamma() const;                   // Gamma prompt de capture radiative
+
+    // Particules chargées (BETA, ALPHA, MUON) : pouvoirs d'arrêt et portées CSDA d'après la
+    // composition et la densité ; nullptr sans composition (transport discret historique)
+    void buildStoppingPowerTables();
+    const StoppingPowerTable* getStoppingPowerTable(RadiationType type) const;
+
     // Matériaux prédéfinis
     static std::shared_ptr<Material> createLead();
     static std::shared_ptr<Material> createSteel();
@@ -63,11 +111,38 @@ private:
     // Tables d'atténuation par type de radiation
     std::map<RadiationType, std::vector<AttenuationData>> m_attenuationTables;
 
+    // Table d'alias de Walker : une case tirée, un seuil comparé (un seul aléa)
+    struct ChannelAliasBin {
+        float threshold[INTERACTION_CHANNEL_COUNT];
+        uint8_t alias[INTERACTION_CHANNEL_COUNT];
+        float scatteringProbability;
+    };
+
+    struct ChannelTable {
+        std::vector<float> energies;         // Points de la table (keV)
+        std::vector<ChannelAliasBin> bins;   // energies.size() + 1 intervalles
+    };
+
+    std::map<RadiationType, ChannelTable> m_channelTables;
+    std::map<RadiationType, std::vector<float>> m_minimumAttenuation; // Minimum cumulé de μ aux points (m⁻¹)
+    std::map<RadiationType, std::shared_ptr<const StoppingPowerTable>> m_stoppingTables; // Partagées entre copies
+    bool m_finalized = false;
+
+    void channelProbabilities(RadiationType type, float energy, float* probabilities) const;
+    static void defaultChannelProbabilities(RadiationType type, float* probabilities);
+    static ChannelAliasBin buildAliasBin(const float* probabilities);
+    const ChannelAliasBin* findAliasBin(RadiationType type, float energy) const;
+
+    // Répartition photoélectrique / Compton / paires d'après la composition
+    void derivePhotonChannels(RadiationType type);
+
     // Interpolation linéaire dans les tables
     float interpolateAttenuation(const std::vector<AttenuationData>& table, float energy, 
                                std::function<float(const AttenuationData&)> getter) const;
 };
 
+class CrossSectionLibrary;
+
 // Gestionnaire de bibliothèque de matériaux
 class MaterialLibrary {
 public:
@@ -78,11 +153,13 @@ public:
     std::vector<std::string> getMaterialNames() const;
     void loadDefaults();
     
-    // Sérialisation
+    // Sérialisation (bibliothèque binaire .rxs, voir CrossSectionLibrary)
     void saveToFile(const std::string& filename) const;
     void loadFromFile(const std::string& filename);
+    std::shared_ptr<const CrossSectionLibrary> getMappedLibrary() const { return m_mappedLibrary; }
 
 private:
     MaterialLibrary() = default;
     std::map<std::string, std::shared_ptr<Material>> m_materials;
+    std::shared_ptr<const CrossSectionLibrary> m_mappedLibrary; // Dernière bibliothèque chargée
 };
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "common.h"
+#include "core/Source.h"
+#include "geometry/Object3D.h"
+#include "utils/MappedFile.h"
+
+// Fichier d'espace des phases (.rphs) : particules traversant une surface, enregistrements
+// de taille fixe (accès direct par projection mémoire, lecture parallèle sans verrou)
+//   en-tête | enregistrement*
+namespace PhaseSpaceFormat {
+    constexpr char MAGIC[8] = {'R', 'A', 'D', 'P', 'H', 'S', 'P', '1'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t ENDIAN_TAG = 0x01020304;
+
+    constexpr uint8_t FLAG_NEGATIVE_W = 0x01; // Signe de la composante w de la direction
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t endianTag;
+        uint64_t recordCount;
+        uint64_t histories;   // Histoires sources simulées pour produire le fichier
+        uint32_t surfaceKind;
+        uint32_t recordSize;
+        float surface[6];     // Plan : point, normale ; boîte : min, max
+    };
+
+    // Direction stockée par (u, v) et le signe de w
+    struct Record {
+        uint8_t type;  // RadiationType
+        uint8_t flags;
+        uint16_t reserved;
+        float energy;  // keV
+        float position[3];
+        float u, v;
+        float weight;
+    };
+
+    static_assert(sizeof(Header) == 64, "En-tête .rphs de 64 octets");
+    static_assert(sizeof(Record) == 32, "Enregistrement .rphs de 32 octets");
+}
+
+// Surface d'enregistrement : plan (traversée dans le sens de la normale) ou
+// boîte alignée sur les axes (sortie de la boîte)
+struct PhaseSpaceSurface {
+    enum class Kind : uint32_t { PLANE, BOX };
+
+    Kind kind = Kind::PLANE;
+    glm::vec3 point{0.0f};
+    glm::vec3 normal{0.0f, 0.0f, 1.0f};
+    AABB box;
+
+    static PhaseSpaceSurface plane(const glm::vec3& point, const glm::vec3& normal);
+    static PhaseSpaceSurface boxExit(const glm::vec3& minPoint, const glm::vec3& maxPoint);
+
+    // Traversée sortante du segment [start, end] : point de passage
+    bool crossing(const glm::vec3& start, const glm::vec3& end, glm::vec3& point) const;
+    glm::vec3 center() const { return kind == Kind::BOX ? box.center() : point; }
+};
+
+// Source rejouant un fichier d'espace des phases, lu par projection mémoire.
+// Le poids émis est w × (enregistrements / histoires) : les résultats par histoire
+// émise sont ceux par histoire du run d'origine, quel que soit le nombre d'émissions.
+// Une passe complète correspond à getRecordCount() × getReuseCount() émissions.
+class PhaseSpaceSource : public Source {
+public:
+    PhaseSpaceSource(const std::string& name, const std::string& filename);
+
+    Particle emitParticle() const override;
+
+    const std::string& getFilename() const { return m_filename; }
+    uint64_t getRecordCount() const { return m_recordCount; }
+    uint64_t getSourceHistories() const { return m_histories; }
+    const PhaseSpaceSurface& getSurface() const { return m_surface; }
+    float getWeightScale() const { return m_weightScale; }
+
+    // Réutilisation : chaque enregistrement émis N fois de suite
+    uint32_t getReuseCount() const { return m_reuseCount; }
+    void setReuseCount(uint32_t count) { m_reuseCount = std::max(1u, count); }
+
+    // Symétrie de révolution : rotation aléatoire autour de l'axe à chaque émission
+    bool hasRotationSymmetry() const { return m_rotationSymmetry; }
+    const glm::vec3& getRotationOrigin() const { return m_rotationOrigin; }
+    const glm::vec3& getRotationAxis() const { return m_rotationAxis; }
+    void setRotationSymmetry(bool enabled, const glm::vec3& origin = glm::vec3(0.0f),
+                             const glm::vec3& axis = glm::vec3(0.0f, 0.0f, 1.0f));
+
+private:
+    std::string m_filename;
+    MappedFile m_file;
+    const PhaseSpaceFormat::Record* m_records = nullptr;
+    uint64_t m_recordCount = 0;
+    uint64_t m_histories = 0;
+    float m_weightScale = 1.0f;
+    PhaseSpaceSurface m_surface;
+
+    uint32_t m_reuseCount = 1;
+    bool m_rotationSymmetry = false;
+    glm::vec3 m_rotationOrigin{0.0f};
+    glm::vec3 m_rotationAxis{0.0f, 0.0f, 1.0f};
+
+    mutable std::atomic<uint64_t> m_cursor{0}; // Runs sans n° d'histoire (graine aléatoire)
+};
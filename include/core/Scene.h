@@ -14,6 +14,7 @@ public:
 
     // Gestion des objets
     void addObject(std::shared_ptr<Object3D> object);
+    void addObjects(const std::vector<std::shared_ptr<Object3D>>& objects); // Ajout groupé (chargement)
     void removeObject(const std::string& name);
     void removeObject(uint32_t id);
     std::shared_ptr<Object3D> getObject(const std::string& name) const;
@@ -35,6 +36,14 @@ public:
     // Intersection avec les rayons (accélérée par BVH)
     IntersectionResult intersectRay(const Ray& ray) const;
     bool intersectRayAny(const Ray& ray) const; // Test d'occlusion rapide
+
+    // Profondeur optique Σ μ·l le long du segment [from, to] (longueurs de corde par objet traversé)
+    float computeOpticalDepth(const glm::vec3& from, const glm::vec3& to, RadiationType type, float energy,
+                              const std::shared_ptr<Material>& worldMaterial) const;
+    // Même parcours sur une structure d'intersection quelconque (intersect(ray), répliques NUMA)
+    template <typename Intersect>
+    static float opticalDepthAlong(const glm::vec3& from, const glm::vec3& to, RadiationType type, float energy,
+                                   const Material* worldMaterial, Intersect&& intersect);
     
     // Boîte englobante de la scène
     AABB getSceneBounds() const;
@@ -44,15 +53,17 @@ public:
         m_backgroundLevels[type] = level; 
     }
     float getBackgroundRadiation(RadiationType type) const;
+    const std::map<RadiationType, float>& getBackgroundLevels() const { return m_backgroundLevels; }
     
     // Optimisations
     void buildAccelerationStructure();
     void updateAccelerationStructure();
     bool isAccelerationStructureValid() const { return m_bvh && m_bvh->isValid(); }
     
-    // Sérialisation
+    // Sérialisation : JSON éditable, ou binaire compact si l'extension est .rsb
+    // (format détecté à la lecture ; chargement en flux, objets décodés en parallèle)
     void saveToFile(const std::string& filename) const;
-    void loadFromFile(const std::string& filename);
+    void loadFromFile(const std::string& filename, uint32_t threadCount = 0);
     void clear();
     
     // Statistiques
@@ -88,5 +99,47 @@ private:
     
     // Helpers privés
     void rebuildIndices();
+    void clearUnlocked();
     void markBVHDirty() { m_bvhDirty = true; }
-};
\ No newline at end of file
+};
+
+template <typename Intersect>
+float Scene::opticalDepthAlong(const glm::vec3& from, const glm::vec3& to, RadiationType type, float energy,
+                               const Material* worldMaterial, Intersect&& intersect) {
+    glm::vec3 delta = to - from;
+    float distance = glm::length(delta);
+    if (distance <= 0.0f) return 0.0f;
+
+    glm::vec3 direction = delta / distance;
+    float worldMu = worldMaterial ? worldMaterial->getLinearAttenuationPerMeter(type, energy) : 0.0f;
+
+    // Parcours des surfaces successives : une sortie d'objet (normale dans le sens du rayon)
+    // signifie que le segment précédent était dans son matériau, sinon dans le milieu ambiant
+    const int maxCrossings = 256;
+    const float surfaceOffset = 1e-4f;
+    float tau = 0.0f;
+    float travelled = 0.0f;
+
+    for (int crossing = 0; crossing < maxCrossings && travelled < distance; ++crossing) {
+        Ray ray(from + direction * travelled, direction);
+        ray.tMin = 0.0f;
+        ray.tMax = distance - travelled;
+
+        IntersectionResult hit = intersect(ray);
+        if (!hit.hit || hit.distance > ray.tMax) {
+            tau += worldMu * (distance - travelled);
+            return tau;
+        }
+
+        bool exiting = glm::dot(hit.normal, direction) > 0.0f;
+        float mu = worldMu;
+        if (exiting && hit.material) {
+            mu = hit.material->getLinearAttenuationPerMeter(type, energy);
+        }
+
+        tau += mu * hit.distance;
+        travelled += hit.distance + surfaceOffset;
+    }
+
+    return tau;
+}
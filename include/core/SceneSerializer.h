@@ -0,0 +1,32 @@
+#pragma once
+
+#include "common.h"
+#include "geometry/Object3D.h"
+#include "core/Sensor.h"
+#include "core/Source.h"
+
+enum class SceneFileFormat {
+    JSON,   // Éditable à la main
+    BINARY  // Compact (.rsb) : enregistrements d'objets de taille fixe
+};
+
+// Contenu sérialisable d'une scène (les matériaux sont référencés par nom)
+struct SceneData {
+    std::vector<std::shared_ptr<Object3D>> objects;
+    std::vector<std::shared_ptr<Source>> sources;
+    std::vector<std::shared_ptr<Sensor>> sensors;
+    std::map<RadiationType, float> backgroundLevels;
+};
+
+// Lecture / écriture des fichiers de scène
+// Le chargement ne construit pas d'arbre : le fichier est projeté en mémoire, les sources
+// et capteurs sont lus en flux, puis les objets sont découpés et décodés par plusieurs threads.
+class SceneSerializer {
+public:
+    static void save(const std::string& filename, const SceneData& data, SceneFileFormat format);
+    static SceneData load(const std::string& filename, uint32_t threadCount = 0); // 0 : tous les cœurs
+
+    static SceneFileFormat formatFromExtension(const std::string& filename);
+
+    static constexpr uint32_t VERSION = 2; // 2 : biaisage par région dans la scène binaire
+};
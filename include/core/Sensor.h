@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common.h"
+#include "core/BinnedTally.h"
 
 // Types de capteurs
 enum class SensorType {
@@ -15,8 +16,18 @@ struct DetectionStats {
     std::atomic<uint64_t> gammaCounts{0};
     std::atomic<uint64_t> neutronCounts{0};
     std::atomic<uint64_t> muonCounts{0};
+    std::atomic<double> weightedCounts{0.0}; // Somme des poids (estimateur non biaisé)
     std::atomic<double> totalEnergy{0.0};
     std::atomic<double> totalDose{0.0};
+
+    // Estimateur next-event (capteurs ponctuels) : fluence au point par histoire (m⁻²)
+    std::atomic<uint64_t> nextEventScores{0};
+    std::atomic<double> nextEventFluence{0.0};
+    std::atomic<double> nextEventEnergyFluence{0.0}; // keV·m⁻²
+
+    // Estimateur longueur de trace (capteurs volumiques) : Σ w·L / V par histoire
+    std::atomic<double> trackLengthFluence{0.0}; // m⁻²
+    std::atomic<double> trackLengthDose{0.0};    // pSv (facteurs fluence-dose du capteur)
     
     // Constructeurs pour permettre la copie
     DetectionStats() = default;
@@ -25,8 +36,14 @@ struct DetectionStats {
         gammaCounts.store(other.gammaCounts.load());
         neutronCounts.store(other.neutronCounts.load());
         muonCounts.store(other.muonCounts.load());
+        weightedCounts.store(other.weightedCounts.load());
         totalEnergy.store(other.totalEnergy.load());
         totalDose.store(other.totalDose.load());
+        nextEventScores.store(other.nextEventScores.load());
+        nextEventFluence.store(other.nextEventFluence.load());
+        nextEventEnergyFluence.store(other.nextEventEnergyFluence.load());
+        trackLengthFluence.store(other.trackLengthFluence.load());
+        trackLengthDose.store(other.trackLengthDose.load());
     }
     
     DetectionStats& operator=(const DetectionStats& other) {
@@ -35,8 +52,14 @@ struct DetectionStats {
             gammaCounts.store(other.gammaCounts.load());
             neutronCounts.store(other.neutronCounts.load());
             muonCounts.store(other.muonCounts.load());
+            weightedCounts.store(other.weightedCounts.load());
             totalEnergy.store(other.totalEnergy.load());
             totalDose.store(other.totalDose.load());
+            nextEventScores.store(other.nextEventScores.load());
+            nextEventFluence.store(other.nextEventFluence.load());
+            nextEventEnergyFluence.store(other.nextEventEnergyFluence.load());
+            trackLengthFluence.store(other.trackLengthFluence.load());
+            trackLengthDose.store(other.trackLengthDose.load());
         }
         return *this;
     }
@@ -46,21 +69,56 @@ struct DetectionStats {
         gammaCounts = 0;
         neutronCounts = 0;
         muonCounts = 0;
+        weightedCounts = 0.0;
         totalEnergy = 0.0;
         totalDose = 0.0;
+        nextEventScores = 0;
+        nextEventFluence = 0.0;
+        nextEventEnergyFluence = 0.0;
+        trackLengthFluence = 0.0;
+        trackLengthDose = 0.0;
     }
     
+    // Transfert vers target par échange avec zéro : aucun comptage perdu si d'autres threads
+    // continuent d'accumuler ici pendant le transfert
+    void transferTo(DetectionStats& target) {
+        target.totalCounts.fetch_add(totalCounts.exchange(0));
+        target.gammaCounts.fetch_add(gammaCounts.exchange(0));
+        target.neutronCounts.fetch_add(neutronCounts.exchange(0));
+        target.muonCounts.fetch_add(muonCounts.exchange(0));
+        target.weightedCounts.fetch_add(weightedCounts.exchange(0.0));
+        target.totalEnergy.fetch_add(totalEnergy.exchange(0.0));
+        target.totalDose.fetch_add(totalDose.exchange(0.0));
+        target.nextEventScores.fetch_add(nextEventScores.exchange(0));
+        target.nextEventFluence.fetch_add(nextEventFluence.exchange(0.0));
+        target.nextEventEnergyFluence.fetch_add(nextEventEnergyFluence.exchange(0.0));
+        target.trackLengthFluence.fetch_add(trackLengthFluence.exchange(0.0));
+        target.trackLengthDose.fetch_add(trackLengthDose.exchange(0.0));
+    }
+
     DetectionStats& operator+=(const DetectionStats& other) {
         totalCounts.fetch_add(other.totalCounts.load());
         gammaCounts.fetch_add(other.gammaCounts.load());
         neutronCounts.fetch_add(other.neutronCounts.load());
         muonCounts.fetch_add(other.muonCounts.load());
+        weightedCounts.fetch_add(other.weightedCounts.load());
         totalEnergy.fetch_add(other.totalEnergy.load());
         totalDose.fetch_add(other.totalDose.load());
+        nextEventScores.fetch_add(other.nextEventScores.load());
+        nextEventFluence.fetch_add(other.nextEventFluence.load());
+        nextEventEnergyFluence.fetch_add(other.nextEventEnergyFluence.load());
+        trackLengthFluence.fetch_add(other.trackLengthFluence.load());
+        trackLengthDose.fetch_add(other.trackLengthDose.load());
         return *this;
     }
 };
 
+// Grandeur accumulée dans le spectre du capteur
+enum class SpectrumQuantity {
+    COUNTS,  // Poids des détections (traversées)
+    FLUENCE  // Longueur de trace (VOLUME) ou next-event (POINT), m⁻²
+};
+
 class Sensor {
 public:
     Sensor(const std::string& name, SensorType type, const glm::vec3& position);
@@ -100,15 +158,54 @@ public:
         m_radiationFilter = types;
     }
 
+    float getMinEnergy() const { return m_minEnergy; }
+    float getMaxEnergy() const { return m_maxEnergy; }
+    const std::vector<RadiationType>& getRadiationFilter() const { return m_radiationFilter; }
+
+    // Facteurs de conversion fluence → dose : (énergie keV, pSv·cm²), interpolation log-log
+    void setFluxToDoseFactors(const std::vector<std::pair<float, float>>& factors);
+    const std::vector<std::pair<float, float>>& getFluxToDoseFactors() const { return m_fluxToDose; }
+    float getFluxToDoseFactor(float energy) const; // 0 sans table
+    static std::vector<std::pair<float, float>> ambientDoseFactorsPhotons(); // H*(10)/Φ, ICRP 74
+    static float interpolateFluxToDose(const std::vector<std::pair<float, float>>& factors, float energy);
+
     // Détection
     bool detectsParticle(const Particle& particle) const;
     bool intersectsSegment(const glm::vec3& p0, const glm::vec3& p1) const;
+    float clippedSegmentLength(const glm::vec3& p0, const glm::vec3& p1) const; // Longueur dans la boîte (m)
+    float distanceFrom(const glm::vec3& point) const; // Distance à la zone de comptage (m, 0 à l'intérieur)
     void recordDetection(const Particle& particle);
-    void recordParticle(const Particle& particle);
+    // time : instant du passage (ns), âge de la particule si négatif ; stats : compteurs où
+    // accumuler (réplique NUMA, transférée par transferStats), ceux du capteur si nul
+    bool recordParticle(const Particle& particle, uint32_t threadSlot = 0, float time = -1.0f,
+                        DetectionStats* stats = nullptr); // true si comptée
+    bool acceptsRadiation(RadiationType type, float energy) const;
+    void recordNextEvent(double fluence, float energy, float time, uint32_t threadSlot = 0,
+                         DetectionStats* stats = nullptr); // m⁻², ns
+    void recordTrackLength(const Particle& particle, float length, uint32_t threadSlot = 0, float time = -1.0f,
+                           DetectionStats* stats = nullptr); // Capteurs volumiques
+    double getVolume() const; // m³
     
     // Statistiques
     const DetectionStats& getStats() const { return m_stats; }
-    void clearStats() { m_stats.clear(); }
+    void clearStats() {
+        m_stats.clear();
+        m_spectrum.clear();
+    }
+    // Ajout de résultats obtenus ailleurs (runs distribués)
+    void addResults(const DetectionStats& stats, const BinnedTally::State& spectrum) {
+        m_stats += stats;
+        m_spectrum.addState(spectrum);
+    }
+    void transferStats(DetectionStats& stats) { stats.transferTo(m_stats); } // stats remis à zéro
+
+    // Spectres en énergie (keV) et en temps (ns) ; Binning() désactive un axe
+    void setSpectrumBinning(const Binning& energyBins, const Binning& timeBins = Binning(),
+                            SpectrumQuantity quantity = SpectrumQuantity::COUNTS);
+    SpectrumQuantity getSpectrumQuantity() const { return m_spectrumQuantity; }
+    const BinnedTally& getSpectrum() const { return m_spectrum; }
+    void prepareSpectrum(uint32_t threadCount) { m_spectrum.ensureThreadSlots(threadCount); }
+    void endSpectrumBatch(uint32_t threadSlot, uint64_t histories) { m_spectrum.endBatch(threadSlot, histories); }
     
     // Calculs dérivés
     double getCountRate() const; // counts/s
@@ -139,9 +236,12 @@ private:
     float m_minEnergy = 0.0f;      // keV
     float m_maxEnergy = 10000.0f;  // keV
     std::vector<RadiationType> m_radiationFilter; // Types acceptés (vide = tous)
+    std::vector<std::pair<float, float>> m_fluxToDose; // Triés par énergie
     
     // Statistiques
     DetectionStats m_stats;
+    BinnedTally m_spectrum;
+    SpectrumQuantity m_spectrumQuantity = SpectrumQuantity::COUNTS;
     std::chrono::steady_clock::time_point m_startTime;
     
     // Visualisation
@@ -151,8 +251,9 @@ private:
     // Tests géométriques
     bool pointInSensor(const glm::vec3& point) const;
     bool rayIntersectsSensor(const Ray& ray, float& t) const;
+    bool clipSegment(const glm::vec3& p0, const glm::vec3& p1, float& tMin, float& tMax) const;
     bool passesFilters(const Particle& particle) const;
-    void accumulateDetection(const Particle& particle);
+    void accumulateDetection(const Particle& particle, DetectionStats& stats);
     float effectiveRadius() const;
 };
 
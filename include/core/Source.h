@@ -9,7 +9,8 @@ enum class SourceType {
     AMBIENT,        // Fond ambiant
     POINT,          // Source ponctuelle
     SURFACE,        // Source surfacique
-    VOLUME          // Source volumique
+    VOLUME,         // Source volumique
+    PHASE_SPACE     // Relecture d'un espace des phases enregistré
 };
 
 // Spectre d'énergie
@@ -24,9 +25,14 @@ struct EnergySpectrum {
     std::vector<std::pair<float, float>> spectrum; // (énergie, intensité relative)
     
     float sampleEnergy() const;
+
+    // Biaisage en énergie : probabilités par groupe (bornes croissantes) et tirage restreint
+    std::vector<double> groupProbabilities(const std::vector<float>& groupBounds) const;
+    float sampleEnergyInRange(float minEnergy, float maxEnergy) const;
     
 private:
     float interpolateIntensity(float energy) const;
+    double integrateIntensity(float minEnergy, float maxEnergy) const;
 };
 
 // Source de radiation de base
@@ -65,6 +71,7 @@ public:
     virtual Particle emitParticle() const = 0;
     virtual glm::vec3 sampleDirection() const;
     virtual glm::vec3 samplePosition() const;
+    virtual float directionPdf(const glm::vec3& direction) const; // sr⁻¹ (0 : émission dirac)
 
     // Statistiques
     uint64_t getEmittedCount() const { return m_emittedCount; }
@@ -103,6 +110,7 @@ public:
     
     Particle emitParticle() const override;
     glm::vec3 sampleDirection() const override;
+    float directionPdf(const glm::vec3& direction) const override;
 };
 
 // Source directionnelle (faisceau)
@@ -112,6 +120,7 @@ public:
     
     Particle emitParticle() const override;
     glm::vec3 sampleDirection() const override;
+    float directionPdf(const glm::vec3& direction) const override;
     
     float getBeamAngle() const { return m_beamAngle; }
     void setBeamAngle(float angle) { m_beamAngle = angle; }
@@ -128,11 +137,14 @@ public:
     Particle emitParticle() const override;
     glm::vec3 sampleDirection() const override;
     glm::vec3 samplePosition() const override;
+    float directionPdf(const glm::vec3& direction) const override;
     
     void setBounds(const glm::vec3& minBounds, const glm::vec3& maxBounds) {
         m_minBounds = minBounds;
         m_maxBounds = maxBounds;
     }
+    const glm::vec3& getMinBounds() const { return m_minBounds; }
+    const glm::vec3& getMaxBounds() const { return m_maxBounds; }
 
 private:
     glm::vec3 m_minBounds{-10.0f};
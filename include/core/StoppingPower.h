@@ -0,0 +1,44 @@
+#pragma once
+
+#include "common.h"
+
+struct ElementComposition;
+
+// Pertes d'énergie continues d'une particule chargée dans un matériau (histoire condensée).
+// Pouvoir d'arrêt de Bethe (muons, alphas ; correction de densité asymptotique) ou de
+// Rohrlich-Carlson plus rayonnement de freinage (électrons), additivité de Bragg sur la
+// composition. Sous le pic de Bragg calculé, raccord en √E. Portée CSDA intégrée sur une
+// grille logarithmique ; longueur de radiation pour la diffusion multiple.
+class StoppingPowerTable {
+public:
+    StoppingPowerTable(const std::vector<ElementComposition>& composition, float density, RadiationType type);
+
+    bool isValid() const { return !m_energies.empty(); }
+
+    float stoppingPower(float energy) const; // keV/m
+    float range(float energy) const;         // m, portée CSDA
+    float energyAtRange(float range) const;  // keV, inverse de range()
+    float getRadiationLength() const { return m_radiationLength; } // m
+
+    // Écart angulaire projeté de Highland après un pas (rad)
+    float highlandAngle(float energy, float step) const;
+
+    // Plus petit pouvoir d'arrêt de plusieurs matériaux à chaque énergie : sa portée majore le
+    // parcours dans toute combinaison de ces matériaux (même type de particule)
+    static std::shared_ptr<const StoppingPowerTable> lowerEnvelope(const std::vector<const StoppingPowerTable*>& tables);
+
+    static constexpr float MIN_ENERGY = 1.0f;  // keV
+    static constexpr float MAX_ENERGY = 1e8f;  // keV (100 GeV)
+
+private:
+    RadiationType m_type = RadiationType::BETA;
+    double m_restMass = 0.0; // keV/c²
+    int m_charge = 1;
+    double m_radiationLength = 0.0; // m
+
+    std::vector<float> m_energies;      // keV, grille logarithmique
+    std::vector<float> m_stoppingPowers; // keV/m
+    std::vector<float> m_ranges;        // m, croissantes
+
+    void integrateRanges();
+};
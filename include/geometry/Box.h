@@ -24,6 +24,8 @@ public:
     // Géométrie
     IntersectionResult intersectLocal(const Ray& ray) const override;
     AABB computeLocalBounds() const override;
+    std::shared_ptr<Object3D> clone() const override { return std::make_shared<Box>(*this); }
+    float surfaceDistanceBound(const glm::vec3& point) const override; // Faces aussi depuis l'intérieur
     
     // Propriétés géométriques
     float getVolume() const { return m_size.x * m_size.y * m_size.z; }
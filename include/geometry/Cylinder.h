@@ -34,6 +34,7 @@ public:
     // Géométrie
     IntersectionResult intersectLocal(const Ray& ray) const override;
     AABB computeLocalBounds() const override;
+    std::shared_ptr<Object3D> clone() const override { return std::make_shared<Cylinder>(*this); }
     
     // Propriétés géométriques
     float getVolume() const { return PI * m_radius * m_radius * m_height; }
@@ -30,10 +30,23 @@ struct AABB {
     void expand(const glm::vec3& point);
     void expand(const AABB& other);
     bool contains(const glm::vec3& point) const;
+    float distanceTo(const glm::vec3& point) const; // 0 à l'intérieur
     bool intersects(const AABB& other) const;
     bool intersects(const Ray& ray, float& tMin, float& tMax) const;
 };
 
+// Biaisage du transport des particules neutres dans le volume d'un objet
+struct RegionBiasing {
+    // Volumes minces : chaque pas est scindé en une part non collisionnée, qui traverse,
+    // et une part collisionnée, qui interagit dans le volume
+    bool forcedCollisions = false;
+    // Volumes épais : μ* = μ (1 - p cos θ) par rapport à la direction privilégiée, p dans [0, 1[
+    float exponentialTransform = 0.0f;
+    glm::vec3 preferredDirection{0.0f, 0.0f, 1.0f};
+
+    bool isActive() const { return forcedCollisions || exponentialTransform > 0.0f; }
+};
+
 // Classe de base pour tous les objets 3D
 class Object3D : public std::enable_shared_from_this<Object3D> {
 public:
@@ -72,6 +85,10 @@ public:
     std::shared_ptr<Material> getMaterial() const { return m_material; }
     void setMaterial(std::shared_ptr<Material> material) { m_material = material; }
 
+    // Biaisage du transport dans le volume
+    const RegionBiasing& getBiasing() const { return m_biasing; }
+    void setBiasing(const RegionBiasing& biasing);
+
     // Intersection avec les rayons (méthode virtuelle pure)
     virtual IntersectionResult intersect(const Ray& ray) const = 0;
     
@@ -79,6 +96,13 @@ public:
     const AABB& getBounds() const;
     virtual AABB computeLocalBounds() const = 0;
 
+    // Minorant de la distance du point à la surface de l'objet. Par défaut, distance à la boîte
+    // englobante : nulle à l'intérieur, faute de mieux
+    virtual float surfaceDistanceBound(const glm::vec3& point) const;
+
+    // Copie indépendante (même identifiant) : répliques de scène par nœud NUMA
+    virtual std::shared_ptr<Object3D> clone() const = 0;
+
     // Propriétés de rendu
     bool isVisible() const { return m_visible; }
     void setVisible(bool visible) { m_visible = visible; }
@@ -98,6 +122,7 @@ protected:
     uint32_t m_id;
     Transform m_transform;
     std::shared_ptr<Material> m_material;
+    RegionBiasing m_biasing;
     
     // Boîte englobante mise en cache
     mutable AABB m_bounds;
@@ -110,7 +135,7 @@ protected:
     bool m_selected = false;
 
 private:
-    static uint32_t s_nextId;
+    static std::atomic<uint32_t> s_nextId; // Objets créés en parallèle au chargement
 };
 
 // Classe de base pour les primitives géométriques
@@ -35,6 +35,7 @@ public:
     // Géométrie
     IntersectionResult intersectLocal(const Ray& ray) const override;
     AABB computeLocalBounds() const override;
+    std::shared_ptr<Object3D> clone() const override { return std::make_shared<Plane>(*this); }
     
     // Distance signée d'un point au plan
     float distanceToPoint(const glm::vec3& point) const;
@@ -16,6 +16,7 @@ public:
     // Géométrie
     IntersectionResult intersectLocal(const Ray& ray) const override;
     AABB computeLocalBounds() const override;
+    std::shared_ptr<Object3D> clone() const override { return std::make_shared<Sphere>(*this); }
     
     // Propriétés géométriques
     float getVolume() const { return (4.0f / 3.0f) * PI * m_radius * m_radius * m_radius; }
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "common.h"
+#include "core/Source.h"
+#include "simulation/Particle.h"
+#include "simulation/WeightWindow.h"
+#include "utils/RegularGrid.h"
+
+// Paramètres de la réduction de variance adjointe (CADIS)
+struct CadisConfig {
+    uint32_t nx = 20;
+    uint32_t ny = 20;
+    uint32_t nz = 20;
+    uint32_t energyGroups = 6;
+    float boundsPadding = 0.5f;             // m autour de la scène, des sources et capteurs
+    std::vector<std::string> targetSensors; // Capteurs visés (vide = tous)
+
+    bool biasPosition = true;  // Sources volumiques (AmbientSource)
+    bool biasEnergy = true;    // Spectres continus / discrets
+    bool biasDirection = true; // Sources isotropes : lobes vers les capteurs
+    float directionBiasFraction = 0.5f;
+    float defensiveFraction = 0.05f; // Part analogique gardée dans la loi biaisée
+};
+
+// Importance adjointe φ†(r, E) sur une grille grossière, par groupe d'énergie
+class AdjointImportanceMap {
+public:
+    AdjointImportanceMap(const RegularGrid& grid, const std::vector<float>& groupBounds);
+
+    const RegularGrid& getGrid() const { return m_grid; }
+    const std::vector<float>& getGroupBounds() const { return m_groupBounds; } // n + 1 bornes (keV)
+    uint32_t getGroupCount() const { return static_cast<uint32_t>(m_groupBounds.size()) - 1; }
+    uint32_t groupIndex(float energy) const;
+    float groupEnergy(uint32_t group) const; // Moyenne géométrique des bornes
+
+    double getValue(uint32_t cell, uint32_t group) const { return m_values[group * m_grid.getCellCount() + cell]; }
+    double getValue(const glm::vec3& position, float energy) const; // 0 hors grille
+    void setValue(uint32_t cell, uint32_t group, double value) { m_values[group * m_grid.getCellCount() + cell] = value; }
+
+    // Fenêtres centrées sur R / φ†, cohérentes avec le biaisage de la source
+    std::shared_ptr<WeightWindowMesh> buildWeightWindows(double response, float upperRatio = 5.0f) const;
+
+private:
+    RegularGrid m_grid;
+    std::vector<float> m_groupBounds;
+    std::vector<double> m_values; // [groupe][cellule]
+};
+
+// Échantillonnage biaisé des sources : q̂(s, r, E) ∝ q(s, r, E) φ†(r, E), poids q / q̂
+class CadisSourceBiasing {
+public:
+    CadisSourceBiasing(std::shared_ptr<const AdjointImportanceMap> importance,
+                       const std::vector<std::shared_ptr<Source>>& sources,
+                       const std::vector<std::shared_ptr<Sensor>>& targets, const CadisConfig& config);
+
+    bool isValid() const { return !m_candidates.empty() && m_response > 0.0; }
+    double getResponseEstimate() const { return m_response; } // R = Σ q φ†
+    bool sample(Particle& particle) const;
+    // Variante renseignant la source tirée et le poids hors biaisage angulaire
+    bool sample(Particle& particle, const Source*& emitter, float& emissionWeight) const;
+
+private:
+    // Couple (source, cellule, groupe) ; -1 = tirage analogique de la composante
+    struct Candidate {
+        uint32_t source;
+        int cell;
+        int group;
+        AABB region;   // Région d'émission (intersection source / cellule)
+        double weight; // q / q̂
+    };
+
+    // Lobe de direction : cône vers un capteur
+    struct Lobe {
+        glm::vec3 target;
+        float targetRadius;
+        double probability;
+    };
+
+    struct BiasedSource {
+        std::shared_ptr<Source> source;
+        bool isotropic = false; // Émission isotrope : direction biaisable
+        bool volume = false;    // AmbientSource : position biaisable
+        bool opaque = false;    // Type inconnu : émission analogique via emitParticle()
+        std::vector<Lobe> lobes;
+    };
+
+    std::shared_ptr<const AdjointImportanceMap> m_importance;
+    std::vector<BiasedSource> m_sources;
+    std::vector<Candidate> m_candidates;
+    std::vector<double> m_cdf;
+    double m_response = 0.0;
+    CadisConfig m_config;
+
+    glm::vec3 sampleDirection(const BiasedSource& biased, const glm::vec3& position, double& weightFactor) const;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "common.h"
+#include "core/Scene.h"
+#include "simulation/MonteCarloEngine.h"
+#include "utils/ColumnStore.h"
+
+// Paramètre balayé : une propriété d'un élément nommé de la scène
+struct SweepParameter {
+    enum class Target { OBJECT, SOURCE, SENSOR };
+
+    std::string column;   // Nom de colonne en sortie (élément.propriété par défaut)
+    Target target = Target::OBJECT;
+    std::string element;  // Nom de l'objet, de la source ou du capteur
+    std::string property; // Objet : thickness, size, position, material ; source : energy, intensity, position ;
+                          // capteur : position
+    std::vector<std::vector<float>> numericValues; // Scalaires ou vecteurs à 3 composantes
+    std::vector<std::string> textValues;           // Noms de matériaux
+
+    size_t getValueCount() const { return textValues.empty() ? numericValues.size() : textValues.size(); }
+    bool isVector() const { return property == "size" || property == "position"; }
+    bool affectsGeometry() const; // Modifie les bornes d'un objet : BVH à reconstruire
+};
+
+// Spécification d'un balayage (fichier JSON)
+struct SweepSpec {
+    std::vector<SweepParameter> parameters;
+    bool zip = false; // Valeurs appariées terme à terme au lieu du produit cartésien
+    SimulationConfig config;
+    std::string materialLibrary; // Bibliothèque .rxs optionnelle, chargée une fois
+
+    static SweepSpec loadFromFile(const std::string& filename);
+};
+
+struct BatchSummary {
+    size_t variants = 0;
+    size_t bvhBuilds = 0;
+    double elapsedSeconds = 0.0;
+};
+
+// Exécution de toutes les variantes dans un seul processus : scène, matériaux et moteur
+// sont partagés ; le BVH n'est reconstruit que si un paramètre géométrique change.
+// Les paramètres géométriques varient le plus lentement pour limiter les reconstructions.
+// Sortie CSV : une ligne par variante, une colonne par paramètre et par grandeur de capteur
+// (valeurs par histoire source), écrite au fil de l'eau ; .rcol : tables par variante (ResultsWriter).
+class BatchRunner {
+public:
+    BatchRunner(std::shared_ptr<Scene> scene, SweepSpec spec);
+
+    size_t getVariantCount() const;
+    BatchSummary run(const std::string& outputFile);
+
+private:
+    std::shared_ptr<Scene> m_scene;
+    SweepSpec m_spec;
+    std::vector<size_t> m_loopOrder;     // Indices de paramètres, du plus lent au plus rapide
+    std::vector<size_t> m_appliedValues; // Valeur appliquée par paramètre (SIZE_MAX : aucune)
+
+    void validate() const;
+    std::vector<size_t> valueIndices(size_t variant) const;
+    bool applyVariant(const std::vector<size_t>& indices); // true si la géométrie a changé
+    void applyValue(const SweepParameter& parameter, size_t valueIndex);
+
+    std::string headerLine() const;
+    std::string resultLine(size_t variant, const std::vector<size_t>& indices, uint64_t histories,
+                           double seconds, bool rebuilt) const;
+    ColumnTable variantTable(size_t variant, const std::vector<size_t>& indices, uint64_t histories,
+                             double seconds, bool rebuilt) const;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "common.h"
+#include "simulation/MonteCarloEngine.h"
+#include "simulation/TallySnapshot.h"
+#include "utils/Socket.h"
+
+// Runs distribués coordinateur / workers sur sockets (TCP ou Unix).
+//
+// Le coordinateur découpe [0, maxParticles) en plages alignées sur les flux aléatoires
+// (SimulationConfig::historiesPerStream) et les confie aux workers à mesure qu'ils se libèrent.
+// Chaque worker charge la même scène, reçoit la configuration de transport et les tallies
+// maillés du coordinateur, traite sa plage avec tous ses threads et renvoie ses résultats.
+// Le coordinateur les fusionne et évalue la convergence (une plage = un lot).
+//
+// Les histoires d'une plage sont tirées de flux déterminés par leur rang : à graine égale,
+// les résultats ne dépendent ni du nombre de workers ni du nombre de threads de chacun
+// (aux arrondis de sommation près). Fenêtres de poids et CADIS ne sont pas transmis.
+namespace DistributedProtocol {
+    constexpr uint32_t MAGIC = 0x44444152; // "RADD"
+    constexpr uint32_t VERSION = 5;
+
+    enum class MessageType : uint32_t {
+        HELLO = 1, // Worker -> coordinateur : version, empreinte de la scène, threads
+        CONFIG,    // Configuration de transport et définitions des tallies maillés
+        ASSIGN,    // Plage d'histoires [premier, premier + nombre)
+        RESULT,    // Plage traitée et résultats sérialisés (TallySnapshot)
+        STOP       // Fin du run
+    };
+
+    struct MessageHeader {
+        uint32_t magic;
+        uint32_t type;
+        uint64_t size; // Octets de données après l'en-tête
+    };
+
+    static_assert(sizeof(MessageHeader) == 16, "En-tête de message de 16 octets");
+}
+
+struct DistributedConfig {
+    std::string address = "unix:/tmp/radiation_sim.sock"; // "unix:/chemin" ou "hôte:port"
+    uint64_t historiesPerRange = 10000; // Arrondi au multiple de historiesPerStream
+    double targetRelativeError = 0.0;   // Arrêt anticipé sur l'erreur relative des capteurs (0 : aucun)
+    std::string convergenceSensor;      // Capteur surveillé (vide : tous ceux ayant compté)
+    uint32_t minRanges = 10;            // Plages fusionnées avant le premier test de convergence
+    uint32_t idleTimeoutMs = 0;         // Abandon sans aucun worker actif pendant ce délai (0 : jamais)
+};
+
+struct DistributedSummary {
+    uint64_t histories = 0;
+    uint64_t ranges = 0;
+    uint32_t workers = 0;          // Workers connectés au cours du run
+    uint64_t reassignedRanges = 0; // Plages reprises après la perte d'un worker
+    bool converged = false;
+    double maxRelativeError = 0.0; // Capteurs surveillés, en fin de run
+    double elapsedSeconds = 0.0;
+};
+
+// Empreinte de la scène (objets, capteurs et sources) : workers et coordinateur doivent concorder
+uint64_t distributedFingerprint(const Scene& scene);
+
+class DistributedCoordinator {
+public:
+    // Écoute dès la construction : les workers peuvent être lancés ensuite
+    DistributedCoordinator(MonteCarloEngine& engine, const DistributedConfig& config);
+
+    const std::string& getAddress() const { return m_listener.getAddress(); }
+
+    // Bloquant : distribue les plages, fusionne les résultats dans la scène et le moteur
+    DistributedSummary run();
+
+    // Erreur relative de weightedCounts par capteur, lots = plages fusionnées
+    double relativeError(size_t sensorIndex) const;
+
+private:
+    struct WorkerSlot {
+        SocketConnection connection;
+        std::string label;
+        bool ready = false;
+        bool busy = false;
+        uint64_t firstHistory = 0;
+        uint64_t count = 0;
+    };
+
+    MonteCarloEngine& m_engine;
+    DistributedConfig m_config;
+    SocketListener m_listener;
+    std::vector<uint8_t> m_configMessage;
+
+    TallySnapshot m_results;
+    std::vector<double> m_batchSum;      // Par capteur : Σ x_b
+    std::vector<double> m_batchSumSqOverN; // Σ x_b² / n_b
+    uint64_t m_histories = 0;
+    uint64_t m_batches = 0;
+
+    void recordBatch(const TallySnapshot& batch);
+    bool isConverged(double& maxError) const;
+};
+
+class DistributedWorker {
+public:
+    explicit DistributedWorker(MonteCarloEngine& engine) : m_engine(engine) {}
+
+    // Bloquant : traite les plages reçues jusqu'au message STOP ; nombre de plages traitées
+    uint64_t run(const std::string& address, uint32_t connectTimeoutMs = 10000);
+
+private:
+    MonteCarloEngine& m_engine;
+};
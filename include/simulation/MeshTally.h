@@ -0,0 +1,70 @@
+#pragma once
+
+#include "common.h"
+#include "utils/RegularGrid.h"
+
+// Tally maillé : fluence et dose par voxel (estimateur longueur de trace, parcours 3D-DDA)
+// Chaque thread accumule dans son propre tampon par blocs, alloués à la première écriture ;
+// mergeThreadBuffers() reporte les tampons dans les totaux une fois les threads arrêtés.
+class MeshTally {
+public:
+    MeshTally(const std::string& name, const AABB& bounds, uint32_t nx, uint32_t ny, uint32_t nz);
+
+    const std::string& getName() const { return m_name; }
+    const RegularGrid& getGrid() const { return m_grid; }
+
+    // Groupes d'énergie (n + 1 bornes croissantes en keV, groupes extrêmes ouverts)
+    void setEnergyBins(const std::vector<float>& bounds);
+    const std::vector<float>& getEnergyBins() const { return m_binBounds; }
+    uint32_t getBinCount() const { return m_binBounds.size() > 1 ? static_cast<uint32_t>(m_binBounds.size()) - 1 : 1; }
+    uint32_t binIndex(float energy) const;
+
+    // Conversion fluence → dose (énergie keV, pSv·cm²) ; sans table, seule la fluence est calculée
+    void setFluxToDoseFactors(const std::vector<std::pair<float, float>>& factors);
+    const std::vector<std::pair<float, float>>& getFluxToDoseFactors() const { return m_fluxToDose; }
+    void setRadiationFilter(const std::vector<RadiationType>& types) { m_radiationFilter = types; }
+    const std::vector<RadiationType>& getRadiationFilter() const { return m_radiationFilter; }
+
+    // Accumulation (sans verrou : un tampon par thread)
+    void ensureThreadSlots(uint32_t threadCount);
+    void scoreSegment(uint32_t threadSlot, const glm::vec3& p0, const glm::vec3& p1, const Particle& particle);
+    void mergeThreadBuffers();
+    void clear();
+
+    // Résultats cumulés sur toutes les histoires
+    double getFluence(uint32_t cell, uint32_t bin) const { return m_fluence[bin * m_grid.getCellCount() + cell]; }
+    double getTotalFluence(uint32_t cell) const; // m⁻²
+    double getDose(uint32_t cell) const { return m_dose[cell]; } // pSv
+    const std::vector<double>& getFluenceData() const { return m_fluence; }
+    const std::vector<double>& getDoseData() const { return m_dose; }
+    // Ajout de totaux obtenus ailleurs (runs distribués), hors transport
+    void addTotals(const std::vector<double>& fluence, const std::vector<double>& dose);
+
+    // Export CSV : centre du voxel, fluence et dose par histoire
+    void exportCsv(const std::string& filename, uint64_t histories) const;
+
+private:
+    static constexpr size_t BLOCK_SIZE = 4096;
+
+    // Tampon par blocs : [fluence groupe × cellule | dose cellule]
+    struct ThreadBuffer {
+        std::vector<std::unique_ptr<double[]>> blocks;
+        std::vector<uint8_t> dirty;    // Bloc modifié depuis la dernière fusion
+        std::vector<uint32_t> touched; // Blocs à relire lors de la fusion
+
+        void add(size_t index, double value);
+    };
+
+    std::string m_name;
+    RegularGrid m_grid;
+    std::vector<float> m_binBounds;
+    std::vector<std::pair<float, float>> m_fluxToDose;
+    std::vector<RadiationType> m_radiationFilter;
+
+    std::vector<ThreadBuffer> m_threadBuffers;
+    std::vector<double> m_fluence; // [groupe][cellule]
+    std::vector<double> m_dose;    // [cellule]
+
+    size_t slotCount() const { return m_fluence.size() + m_dose.size(); }
+    bool accepts(const Particle& particle) const;
+};
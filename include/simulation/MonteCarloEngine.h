@@ -3,6 +3,15 @@
 #include "common.h"
 #include "simulation/Particle.h"
 #include "core/Scene.h"
+#include "simulation/WeightWindow.h"
+#include "simulation/AdjointImportance.h"
+#include "simulation/MeshTally.h"
+#include "simulation/TrackRecorder.h"
+#include "simulation/PhaseSpace.h"
+#include "simulation/NodeReplica.h"
+#include "utils/NumaTopology.h"
+#include "utils/Arena.h"
+#include "core/StoppingPower.h"
 
 // Configuration de simulation
 struct SimulationConfig {
@@ -19,6 +28,49 @@ struct SimulationConfig {
     float russianRouletteThreshold = 0.1f;
     bool useSplitting = false;
     uint32_t splittingFactor = 2;
+    bool useWeightWindows = false; // Nécessite un maillage (setWeightWindows / generateWeightWindows)
+
+    // Estimateur next-event pour les capteurs ponctuels (émission et collisions)
+    bool useNextEventEstimator = false;
+    float nextEventMaxDistance = 0.0f;       // m, capteurs plus lointains ignorés (0 = sans limite)
+    float nextEventRouletteThreshold = 0.0f; // m⁻², roulette sur les contributions plus faibles (0 = désactivée)
+
+    // Reproductibilité : avec une graine non nulle, les histoires sont traitées par flux de
+    // historiesPerStream histoires consécutives, chaque flux ayant son générateur propre.
+    // Les résultats ne dépendent alors ni du nombre de threads ni du nombre de processus.
+    uint64_t rngSeed = 0; // 0 : graines aléatoires
+    uint32_t historiesPerStream = 1000;
+
+    // Placement NUMA (sans effet sur une machine à un seul nœud) : épinglage des threads sur un
+    // cœur de leur nœud, répliques par nœud de la géométrie, des matériaux et des capteurs
+    bool pinThreads = false;
+    bool numaReplicas = false;
+
+    // Particules secondaires : gammas de capture, fluorescence K, photons d'annihilation.
+    // Suivies dans l'histoire de leur parent, une fois la trace de celui-ci terminée.
+    bool produceSecondaries = true;
+    uint32_t maxSecondariesPerHistory = 256; // Au-delà, abandonnées (comptées dans les statistiques)
+
+    // Particules chargées (BETA, ALPHA, MUON) : histoire condensée, pertes continues CSDA et
+    // diffusion multiple de Highland, pas limités aux frontières et à une fraction de la portée
+    float chargedStepFraction = 0.2f;
+    uint32_t maxChargedSteps = 1000;   // Pas condensés par trace (maxBounces : collisions discrètes)
+    bool chargedRangeRejection = true; // Arrêt des particules dont la portée n'atteint aucun capteur
+
+    // Élimination des histoires qui ne peuvent plus compter : photons sous le seuil de tous les
+    // capteurs et tallies (arrêt sans biais, leur descendance est moins énergétique), roulette
+    // sur la profondeur optique minorée jusqu'aux cibles au-delà de cullingOpticalDepth (poids
+    // des survivants compensé ; sans effet avec les fenêtres de poids, qui règlent déjà la population)
+    bool useCulling = false;
+    float cullingOpticalDepth = 10.0f;
+
+    // Capture implicite (survival biasing) des types listés : à une collision, le poids est
+    // multiplié par la probabilité de diffusion et la particule diffuse toujours (les secondaires
+    // d'une voie d'absorption tirée gardent le poids entrant). Roulette sous le poids de coupure,
+    // survivants au poids de survie (remplace russianRouletteThreshold pour ces types)
+    std::vector<RadiationType> implicitCaptureTypes;
+    float implicitCaptureWeightCutoff = 0.25f;
+    float implicitCaptureSurvivalWeight = 0.5f;
 };
 
 // Statistiques de simulation
@@ -30,6 +82,9 @@ struct SimulationStats {
     std::atomic<uint64_t> particlesEscaped{0};
     std::atomic<uint64_t> totalCollisions{0};
     std::atomic<uint64_t> rayIntersections{0};
+    std::atomic<uint64_t> secondariesProduced{0};
+    std::atomic<uint64_t> secondariesDropped{0}; // Plafond par histoire atteint
+    std::atomic<uint64_t> particlesCulled{0};    // Rejet sur portée et élimination hors d'atteinte
     
     std::chrono::steady_clock::time_point startTime;
     std::chrono::steady_clock::time_point endTime;
@@ -42,6 +97,9 @@ struct SimulationStats {
         particlesEscaped = 0;
         totalCollisions = 0;
         rayIntersections = 0;
+        secondariesProduced = 0;
+        secondariesDropped = 0;
+        particlesCulled = 0;
     }
     
     double getElapsedTime() const {
@@ -49,12 +107,61 @@ struct SimulationStats {
         return std::chrono::duration<double>(end - startTime).count();
     }
     
+    // Cumul de résultats calculés ailleurs (runs distribués) ; l'intervalle de temps est repris
+    void add(const SimulationStats& other) {
+        particlesEmitted.fetch_add(other.particlesEmitted.load());
+        particlesTransported.fetch_add(other.particlesTransported.load());
+        particlesAbsorbed.fetch_add(other.particlesAbsorbed.load());
+        particlesDetected.fetch_add(other.particlesDetected.load());
+        particlesEscaped.fetch_add(other.particlesEscaped.load());
+        totalCollisions.fetch_add(other.totalCollisions.load());
+        rayIntersections.fetch_add(other.rayIntersections.load());
+        secondariesProduced.fetch_add(other.secondariesProduced.load());
+        secondariesDropped.fetch_add(other.secondariesDropped.load());
+        particlesCulled.fetch_add(other.particlesCulled.load());
+        startTime = other.startTime;
+        endTime = other.endTime;
+    }
+    
     double getParticleRate() const {
         double elapsed = getElapsedTime();
         return elapsed > 0.0 ? particlesTransported.load() / elapsed : 0.0;
     }
 };
 
+// Contexte de transport propre à un thread
+struct TransportContext {
+    uint32_t threadId = 0;
+    MonotonicArena* arena = nullptr;       // Données temporaires du lot (remise à zéro entre lots)
+    ArenaStack<Particle> bank;             // Progéniture en attente (splitting), dans l'arène
+    ArenaStack<Particle> secondaries;      // Secondaires en attente de l'histoire courante
+    uint32_t historySecondaries = 0;       // Secondaires produits dans l'histoire courante
+    ImportanceTally* importance = nullptr; // Pré-calcul des fenêtres de poids
+    int lastCell = -1;                     // Dernière cellule du maillage d'importance
+    const Source* emitter = nullptr;       // Source de la particule tirée, pour le next-event
+    float emissionWeight = 1.0f;           // Poids d'émission hors biaisage angulaire
+    TrackChannel* tracks = nullptr;        // Canal d'enregistrement des traces du thread
+    bool recordTrack = false;              // Histoire courante dans l'échantillon enregistré
+    NodeReplica* replica = nullptr;        // Données du nœud NUMA du thread (nullptr : scène partagée)
+    int pinnedCpu = -1;                    // CPU d'épinglage (-1 : aucun)
+
+    void attachArena(MonotonicArena* threadArena) {
+        arena = threadArena;
+        bank = ArenaStack<Particle>(threadArena);
+        secondaries = ArenaStack<Particle>(threadArena);
+    }
+
+    // Limite de lot : plus rien de vivant dans l'arène
+    void resetArena() {
+        bank.release();
+        secondaries.release();
+        if (arena)
+            arena->reset();
+        bank.reservePeak();
+        secondaries.reservePeak();
+    }
+};
+
 // État de simulation
 enum class SimulationState {
     IDLE,
@@ -78,6 +185,10 @@ public:
     void pauseSimulation();
     void resumeSimulation();
     void stopSimulation();
+    void waitForCompletion(); // Bloquant : attend que maxParticles histoires soient transportées
+    // Bloquant : histoires [firstHistory, firstHistory + count) en flux reproductibles
+    // (rngSeed non nul, firstHistory multiple de historiesPerStream)
+    void runHistoryRange(uint64_t firstHistory, uint64_t count);
     bool isRunning() const { return m_state == SimulationState::RUNNING; }
     SimulationState getState() const { return m_state; }
     
@@ -88,6 +199,8 @@ public:
     // Statistiques
     const SimulationStats& getStats() const { return m_stats; }
     void resetStats() { m_stats.clear(); }
+    void addStats(const SimulationStats& stats) { m_stats.add(stats); }
+    std::shared_ptr<Scene> getScene() const { return m_scene; }
     
     // Transport de particule unique (pour debugging)
     void transportParticle(Particle& particle);
@@ -97,12 +210,58 @@ public:
     void enableSplitting(bool enable, uint32_t factor = 2);
     void enableImportanceSampling(bool enable);
 
+    // Tallies maillés (cartes de dose), fusionnés à la fin de runBatch / stopSimulation
+    void addMeshTally(std::shared_ptr<MeshTally> tally);
+    const std::vector<std::shared_ptr<MeshTally>>& getMeshTallies() const { return m_meshTallies; }
+    void clearMeshTallies() { m_meshTallies.clear(); }
+
+    // Enregistrement des traces (débogage, visualisation) ; nullptr pour désactiver
+    void setTrackRecorder(std::shared_ptr<TrackRecorder> recorder) { m_trackRecorder = recorder; }
+    std::shared_ptr<TrackRecorder> getTrackRecorder() const { return m_trackRecorder; }
+
+    // Enregistrement des particules traversant une surface (espace des phases) ; nullptr pour désactiver
+    void setPhaseSpaceWriter(std::shared_ptr<PhaseSpaceWriter> writer) { m_phaseSpaceWriter = writer; }
+    std::shared_ptr<PhaseSpaceWriter> getPhaseSpaceWriter() const { return m_phaseSpaceWriter; }
+
+    // Fenêtres de poids
+    void setWeightWindows(std::shared_ptr<WeightWindowMesh> mesh) { m_weightWindows = mesh; }
+    std::shared_ptr<WeightWindowMesh> getWeightWindows() const { return m_weightWindows; }
+    // Pré-calcul direct itératif (type WWG) ; active les fenêtres pour la suite
+    std::shared_ptr<WeightWindowMesh> generateWeightWindows(const WeightWindowGenerationConfig& config);
+
+    // CADIS : importance adjointe déterministe, source biaisée et fenêtres cohérentes
+    std::shared_ptr<const AdjointImportanceMap> setupCadis(const CadisConfig& config);
+    void clearCadis() { m_sourceBiasing.reset(); }
+    bool isCadisEnabled() const { return m_sourceBiasing != nullptr; }
+
 private:
     std::shared_ptr<Scene> m_scene;
     std::shared_ptr<Material> m_worldMaterial;
     SimulationConfig m_config;
     SimulationStats m_stats;
     SimulationState m_state = SimulationState::IDLE;
+    std::shared_ptr<WeightWindowMesh> m_weightWindows;
+    std::shared_ptr<const CadisSourceBiasing> m_sourceBiasing;
+    std::vector<std::shared_ptr<MeshTally>> m_meshTallies;
+    std::shared_ptr<TrackRecorder> m_trackRecorder;
+    std::shared_ptr<PhaseSpaceWriter> m_phaseSpaceWriter;
+    std::vector<const Sensor*> m_importanceTargets;
+    std::vector<TransportContext> m_threadContexts;
+    std::vector<std::unique_ptr<MonotonicArena>> m_threadArenas; // Conservées d'un run à l'autre
+    MonotonicArena m_batchArena;                                 // runBatch (thread appelant)
+    std::vector<std::unique_ptr<NodeReplica>> m_replicas; // Par nœud NUMA, run en cours
+    // Portée majorante par type chargé (absent : rejet impossible, un matériau sans table)
+    std::map<RadiationType, std::shared_ptr<const StoppingPowerTable>> m_rangeBounds;
+    // Élimination : seuil photons (keV, infini sans cible), matériaux et objets de la scène
+    float m_photonCullingEnergy = 0.0f;
+    bool m_opticalCulling = false;
+    std::vector<const Material*> m_cullingMaterials;
+    std::vector<const Object3D*> m_cullingObjects;
+    uint32_t m_implicitCaptureMask = 0; // Bit par RadiationType
+
+    // Plage d'histoires du run en cours (mode reproductible : flux distribués aux threads)
+    uint64_t m_rangeEnd = 0;
+    std::atomic<uint64_t> m_nextHistory{0};
     
     // Threading
     std::vector<std::thread> m_workers;
@@ -115,25 +274,96 @@ private:
     thread_local static std::mt19937 s_rng;
     
     // Worker functions
+    void startRange(uint64_t firstHistory, uint64_t endHistory);
     void workerThread(uint32_t threadId);
     void emitAndTransportBatch(uint32_t batchSize, uint32_t threadId);
+    void emitAndTransportStream(uint64_t firstHistory, uint64_t count, uint32_t threadId);
     
-    // Transport de particule
-    void transportParticleInternal(Particle& particle);
-    bool stepParticle(Particle& particle);
+    // Émission
+    bool sampleSourceParticle(const std::vector<std::shared_ptr<Source>>& sources, Particle& particle,
+                              TransportContext& ctx);
+
+    // Transport de particule (histoire complète, progéniture incluse)
+    void transportParticleInternal(Particle& particle, TransportContext& ctx);
+    void transportTrack(Particle& particle, TransportContext& ctx);
+    bool stepParticle(Particle& particle, TransportContext& ctx);
+    bool stepCondensedHistory(Particle& particle, const StoppingPowerTable& table, TransportContext& ctx);
+    void crossBoundary(Particle& particle, const IntersectionResult& hit,
+                       const std::shared_ptr<Material>& currentMaterial, const TransportContext& ctx);
+    // Capteurs et tallies maillés ; remaining : distance du bout du segment à la particule
+    void scoreSegment(const Particle& particle, const glm::vec3& startPos, const glm::vec3& endPos,
+                      TransportContext& ctx, float remaining = 0.0f);
+
+    // Biaisage par région (objet contenant) : collisions forcées, transformation exponentielle
+    const RegionBiasing* regionBiasing(const Particle& particle) const; // nullptr : transport analogique
+    void forceCollision(Particle& particle, const std::shared_ptr<Material>& material, float mu, float distance,
+                        TransportContext& ctx);
+    void scoreStretchedSegment(const Particle& particle, const glm::vec3& startPos, const glm::vec3& endPos,
+                               float stretch, TransportContext& ctx); // stretch : μ - μ*
     
     // Interactions physiques
-    InteractionType sampleInteraction(const Particle& particle, std::shared_ptr<Material> material);
-    void processInteraction(Particle& particle, InteractionType interaction, std::shared_ptr<Material> material);
+    InteractionChannel sampleInteraction(const Particle& particle, std::shared_ptr<Material> material);
+    // Issue appliquée : diffusion pour une absorption sous capture implicite
+    InteractionType processInteraction(Particle& particle, InteractionChannel channel,
+                                       std::shared_ptr<Material> material, TransportContext& ctx);
+    void produceSecondaries(const Particle& particle, InteractionChannel channel, const Material& material,
+                            TransportContext& ctx);
+    void bankSecondary(const Particle& parent, RadiationType type, float energy, const glm::vec3& direction,
+                       TransportContext& ctx);
     
     // Scattering
     glm::vec3 sampleComptonScattering(const Particle& particle, std::shared_ptr<Material> material);
     glm::vec3 sampleNeutronScattering(const Particle& particle, std::shared_ptr<Material> material);
-    glm::vec3 sampleCoulombScattering(const Particle& particle, std::shared_ptr<Material> material);
+    glm::vec3 sampleCoulombScattering(const Particle& particle, const StoppingPowerTable& table, float step);
+    float sampleScatteredEnergy(const Particle& particle, float cosTheta);
+
+    // Estimateur next-event (capteurs ponctuels)
+    void scoreNextEventAtEmission(const Particle& particle, const TransportContext& ctx);
+    void scoreNextEventAtCollision(const Particle& particle, const std::shared_ptr<Material>& material,
+                                   const TransportContext& ctx);
+    // angularLaw(direction, énergie) : densité sr⁻¹, ajuste l'énergie de sortie
+    template <typename AngularLaw>
+    void scoreNextEvent(const Particle& particle, double weight, AngularLaw&& angularLaw,
+                        const TransportContext& ctx);
     
     // Réduction de variance
-    bool russianRoulette(Particle& particle);
-    std::vector<Particle> splitting(const Particle& particle);
+    bool russianRoulette(Particle& particle, float survivalWeight); // Survivants au poids survivalWeight
+    void prepareImplicitCapture();
+    bool implicitCapture(RadiationType type) const { return m_implicitCaptureMask & (1u << static_cast<int>(type)); }
+    // Copies de poids égal : la particule garde une part, les autres rejoignent la banque
+    void splitting(Particle& particle, uint32_t copies, TransportContext& ctx);
+    bool applyWeightWindow(Particle& particle, TransportContext& ctx);
+    void recordImportance(const Particle& particle, TransportContext& ctx);
+    bool isImportanceTarget(const Sensor* sensor) const;
+
+    // Tallies (spectres des capteurs, tallies maillés)
+    void prepareTallies(uint32_t threadCount);
+    void endTallyBatch(uint32_t threadSlot, uint64_t histories);
+    void mergeMeshTallies();
+
+    // Rejet sur portée des particules chargées : enveloppes des matériaux de la scène, cibles
+    void prepareChargedTransport();
+    float distanceToTargets(const glm::vec3& position, const TransportContext& ctx) const; // Capteurs et tallies maillés
+
+    // Élimination des particules hors d'atteinte des cibles (photons, neutrons)
+    void prepareCulling();
+    bool cullParticle(Particle& particle, TransportContext& ctx); // true : particule arrêtée
+    float minimumOpticalDepth(const Particle& particle, float targetDistance, const TransportContext& ctx) const;
+
+    // Placement NUMA : épinglage et répliques par nœud, compteurs des répliques
+    void prepareNumaPlacement();
+    void mergeReplicaStats();                     // Toutes les répliques
+    void mergeReplicaStats(NodeReplica& replica); // En fin de lot, pendant le transport
+
+    // Traces
+    void attachTrackChannel(TransportContext& ctx); // Après m_trackRecorder->prepare()
+    // Étape de start à la position courante ; énergie et poids en début d'étape
+    void recordTrackEvent(TransportContext& ctx, TrackEventType type, const Particle& particle,
+                          const Material* material, const glm::vec3& start, float energy, float weight) {
+        if (ctx.recordTrack) {
+            ctx.tracks->record(type, particle.getType(), material, start, particle.getPosition(), energy, weight);
+        }
+    }
     
     // Optimisations
     float calculateImportance(const glm::vec3& position);
@@ -160,4 +390,11 @@ public:
     // Validation analytique
     static float analyticalAttenuation(float thickness, float mu);
     static float analyticalBuildup(float thickness, float mu, float energy);
+
+    // Importance adjointe par noyau ponctuel (sans build-up) :
+    // φ†(r, E) = Σ capteurs exp(-τ(r → capteur, E)) / (4π d²)
+    static std::shared_ptr<AdjointImportanceMap> computeAdjointImportance(
+        std::shared_ptr<Scene> scene, const RegularGrid& grid, const std::vector<float>& groupBounds,
+        RadiationType type, const std::vector<std::shared_ptr<Sensor>>& targets,
+        std::shared_ptr<Material> worldMaterial);
 };
\ No newline at end of file
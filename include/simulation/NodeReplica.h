@@ -0,0 +1,54 @@
+#pragma once
+
+#include "common.h"
+#include "core/Scene.h"
+#include "utils/BVH.h"
+
+// Données de transport en lecture seule dupliquées pour un nœud NUMA : objets et matériaux
+// copiés, BVH reconstruit sur les copies, index des capteurs et compteurs de détection propres.
+// À construire depuis un thread épinglé sur le nœud pour que la première écriture y place la
+// mémoire. Les requêtes ne prennent pas le verrou de la scène (la réplique ne change pas
+// pendant le run).
+class NodeReplica {
+public:
+    NodeReplica(uint32_t node, const Scene& scene, const std::shared_ptr<Material>& worldMaterial);
+
+    uint32_t getNode() const { return m_node; }
+
+    // Intersection sur le BVH local ; le matériau touché est la copie locale
+    IntersectionResult intersectRay(const Ray& ray) const;
+
+    const std::shared_ptr<Material>& getWorldMaterial() const { return m_worldMaterial; }
+    // Copie locale d'un matériau de la scène (le matériau lui-même s'il n'est pas répliqué)
+    const std::shared_ptr<Material>& localMaterial(const std::shared_ptr<Material>& material) const;
+
+    // Profondeur optique du segment [from, to] sur les copies locales
+    // (cf. Scene::computeOpticalDepth)
+    float computeOpticalDepth(const glm::vec3& from, const glm::vec3& to, RadiationType type,
+                              float energy) const;
+
+    // Objets et matériaux locaux (triés, sans doublon) pour l'élagage optique
+    const std::vector<const Object3D*>& getCullingObjects() const { return m_cullingObjects; }
+    const std::vector<const Material*>& getCullingMaterials() const { return m_cullingMaterials; }
+
+    const std::vector<std::shared_ptr<Sensor>>& getSensors() const { return m_sensors; }
+    // Compteurs du nœud pour le capteur d'indice index (même ordre que getSensors), transférés
+    // aux capteurs de la scène par mergeSensorStats en fin de lot
+    DetectionStats* sensorStats(size_t index) { return &m_sensorStats[index]; }
+    void mergeSensorStats();
+
+    // Compteurs par pas du nœud, transférés dans SimulationStats en fin de lot
+    alignas(64) std::atomic<uint64_t> rayIntersections{0};
+    std::atomic<uint64_t> totalCollisions{0};
+
+private:
+    uint32_t m_node;
+    std::vector<std::shared_ptr<Object3D>> m_objects;
+    std::vector<std::pair<const Material*, std::shared_ptr<Material>>> m_materials; // Original -> copie
+    std::shared_ptr<Material> m_worldMaterial;
+    BVH m_bvh;
+    std::vector<const Object3D*> m_cullingObjects;
+    std::vector<const Material*> m_cullingMaterials;
+    std::vector<std::shared_ptr<Sensor>> m_sensors;
+    std::vector<DetectionStats> m_sensorStats;
+};
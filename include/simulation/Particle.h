@@ -48,10 +48,18 @@ public:
     
     uint32_t getCollisionCount() const { return m_collisionCount; }
     void incrementCollisionCount() { ++m_collisionCount; }
+
+    // Profondeur optique déjà soumise à la roulette d'élimination (transmise à la progéniture)
+    float getCullingDepth() const { return m_cullingDepth; }
+    void setCullingDepth(float depth) { m_cullingDepth = depth; }
     
     // Matériau actuel
     std::shared_ptr<Material> getCurrentMaterial() const { return m_currentMaterial; }
     void setCurrentMaterial(std::shared_ptr<Material> material) { m_currentMaterial = material; }
+
+    // Objet contenant (nullptr : monde), mis à jour avec le matériau aux frontières
+    const Object3D* getRegion() const { return m_region; }
+    void setRegion(const Object3D* region) { m_region = region; }
     
     // Transport
     void move(float distance);
@@ -92,9 +100,11 @@ private:
     float m_age = 0.0f; // ns
     float m_travelDistance = 0.0f; // cm
     uint32_t m_collisionCount = 0;
+    float m_cullingDepth = 0.0f;
     
     // Contexte matériau
     std::shared_ptr<Material> m_currentMaterial;
+    const Object3D* m_region = nullptr;
 };
 
 // Factory pour création de particules
@@ -115,23 +125,3 @@ public:
     static Particle createBackgroundGamma(const glm::vec3& position);
     static Particle createRadonDecay(const glm::vec3& position);
 };
-
-// Pool de particules pour éviter les allocations
-class ParticlePool {
-public:
-    static ParticlePool& getInstance();
-    
-    Particle* acquire();
-    void release(Particle* particle);
-    void clear();
-    
-    size_t getPoolSize() const { return m_pool.size(); }
-    size_t getActiveCount() const { return m_activeCount; }
-
-private:
-    ParticlePool() = default;
-    std::vector<std::unique_ptr<Particle>> m_pool;
-    std::stack<Particle*> m_available;
-    std::atomic<size_t> m_activeCount{0};
-    std::mutex m_mutex;
-};
\ No newline at end of file
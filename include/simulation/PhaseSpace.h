@@ -0,0 +1,45 @@
+#pragma once
+
+#include "common.h"
+#include "core/PhaseSpaceSource.h"
+#include <cstdio>
+
+// Écriture depuis les threads de transport : tampon par thread, blocs ajoutés sous verrou.
+// L'en-tête (nombre d'enregistrements et d'histoires) est mis à jour à chaque flush,
+// le fichier est donc exploitable dès la fin d'un run.
+class PhaseSpaceWriter {
+public:
+    // terminate : les particules enregistrées ne sont plus transportées (découplage de la
+    // géométrie intérieure ; le retour de particules depuis l'extérieur est alors négligé)
+    PhaseSpaceWriter(const std::string& filename, const PhaseSpaceSurface& surface, bool terminate = false);
+    ~PhaseSpaceWriter();
+
+    PhaseSpaceWriter(const PhaseSpaceWriter&) = delete;
+    PhaseSpaceWriter& operator=(const PhaseSpaceWriter&) = delete;
+
+    const PhaseSpaceSurface& getSurface() const { return m_surface; }
+    bool terminatesParticles() const { return m_terminate; }
+    const std::string& getFilename() const { return m_filename; }
+
+    void prepare(uint32_t threadCount); // Hors transport
+    void record(uint32_t threadId, const Particle& particle, const glm::vec3& position);
+
+    // Vidage des tampons ; histories : histoires sources cumulées depuis la création
+    void flush(uint64_t histories);
+    uint64_t getRecordCount() const { return m_recordCount; }
+
+private:
+    static constexpr size_t BUFFER_RECORDS = 4096;
+
+    std::string m_filename;
+    PhaseSpaceSurface m_surface;
+    bool m_terminate;
+    std::FILE* m_file = nullptr;
+    std::vector<std::vector<PhaseSpaceFormat::Record>> m_buffers;
+    uint64_t m_recordCount = 0;
+    uint64_t m_histories = 0;
+    std::mutex m_mutex;
+
+    void writeRecords(std::vector<PhaseSpaceFormat::Record>& buffer); // m_mutex tenu
+    void writeHeader();                                               // m_mutex tenu
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "common.h"
+#include "utils/ColumnStore.h"
+#include "simulation/MonteCarloEngine.h"
+
+// Résultats de simulation au format colonnes (.rcol), un bloc par table et par lot.
+// Les valeurs sont cumulées depuis le début du run : le dernier bloc d'une table fait foi.
+//   "stats"              : une ligne (compteurs de SimulationStats, durée)
+//   "sensors"            : une ligne par capteur (compteurs, fluences, doses)
+//   "spectrum/<capteur>" : une ligne par groupe énergie × temps (bornes, moyenne, erreur relative)
+//   "mesh/<tally>"       : une ligne par voxel (centre, fluence par groupe, dose), par histoire
+class ResultsWriter {
+public:
+    explicit ResultsWriter(const std::string& filename, bool append = false, bool compress = false);
+
+    void writeStats(uint64_t batch, const SimulationStats& stats);
+    void writeSensors(uint64_t batch, const std::vector<std::shared_ptr<Sensor>>& sensors);
+    void writeSpectrum(uint64_t batch, const Sensor& sensor);
+    void writeMeshTally(uint64_t batch, const MeshTally& tally, uint64_t histories);
+
+    // Toutes les tables d'un lot : statistiques, capteurs, spectres actifs, tallies maillés
+    void writeBatch(uint64_t batch, const Scene& scene, const MonteCarloEngine& engine);
+
+    // Table libre (paramètres de variante, etc.)
+    void writeTable(const ColumnTable& table) { m_writer.write(table); }
+
+private:
+    ColumnWriter m_writer;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "common.h"
+#include "core/Sensor.h"
+
+class Scene;
+class MonteCarloEngine;
+
+// Résultats cumulés d'un run : compteurs du moteur, capteurs (statistiques et spectres),
+// tallies maillés. Les résultats de runs indépendants (plages d'histoires disjointes) se
+// fusionnent par simple somme ; sérialisation binaire pour l'échange entre processus.
+struct TallySnapshot {
+    struct Counters {
+        uint64_t emitted = 0;
+        uint64_t transported = 0;
+        uint64_t absorbed = 0;
+        uint64_t detected = 0;
+        uint64_t escaped = 0;
+        uint64_t collisions = 0;
+        uint64_t rays = 0;
+        uint64_t secondaries = 0;
+        uint64_t secondariesDropped = 0;
+        uint64_t culled = 0;
+    };
+
+    struct SensorResult {
+        std::string name;
+        DetectionStats stats;
+        BinnedTally::State spectrum;
+    };
+
+    struct MeshResult {
+        std::string name;
+        std::vector<double> fluence;
+        std::vector<double> dose;
+    };
+
+    Counters counters;
+    std::vector<SensorResult> sensors; // Ordre de Scene::getAllSensors()
+    std::vector<MeshResult> meshes;    // Ordre de MonteCarloEngine::getMeshTallies()
+
+    // Capture des résultats courants (moteur arrêté)
+    static TallySnapshot capture(const Scene& scene, const MonteCarloEngine& engine);
+
+    // Somme terme à terme ; les capteurs et tallies doivent correspondre (noms vérifiés)
+    void merge(const TallySnapshot& other);
+
+    // Ajout aux résultats du moteur et de la scène (affichage, export) ; elapsedSeconds :
+    // durée du run, reprise dans les statistiques du moteur
+    void applyTo(Scene& scene, MonteCarloEngine& engine, double elapsedSeconds) const;
+
+    std::vector<uint8_t> serialize() const;
+    static TallySnapshot deserialize(const uint8_t* data, size_t size);
+};
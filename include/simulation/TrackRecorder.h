@@ -0,0 +1,174 @@
+#pragma once
+
+#include "common.h"
+#include <cstdio>
+
+class Material;
+
+// Événement de fin d'étape (ou de fin de trace sans déplacement : coupures, roulette)
+enum class TrackEventType : uint8_t {
+    BOUNDARY,      // Traversée de frontière
+    ABSORPTION,    // Collisions (InteractionType)
+    SCATTERING,
+    TRANSMISSION,
+    CAPTURE,
+    ESCAPE,        // Sortie de la géométrie
+    ENERGY_CUTOFF,
+    TIME_CUTOFF,
+    ROULETTE,      // Tuée par roulette russe ou fenêtre de poids
+    BOUNCE_LIMIT,
+    RANGE_CUTOFF   // Portée résiduelle insuffisante pour atteindre un capteur
+};
+
+const char* trackEventTypeName(TrackEventType type);
+TrackEventType trackEventType(InteractionType interaction);
+
+// Étape relue depuis un fichier de traces (.rtrk)
+// Résolution d'enregistrement : 1 µm pour les positions, 1 eV pour l'énergie
+struct TrackStep {
+    uint64_t history = 0;  // (thread << 40) | rang de l'histoire dans le thread
+    TrackEventType type = TrackEventType::BOUNDARY;
+    RadiationType particle = RadiationType::GAMMA;
+    uint32_t material = 0; // Indice dans TrackData::materials (0 : aucun)
+    glm::vec3 start{0.0f};
+    glm::vec3 end{0.0f};
+    float energy = 0.0f;   // keV, en début d'étape
+    float weight = 1.0f;   // En début d'étape
+};
+
+struct TrackData {
+    std::vector<std::string> materials{""};
+    std::vector<TrackStep> steps; // Ordonnées par histoire au sein de chaque thread
+    uint64_t droppedEvents = 0;   // Perdus sur tampon plein
+
+    std::vector<uint64_t> histories() const;
+    std::vector<TrackStep> history(uint64_t id) const;
+};
+
+struct TrackRecorderConfig {
+    uint32_t sampleEvery = 100;      // Une histoire enregistrée sur N par thread (1 : toutes)
+    uint32_t ringCapacity = 1 << 16; // Événements par thread, arrondi à une puissance de 2
+    uint32_t drainIntervalMs = 20;
+    bool compress = true;            // zlib si disponible à la compilation
+};
+
+// Tampon circulaire d'un thread de transport : un seul producteur (le thread),
+// un seul consommateur (le thread de vidage), sans verrou. Tampon plein : l'événement
+// est compté comme perdu, le transport n'attend jamais.
+class TrackChannel {
+public:
+    // Début d'histoire : true si elle fait partie de l'échantillon
+    bool beginHistory() {
+        m_recording = m_sampleEvery > 0 && m_historyCounter % m_sampleEvery == 0;
+        m_currentHistory = (static_cast<uint64_t>(m_threadId) << 40) | m_historyCounter;
+        ++m_historyCounter;
+        return m_recording;
+    }
+
+    bool isRecording() const { return m_recording; }
+
+    void record(TrackEventType type, RadiationType particle, const Material* material, const glm::vec3& start,
+                const glm::vec3& end, float energy, float weight) {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail >= m_ring.size()) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail >= m_ring.size()) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        Entry& entry = m_ring[head & m_mask];
+        entry.history = m_currentHistory;
+        entry.start = start;
+        entry.end = end;
+        entry.material = material;
+        entry.energy = energy;
+        entry.weight = weight;
+        entry.particle = particle;
+        entry.type = type;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    uint64_t getDroppedEvents() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    friend class TrackRecorder;
+
+    struct Entry {
+        uint64_t history;
+        glm::vec3 start;
+        glm::vec3 end;
+        const Material* material;
+        float energy;
+        float weight;
+        RadiationType particle;
+        TrackEventType type;
+    };
+
+    TrackChannel(uint32_t threadId, uint32_t capacity, uint32_t sampleEvery);
+
+    std::vector<Entry> m_ring;
+    uint64_t m_mask;
+    uint32_t m_threadId;
+    uint32_t m_sampleEvery;
+
+    // Côté producteur
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    uint64_t m_cachedTail = 0;
+    uint64_t m_historyCounter = 0;
+    uint64_t m_currentHistory = 0;
+    bool m_recording = false;
+    std::atomic<uint64_t> m_dropped{0};
+
+    // Côté consommateur
+    alignas(64) std::atomic<uint64_t> m_tail{0};
+    uint64_t m_reportedDropped = 0;
+};
+
+// Enregistreur de traces (opt-in) : un canal par thread de transport, vidé en tâche de fond
+// vers un fichier .rtrk par blocs compressés. Dans un bloc, les étapes sont regroupées par
+// thread et codées en delta (histoire, positions, énergie) en entiers variables.
+//
+//   en-tête fichier | [en-tête bloc | données]*
+//   données : [section MATÉRIAU | section ÉTAPES | section PERTES]*
+class TrackRecorder {
+public:
+    TrackRecorder(const std::string& filename, const TrackRecorderConfig& config = {});
+    ~TrackRecorder(); // Vidage final et fermeture
+
+    TrackRecorder(const TrackRecorder&) = delete;
+    TrackRecorder& operator=(const TrackRecorder&) = delete;
+
+    // Canaux des threads 0..threadCount-1 (créés au besoin, conservés entre les runs).
+    // À appeler hors transport.
+    void prepare(uint32_t threadCount);
+    TrackChannel* getChannel(uint32_t threadId);
+
+    // Vidage synchrone de tous les canaux (fin de run)
+    void flush();
+
+    const std::string& getFilename() const { return m_filename; }
+    const TrackRecorderConfig& getConfig() const { return m_config; }
+    uint64_t getRecordedEvents() const { return m_recordedEvents.load(); }
+    uint64_t getDroppedEvents() const;
+
+    static TrackData readFile(const std::string& filename);
+
+private:
+    std::string m_filename;
+    TrackRecorderConfig m_config;
+    std::FILE* m_file = nullptr;
+    std::vector<std::unique_ptr<TrackChannel>> m_channels;
+    // Par nom : une adresse peut être réutilisée par un autre matériau entre deux runs
+    std::unordered_map<std::string, uint32_t> m_materialIds;
+    std::atomic<uint64_t> m_recordedEvents{0};
+
+    std::thread m_drainThread;
+    std::mutex m_drainMutex; // Canaux, fichier et dictionnaire des matériaux
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    bool m_shouldStop = false;
+
+    void drainLoop();
+    void drainAll(); // m_drainMutex tenu
+};
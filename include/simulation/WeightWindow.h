@@ -0,0 +1,97 @@
+#pragma once
+
+#include "common.h"
+#include "utils/RegularGrid.h"
+
+// Maillage d'importance : borne inférieure de fenêtre de poids par cellule
+// (grille régulière alignée sur les axes, une borne nulle désactive la fenêtre)
+class WeightWindowMesh {
+public:
+    WeightWindowMesh(const AABB& bounds, uint32_t nx, uint32_t ny, uint32_t nz);
+
+    // Géométrie du maillage
+    const RegularGrid& getGrid() const { return m_grid; }
+    const AABB& getBounds() const { return m_grid.getBounds(); }
+    uint32_t getCellCount() const { return m_grid.getCellCount(); }
+    int cellIndex(const glm::vec3& position) const { return m_grid.cellIndex(position); } // -1 hors maillage
+    glm::vec3 cellCenter(uint32_t cell) const { return m_grid.cellCenter(cell); }
+
+    // Groupes d'énergie (bornes supérieures croissantes en keV, un seul groupe par défaut)
+    void setEnergyGroups(const std::vector<float>& upperBounds);
+    const std::vector<float>& getEnergyGroups() const { return m_groupUpperBounds; }
+    uint32_t getGroupCount() const { return static_cast<uint32_t>(m_groupUpperBounds.size()) + 1; }
+    uint32_t groupIndex(float energy) const;
+
+    // Bornes inférieures
+    float getLowerBound(uint32_t cell, uint32_t group = 0) const { return m_lowerBounds[group * getCellCount() + cell]; }
+    float getLowerBound(const glm::vec3& position, float energy) const;
+    void setLowerBound(uint32_t cell, uint32_t group, float value) {
+        m_lowerBounds[group * getCellCount() + cell] = std::max(0.0f, value);
+    }
+    const std::vector<float>& getLowerBounds() const { return m_lowerBounds; }
+
+    // Paramètres de la fenêtre (borne haute = ratio * borne basse)
+    float getUpperRatio() const { return m_upperRatio; }
+    void setUpperRatio(float ratio) { m_upperRatio = std::max(1.0f, ratio); }
+
+    float getSurvivalRatio() const { return m_survivalRatio; }
+    void setSurvivalRatio(float ratio) { m_survivalRatio = std::max(1.0f, ratio); }
+
+    uint32_t getMaxSplit() const { return m_maxSplit; }
+    void setMaxSplit(uint32_t maxSplit) { m_maxSplit = std::max(1u, maxSplit); }
+
+private:
+    RegularGrid m_grid;
+    std::vector<float> m_groupUpperBounds; // Vide : un groupe unique
+    std::vector<float> m_lowerBounds;      // [groupe][cellule]
+
+    float m_upperRatio = 5.0f;    // Borne haute / borne basse
+    float m_survivalRatio = 3.0f; // Poids de survie à la roulette / borne basse
+    uint32_t m_maxSplit = 10;     // Nombre maximal de copies par splitting
+};
+
+// Accumulateur d'importance par thread (estimateur de type WWG) :
+// importance(c) = score produit après entrée dans c / poids entré dans c
+struct ImportanceTally {
+    struct Entry {
+        uint32_t cell;
+        float weight;
+        double scoreAtEntry;
+    };
+
+    std::vector<double> score;
+    std::vector<double> weight;
+    std::vector<Entry> history; // Entrées de cellules de l'histoire courante
+    double historyScore = 0.0;
+    uint64_t histories = 0;
+    double totalScore = 0.0;
+
+    void resize(size_t cellCount);
+    void beginHistory();
+    void recordEntry(uint32_t cell, float entryWeight);
+    void recordScore(double value) { historyScore += value; }
+    void endHistory();
+    void merge(const ImportanceTally& other);
+};
+
+// Paramètres de génération automatique des fenêtres de poids
+struct WeightWindowGenerationConfig {
+    uint32_t nx = 20;
+    uint32_t ny = 20;
+    uint32_t nz = 20;
+    float boundsPadding = 0.5f;             // m autour de la scène, des sources et capteurs
+    uint64_t historiesPerIteration = 20000;
+    uint32_t maxIterations = 4;
+    float convergenceTolerance = 0.1f;      // Variation relative médiane des bornes
+    std::vector<std::string> targetSensors; // Capteurs visés (vide = tous)
+};
+
+namespace WeightWindowBuilder {
+    // Bornes inférieures inversement proportionnelles à l'importance estimée,
+    // normalisées pour qu'un poids source de 1 soit au centre de la fenêtre
+    std::shared_ptr<WeightWindowMesh> fromImportance(const AABB& bounds, uint32_t nx, uint32_t ny, uint32_t nz,
+                                                     const ImportanceTally& tally);
+
+    // Variation relative médiane entre deux cartes (cellules actives des deux côtés)
+    float relativeChange(const WeightWindowMesh& previous, const WeightWindowMesh& current);
+}
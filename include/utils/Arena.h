@@ -0,0 +1,145 @@
+#pragma once
+
+#include "common.h"
+#include <cstddef>
+#include <new>
+
+// Allocateur monotone d'un thread : allocation par simple avancée dans des blocs, aucune
+// libération individuelle. reset() rembobine sans rendre les blocs au système : une fois la
+// taille de travail atteinte (premiers lots), plus aucune allocation sur le tas.
+class MonotonicArena {
+public:
+    explicit MonotonicArena(size_t blockSize = 64 * 1024) : m_blockSize(blockSize) {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment) {
+        while (true) {
+            if (m_current < m_blocks.size()) {
+                Block& block = m_blocks[m_current];
+                size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+                if (offset + size <= block.size) {
+                    m_offset = offset + size;
+                    m_used += size;
+                    m_highWater = std::max(m_highWater, m_used);
+                    return block.data.get() + offset;
+                }
+                ++m_current;
+                m_offset = 0;
+                continue;
+            }
+            // Nouveau bloc (au moins la demande, alignement compris)
+            size_t blockSize = std::max(m_blockSize, size + alignment);
+            m_blocks.push_back({std::make_unique<std::byte[]>(blockSize), blockSize});
+            m_capacity += blockSize;
+        }
+    }
+
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Les objets construits dans l'arène doivent avoir été détruits
+    void reset() {
+        m_current = 0;
+        m_offset = 0;
+        m_used = 0;
+    }
+
+    size_t getCapacity() const { return m_capacity; }
+    size_t getUsed() const { return m_used; }
+    size_t getHighWater() const { return m_highWater; } // Depuis la création
+    size_t getBlockCount() const { return m_blocks.size(); }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    size_t m_blockSize;
+    std::vector<Block> m_blocks;
+    size_t m_current = 0; // Bloc en cours
+    size_t m_offset = 0;  // Position dans le bloc en cours
+    size_t m_used = 0;
+    size_t m_capacity = 0;
+    size_t m_highWater = 0;
+};
+
+// Pile LIFO dans une arène (banque de particules secondaires, piles de parcours).
+// La croissance recopie dans un nouveau tableau de l'arène ; l'ancien n'est récupéré qu'au
+// reset de l'arène, encadré par release() et reservePeak().
+template <typename T>
+class ArenaStack {
+public:
+    ArenaStack() = default;
+    explicit ArenaStack(MonotonicArena* arena) : m_arena(arena) {}
+    ~ArenaStack() { destroyAll(); }
+
+    ArenaStack(const ArenaStack&) = delete;
+    ArenaStack& operator=(const ArenaStack&) = delete;
+    ArenaStack(ArenaStack&& other) noexcept { *this = std::move(other); }
+    ArenaStack& operator=(ArenaStack&& other) noexcept {
+        if (this != &other) {
+            destroyAll();
+            m_arena = other.m_arena;
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_capacity = other.m_capacity;
+            m_peakCapacity = other.m_peakCapacity;
+            other.m_data = nullptr;
+            other.m_size = other.m_capacity = 0;
+        }
+        return *this;
+    }
+
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+    T& back() { return m_data[m_size - 1]; }
+
+    void push_back(const T& value) {
+        if (m_size == m_capacity) grow(std::max<size_t>(16, m_capacity * 2));
+        new (m_data + m_size) T(value);
+        ++m_size;
+    }
+
+    void pop_back() { m_data[--m_size].~T(); }
+
+    void clear() {
+        while (m_size > 0) pop_back();
+    }
+
+    // Abandon du stockage, avant MonotonicArena::reset()
+    void release() { destroyAll(); }
+    // Après le reset : capacité maximale déjà atteinte, pour ne pas recroître à chaque lot
+    void reservePeak() {
+        if (m_capacity < m_peakCapacity) grow(m_peakCapacity);
+    }
+
+private:
+    MonotonicArena* m_arena = nullptr;
+    T* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+    size_t m_peakCapacity = 0;
+
+    void grow(size_t capacity) {
+        if (!m_arena) throw std::runtime_error("Pile sans arène");
+        T* data = m_arena->allocateArray<T>(capacity);
+        for (size_t i = 0; i < m_size; ++i) {
+            new (data + i) T(std::move(m_data[i]));
+            m_data[i].~T();
+        }
+        m_data = data;
+        m_capacity = capacity;
+        m_peakCapacity = std::max(m_peakCapacity, capacity);
+    }
+
+    void destroyAll() {
+        clear();
+        m_data = nullptr;
+        m_capacity = 0;
+    }
+};
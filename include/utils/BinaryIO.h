@@ -0,0 +1,117 @@
+#pragma once
+
+#include "common.h"
+#include <cstring>
+
+// Tampon d'écriture binaire petit-boutiste : ajout séquentiel, réservation
+// d'enregistrements puis correction, alignement des sections
+class ByteWriter {
+public:
+    uint64_t position() const { return m_bytes.size(); }
+
+    uint64_t align(uint64_t alignment) {
+        m_bytes.resize((m_bytes.size() + alignment - 1) / alignment * alignment, 0);
+        return m_bytes.size();
+    }
+
+    uint64_t append(const void* data, size_t size) {
+        uint64_t offset = m_bytes.size();
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        m_bytes.insert(m_bytes.end(), bytes, bytes + size);
+        return offset;
+    }
+
+    uint64_t reserve(size_t size) {
+        uint64_t offset = m_bytes.size();
+        m_bytes.resize(m_bytes.size() + size, 0);
+        return offset;
+    }
+
+    template <typename T>
+    uint64_t put(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Type non copiable bit à bit");
+        return append(&value, sizeof(T));
+    }
+
+    void putString(const std::string& text) {
+        put(static_cast<uint32_t>(text.size()));
+        append(text.data(), text.size());
+    }
+
+    // Entiers à longueur variable (LEB128), signés en zigzag
+    void putVarint(uint64_t value) {
+        while (value >= 0x80) {
+            m_bytes.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        m_bytes.push_back(static_cast<uint8_t>(value));
+    }
+
+    void putSignedVarint(int64_t value) {
+        putVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    template <typename T>
+    void patch(uint64_t offset, const T& value) {
+        std::memcpy(m_bytes.data() + offset, &value, sizeof(T));
+    }
+
+    const std::vector<uint8_t>& bytes() const { return m_bytes; }
+    void clear() { m_bytes.clear(); }
+
+private:
+    std::vector<uint8_t> m_bytes;
+};
+
+// Lecture séquentielle avec contrôle des bornes (exception si dépassement)
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    size_t position() const { return m_position; }
+    void seek(size_t position) {
+        if (position > m_size) throw std::runtime_error("Lecture binaire hors limites");
+        m_position = position;
+    }
+
+    const uint8_t* take(size_t size) {
+        if (size > m_size - m_position) throw std::runtime_error("Lecture binaire hors limites");
+        const uint8_t* data = m_data + m_position;
+        m_position += size;
+        return data;
+    }
+
+    template <typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    uint64_t getVarint() {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = get<uint8_t>();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        throw std::runtime_error("Entier variable invalide");
+    }
+
+    int64_t getSignedVarint() {
+        uint64_t value = getVarint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    bool atEnd() const { return m_position >= m_size; }
+
+    std::string getString() {
+        uint32_t length = get<uint32_t>();
+        return std::string(reinterpret_cast<const char*>(take(length)), length);
+    }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_position = 0;
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "common.h"
+#include <cstdio>
+
+// Fichier de colonnes par blocs (.rcol) : suite de blocs autonomes ajoutés en fin de fichier.
+// Chaque bloc est une table (nom, numéro de lot, lignes) stockée colonne par colonne,
+// éventuellement compressée. Un bloc incomplet en fin de fichier (écriture en cours
+// ou interrompue) est ignoré à la lecture et tronqué à la reprise en ajout.
+//
+//   en-tête fichier | [en-tête bloc | nom de table | répertoire des colonnes | données]*
+namespace ColumnFormat {
+    constexpr char MAGIC[8] = {'R', 'A', 'D', 'C', 'O', 'L', 'S', '1'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t ENDIAN_TAG = 0x01020304;
+    constexpr uint32_t CHUNK_MAGIC = 0x4B484352; // "RCHK"
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t endianTag;
+    };
+
+    struct ChunkHeader {
+        uint32_t magic;
+        uint32_t checksum;    // FNV-1a de la charge utile
+        uint64_t payloadSize; // Octets suivant cet en-tête
+        uint64_t batch;
+        uint64_t rowCount;
+        uint32_t columnCount;
+        uint32_t reserved;
+    };
+
+    struct ColumnRecord {
+        uint8_t type;
+        uint8_t codec;
+        uint8_t reserved[6];
+        uint64_t rawSize;    // Octets décompressés
+        uint64_t storedSize; // Octets dans le fichier
+        uint64_t dataOffset; // Relatif au début de la charge utile
+    };
+
+    static_assert(sizeof(FileHeader) == 16, "En-tête .rcol de 16 octets");
+    static_assert(sizeof(ChunkHeader) == 40, "ChunkHeader de 40 octets");
+    static_assert(sizeof(ColumnRecord) == 32, "ColumnRecord de 32 octets");
+}
+
+enum class ColumnType : uint8_t {
+    FLOAT64,
+    FLOAT32,
+    UINT64,
+    UINT32,
+    STRING   // Par ligne : longueur u32 puis octets UTF-8
+};
+
+enum class ColumnCodec : uint8_t {
+    NONE,
+    ZLIB,        // deflate
+    SHUFFLE_ZLIB // Octets regroupés par rang avant deflate (valeurs numériques)
+};
+
+// Colonne typée, valeurs brutes petit-boutistes
+struct Column {
+    std::string name;
+    ColumnType type = ColumnType::FLOAT64;
+    std::vector<uint8_t> data;
+
+    static Column float64(const std::string& name, const std::vector<double>& values);
+    static Column float32(const std::string& name, const std::vector<float>& values);
+    static Column uint64(const std::string& name, const std::vector<uint64_t>& values);
+    static Column uint32(const std::string& name, const std::vector<uint32_t>& values);
+    static Column strings(const std::string& name, const std::vector<std::string>& values);
+
+    size_t elementSize() const; // 0 pour STRING
+    uint64_t rowCount() const;
+
+    // Conversions (les types numériques sont convertibles entre eux)
+    std::vector<double> asDoubles() const;
+    std::vector<uint64_t> asUInt64() const;
+    std::vector<std::string> asStrings() const;
+};
+
+struct ColumnTable {
+    std::string name;
+    uint64_t batch = 0;
+    std::vector<Column> columns;
+
+    uint64_t rowCount() const { return columns.empty() ? 0 : columns.front().rowCount(); }
+    const Column* find(const std::string& columnName) const;
+    const Column& at(const std::string& columnName) const; // Exception si absente
+};
+
+// Écriture par ajout : chaque table devient un bloc vidé immédiatement sur disque
+class ColumnWriter {
+public:
+    // append : reprise d'un fichier existant (sinon créé ou écrasé)
+    ColumnWriter(const std::string& filename, bool append = false, ColumnCodec codec = ColumnCodec::NONE);
+    ~ColumnWriter();
+
+    ColumnWriter(const ColumnWriter&) = delete;
+    ColumnWriter& operator=(const ColumnWriter&) = delete;
+
+    void write(const ColumnTable& table);
+
+    const std::string& getFilename() const { return m_filename; }
+    static bool isCompressionAvailable(); // zlib présente à la compilation
+
+private:
+    std::string m_filename;
+    std::FILE* m_file = nullptr;
+    ColumnCodec m_codec;
+    std::mutex m_mutex;
+};
+
+// Lecture, éventuellement pendant que le fichier est encore écrit (refresh)
+class ColumnReader {
+public:
+    struct ChunkInfo {
+        std::string table;
+        uint64_t batch = 0;
+        uint64_t rowCount = 0;
+        uint64_t offset = 0; // Début de l'en-tête du bloc
+    };
+
+    explicit ColumnReader(const std::string& filename);
+
+    // Indexe les blocs complets ajoutés depuis le dernier appel ; renvoie le nombre total
+    size_t refresh();
+    const std::vector<ChunkInfo>& getChunks() const { return m_chunks; }
+    std::vector<size_t> findChunks(const std::string& table) const;
+
+    // Lecture d'un bloc ; columns non vide : seules ces colonnes sont lues et décompressées
+    ColumnTable read(size_t chunk, const std::vector<std::string>& columns = {}) const;
+
+    // Bloc le plus récent d'une table (résultats cumulés du dernier lot écrit)
+    bool readLatest(const std::string& table, ColumnTable& result) const;
+
+private:
+    std::string m_filename;
+    std::vector<ChunkInfo> m_chunks;
+    uint64_t m_scanOffset = sizeof(ColumnFormat::FileHeader);
+};
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "common.h"
+#include <charconv>
+#include <cstring>
+
+// Curseur de lecture JSON en flux, sans arbre intermédiaire : l'appelant parcourt
+// les objets et tableaux par rappels et saute les valeurs qui ne l'intéressent pas.
+// base sert uniquement à situer les erreurs (décalage en octets dans le fichier).
+class JsonCursor {
+public:
+    JsonCursor(const char* begin, const char* end, const char* base)
+        : m_p(begin), m_end(end), m_base(base) {}
+
+    const char* position() const { return m_p; }
+    char peek() const { return m_p < m_end ? *m_p : '\0'; }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("JSON invalide (octet " + std::to_string(m_p - m_base) + "): " + message);
+    }
+
+    void skipWhitespace() {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\n' || *m_p == '\r' || *m_p == '\t')) ++m_p;
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (m_p < m_end && *m_p == c) {
+            ++m_p;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!consume(c)) fail(std::string("'") + c + "' attendu");
+    }
+
+    template <typename Func>
+    void readObject(Func&& onKey) {
+        expect('{');
+        if (consume('}')) return;
+        do {
+            std::string key = readString();
+            expect(':');
+            onKey(key);
+        } while (consume(','));
+        expect('}');
+    }
+
+    template <typename Func>
+    void readArray(Func&& onElement) {
+        expect('[');
+        if (consume(']')) return;
+        do {
+            onElement();
+        } while (consume(','));
+        expect(']');
+    }
+
+    std::string readString() {
+        skipWhitespace();
+        if (m_p >= m_end || *m_p != '"') fail("chaîne attendue");
+        ++m_p;
+
+        std::string result;
+        while (true) {
+            if (m_p >= m_end) fail("chaîne non terminée");
+            char c = *m_p++;
+            if (c == '"') break;
+            if (c != '\\') {
+                result += c;
+                continue;
+            }
+            if (m_p >= m_end) fail("échappement incomplet");
+            char escape = *m_p++;
+            switch (escape) {
+                case '"': result += '"'; break;
+                case '\\': result += '\\'; break;
+                case '/': result += '/'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'n': result += '\n'; break;
+                case 'r': result += '\r'; break;
+                case 't': result += '\t'; break;
+                case 'u': appendCodePoint(result, readCodePoint()); break;
+                default: fail("échappement inconnu");
+            }
+        }
+        return result;
+    }
+
+    double readNumber() {
+        skipWhitespace();
+        double value = 0.0;
+        auto result = std::from_chars(m_p, m_end, value);
+        if (result.ec != std::errc()) fail("nombre attendu");
+        m_p = result.ptr;
+        return value;
+    }
+
+    float readFloat() { return static_cast<float>(readNumber()); }
+
+    bool readBool() {
+        skipWhitespace();
+        if (matchLiteral("true")) return true;
+        if (matchLiteral("false")) return false;
+        fail("booléen attendu");
+    }
+
+    glm::vec3 readVec3() {
+        float values[3] = {0.0f, 0.0f, 0.0f};
+        size_t count = 0;
+        readArray([&]() {
+            float value = readFloat();
+            if (count < 3) values[count] = value;
+            ++count;
+        });
+        if (count != 3) fail("vecteur à 3 composantes attendu");
+        return glm::vec3(values[0], values[1], values[2]);
+    }
+
+    std::vector<float> readFloats() {
+        std::vector<float> values;
+        readArray([&]() { values.push_back(readFloat()); });
+        return values;
+    }
+
+    std::vector<std::pair<float, float>> readPairs() {
+        std::vector<std::pair<float, float>> pairs;
+        readArray([&]() {
+            auto values = readFloats();
+            if (values.size() != 2) fail("couple [énergie, valeur] attendu");
+            pairs.emplace_back(values[0], values[1]);
+        });
+        return pairs;
+    }
+
+    // Saut d'une valeur quelconque par simple balayage des délimiteurs
+    void skipValue() {
+        skipWhitespace();
+        if (m_p >= m_end) fail("valeur attendue");
+
+        if (*m_p == '"') {
+            skipString();
+        } else if (*m_p == '{' || *m_p == '[') {
+            int depth = 0;
+            do {
+                if (m_p >= m_end) fail("structure non terminée");
+                char c = *m_p;
+                if (c == '"') {
+                    skipString();
+                    continue;
+                }
+                if (c == '{' || c == '[') ++depth;
+                else if (c == '}' || c == ']') --depth;
+                ++m_p;
+            } while (depth > 0);
+        } else {
+            while (m_p < m_end && *m_p != ',' && *m_p != '}' && *m_p != ']' &&
+                   *m_p != ' ' && *m_p != '\n' && *m_p != '\r' && *m_p != '\t') {
+                ++m_p;
+            }
+        }
+    }
+
+private:
+    const char* m_p;
+    const char* m_end;
+    const char* m_base;
+
+    bool matchLiteral(const char* literal) {
+        size_t length = std::strlen(literal);
+        if (static_cast<size_t>(m_end - m_p) >= length && std::memcmp(m_p, literal, length) == 0) {
+            m_p += length;
+            return true;
+        }
+        return false;
+    }
+
+    void skipString() {
+        ++m_p; // Guillemet ouvrant
+        while (true) {
+            const char* quote = static_cast<const char*>(std::memchr(m_p, '"', m_end - m_p));
+            if (!quote) fail("chaîne non terminée");
+            // Guillemet échappé si précédé d'un nombre impair de barres obliques
+            size_t backslashes = 0;
+            for (const char* q = quote - 1; q >= m_p && *q == '\\'; --q) ++backslashes;
+            m_p = quote + 1;
+            if (backslashes % 2 == 0) return;
+        }
+    }
+
+    uint32_t readHex4() {
+        if (m_end - m_p < 4) fail("séquence \\u incomplète");
+        uint32_t value = 0;
+        auto result = std::from_chars(m_p, m_p + 4, value, 16);
+        if (result.ptr != m_p + 4) fail("séquence \\u invalide");
+        m_p += 4;
+        return value;
+    }
+
+    uint32_t readCodePoint() {
+        uint32_t code = readHex4();
+        // Paire de substitution UTF-16
+        if (code >= 0xD800 && code <= 0xDBFF && m_end - m_p >= 6 && m_p[0] == '\\' && m_p[1] == 'u') {
+            m_p += 2;
+            uint32_t low = readHex4();
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        }
+        return code;
+    }
+
+    static void appendCodePoint(std::string& out, uint32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "common.h"
+
+// Projection mémoire en lecture seule d'un fichier (mmap POSIX) ;
+// les pages sont partagées par tous les processus qui projettent le même fichier.
+// Sans mmap, le fichier est lu intégralement en mémoire.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool isMapped() const { return m_mapped; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_mapped = false;
+    std::vector<uint8_t> m_buffer; // Repli sans mmap
+
+    void release();
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "common.h"
+
+// Topologie NUMA de la machine, limitée aux CPU autorisés pour le processus.
+// Lue dans /sys/devices/system/node ; sans cette information (ou hors Linux), un seul nœud
+// regroupant tous les CPU. La variable d'environnement RADIATION_NUMA_NODES=N découpe les
+// CPU en N nœuds émulés : exerce le chemin multi-nœuds sur une machine à un seul nœud,
+// sans gain de localité mémoire.
+class NumaTopology {
+public:
+    static const NumaTopology& getInstance();
+
+    size_t getNodeCount() const { return m_nodes.size(); }
+    const std::vector<uint32_t>& getNodeCpus(size_t node) const { return m_nodes[node]; }
+    bool isEmulated() const { return m_emulated; }
+
+    struct Placement {
+        uint32_t node = 0;
+        uint32_t cpu = 0; // CPU attribué dans le nœud (épinglage)
+    };
+
+    // Répartition de threadCount threads en blocs contigus, proportionnellement aux CPU des nœuds
+    std::vector<Placement> distributeThreads(uint32_t threadCount) const;
+
+    // Épinglage du thread appelant ; false si refusé par le système
+    static bool pinCurrentThread(uint32_t cpu);
+    static bool pinCurrentThread(const std::vector<uint32_t>& cpus);
+
+private:
+    NumaTopology();
+
+    std::vector<std::vector<uint32_t>> m_nodes; // CPU de chaque nœud
+    bool m_emulated = false;
+};
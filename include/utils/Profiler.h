@@ -0,0 +1,154 @@
+#pragma once
+
+#include "common.h"
+#include <chrono>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_HAS_TSC 1
+#endif
+
+// Profilage des étapes du transport, activé à la compilation (option CMake ENABLE_PROFILING,
+// définition USE_PROFILING). Sans elle, les macros PROFILE_* ne génèrent aucun code.
+//
+//   PROFILE_SCOPE(ProfileStage::RAY_CAST);             // Chronomètre jusqu'à la fin du bloc
+//   PROFILE_COUNT(ProfileCounter::BVH_NODES, 1);       // Compteur du thread courant
+//
+// Les mesures sont cumulées par thread sans synchronisation ; report() et writeChromeTrace()
+// se lisent une fois les threads de transport arrêtés.
+
+enum class ProfileStage : uint8_t {
+    BATCH,              // Lot complet d'un thread (englobe les autres étapes)
+    SOURCE_SAMPLING,
+    CROSS_SECTION,      // Coefficients d'atténuation, choix de l'interaction
+    RAY_CAST,
+    SENSOR_SCORING,     // Capteurs et tallies maillés
+    NEXT_EVENT,
+    INTERACTION,        // Cinématique des collisions
+    VARIANCE_REDUCTION, // Roulette russe, splitting, fenêtres de poids
+    COUNT
+};
+
+enum class ProfileCounter : uint8_t {
+    RAYS,
+    BVH_NODES,         // Nœuds visités
+    PRIMITIVE_TESTS,   // Tests d'intersection d'objets
+    STEPS,
+    COUNT
+};
+
+const char* profileStageName(ProfileStage stage);
+const char* profileCounterName(ProfileCounter counter);
+
+class Profiler {
+public:
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(ProfileStage::COUNT);
+    static constexpr size_t COUNTER_COUNT = static_cast<size_t>(ProfileCounter::COUNT);
+
+    struct TraceEvent {
+        uint64_t start;    // Ticks
+        uint64_t duration;
+        ProfileStage stage;
+    };
+
+    struct ThreadProfile {
+        uint32_t index = 0;
+        uint64_t generation = 0;
+        std::array<uint64_t, STAGE_COUNT> ticks{};
+        std::array<uint64_t, STAGE_COUNT> calls{};
+        std::array<uint64_t, COUNTER_COUNT> counters{};
+        std::vector<TraceEvent> events;
+        uint64_t droppedEvents = 0;
+    };
+
+    static Profiler& getInstance();
+
+    static constexpr bool isCompiledIn() {
+#ifdef USE_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static uint64_t now() {
+#ifdef PROFILER_HAS_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Profil du thread appelant (créé au premier appel après reset())
+    ThreadProfile& local() {
+        thread_local ThreadProfile* profile = nullptr;
+        if (!profile || profile->generation != m_generation.load(std::memory_order_relaxed)) {
+            profile = registerThread();
+        }
+        return *profile;
+    }
+
+    void addTime(ProfileStage stage, uint64_t start, uint64_t end) {
+        ThreadProfile& profile = local();
+        size_t index = static_cast<size_t>(stage);
+        profile.ticks[index] += end - start;
+        ++profile.calls[index];
+        if (m_traceCapacity > 0) {
+            if (profile.events.size() < m_traceCapacity) profile.events.push_back({start, end - start, stage});
+            else ++profile.droppedEvents;
+        }
+    }
+
+    void count(ProfileCounter counter, uint64_t amount) {
+        local().counters[static_cast<size_t>(counter)] += amount;
+    }
+
+    // Remise à zéro et début de la mesure de référence (calibration des ticks)
+    void reset();
+
+    // Événements conservés par thread pour la trace Chrome (0 : aucune trace)
+    void setTraceCapacity(size_t eventsPerThread) { m_traceCapacity = eventsPerThread; }
+
+    // Rapport texte : temps par étape (total, par appel, part du temps des lots), compteurs
+    std::string report() const;
+    // Format trace-event de Chrome (chrome://tracing, Perfetto)
+    void writeChromeTrace(const std::string& filename) const;
+
+private:
+    Profiler() = default;
+
+    std::vector<std::unique_ptr<ThreadProfile>> m_threads;
+    mutable std::mutex m_mutex;
+    std::atomic<uint64_t> m_generation{1};
+    size_t m_traceCapacity = 0;
+    uint64_t m_startTicks = now();
+    std::chrono::steady_clock::time_point m_startTime = std::chrono::steady_clock::now();
+
+    ThreadProfile* registerThread();
+    double ticksPerSecond() const; // Étalonné sur l'horloge monotone depuis reset()
+};
+
+// Chronomètre de portée
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileStage stage) : m_stage(stage), m_start(Profiler::now()) {}
+    ~ProfileScope() { Profiler::getInstance().addTime(m_stage, m_start, Profiler::now()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileStage m_stage;
+    uint64_t m_start;
+};
+
+#ifdef USE_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(stage) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(stage)
+#define PROFILE_COUNT(counter, amount) Profiler::getInstance().count(counter, amount)
+#else
+#define PROFILE_SCOPE(stage) ((void)0)
+#define PROFILE_COUNT(counter, amount) ((void)0)
+#endif
@@ -7,8 +7,14 @@ struct RandomGenerator
 {
     static thread_local std::mt19937 generator;
     static thread_local std::uniform_real_distribution<float> uniform;
+    // N° global de l'histoire en cours dans les runs reproductibles (NO_HISTORY sinon)
+    static constexpr std::uint64_t NO_HISTORY = ~std::uint64_t(0);
+    static thread_local std::uint64_t history;
 
     static void seed(std::uint64_t s) { generator.seed(static_cast<uint32_t>(s)); }
+    // Flux indépendant n° stream d'une graine commune (runs reproductibles, distribués)
+    static void seedStream(std::uint64_t seed, std::uint64_t stream);
+    static void setHistory(std::uint64_t index) { history = index; }
     static float random() { return uniform(generator); } // [0,1)
     static float randomRange(float a, float b) { return a + (b - a) * random(); }
     static glm::vec3 randomDirection(); // direction isotrope
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "common.h"
+#include "geometry/Object3D.h"
+
+// Grille régulière alignée sur les axes (maillages d'importance, cartes adjointes)
+class RegularGrid {
+public:
+    RegularGrid() = default;
+    RegularGrid(const AABB& bounds, uint32_t nx, uint32_t ny, uint32_t nz);
+
+    const AABB& getBounds() const { return m_bounds; }
+    uint32_t getNx() const { return m_nx; }
+    uint32_t getNy() const { return m_ny; }
+    uint32_t getNz() const { return m_nz; }
+    uint32_t getCellCount() const { return m_nx * m_ny * m_nz; }
+    glm::vec3 getCellSize() const;
+
+    // Indexation (x le plus rapide)
+    int cellIndex(const glm::vec3& position) const; // -1 hors grille
+    uint32_t cellIndex(uint32_t ix, uint32_t iy, uint32_t iz) const { return (iz * m_ny + iy) * m_nx + ix; }
+    glm::vec3 cellCenter(uint32_t cell) const;
+    AABB cellBounds(uint32_t cell) const;
+
+    // Parcours 3D-DDA d'un segment : visit(cellule, longueur en m) pour chaque voxel traversé
+    template <typename Visitor>
+    void traverseSegment(const glm::vec3& p0, const glm::vec3& p1, Visitor&& visit) const;
+
+private:
+    AABB m_bounds;
+    uint32_t m_nx = 1;
+    uint32_t m_ny = 1;
+    uint32_t m_nz = 1;
+    glm::vec3 m_invCellSize{0.0f};
+};
+
+template <typename Visitor>
+void RegularGrid::traverseSegment(const glm::vec3& p0, const glm::vec3& p1, Visitor&& visit) const {
+    glm::vec3 d = p1 - p0;
+    float length = glm::length(d);
+    if (length <= 0.0f) return;
+
+    // Découpage du segment par la boîte de la grille
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::abs(d[axis]) < 1e-12f) {
+            if (p0[axis] < m_bounds.min[axis] || p0[axis] > m_bounds.max[axis]) return;
+            continue;
+        }
+        float t1 = (m_bounds.min[axis] - p0[axis]) / d[axis];
+        float t2 = (m_bounds.max[axis] - p0[axis]) / d[axis];
+        if (t1 > t2) std::swap(t1, t2);
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin >= tMax) return;
+    }
+
+    const uint32_t counts[3] = {m_nx, m_ny, m_nz};
+    const glm::vec3 cellSize = getCellSize();
+    const glm::vec3 entry = p0 + d * tMin;
+
+    int index[3];
+    int step[3];
+    float tNext[3];
+    float tDelta[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        float local = (entry[axis] - m_bounds.min[axis]) * m_invCellSize[axis];
+        index[axis] = std::clamp(static_cast<int>(local), 0, static_cast<int>(counts[axis]) - 1);
+
+        if (std::abs(d[axis]) < 1e-12f || cellSize[axis] <= 0.0f) {
+            step[axis] = 0;
+            tNext[axis] = std::numeric_limits<float>::infinity();
+            tDelta[axis] = std::numeric_limits<float>::infinity();
+            continue;
+        }
+
+        step[axis] = d[axis] > 0.0f ? 1 : -1;
+        float boundary = m_bounds.min[axis] + (index[axis] + (step[axis] > 0 ? 1 : 0)) * cellSize[axis];
+        tNext[axis] = (boundary - p0[axis]) / d[axis];
+        tDelta[axis] = cellSize[axis] / std::abs(d[axis]);
+    }
+
+    float t = tMin;
+    while (t < tMax) {
+        int axis = tNext[0] < tNext[1] ? (tNext[0] < tNext[2] ? 0 : 2) : (tNext[1] < tNext[2] ? 1 : 2);
+        float tEnd = std::min(tNext[axis], tMax);
+
+        if (tEnd > t) {
+            visit(cellIndex(static_cast<uint32_t>(index[0]), static_cast<uint32_t>(index[1]),
+                            static_cast<uint32_t>(index[2])),
+                  (tEnd - t) * length);
+        }
+        t = tEnd;
+        if (t >= tMax) break;
+
+        index[axis] += step[axis];
+        if (index[axis] < 0 || index[axis] >= static_cast<int>(counts[axis])) break;
+        tNext[axis] += tDelta[axis];
+    }
+}
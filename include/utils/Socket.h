@@ -0,0 +1,48 @@
+#pragma once
+
+#include "common.h"
+
+// Sockets flux POSIX : TCP ("hôte:port") ou socket Unix ("unix:/chemin").
+// Erreurs signalées par exception (std::runtime_error).
+class SocketConnection {
+public:
+    SocketConnection() = default;
+    explicit SocketConnection(int fd) : m_fd(fd) {}
+    ~SocketConnection() { close(); }
+
+    SocketConnection(SocketConnection&& other) noexcept : m_fd(other.m_fd) { other.m_fd = -1; }
+    SocketConnection& operator=(SocketConnection&& other) noexcept;
+    SocketConnection(const SocketConnection&) = delete;
+    SocketConnection& operator=(const SocketConnection&) = delete;
+
+    bool isOpen() const { return m_fd >= 0; }
+    int fd() const { return m_fd; }
+    void close();
+
+    void sendAll(const void* data, size_t size);
+    void receiveAll(void* data, size_t size); // Exception si la connexion est fermée avant la fin
+
+    // Tentatives répétées jusqu'à timeoutMs (démarrage concurrent du serveur)
+    static SocketConnection connect(const std::string& address, uint32_t timeoutMs = 10000);
+
+private:
+    int m_fd = -1;
+};
+
+class SocketListener {
+public:
+    explicit SocketListener(const std::string& address); // Port 0 : choisi par le système
+    ~SocketListener();
+
+    SocketListener(const SocketListener&) = delete;
+    SocketListener& operator=(const SocketListener&) = delete;
+
+    int fd() const { return m_fd; }
+    const std::string& getAddress() const { return m_address; } // Port effectif inclus
+    SocketConnection accept();
+
+private:
+    int m_fd = -1;
+    std::string m_address;
+    std::string m_unixPath; // Supprimé à la fermeture
+};
@@ -45,6 +45,7 @@ class Renderer {
     void drawAxes(float /*length*/) {}
     void drawAABB(const glm::vec3 & /*minPt*/, const glm::vec3 & /*maxPt*/, const glm::vec4 & /*color*/) {}
     void drawCross(const glm::vec3 & /*p*/, float /*size*/, const glm::vec4 & /*color*/) {}
+    void drawLine(const glm::vec3 & /*a*/, const glm::vec3 & /*b*/, const glm::vec4 & /*color*/) {}
 
   private:
     void ensureInitialized();
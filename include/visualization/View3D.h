@@ -19,6 +19,7 @@ class Renderer;
 #endif
 
 class Scene;
+struct TrackData;
 
 class View3D : public QOpenGLWindow, protected QOpenGLFunctions {
     Q_OBJECT
@@ -31,6 +32,9 @@ class View3D : public QOpenGLWindow, protected QOpenGLFunctions {
     void setWireframeEnabled(bool enabled);
     void setShowSensors(bool enabled);
     void setShowSources(bool enabled);
+    // Traces relues d'un fichier .rtrk (TrackRecorder::readFile), nullptr pour effacer
+    void setTracks(std::shared_ptr<const TrackData> tracks);
+    void setShowTracks(bool enabled);
     void resetCamera();
 
   protected:
@@ -52,6 +56,7 @@ class View3D : public QOpenGLWindow, protected QOpenGLFunctions {
     void updateSceneHelpers();
 
     std::shared_ptr<Scene> m_scene;
+    std::shared_ptr<const TrackData> m_tracks;
     std::unique_ptr<Renderer> m_renderer;
 
     glm::vec3 m_target{0.0f};
@@ -65,4 +70,5 @@ class View3D : public QOpenGLWindow, protected QOpenGLFunctions {
     bool m_wireframe = false;
     bool m_showSensors = true;
     bool m_showSources = true;
+    bool m_showTracks = true;
 };
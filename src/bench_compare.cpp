@@ -0,0 +1,316 @@
+#include "common.h"
+#include "utils/JsonCursor.h"
+#include "utils/MappedFile.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+// Comparaison de deux fichiers de résultats RadiationBench (référence, candidat).
+// Pour chaque mesure commune : écart relatif des médianes orienté « dégradation » (positif :
+// plus lent) et intervalle de confiance par bootstrap sur les échantillons répétés.
+// Une régression n'est signalée que si toute la plage de l'intervalle dépasse le seuil.
+
+namespace {
+
+struct MetricSamples {
+    std::string unit;
+    bool higherIsBetter = false;
+    std::vector<double> samples;
+};
+
+struct BenchResults {
+    std::string buildType;
+    std::string compiler;
+    bool quick = false;
+    // Clé : "cas|mesure", dans l'ordre du fichier
+    std::vector<std::string> order;
+    std::map<std::string, MetricSamples> metrics;
+};
+
+struct CompareOptions {
+    double threshold = 5.0;   // % de dégradation toléré
+    double confidence = 0.95;
+    uint32_t resamples = 2000;
+    std::vector<std::pair<std::string, double>> caseThresholds; // Préfixe de cas -> seuil (%)
+
+    double thresholdFor(const std::string& caseName) const {
+        // Préfixe le plus long
+        double value = threshold;
+        size_t best = 0;
+        for (const auto& [prefix, percent] : caseThresholds) {
+            if (caseName.rfind(prefix, 0) == 0 && prefix.size() >= best) {
+                best = prefix.size();
+                value = percent;
+            }
+        }
+        return value;
+    }
+};
+
+enum class Verdict { REGRESSION, IMPROVEMENT, UNCHANGED, UNCERTAIN };
+
+const char* verdictName(Verdict verdict) {
+    switch (verdict) {
+        case Verdict::REGRESSION: return "RÉGRESSION";
+        case Verdict::IMPROVEMENT: return "amélioration";
+        case Verdict::UNCERTAIN: return "incertain";
+        default: return "=";
+    }
+}
+
+BenchResults readResults(const std::string& filename) {
+    MappedFile file(filename);
+    const char* base = reinterpret_cast<const char*>(file.data());
+    JsonCursor cursor(base, base + file.size(), base);
+
+    BenchResults results;
+    std::string format;
+    cursor.readObject([&](const std::string& key) {
+        if (key == "format") {
+            format = cursor.readString();
+        } else if (key == "quick") {
+            results.quick = cursor.readBool();
+        } else if (key == "build") {
+            cursor.readObject([&](const std::string& buildKey) {
+                if (buildKey == "type") results.buildType = cursor.readString();
+                else if (buildKey == "compiler") results.compiler = cursor.readString();
+                else cursor.skipValue();
+            });
+        } else if (key == "cases") {
+            cursor.readArray([&]() {
+                std::string caseName;
+                std::vector<std::pair<std::string, MetricSamples>> caseMetrics;
+                cursor.readObject([&](const std::string& caseKey) {
+                    if (caseKey == "name") {
+                        caseName = cursor.readString();
+                    } else if (caseKey == "metrics") {
+                        cursor.readArray([&]() {
+                            std::string metricName;
+                            MetricSamples metric;
+                            cursor.readObject([&](const std::string& metricKey) {
+                                if (metricKey == "name") metricName = cursor.readString();
+                                else if (metricKey == "unit") metric.unit = cursor.readString();
+                                else if (metricKey == "higherIsBetter") metric.higherIsBetter = cursor.readBool();
+                                else if (metricKey == "samples") {
+                                    cursor.readArray([&]() { metric.samples.push_back(cursor.readNumber()); });
+                                } else cursor.skipValue();
+                            });
+                            caseMetrics.emplace_back(metricName, std::move(metric));
+                        });
+                    } else {
+                        cursor.skipValue();
+                    }
+                });
+                for (auto& [metricName, metric] : caseMetrics) {
+                    std::string id = caseName + "|" + metricName;
+                    auto& merged = results.metrics[id];
+                    if (merged.samples.empty()) results.order.push_back(id);
+                    merged.unit = metric.unit;
+                    merged.higherIsBetter = metric.higherIsBetter;
+                    merged.samples.insert(merged.samples.end(), metric.samples.begin(), metric.samples.end());
+                }
+            });
+        } else {
+            cursor.skipValue();
+        }
+    });
+
+    if (format != "radiation-bench") {
+        throw std::runtime_error("Fichier de résultats RadiationBench invalide: " + filename);
+    }
+    return results;
+}
+
+// Plusieurs exécutions d'un même côté : échantillons concaténés par mesure
+void mergeResults(BenchResults& into, const BenchResults& other) {
+    for (const auto& id : other.order) {
+        const auto& metric = other.metrics.at(id);
+        auto& merged = into.metrics[id];
+        if (merged.samples.empty()) into.order.push_back(id);
+        merged.unit = metric.unit;
+        merged.higherIsBetter = metric.higherIsBetter;
+        merged.samples.insert(merged.samples.end(), metric.samples.begin(), metric.samples.end());
+    }
+}
+
+double median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    double upper = values[mid];
+    if (values.size() % 2) return upper;
+    double lower = *std::max_element(values.begin(), values.begin() + mid);
+    return 0.5 * (lower + upper);
+}
+
+// Dégradation relative (%) : candidat plus lent que la référence si positive
+double degradation(double reference, double candidate, bool higherIsBetter) {
+    if (reference <= 0.0 || candidate <= 0.0) return 0.0;
+    return 100.0 * (higherIsBetter ? reference / candidate - 1.0 : candidate / reference - 1.0);
+}
+
+// Intervalle de confiance percentile de la dégradation par bootstrap (tirage déterministe)
+std::pair<double, double> bootstrapInterval(const MetricSamples& reference, const MetricSamples& candidate,
+                                            const CompareOptions& options) {
+    std::mt19937 generator(20240611u);
+    std::vector<double> a(reference.samples.size()), b(candidate.samples.size());
+    std::vector<double> estimates;
+    estimates.reserve(options.resamples);
+    for (uint32_t r = 0; r < options.resamples; ++r) {
+        std::uniform_int_distribution<size_t> pickA(0, a.size() - 1), pickB(0, b.size() - 1);
+        for (auto& value : a) value = reference.samples[pickA(generator)];
+        for (auto& value : b) value = candidate.samples[pickB(generator)];
+        estimates.push_back(degradation(median(a), median(b), reference.higherIsBetter));
+    }
+    std::sort(estimates.begin(), estimates.end());
+    double alpha = 0.5 * (1.0 - options.confidence);
+    size_t low = static_cast<size_t>(alpha * (estimates.size() - 1));
+    size_t high = static_cast<size_t>((1.0 - alpha) * (estimates.size() - 1) + 0.5);
+    return {estimates[low], estimates[high]};
+}
+
+std::string formatValue(double value) {
+    std::ostringstream out;
+    out << std::setprecision(4) << value;
+    return out.str();
+}
+
+std::string formatPercent(double value) {
+    std::ostringstream out;
+    out << std::showpos << std::fixed << std::setprecision(1) << value << "%";
+    return out.str();
+}
+
+void printUsage(const char* program) {
+    std::cout << "Comparaison de résultats RadiationBench" << std::endl;
+    std::cout << "Usage: " << program << " [OPTIONS] <référence.json>[,...] <candidat.json>[,...]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Plusieurs fichiers séparés par des virgules : échantillons regroupés (runs répétés)." << std::endl;
+    std::cout << "Code de retour 2 si une régression dépasse son seuil avec la confiance demandée." << std::endl;
+    std::cout << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "  --threshold <pct>            Dégradation tolérée (5 % par défaut)" << std::endl;
+    std::cout << "  --case-threshold <préfixe>=<pct>" << std::endl;
+    std::cout << "                               Seuil propre aux cas commençant par le préfixe" << std::endl;
+    std::cout << "  --confidence <niveau>        Niveau de l'intervalle de confiance (0.95 par défaut)" << std::endl;
+    std::cout << "  --resamples <N>              Tirages bootstrap (2000 par défaut)" << std::endl;
+    std::cout << "  --help, -h                   Afficher cette aide" << std::endl;
+}
+
+BenchResults readResultList(const std::string& list) {
+    BenchResults results;
+    std::stringstream stream(list);
+    std::string filename;
+    bool first = true;
+    while (std::getline(stream, filename, ',')) {
+        if (filename.empty()) continue;
+        BenchResults part = readResults(filename);
+        if (first) {
+            results = std::move(part);
+            first = false;
+        } else {
+            mergeResults(results, part);
+        }
+    }
+    if (first) throw std::runtime_error("Aucun fichier de résultats: " + list);
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    CompareOptions options;
+    std::vector<std::string> files;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (arg == "--threshold" && hasValue) {
+                options.threshold = std::stod(argv[++i]);
+            } else if (arg == "--case-threshold" && hasValue) {
+                std::string spec = argv[++i];
+                size_t equal = spec.find('=');
+                if (equal == std::string::npos) throw std::runtime_error("Seuil attendu sous la forme préfixe=pct: " + spec);
+                options.caseThresholds.emplace_back(spec.substr(0, equal), std::stod(spec.substr(equal + 1)));
+            } else if (arg == "--confidence" && hasValue) {
+                options.confidence = std::clamp(std::stod(argv[++i]), 0.5, 0.999);
+            } else if (arg == "--resamples" && hasValue) {
+                options.resamples = std::max(100, std::stoi(argv[++i]));
+            } else if (!arg.empty() && arg[0] == '-') {
+                std::cerr << "Option inconnue ou incomplète: " << arg << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            } else {
+                files.push_back(arg);
+            }
+        }
+        if (files.size() != 2) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        BenchResults reference = readResultList(files[0]);
+        BenchResults candidate = readResultList(files[1]);
+
+        if (reference.buildType != candidate.buildType || reference.compiler != candidate.compiler) {
+            Log::warning("Builds différents (" + reference.buildType + " " + reference.compiler + " / " +
+                         candidate.buildType + " " + candidate.compiler + ")");
+        }
+        if (reference.quick != candidate.quick) {
+            Log::warning("Tailles différentes (--quick) : les mesures ne sont pas comparables");
+        }
+
+        int confidencePercent = static_cast<int>(std::lround(options.confidence * 100.0));
+        std::cout << std::left << std::setw(28) << "Cas" << std::setw(18) << "Mesure" << std::right
+                  << std::setw(12) << "Référence" << std::setw(12) << "Candidat" << std::setw(10) << "Écart"
+                  << "   IC " << confidencePercent << " %" << std::setw(13) << "" << "Verdict" << std::endl;
+
+        size_t regressions = 0, improvements = 0, compared = 0;
+        for (const auto& id : candidate.order) {
+            auto found = reference.metrics.find(id);
+            const MetricSamples& after = candidate.metrics.at(id);
+            if (found == reference.metrics.end() || found->second.samples.empty() || after.samples.empty()) {
+                continue;
+            }
+            const MetricSamples& before = found->second;
+            std::string caseName = id.substr(0, id.find('|'));
+            std::string metricName = id.substr(id.find('|') + 1);
+
+            double medianBefore = median(before.samples);
+            double medianAfter = median(after.samples);
+            double change = degradation(medianBefore, medianAfter, before.higherIsBetter);
+            auto [low, high] = bootstrapInterval(before, after, options);
+            double threshold = options.thresholdFor(caseName);
+
+            Verdict verdict = Verdict::UNCHANGED;
+            if (low > threshold) verdict = Verdict::REGRESSION;
+            else if (high < -threshold) verdict = Verdict::IMPROVEMENT;
+            else if (std::abs(change) > threshold) verdict = Verdict::UNCERTAIN;
+
+            if (verdict == Verdict::REGRESSION) ++regressions;
+            if (verdict == Verdict::IMPROVEMENT) ++improvements;
+            ++compared;
+
+            std::cout << std::left << std::setw(28) << caseName << std::setw(18) << metricName << std::right
+                      << std::setw(12) << formatValue(medianBefore) << std::setw(12) << formatValue(medianAfter)
+                      << std::setw(10) << formatPercent(change) << "   [" << std::setw(8) << formatPercent(low)
+                      << ", " << std::setw(8) << formatPercent(high) << "]   " << verdictName(verdict) << std::endl;
+        }
+
+        for (const auto& id : reference.order) {
+            if (!candidate.metrics.count(id)) Log::warning("Mesure absente du candidat: " + id);
+        }
+
+        std::cout << std::endl << compared << " mesures comparées, " << regressions << " régressions, "
+                  << improvements << " améliorations (seuil " << options.threshold << " %)" << std::endl;
+        return regressions > 0 ? 2 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur fatale: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,171 @@
+#include "core/BinnedTally.h"
+#include <algorithm>
+#include <cmath>
+
+// Binning implementation
+Binning Binning::linear(float min, float max, uint32_t count) {
+    Binning binning;
+    if (count == 0 || max <= min) return binning;
+
+    binning.m_scale = Scale::LINEAR;
+    binning.m_min = min;
+    binning.m_max = max;
+    binning.m_count = count;
+    binning.m_offset = min;
+    binning.m_invWidth = count / (max - min);
+    return binning;
+}
+
+Binning Binning::logarithmic(float min, float max, uint32_t count) {
+    Binning binning;
+    if (count == 0 || min <= 0.0f || max <= min) return binning;
+
+    binning.m_scale = Scale::LOG;
+    binning.m_min = min;
+    binning.m_max = max;
+    binning.m_count = count;
+    binning.m_offset = std::log(min);
+    binning.m_invWidth = count / (std::log(max) - std::log(min));
+    return binning;
+}
+
+int Binning::index(float value) const {
+    if (m_count == 0) return 0;
+    if (!(value >= m_min) || value >= m_max) return -1;
+
+    float position = m_scale == Scale::LOG ? (std::log(value) - m_offset) * m_invWidth
+                                           : (value - m_offset) * m_invWidth;
+    return std::min(static_cast<int>(position), static_cast<int>(m_count) - 1);
+}
+
+float Binning::lowerEdge(uint32_t bin) const {
+    if (m_count == 0) return bin == 0 ? std::numeric_limits<float>::lowest() : std::numeric_limits<float>::max();
+
+    if (m_scale == Scale::LOG) {
+        return std::exp(m_offset + bin / m_invWidth);
+    }
+    return m_offset + bin / m_invWidth;
+}
+
+// BinnedTally implementation
+void BinnedTally::configure(const Binning& energyBins, const Binning& timeBins) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_energyBins = energyBins;
+    m_timeBins = timeBins;
+    m_threadBuffers.clear();
+    m_sum.assign(getBinCount(), 0.0);
+    m_sumSqOverN.assign(getBinCount(), 0.0);
+    m_histories = 0;
+    m_batches = 0;
+}
+
+void BinnedTally::ensureThreadSlots(uint32_t threadCount) {
+    if (!isEnabled()) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_threadBuffers.size() < threadCount) {
+        m_threadBuffers.resize(threadCount);
+    }
+    for (auto& buffer : m_threadBuffers) {
+        buffer.values.resize(getBinCount(), 0.0);
+    }
+}
+
+void BinnedTally::score(uint32_t threadSlot, float energy, float time, double value) {
+    if (threadSlot >= m_threadBuffers.size()) return;
+
+    int energyBin = m_energyBins.index(energy);
+    int timeBin = m_timeBins.index(time);
+    if (energyBin < 0 || timeBin < 0) return;
+
+    ThreadBuffer& buffer = m_threadBuffers[threadSlot];
+    buffer.values[flatIndex(static_cast<uint32_t>(energyBin), static_cast<uint32_t>(timeBin))] += value;
+    buffer.dirty = true;
+}
+
+void BinnedTally::endBatch(uint32_t threadSlot, uint64_t histories) {
+    if (threadSlot >= m_threadBuffers.size() || histories == 0) return;
+
+    ThreadBuffer& buffer = m_threadBuffers[threadSlot];
+    const double invHistories = 1.0 / static_cast<double>(histories);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (buffer.dirty) {
+        for (size_t i = 0; i < buffer.values.size(); ++i) {
+            double value = buffer.values[i];
+            m_sum[i] += value;
+            m_sumSqOverN[i] += value * value * invHistories;
+        }
+        std::fill(buffer.values.begin(), buffer.values.end(), 0.0);
+        buffer.dirty = false;
+    }
+    m_histories += histories;
+    ++m_batches;
+}
+
+void BinnedTally::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::fill(m_sum.begin(), m_sum.end(), 0.0);
+    std::fill(m_sumSqOverN.begin(), m_sumSqOverN.end(), 0.0);
+    for (auto& buffer : m_threadBuffers) {
+        std::fill(buffer.values.begin(), buffer.values.end(), 0.0);
+        buffer.dirty = false;
+    }
+    m_histories = 0;
+    m_batches = 0;
+}
+
+BinnedTally::State BinnedTally::getState() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return State{m_sum, m_sumSqOverN, m_histories, m_batches};
+}
+
+void BinnedTally::addState(const State& state) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (state.sum.size() != m_sum.size() || state.sumSqOverN.size() != m_sumSqOverN.size()) {
+        throw std::runtime_error("Fusion d'histogrammes de découpages différents");
+    }
+    for (size_t i = 0; i < m_sum.size(); ++i) {
+        m_sum[i] += state.sum[i];
+        m_sumSqOverN[i] += state.sumSqOverN[i];
+    }
+    m_histories += state.histories;
+    m_batches += state.batches;
+}
+
+uint64_t BinnedTally::getHistories() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_histories;
+}
+
+uint32_t BinnedTally::getBatchCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_batches;
+}
+
+double BinnedTally::getMean(uint32_t energyBin, uint32_t timeBin) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_histories == 0) return 0.0;
+
+    return m_sum[flatIndex(energyBin, timeBin)] / static_cast<double>(m_histories);
+}
+
+double BinnedTally::getVarianceOfMean(uint32_t energyBin, uint32_t timeBin) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_batches < 2 || m_histories == 0) return 0.0;
+
+    // Lots de tailles n_b : s² = Σ n_b (x_b - m)² / (B - 1), Var(m) = s² / N
+    const double n = static_cast<double>(m_histories);
+    const uint32_t index = flatIndex(energyBin, timeBin);
+    double mean = m_sum[index] / n;
+    double spread = m_sumSqOverN[index] - n * mean * mean;
+
+    return std::max(0.0, spread) / ((m_batches - 1) * n);
+}
+
+double BinnedTally::getRelativeError(uint32_t energyBin, uint32_t timeBin) const {
+    double mean = getMean(energyBin, timeBin);
+    if (mean <= 0.0) return 0.0;
+
+    return std::sqrt(getVarianceOfMean(energyBin, timeBin)) / mean;
+}
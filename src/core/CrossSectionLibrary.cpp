@@ -0,0 +1,549 @@
+#include "core/CrossSectionLibrary.h"
+#include "utils/BinaryIO.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace XsFormat;
+
+namespace {
+
+uint64_t alignUp(uint64_t value) {
+    return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+void requireLittleEndianHost() {
+    if constexpr (std::endian::native != std::endian::little) {
+        throw std::runtime_error("Format .rxs : hôte gros-boutiste non supporté");
+    }
+}
+
+float columnValue(const AttenuationData& data, uint32_t column) {
+    switch (column) {
+        case COLUMN_LINEAR: return data.linearCoeff;
+        case COLUMN_MASS: return data.massCoeff;
+        case COLUMN_CROSS_SECTION: return data.crossSection;
+        default: break;
+    }
+
+    switch (static_cast<InteractionChannel>(column - COLUMN_FIRST_CHANNEL)) {
+        case InteractionChannel::PHOTOELECTRIC: return data.photoelectric;
+        case InteractionChannel::COMPTON: return data.compton;
+        case InteractionChannel::PAIR: return data.pair;
+        case InteractionChannel::ELASTIC: return data.elastic;
+        case InteractionChannel::CAPTURE: return data.capture;
+    }
+    return 0.0f;
+}
+
+void setColumnValue(AttenuationData& data, uint32_t column, float value) {
+    switch (column) {
+        case COLUMN_LINEAR: data.linearCoeff = value; return;
+        case COLUMN_MASS: data.massCoeff = value; return;
+        case COLUMN_CROSS_SECTION: data.crossSection = value; return;
+        default: break;
+    }
+
+    switch (static_cast<InteractionChannel>(column - COLUMN_FIRST_CHANNEL)) {
+        case InteractionChannel::PHOTOELECTRIC: data.photoelectric = value; break;
+        case InteractionChannel::COMPTON: data.compton = value; break;
+        case InteractionChannel::PAIR: data.pair = value; break;
+        case InteractionChannel::ELASTIC: data.elastic = value; break;
+        case InteractionChannel::CAPTURE: data.capture = value; break;
+    }
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n\"");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n\"");
+    return text.substr(begin, end - begin + 1);
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+std::vector<std::string> splitFields(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string field;
+    for (char c : line) {
+        if (c == ',' || c == ';' || c == '\t') {
+            fields.push_back(trim(field));
+            field.clear();
+        } else {
+            field += c;
+        }
+    }
+    fields.push_back(trim(field));
+    return fields;
+}
+
+} // namespace
+
+// Écriture
+void CrossSectionLibrary::write(const std::string& filename, const std::vector<std::shared_ptr<Material>>& materials) {
+    requireLittleEndianHost();
+
+    // Grilles unionisées : tous les points d'énergie des matériaux, par type
+    std::map<RadiationType, std::vector<float>> grids;
+    for (const auto& material : materials) {
+        for (RadiationType type : material->getRadiationTypes()) {
+            auto& grid = grids[type];
+            for (const auto& data : *material->getAttenuationTable(type)) {
+                grid.push_back(data.energy);
+            }
+        }
+    }
+    std::map<RadiationType, uint32_t> gridIndices;
+    for (auto& [type, grid] : grids) {
+        std::sort(grid.begin(), grid.end());
+        grid.erase(std::unique(grid.begin(), grid.end()), grid.end());
+        gridIndices[type] = static_cast<uint32_t>(gridIndices.size());
+    }
+
+    ByteWriter writer;
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.endianTag = ENDIAN_TAG;
+    header.gridCount = static_cast<uint32_t>(grids.size());
+    header.materialCount = static_cast<uint32_t>(materials.size());
+    writer.reserve(sizeof(Header));
+
+    // Grilles
+    header.gridsOffset = writer.align(ALIGNMENT);
+    writer.reserve(sizeof(GridRecord) * grids.size());
+    uint32_t gridSlot = 0;
+    for (const auto& [type, grid] : grids) {
+        GridRecord record{};
+        record.radiationType = static_cast<uint32_t>(type);
+        record.pointCount = static_cast<uint32_t>(grid.size());
+        record.energiesOffset = writer.align(ALIGNMENT);
+        writer.append(grid.data(), grid.size() * sizeof(float));
+        writer.patch(header.gridsOffset + gridSlot++ * sizeof(GridRecord), record);
+    }
+
+    // Matériaux
+    header.materialsOffset = writer.align(ALIGNMENT);
+    writer.reserve(sizeof(MaterialRecord) * materials.size());
+    std::string strings;
+
+    for (size_t m = 0; m < materials.size(); ++m) {
+        const auto& material = *materials[m];
+        MaterialRecord record{};
+        record.nameOffset = strings.size();
+        record.nameLength = static_cast<uint32_t>(material.getName().size());
+        record.density = material.getDensity();
+        strings += material.getName();
+
+        const auto& composition = material.getComposition();
+        record.elementCount = static_cast<uint32_t>(composition.size());
+        record.elementsOffset = writer.align(ALIGNMENT);
+        for (const auto& element : composition) {
+            ElementRecord elementRecord{};
+            elementRecord.atomicNumber = element.atomicNumber;
+            elementRecord.massFraction = element.massFraction;
+            elementRecord.atomicMass = element.atomicMass;
+            // Enregistrement à zéro : le symbole reste terminé par un NUL
+            std::memcpy(elementRecord.symbol, element.symbol.data(),
+                        std::min(element.symbol.size(), sizeof(elementRecord.symbol) - 1));
+            writer.append(&elementRecord, sizeof(elementRecord));
+        }
+
+        auto types = material.getRadiationTypes();
+        record.tableCount = static_cast<uint32_t>(types.size());
+        record.tablesOffset = writer.align(ALIGNMENT);
+        writer.reserve(sizeof(TableRecord) * types.size());
+
+        for (size_t t = 0; t < types.size(); ++t) {
+            const auto& grid = grids[types[t]];
+            TableRecord table{};
+            table.radiationType = static_cast<uint32_t>(types[t]);
+            table.gridIndex = gridIndices[types[t]];
+            table.columnStride = alignUp(grid.size() * sizeof(float));
+
+            // Valeurs ramenées sur la grille unionisée (interpolation du matériau)
+            std::vector<AttenuationData> values;
+            values.reserve(grid.size());
+            for (float energy : grid) {
+                values.push_back(material.getAttenuationData(types[t], energy));
+            }
+
+            table.columnsOffset = writer.align(ALIGNMENT);
+            std::vector<float> column(table.columnStride / sizeof(float), 0.0f);
+            for (uint32_t c = 0; c < COLUMN_COUNT; ++c) {
+                for (size_t i = 0; i < values.size(); ++i) {
+                    column[i] = columnValue(values[i], c);
+                }
+                writer.append(column.data(), table.columnStride);
+            }
+
+            writer.patch(record.tablesOffset + t * sizeof(TableRecord), table);
+        }
+
+        writer.patch(header.materialsOffset + m * sizeof(MaterialRecord), record);
+    }
+
+    header.stringsOffset = writer.align(ALIGNMENT);
+    writer.append(strings.data(), strings.size());
+    header.fileSize = writer.align(ALIGNMENT);
+    writer.patch(0, header);
+
+    // Remplacement atomique : les processus ayant projeté l'ancien fichier ne sont pas affectés
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Impossible d'ouvrir le fichier pour écriture: " + temporary);
+        }
+        file.write(reinterpret_cast<const char*>(writer.bytes().data()),
+                   static_cast<std::streamsize>(writer.bytes().size()));
+        if (!file) {
+            throw std::runtime_error("Erreur d'écriture: " + temporary);
+        }
+    }
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Impossible de remplacer le fichier: " + filename);
+    }
+
+    Log::info("Bibliothèque de sections efficaces écrite: " + filename + " (" +
+              std::to_string(materials.size()) + " matériaux, " +
+              std::to_string(writer.bytes().size()) + " octets)");
+}
+
+// Lecture
+CrossSectionLibrary::CrossSectionLibrary(MappedFile file)
+    : m_file(std::move(file)) {
+    m_header = validate();
+}
+
+std::shared_ptr<const CrossSectionLibrary> CrossSectionLibrary::open(const std::string& filename) {
+    requireLittleEndianHost();
+    return std::shared_ptr<const CrossSectionLibrary>(new CrossSectionLibrary(MappedFile(filename)));
+}
+
+template <typename T>
+const T* CrossSectionLibrary::at(uint64_t offset, uint64_t count) const {
+    if (offset % alignof(T) != 0 || offset > m_file.size() ||
+        count > (m_file.size() - offset) / sizeof(T)) {
+        throw std::runtime_error("Bibliothèque .rxs corrompue (décalage hors fichier)");
+    }
+    return reinterpret_cast<const T*>(m_file.data() + offset);
+}
+
+const Header* CrossSectionLibrary::validate() const {
+    if (m_file.size() < sizeof(Header)) {
+        throw std::runtime_error("Bibliothèque .rxs tronquée");
+    }
+
+    auto header = at<Header>(0);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Fichier non reconnu comme bibliothèque .rxs");
+    }
+    if (header->endianTag != ENDIAN_TAG) {
+        throw std::runtime_error("Bibliothèque .rxs d'un boutisme incompatible");
+    }
+    if (header->version != VERSION) {
+        throw std::runtime_error("Version de bibliothèque .rxs non supportée: " + std::to_string(header->version));
+    }
+    if (header->fileSize != m_file.size()) {
+        throw std::runtime_error("Bibliothèque .rxs tronquée");
+    }
+
+    // Bornes de toutes les sections, une fois pour toutes
+    auto grids = at<GridRecord>(header->gridsOffset, header->gridCount);
+    for (uint32_t g = 0; g < header->gridCount; ++g) {
+        at<float>(grids[g].energiesOffset, grids[g].pointCount);
+    }
+
+    auto materials = at<MaterialRecord>(header->materialsOffset, header->materialCount);
+    for (uint32_t m = 0; m < header->materialCount; ++m) {
+        const auto& record = materials[m];
+        materialName(*header, record);
+        at<ElementRecord>(record.elementsOffset, record.elementCount);
+
+        auto tables = at<TableRecord>(record.tablesOffset, record.tableCount);
+        for (uint32_t t = 0; t < record.tableCount; ++t) {
+            // Produit borné avant calcul : un pas de colonne forgé ne doit pas reboucler
+            if (tables[t].gridIndex >= header->gridCount ||
+                tables[t].columnStride < grids[tables[t].gridIndex].pointCount * sizeof(float) ||
+                tables[t].columnsOffset > m_file.size() ||
+                tables[t].columnStride > (m_file.size() - tables[t].columnsOffset) / COLUMN_COUNT) {
+                throw std::runtime_error("Bibliothèque .rxs corrompue (table invalide)");
+            }
+            at<uint8_t>(tables[t].columnsOffset, tables[t].columnStride * COLUMN_COUNT);
+        }
+    }
+
+    return header;
+}
+
+const char* CrossSectionLibrary::materialName(const Header& header, const MaterialRecord& record) const {
+    if (header.stringsOffset > m_file.size() || record.nameOffset > m_file.size() - header.stringsOffset) {
+        throw std::runtime_error("Bibliothèque .rxs corrompue (décalage hors fichier)");
+    }
+    return at<char>(header.stringsOffset + record.nameOffset, record.nameLength);
+}
+
+const MaterialRecord& CrossSectionLibrary::materialRecord(uint32_t index) const {
+    if (index >= m_header->materialCount) {
+        throw std::out_of_range("Indice de matériau hors bibliothèque");
+    }
+    return at<MaterialRecord>(m_header->materialsOffset, m_header->materialCount)[index];
+}
+
+const GridRecord* CrossSectionLibrary::findGrid(RadiationType type, uint32_t* gridIndex) const {
+    auto grids = at<GridRecord>(m_header->gridsOffset, m_header->gridCount);
+    for (uint32_t g = 0; g < m_header->gridCount; ++g) {
+        if (grids[g].radiationType == static_cast<uint32_t>(type)) {
+            if (gridIndex) *gridIndex = g;
+            return &grids[g];
+        }
+    }
+    return nullptr;
+}
+
+std::string CrossSectionLibrary::getMaterialName(uint32_t index) const {
+    const auto& record = materialRecord(index);
+    return std::string(materialName(*m_header, record), record.nameLength);
+}
+
+int CrossSectionLibrary::findMaterial(const std::string& name) const {
+    for (uint32_t m = 0; m < m_header->materialCount; ++m) {
+        if (getMaterialName(m) == name) return static_cast<int>(m);
+    }
+    return -1;
+}
+
+const float* CrossSectionLibrary::getEnergyGrid(RadiationType type, uint32_t& pointCount) const {
+    const GridRecord* grid = findGrid(type);
+    pointCount = grid ? grid->pointCount : 0;
+    return grid ? at<float>(grid->energiesOffset, grid->pointCount) : nullptr;
+}
+
+const float* CrossSectionLibrary::getColumn(uint32_t material, RadiationType type, uint32_t column) const {
+    if (column >= COLUMN_COUNT) return nullptr;
+
+    const auto& record = materialRecord(material);
+    auto tables = at<TableRecord>(record.tablesOffset, record.tableCount);
+    for (uint32_t t = 0; t < record.tableCount; ++t) {
+        if (tables[t].radiationType == static_cast<uint32_t>(type)) {
+            return at<float>(tables[t].columnsOffset + column * tables[t].columnStride);
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<Material> CrossSectionLibrary::createMaterial(uint32_t index) const {
+    const auto& record = materialRecord(index);
+    auto material = std::make_shared<Material>(getMaterialName(index), record.density);
+
+    auto elements = at<ElementRecord>(record.elementsOffset, record.elementCount);
+    for (uint32_t e = 0; e < record.elementCount; ++e) {
+        std::string symbol(elements[e].symbol, strnlen(elements[e].symbol, sizeof(elements[e].symbol)));
+        material->addElement(elements[e].atomicNumber, symbol, elements[e].massFraction, elements[e].atomicMass);
+    }
+
+    auto tables = at<TableRecord>(record.tablesOffset, record.tableCount);
+    auto grids = at<GridRecord>(m_header->gridsOffset, m_header->gridCount);
+    for (uint32_t t = 0; t < record.tableCount; ++t) {
+        const auto& table = tables[t];
+        const auto& grid = grids[table.gridIndex];
+        const float* energies = at<float>(grid.energiesOffset, grid.pointCount);
+
+        RadiationType type = static_cast<RadiationType>(table.radiationType);
+        for (uint32_t i = 0; i < grid.pointCount; ++i) {
+            AttenuationData data;
+            data.energy = energies[i];
+            for (uint32_t c = 0; c < COLUMN_COUNT; ++c) {
+                setColumnValue(data, c, at<float>(table.columnsOffset + c * table.columnStride)[i]);
+            }
+            material->addAttenuationData(type, data);
+        }
+    }
+
+    material->finalize();
+    return material;
+}
+
+// Conversion CSV (type NIST XCOM)
+// En-têtes de commentaires : "# name: ...", "# density: ...", "# element: Z Symbole fraction A",
+// "# radiation: GAMMA", "# units: cm2/g | barns" ; puis une ligne d'en-tête de colonnes
+// (énergie en MeV par défaut, keV ou eV si indiqué) et les lignes de données.
+std::shared_ptr<Material> CrossSectionLibrary::importCsv(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour lecture: " + filename);
+    }
+
+    std::string name = filename;
+    float density = 0.0f;
+    RadiationType type = RadiationType::GAMMA;
+    bool barns = false;
+    std::vector<ElementComposition> elements;
+
+    enum class Column { IGNORED, ENERGY, PHOTOELECTRIC, COMPTON, PAIR, ELASTIC, CAPTURE, TOTAL };
+    std::vector<Column> columns;
+    float energyScale = 1000.0f; // MeV → keV
+    std::vector<AttenuationData> rows;
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::string content = trim(line);
+        if (content.empty()) continue;
+
+        if (content[0] == '#') {
+            size_t colon = content.find(':');
+            if (colon == std::string::npos) continue;
+            std::string key = toLower(trim(content.substr(1, colon - 1)));
+            std::string value = trim(content.substr(colon + 1));
+
+            if (key == "name") {
+                name = value;
+            } else if (key == "density") {
+                density = std::stof(value);
+            } else if (key == "radiation") {
+                if (!parseRadiationType(value, type)) {
+                    throw std::runtime_error("Type de rayonnement inconnu ligne " + std::to_string(lineNumber));
+                }
+            } else if (key == "units") {
+                barns = toLower(value).find("barn") != std::string::npos;
+            } else if (key == "element") {
+                ElementComposition element;
+                std::istringstream stream(value);
+                stream >> element.atomicNumber >> element.symbol >> element.massFraction >> element.atomicMass;
+                if (!stream) {
+                    throw std::runtime_error("Élément invalide ligne " + std::to_string(lineNumber));
+                }
+                elements.push_back(element);
+            }
+            continue;
+        }
+
+        auto fields = splitFields(content);
+        if (columns.empty()) {
+            // En-tête de colonnes
+            for (const auto& field : fields) {
+                std::string header = toLower(field);
+                if (header.find("energy") != std::string::npos || header.find("énergie") != std::string::npos) {
+                    columns.push_back(Column::ENERGY);
+                    if (header.find("kev") != std::string::npos) {
+                        energyScale = 1.0f;
+                    } else if (header.find("ev") != std::string::npos && header.find("mev") == std::string::npos) {
+                        energyScale = 0.001f;
+                    }
+                } else if (header.find("incoherent") != std::string::npos || header.find("compton") != std::string::npos) {
+                    columns.push_back(Column::COMPTON);
+                } else if (header.find("coherent") != std::string::npos) {
+                    // Rayleigh : très piquée vers l'avant, négligée comme dans μ « sans cohérente »
+                    columns.push_back(Column::IGNORED);
+                } else if (header.find("photo") != std::string::npos) {
+                    columns.push_back(Column::PHOTOELECTRIC);
+                } else if (header.find("pair") != std::string::npos) {
+                    columns.push_back(Column::PAIR); // Champs nucléaire et électronique cumulés
+                } else if (header.find("elastic") != std::string::npos) {
+                    columns.push_back(Column::ELASTIC);
+                } else if (header.find("capture") != std::string::npos) {
+                    columns.push_back(Column::CAPTURE);
+                } else if (header.find("total") != std::string::npos &&
+                           header.find("w/ coherent") == std::string::npos) {
+                    columns.push_back(Column::TOTAL);
+                } else {
+                    columns.push_back(Column::IGNORED);
+                }
+            }
+            if (std::find(columns.begin(), columns.end(), Column::ENERGY) == columns.end()) {
+                throw std::runtime_error("Colonne d'énergie absente: " + filename);
+            }
+            continue;
+        }
+
+        AttenuationData row;
+        float total = 0.0f;
+        for (size_t i = 0; i < fields.size() && i < columns.size(); ++i) {
+            if (columns[i] == Column::IGNORED || fields[i].empty()) continue;
+            float value;
+            try {
+                value = std::stof(fields[i]);
+            } catch (const std::exception&) {
+                throw std::runtime_error("Valeur invalide ligne " + std::to_string(lineNumber) + ": " + fields[i]);
+            }
+
+            switch (columns[i]) {
+                case Column::ENERGY: row.energy = value * energyScale; break;
+                case Column::PHOTOELECTRIC: row.photoelectric = value; break;
+                case Column::COMPTON: row.compton = value; break;
+                case Column::PAIR: row.pair += value; break;
+                case Column::ELASTIC: row.elastic = value; break;
+                case Column::CAPTURE: row.capture = value; break;
+                case Column::TOTAL: total = value; break;
+                case Column::IGNORED: break;
+            }
+        }
+        row.massCoeff = row.partialSum() > 0.0f ? row.partialSum() : total;
+        if (row.energy <= 0.0f) continue;
+
+        // Seuil d'absorption (énergie répétée) : le point sous le seuil est décalé d'un ulp
+        if (!rows.empty() && row.energy == rows.back().energy) {
+            rows.back().energy = std::nextafter(row.energy, 0.0f);
+        }
+        rows.push_back(row);
+    }
+
+    if (rows.empty()) {
+        throw std::runtime_error("Aucune donnée dans: " + filename);
+    }
+    if (density <= 0.0f) {
+        throw std::runtime_error("Densité manquante (# density:) dans: " + filename);
+    }
+
+    auto material = std::make_shared<Material>(name, density);
+    double atomsPerGram = 0.0; // Σ w / A · N_A
+    for (const auto& element : elements) {
+        material->addElement(element.atomicNumber, element.symbol, element.massFraction, element.atomicMass);
+        if (element.atomicMass > 0.0f) {
+            atomsPerGram += element.massFraction / element.atomicMass * Physics::AVOGADRO;
+        }
+    }
+
+    // Barns par atome → cm²/g (section moyenne sur la composition)
+    if (barns) {
+        if (atomsPerGram <= 0.0) {
+            throw std::runtime_error("Composition requise pour convertir des barns: " + filename);
+        }
+        float toMass = static_cast<float>(atomsPerGram * 1e-24);
+        for (auto& row : rows) {
+            row.crossSection = row.massCoeff;
+            row.massCoeff *= toMass;
+            row.photoelectric *= toMass;
+            row.compton *= toMass;
+            row.pair *= toMass;
+            row.elastic *= toMass;
+            row.capture *= toMass;
+        }
+    }
+
+    // Partielles stockées en cm⁻¹ comme μ
+    for (auto& row : rows) {
+        row.linearCoeff = row.massCoeff * density;
+        row.photoelectric *= density;
+        row.compton *= density;
+        row.pair *= density;
+        row.elastic *= density;
+        row.capture *= density;
+        material->addAttenuationData(type, row);
+    }
+
+    material->finalize();
+    Log::info("Table importée: " + name + " (" + std::to_string(rows.size()) + " points) depuis " + filename);
+    return material;
+}
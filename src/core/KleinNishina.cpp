@@ -0,0 +1,100 @@
+#include "core/KleinNishina.h"
+#include <algorithm>
+
+const KleinNishina& KleinNishina::getInstance() {
+    static const KleinNishina instance;
+    return instance;
+}
+
+KleinNishina::KleinNishina() {
+    m_logMinEnergy = std::log(MIN_ENERGY);
+    m_invLogStep = (ENERGY_POINTS - 1) / (std::log(MAX_ENERGY) - m_logMinEnergy);
+    m_inverseCdf.resize(static_cast<size_t>(ENERGY_POINTS) * CDF_POINTS);
+
+    // CDF en cos θ par intégration trapézoïdale fine, puis inversion aux nœuds ξ
+    const uint32_t integrationPoints = 8192;
+    std::vector<double> mu(integrationPoints);
+    std::vector<double> cdf(integrationPoints);
+
+    for (uint32_t e = 0; e < ENERGY_POINTS; ++e) {
+        float energy = std::exp(m_logMinEnergy + e / m_invLogStep);
+
+        cdf[0] = 0.0;
+        mu[0] = -1.0;
+        double previous = differentialCrossSection(energy, -1.0f);
+        for (uint32_t i = 1; i < integrationPoints; ++i) {
+            mu[i] = -1.0 + 2.0 * i / (integrationPoints - 1);
+            double current = differentialCrossSection(energy, static_cast<float>(mu[i]));
+            cdf[i] = cdf[i - 1] + 0.5 * (previous + current) * (mu[i] - mu[i - 1]);
+            previous = current;
+        }
+
+        const double total = cdf.back();
+        float* row = &m_inverseCdf[static_cast<size_t>(e) * CDF_POINTS];
+        uint32_t i = 1;
+        for (uint32_t k = 0; k < CDF_POINTS; ++k) {
+            double target = total * k / (CDF_POINTS - 1);
+            while (i < integrationPoints - 1 && cdf[i] < target) ++i;
+
+            double span = cdf[i] - cdf[i - 1];
+            double t = span > 0.0 ? (target - cdf[i - 1]) / span : 0.0;
+            row[k] = static_cast<float>(std::clamp(mu[i - 1] + t * (mu[i] - mu[i - 1]), -1.0, 1.0));
+        }
+        row[0] = -1.0f;
+        row[CDF_POINTS - 1] = 1.0f;
+    }
+}
+
+float KleinNishina::sampleCosTheta(float energy) const {
+    return sampleCosTheta(energy, RandomGenerator::random(), RandomGenerator::random());
+}
+
+float KleinNishina::sampleCosTheta(float energy, float xiRow, float xi) const {
+    // Ligne d'énergie choisie aléatoirement entre les deux voisines (pas de mélange de CDF)
+    float position = (std::log(std::clamp(energy, MIN_ENERGY, MAX_ENERGY)) - m_logMinEnergy) * m_invLogStep;
+    uint32_t lower = std::min(static_cast<uint32_t>(position), ENERGY_POINTS - 2);
+    uint32_t row = xiRow < position - lower ? lower + 1 : lower;
+
+    float u = xi * (CDF_POINTS - 1);
+    uint32_t k = std::min(static_cast<uint32_t>(u), CDF_POINTS - 2);
+    float t = u - k;
+
+    const float* values = &m_inverseCdf[static_cast<size_t>(row) * CDF_POINTS];
+    return values[k] + t * (values[k + 1] - values[k]);
+}
+
+void KleinNishina::sampleBatch(const float* energies, float* cosTheta, float* scatteredEnergies, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        cosTheta[i] = sampleCosTheta(energies[i]);
+        scatteredEnergies[i] = scatteredEnergy(energies[i], cosTheta[i]);
+    }
+}
+
+float KleinNishina::scatteredEnergy(float energy, float cosTheta) {
+    float k = energy / static_cast<float>(Physics::ELECTRON_MASS_KEV);
+    return energy / (1.0f + k * (1.0f - cosTheta));
+}
+
+double KleinNishina::differentialCrossSection(float energy, float cosTheta) {
+    double ratio = scatteredEnergy(energy, cosTheta) / energy; // E'/E
+    double sin2 = 1.0 - static_cast<double>(cosTheta) * cosTheta;
+    return 0.5 * ratio * ratio * (ratio + 1.0 / ratio - sin2);
+}
+
+double KleinNishina::totalCrossSectionRatio(float energy) {
+    double k = energy / Physics::ELECTRON_MASS_KEV;
+    if (k < 1e-3) {
+        return 1.0 - 2.0 * k + 5.2 * k * k; // Limite de Thomson
+    }
+
+    double l = std::log(1.0 + 2.0 * k);
+    double sigma = (1.0 + k) / (k * k) * (2.0 * (1.0 + k) / (1.0 + 2.0 * k) - l / k) + l / (2.0 * k) -
+                   (1.0 + 3.0 * k) / ((1.0 + 2.0 * k) * (1.0 + 2.0 * k));
+    return 0.75 * sigma; // σ_Thomson = 8π/3 r_e²
+}
+
+double KleinNishina::angularPdf(float energy, float cosTheta) {
+    // (dσ/dΩ) / σ avec σ = (8π/3) r_e² × rapport
+    double total = (8.0 * PI / 3.0) * totalCrossSectionRatio(energy);
+    return differentialCrossSection(energy, cosTheta) / total;
+}
@@ -1,5 +1,8 @@
 #include "utils/Random.h"
 #include "core/Material.h"
+#include "core/KleinNishina.h"
+#include "core/CrossSectionLibrary.h"
+#include "core/StoppingPower.h"
 #include <algorithm>
 #include <fstream>
 // #include <json/json.h> // Pas nécessaire pour la démo
@@ -44,6 +47,52 @@ void Material::addAttenuationData(RadiationType type, float energy,
         });
     
     table.insert(it, data);
+    m_finalized = false;
+}
+
+void Material::addAttenuationData(RadiationType type, const AttenuationData& data) {
+    auto& table = m_attenuationTables[type];
+
+    // Ordre d'insertion conservé à énergie égale (seuils d'absorption)
+    auto it = std::upper_bound(table.begin(), table.end(), data,
+        [](const AttenuationData& a, const AttenuationData& b) {
+            return a.energy < b.energy;
+        });
+
+    table.insert(it, data);
+    m_finalized = false;
+}
+
+const std::vector<AttenuationData>* Material::getAttenuationTable(RadiationType type) const {
+    auto it = m_attenuationTables.find(type);
+    return it != m_attenuationTables.end() ? &it->second : nullptr;
+}
+
+std::vector<RadiationType> Material::getRadiationTypes() const {
+    std::vector<RadiationType> types;
+    for (const auto& pair : m_attenuationTables) {
+        types.push_back(pair.first);
+    }
+    return types;
+}
+
+AttenuationData Material::getAttenuationData(RadiationType type, float energy) const {
+    AttenuationData data;
+    data.energy = energy;
+
+    auto it = m_attenuationTables.find(type);
+    if (it == m_attenuationTables.end()) return data;
+
+    const auto& table = it->second;
+    data.linearCoeff = interpolateAttenuation(table, energy, [](const AttenuationData& d) { return d.linearCoeff; });
+    data.massCoeff = interpolateAttenuation(table, energy, [](const AttenuationData& d) { return d.massCoeff; });
+    data.crossSection = interpolateAttenuation(table, energy, [](const AttenuationData& d) { return d.crossSection; });
+    data.photoelectric = interpolateAttenuation(table, energy, [](const AttenuationData& d) { return d.photoelectric; });
+    data.compton = interpolateAttenuation(table, energy, [](const AttenuationData& d) { return d.compton; });
+    data.pair = interpolateAttenuation(table, energy, [](const AttenuationData& d) { return d.pair; });
+    data.elastic = interpolateAttenuation(table, energy, [](const AttenuationData& d) { return d.elastic; });
+    data.capture = interpolateAttenuation(table, energy, [](const AttenuationData& d) { return d.capture; });
+    return data;
 }
 
 float Material::getLinearAttenuation(RadiationType type, float energy) const {
@@ -73,6 +122,27 @@ float Material::getLinearAttenuationPerMeter(RadiationType type, float energy) c
     return linearCmInv * 100.0f; // m^-1
 }
 
+float Material::getMinimumAttenuationPerMeter(RadiationType type, float energy) const {
+    auto table = m_attenuationTables.find(type);
+    if (table == m_attenuationTables.end() || table->second.empty()) return 0.0f;
+
+    // L'interpolation log-log est monotone entre deux points : le minimum jusqu'au premier
+    // point d'énergie supérieure ou égale minore μ sur tout l'intervalle
+    const auto& points = table->second;
+    size_t last = std::lower_bound(points.begin(), points.end(), energy,
+        [](const AttenuationData& data, float e) { return data.energy < e; }) - points.begin();
+    last = std::min(last, points.size() - 1);
+
+    auto minimum = m_minimumAttenuation.find(type);
+    if (m_finalized && minimum != m_minimumAttenuation.end()) return minimum->second[last];
+
+    float mu = std::numeric_limits<float>::max();
+    for (size_t i = 0; i <= last; ++i) {
+        mu = std::min(mu, getLinearAttenuationPerMeter(type, points[i].energy));
+    }
+    return mu;
+}
+
 float Material::getCrossSection(RadiationType type, float energy) const {
     auto it = m_attenuationTables.find(type);
     if (it == m_attenuationTables.end()) return 0.0f;
@@ -94,7 +164,7 @@ float Material::interpolateAttenuation(const std::vector<AttenuationData>& table
     auto it = std::lower_bound(table.begin(), table.end(), energy,
         [](const AttenuationData& data, float e) { return data.energy < e; });
     
-    if (it == table.begin()) return getter(*it);
+    if (it == table.begin() || it->energy == energy) return getter(*it);
     
     auto it1 = it - 1;
     auto it2 = it;
@@ -113,6 +183,7 @@ float Material::interpolateAttenuation(const std::vector<AttenuationData>& table
         float logV1 = std::log(v1), logV2 = std::log(v2);
         float logE = std::log(energy);
         
+        if (logE2 <= logE1) return v2; // Points confondus (seuil d'absorption)
         float t = (logE - logE1) / (logE2 - logE1);
         float logV = logV1 + t * (logV2 - logV1);
         return std::exp(logV);
@@ -120,25 +191,377 @@ float Material::interpolateAttenuation(const std::vector<AttenuationData>& table
 }
 
 InteractionType Material::sampleInteraction(RadiationType type, float energy) const {
-    // Probabilités d'interaction simplifiées
-    float mu = getLinearAttenuation(type, energy);
-    if (mu <= 0.0f) return InteractionType::TRANSMISSION;
-    
+    if (m_attenuationTables.find(type) == m_attenuationTables.end()) {
+        return InteractionType::TRANSMISSION;
+    }
+
+    return channelOutcome(sampleChannel(type, energy));
+}
+
+InteractionChannel Material::sampleChannel(RadiationType type, float energy) const {
+    if (const ChannelAliasBin* bin = findAliasBin(type, energy)) {
+        float u = RandomGenerator::random() * INTERACTION_CHANNEL_COUNT;
+        uint32_t column = std::min(static_cast<uint32_t>(u), INTERACTION_CHANNEL_COUNT - 1);
+        uint32_t channel = (u - column) < bin->threshold[column] ? column : bin->alias[column];
+        return static_cast<InteractionChannel>(channel);
+    }
+
+    // Matériau non finalisé : inversion directe de la répartition
+    float probabilities[INTERACTION_CHANNEL_COUNT];
+    channelProbabilities(type, energy, probabilities);
+
     float r = RandomGenerator::random();
-    
+    for (uint32_t i = 0; i + 1 < INTERACTION_CHANNEL_COUNT; ++i) {
+        if (r < probabilities[i]) return static_cast<InteractionChannel>(i);
+        r -= probabilities[i];
+    }
+    return static_cast<InteractionChannel>(INTERACTION_CHANNEL_COUNT - 1);
+}
+
+InteractionType Material::channelOutcome(InteractionChannel channel) {
+    switch (channel) {
+        case InteractionChannel::COMPTON:
+        case InteractionChannel::ELASTIC:
+            return InteractionType::SCATTERING;
+        case InteractionChannel::CAPTURE:
+            return InteractionType::CAPTURE;
+        case InteractionChannel::PHOTOELECTRIC:
+        case InteractionChannel::PAIR:
+        default:
+            // Les secondaires (fluorescence, annihilation) sont émis par le moteur
+            return InteractionType::ABSORPTION;
+    }
+}
+
+float Material::getScatteringProbability(RadiationType type, float energy) const {
+    if (const ChannelAliasBin* bin = findAliasBin(type, energy)) {
+        return bin->scatteringProbability;
+    }
+
+    float probabilities[INTERACTION_CHANNEL_COUNT];
+    channelProbabilities(type, energy, probabilities);
+    return probabilities[static_cast<int>(InteractionChannel::COMPTON)] +
+           probabilities[static_cast<int>(InteractionChannel::ELASTIC)];
+}
+
+void Material::defaultChannelProbabilities(RadiationType type, float* probabilities) {
+    std::fill(probabilities, probabilities + INTERACTION_CHANNEL_COUNT, 0.0f);
+    auto set = [probabilities](InteractionChannel channel, float p) {
+        probabilities[static_cast<int>(channel)] = p;
+    };
+
+    // Répartitions historiques, conservées faute de données partielles
     switch (type) {
         case RadiationType::GAMMA:
-            if (r < 0.7f) return InteractionType::SCATTERING; // Compton
-            else return InteractionType::ABSORPTION; // Photoélectrique
-            
+            set(InteractionChannel::COMPTON, 0.7f);
+            set(InteractionChannel::PHOTOELECTRIC, 0.3f);
+            break;
+        case RadiationType::X_RAY:
+            set(InteractionChannel::COMPTON, 0.8f);
+            set(InteractionChannel::PHOTOELECTRIC, 0.2f);
+            break;
         case RadiationType::NEUTRON:
-            if (r < 0.5f) return InteractionType::SCATTERING;
-            else return InteractionType::CAPTURE;
-            
+            set(InteractionChannel::ELASTIC, 0.5f);
+            set(InteractionChannel::CAPTURE, 0.5f);
+            break;
         default:
-            if (r < 0.8f) return InteractionType::SCATTERING;
-            else return InteractionType::ABSORPTION;
+            set(InteractionChannel::ELASTIC, 0.8f);
+            set(InteractionChannel::PHOTOELECTRIC, 0.2f);
+            break;
+    }
+}
+
+void Material::channelProbabilities(RadiationType type, float energy, float* probabilities) const {
+    auto it = m_attenuationTables.find(type);
+    if (it == m_attenuationTables.end() || it->second.empty()) {
+        defaultChannelProbabilities(type, probabilities);
+        return;
+    }
+
+    const auto& table = it->second;
+    static const std::function<float(const AttenuationData&)> getters[INTERACTION_CHANNEL_COUNT] = {
+        [](const AttenuationData& d) { return d.photoelectric; },
+        [](const AttenuationData& d) { return d.compton; },
+        [](const AttenuationData& d) { return d.pair; },
+        [](const AttenuationData& d) { return d.elastic; },
+        [](const AttenuationData& d) { return d.capture; },
+    };
+
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < INTERACTION_CHANNEL_COUNT; ++i) {
+        probabilities[i] = std::max(0.0f, interpolateAttenuation(table, energy, getters[i]));
+        sum += probabilities[i];
+    }
+
+    if (sum <= 0.0f) {
+        defaultChannelProbabilities(type, probabilities);
+        return;
+    }
+
+    for (uint32_t i = 0; i < INTERACTION_CHANNEL_COUNT; ++i) {
+        probabilities[i] /= sum;
+    }
+}
+
+Material::ChannelAliasBin Material::buildAliasBin(const float* probabilities) {
+    // Méthode de Vose : cases de hauteur n p_i, les excédents comblent les déficits
+    ChannelAliasBin bin{};
+    float scaled[INTERACTION_CHANNEL_COUNT];
+    uint8_t small[INTERACTION_CHANNEL_COUNT], large[INTERACTION_CHANNEL_COUNT];
+    uint32_t smallCount = 0, largeCount = 0;
+
+    for (uint32_t i = 0; i < INTERACTION_CHANNEL_COUNT; ++i) {
+        scaled[i] = probabilities[i] * INTERACTION_CHANNEL_COUNT;
+        bin.alias[i] = static_cast<uint8_t>(i);
+        if (scaled[i] < 1.0f) {
+            small[smallCount++] = static_cast<uint8_t>(i);
+        } else {
+            large[largeCount++] = static_cast<uint8_t>(i);
+        }
+    }
+
+    while (smallCount > 0 && largeCount > 0) {
+        uint8_t s = small[--smallCount];
+        uint8_t l = large[--largeCount];
+        bin.threshold[s] = scaled[s];
+        bin.alias[s] = l;
+        scaled[l] -= 1.0f - scaled[s];
+        if (scaled[l] < 1.0f) {
+            small[smallCount++] = l;
+        } else {
+            large[largeCount++] = l;
+        }
+    }
+
+    // Reliquats d'arrondi : cases pleines
+    while (largeCount > 0) bin.threshold[large[--largeCount]] = 1.0f;
+    while (smallCount > 0) bin.threshold[small[--smallCount]] = 1.0f;
+
+    bin.scatteringProbability = probabilities[static_cast<int>(InteractionChannel::COMPTON)] +
+                                probabilities[static_cast<int>(InteractionChannel::ELASTIC)];
+    return bin;
+}
+
+void Material::finalize() {
+    m_channelTables.clear();
+    m_minimumAttenuation.clear();
+    buildStoppingPowerTables();
+
+    for (const auto& [type, table] : m_attenuationTables) {
+        if (table.empty()) continue;
+
+        std::vector<float> minimum(table.size());
+        for (size_t i = 0; i < table.size(); ++i) {
+            float mu = getLinearAttenuationPerMeter(type, table[i].energy);
+            minimum[i] = i > 0 ? std::min(minimum[i - 1], mu) : mu;
+        }
+        m_minimumAttenuation[type] = std::move(minimum);
+
+        ChannelTable channels;
+        channels.energies.reserve(table.size());
+        for (const auto& data : table) {
+            channels.energies.push_back(data.energy);
+        }
+
+        // Intervalle k : [E(k-1), E(k)[, répartition prise au milieu logarithmique ;
+        // les deux intervalles extrêmes reprennent les points de bord
+        float probabilities[INTERACTION_CHANNEL_COUNT];
+        channels.bins.reserve(table.size() + 1);
+        for (size_t k = 0; k <= table.size(); ++k) {
+            float energy;
+            if (k == 0) {
+                energy = table.front().energy;
+            } else if (k == table.size()) {
+                energy = table.back().energy;
+            } else {
+                energy = std::sqrt(std::max(table[k - 1].energy, 1e-6f) * table[k].energy);
+            }
+            channelProbabilities(type, energy, probabilities);
+            channels.bins.push_back(buildAliasBin(probabilities));
+        }
+
+        m_channelTables[type] = std::move(channels);
+    }
+
+    m_finalized = true;
+}
+
+void Material::buildStoppingPowerTables() {
+    m_stoppingTables.clear();
+    if (m_composition.empty() || m_density <= 0.0f) return;
+
+    for (RadiationType type : {RadiationType::BETA, RadiationType::ALPHA, RadiationType::MUON}) {
+        auto table = std::make_shared<StoppingPowerTable>(m_composition, m_density, type);
+        if (table->isValid()) m_stoppingTables[type] = std::move(table);
+    }
+}
+
+const StoppingPowerTable* Material::getStoppingPowerTable(RadiationType type) const {
+    auto it = m_stoppingTables.find(type);
+    return it != m_stoppingTables.end() ? it->second.get() : nullptr;
+}
+
+const Material::ChannelAliasBin* Material::findAliasBin(RadiationType type, float energy) const {
+    if (!m_finalized) return nullptr;
+
+    auto it = m_channelTables.find(type);
+    if (it == m_channelTables.end()) return nullptr;
+
+    const auto& energies = it->second.energies;
+    size_t k = std::upper_bound(energies.begin(), energies.end(), energy) - energies.begin();
+    return &it->second.bins[k];
+}
+
+namespace {
+
+// Modèles simplifiés par atome (barns), servant uniquement aux proportions entre voies
+constexpr double THOMSON_CROSS_SECTION = 0.6652; // barns
+constexpr double ALPHA_RE2 = 5.795e-4;            // α r_e² (barns)
+
+double photoelectricPerAtom(int Z, float energy) {
+    // τ ∝ Z^4.5 E^-3, adouci en E^-1.5 au-delà de 500 keV ; calé sur l'eau à 100 keV
+    double zTerm = std::pow(static_cast<double>(Z), 4.5);
+    double e = std::max(1.0, static_cast<double>(energy));
+    double shape = e <= 500.0 ? std::pow(e / 100.0, -3.0)
+                              : std::pow(5.0, -3.0) * std::pow(e / 500.0, -1.5);
+    return 7.2e-6 * zTerm * shape;
+}
+
+double pairPerAtom(int Z, float energy) {
+    // Bethe-Heitler sans écrantage, forme de seuil en ((k - 2) / k)³
+    double k = energy / Physics::ELECTRON_MASS_KEV;
+    if (k <= 2.0) return 0.0;
+
+    double threshold = (TWO_PI / 3.0) * std::pow((k - 2.0) / k, 3.0);
+    double asymptotic = (28.0 / 9.0) * std::log(2.0 * k) - 218.0 / 27.0;
+    return ALPHA_RE2 * Z * (Z + 1.0) * std::max(threshold, asymptotic);
+}
+
+// Données atomiques et nucléaires des émissions secondaires (éléments des matériaux courants).
+// Raies K : seuil, Kα (moyenne pondérée Kα1/Kα2), Kβ, rendement de fluorescence ω_K.
+// Capture radiative : section thermique (barns) et raie prompte principale, seule émise
+// (les cascades sont ramenées à un photon ; le reste est déposé sur place).
+struct SecondaryData {
+    int atomicNumber;
+    float kEdge, kAlpha, kBeta; // keV
+    float kBetaFraction;
+    float fluorescenceYield;
+    float captureCrossSection;  // barns
+    float captureGamma;         // keV
+};
+
+constexpr SecondaryData SECONDARY_DATA[] = {
+    {1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.332f, 2223.2f},
+    {6, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0035f, 4945.3f},
+    {7, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.075f, 10829.1f},
+    {8, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.00019f, 870.7f},
+    {13, 1.560f, 1.487f, 1.557f, 0.02f, 0.04f, 0.231f, 7724.0f},
+    {14, 1.839f, 1.740f, 1.836f, 0.03f, 0.05f, 0.171f, 3539.0f},
+    {18, 3.206f, 2.957f, 3.190f, 0.10f, 0.12f, 0.66f, 167.3f},
+    {20, 4.038f, 3.691f, 4.013f, 0.12f, 0.16f, 0.43f, 1942.7f},
+    {26, 7.112f, 6.400f, 7.058f, 0.12f, 0.35f, 2.56f, 7631.1f},
+    {29, 8.979f, 8.041f, 8.905f, 0.12f, 0.44f, 3.78f, 7915.6f},
+    {74, 69.525f, 59.000f, 67.240f, 0.22f, 0.95f, 18.3f, 6190.8f},
+    {82, 88.005f, 74.250f, 84.940f, 0.22f, 0.96f, 0.171f, 7367.8f},
+};
+
+const SecondaryData* findSecondaryData(int Z) {
+    for (const auto& data : SECONDARY_DATA) {
+        if (data.atomicNumber == Z) return &data;
     }
+    return nullptr;
+}
+
+} // namespace
+
+float Material::sampleFluorescence(float photonEnergy) const {
+    // Élément absorbeur tiré selon sa part de la section photoélectrique
+    double total = 0.0;
+    for (const auto& element : m_composition) {
+        if (element.atomicMass <= 0.0f) continue;
+        total += element.massFraction / element.atomicMass * photoelectricPerAtom(element.atomicNumber, photonEnergy);
+    }
+    if (total <= 0.0) return 0.0f;
+
+    double r = RandomGenerator::random() * total;
+    const ElementComposition* absorber = nullptr;
+    for (const auto& element : m_composition) {
+        if (element.atomicMass <= 0.0f) continue;
+        absorber = &element;
+        r -= element.massFraction / element.atomicMass * photoelectricPerAtom(element.atomicNumber, photonEnergy);
+        if (r < 0.0) break;
+    }
+
+    const SecondaryData* data = absorber ? findSecondaryData(absorber->atomicNumber) : nullptr;
+    if (!data || data->fluorescenceYield <= 0.0f || photonEnergy <= data->kEdge) return 0.0f;
+
+    // Absorption en couche K : (J - 1) / J, rapport de saut J ≈ 125/Z + 3.5
+    float jump = 125.0f / data->atomicNumber + 3.5f;
+    if (RandomGenerator::random() >= (jump - 1.0f) / jump) return 0.0f;
+    if (RandomGenerator::random() >= data->fluorescenceYield) return 0.0f; // Électron Auger
+    return RandomGenerator::random() < data->kBetaFraction ? data->kBeta : data->kAlpha;
+}
+
+float Material::sampleCaptureGamma() const {
+    // Noyau capteur tiré selon atomes × section de capture thermique
+    double total = 0.0;
+    for (const auto& element : m_composition) {
+        const SecondaryData* data = findSecondaryData(element.atomicNumber);
+        if (data && element.atomicMass > 0.0f) {
+            total += element.massFraction / element.atomicMass * data->captureCrossSection;
+        }
+    }
+    if (total <= 0.0) return 0.0f;
+
+    double r = RandomGenerator::random() * total;
+    float energy = 0.0f;
+    for (const auto& element : m_composition) {
+        const SecondaryData* data = findSecondaryData(element.atomicNumber);
+        if (!data || element.atomicMass <= 0.0f) continue;
+        energy = data->captureGamma;
+        r -= element.massFraction / element.atomicMass * data->captureCrossSection;
+        if (r < 0.0) break;
+    }
+    return energy;
+}
+
+void Material::derivePhotonChannels(RadiationType type) {
+    auto it = m_attenuationTables.find(type);
+    if (it == m_attenuationTables.end() || m_composition.empty()) return;
+
+    for (auto& data : it->second) {
+        double photo = 0.0, compton = 0.0, pair = 0.0;
+        double kleinNishina = THOMSON_CROSS_SECTION * KleinNishina::totalCrossSectionRatio(data.energy);
+
+        // Atomes par gramme ∝ w / A (le facteur N_A disparaît dans les proportions)
+        for (const auto& element : m_composition) {
+            if (element.atomicMass <= 0.0f) continue;
+            double atoms = element.massFraction / element.atomicMass;
+            photo += atoms * photoelectricPerAtom(element.atomicNumber, data.energy);
+            compton += atoms * element.atomicNumber * kleinNishina;
+            pair += atoms * pairPerAtom(element.atomicNumber, data.energy);
+        }
+
+        double total = photo + compton + pair;
+        if (total <= 0.0) continue;
+
+        // Les partielles se répartissent le μ tabulé
+        float mu = data.massCoeff > 0.0f ? data.massCoeff * m_density : data.linearCoeff;
+        data.photoelectric = static_cast<float>(mu * photo / total);
+        data.compton = static_cast<float>(mu * compton / total);
+        data.pair = static_cast<float>(mu * pair / total);
+    }
+
+    m_finalized = false;
+}
+
+float Material::getScatteringPdf(RadiationType type, float energy, float cosTheta) const {
+    if (type == RadiationType::GAMMA || type == RadiationType::X_RAY) {
+        return static_cast<float>(KleinNishina::angularPdf(energy, cosTheta));
+    }
+
+    // Autres rayonnements : diffusion isotrope dans le laboratoire
+    return 1.0f / (4.0f * PI);
 }
 
 float Material::getMeanFreePath(RadiationType type, float energy) const {
@@ -148,9 +571,10 @@ float Material::getMeanFreePath(RadiationType type, float energy) const {
 
 glm::vec3 Material::sampleScattering(const glm::vec3& incident, RadiationType type, float energy) const {
     switch (type) {
-        case RadiationType::GAMMA: {
-            // Diffusion Compton
-            float cosTheta = RandomGenerator::randomRange(-1.0f, 1.0f);
+        case RadiationType::GAMMA:
+        case RadiationType::X_RAY: {
+            // Diffusion Compton (Klein-Nishina)
+            float cosTheta = KleinNishina::getInstance().sampleCosTheta(energy);
             float phi = RandomGenerator::randomRange(0.0f, TWO_PI);
             
             // Construction d'un système de coordonnées local
@@ -160,7 +584,7 @@ glm::vec3 Material::sampleScattering(const glm::vec3& incident, RadiationType ty
             u = glm::normalize(glm::cross(u, w));
             glm::vec3 v = glm::cross(w, u);
             
-            float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+            float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
             glm::vec3 newDir = sinTheta * std::cos(phi) * u + 
                               sinTheta * std::sin(phi) * v + 
                               cosTheta * w;
@@ -189,6 +613,8 @@ std::shared_ptr<Material> Material::createLead() {
         float mu = 11.34f * (5.0f * std::pow(energy / 1000.0f, -0.7f)); // cm⁻¹
         lead->addAttenuationData(RadiationType::GAMMA, energy, mu, mu / 11.34f);
     }
+    lead->derivePhotonChannels(RadiationType::GAMMA);
+    lead->finalize();
     
     return lead;
 }
@@ -202,6 +628,8 @@ std::shared_ptr<Material> Material::createSteel() {
         float mu = 7.87f * (0.8f * std::pow(energy / 1000.0f, -0.5f));
         steel->addAttenuationData(RadiationType::GAMMA, energy, mu, mu / 7.87f);
     }
+    steel->derivePhotonChannels(RadiationType::GAMMA);
+    steel->finalize();
     
     return steel;
 }
@@ -214,6 +642,8 @@ std::shared_ptr<Material> Material::createCopper() {
         float mu = 8.96f * (1.2f * std::pow(energy / 1000.0f, -0.6f));
         copper->addAttenuationData(RadiationType::GAMMA, energy, mu, mu / 8.96f);
     }
+    copper->derivePhotonChannels(RadiationType::GAMMA);
+    copper->finalize();
     
     return copper;
 }
@@ -224,10 +654,27 @@ std::shared_ptr<Material> Material::createPolyethylene() {
     poly->addElement(6, "C", 0.857f, 12.011f);
     
     // Excellent pour les neutrons grâce à l'hydrogène
+    // Densités atomiques (cm⁻³) : H et C
+    const double hydrogenAtoms = 0.92 * Physics::AVOGADRO * 0.143 / 1.008;
+    const double carbonAtoms = 0.92 * Physics::AVOGADRO * 0.857 / 12.011;
     for (float energy = 0.01f; energy <= 1000.0f; energy *= 2.0f) {
-        float sigma = 20.0f * std::pow(energy, -0.5f); // barns
-        poly->addAttenuationData(RadiationType::NEUTRON, energy, 0.0f, 0.0f, sigma);
+        // Sections microscopiques approchées (barns) : diffusion élastique sur H et C,
+        // capture radiative en 1/v à partir des valeurs thermiques (0.0253 eV)
+        double thermalRatio = std::sqrt(2.53e-5 / energy);
+        double elasticH = 20.4 / (1.0 + std::pow(energy / 100.0, 0.6));
+        double elasticC = 4.7 / (1.0 + energy / 1000.0);
+        double captureH = 0.332 * thermalRatio;
+        double captureC = 0.0035 * thermalRatio;
+
+        AttenuationData data;
+        data.energy = energy;
+        data.elastic = static_cast<float>((hydrogenAtoms * elasticH + carbonAtoms * elasticC) * 1e-24);
+        data.capture = static_cast<float>((hydrogenAtoms * captureH + carbonAtoms * captureC) * 1e-24);
+        data.linearCoeff = data.elastic + data.capture; // cm⁻¹
+        data.crossSection = static_cast<float>(data.linearCoeff / ((hydrogenAtoms + carbonAtoms) * 1e-24));
+        poly->addAttenuationData(RadiationType::NEUTRON, data);
     }
+    poly->finalize();
     
     return poly;
 }
@@ -243,6 +690,8 @@ std::shared_ptr<Material> Material::createConcrete() {
         float mu = 2.3f * (0.3f * std::pow(energy / 1000.0f, -0.4f));
         concrete->addAttenuationData(RadiationType::GAMMA, energy, mu, mu / 2.3f);
     }
+    concrete->derivePhotonChannels(RadiationType::GAMMA);
+    concrete->finalize();
     
     return concrete;
 }
@@ -256,6 +705,8 @@ std::shared_ptr<Material> Material::createWater() {
         float mu = 1.0f * (0.15f * std::pow(energy / 1000.0f, -0.3f));
         water->addAttenuationData(RadiationType::GAMMA, energy, mu, mu / 1.0f);
     }
+    water->derivePhotonChannels(RadiationType::GAMMA);
+    water->finalize();
     
     return water;
 }
@@ -271,6 +722,8 @@ std::shared_ptr<Material> Material::createAir() {
         float mu = 0.001225f * (0.001f * std::pow(energy / 1000.0f, -0.3f));
         air->addAttenuationData(RadiationType::GAMMA, energy, mu, mu / 0.001225f);
     }
+    air->derivePhotonChannels(RadiationType::GAMMA);
+    air->finalize();
     
     return air;
 }
@@ -288,6 +741,9 @@ MaterialLibrary& MaterialLibrary::getInstance() {
 }
 
 void MaterialLibrary::addMaterial(std::shared_ptr<Material> material) {
+    if (!material->isFinalized()) {
+        material->finalize();
+    }
     m_materials[material->getName()] = material;
 }
 
@@ -313,4 +769,25 @@ void MaterialLibrary::loadDefaults() {
     addMaterial(Material::createWater());
     addMaterial(Material::createAir());
     addMaterial(Material::createVacuum());
-}
\ No newline at end of file
+}
+
+void MaterialLibrary::saveToFile(const std::string& filename) const {
+    std::vector<std::shared_ptr<Material>> materials;
+    for (const auto& pair : m_materials) {
+        materials.push_back(pair.second);
+    }
+    CrossSectionLibrary::write(filename, materials);
+}
+
+void MaterialLibrary::loadFromFile(const std::string& filename) {
+    auto library = CrossSectionLibrary::open(filename);
+    for (uint32_t i = 0; i < library->getMaterialCount(); ++i) {
+        addMaterial(library->createMaterial(i));
+    }
+
+    // La projection reste ouverte pour l'accès direct aux colonnes
+    m_mappedLibrary = library;
+    Log::info("Bibliothèque de matériaux chargée: " + filename + " (" +
+              std::to_string(library->getMaterialCount()) + " matériaux" +
+              (library->isMapped() ? ", projetée en mémoire)" : ")"));
+}
@@ -0,0 +1,121 @@
+#include "core/PhaseSpaceSource.h"
+#include "simulation/Particle.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace PhaseSpaceFormat;
+
+namespace {
+
+glm::vec3 rotateAround(const glm::vec3& v, const glm::vec3& axis, float cosAngle, float sinAngle) {
+    return v * cosAngle + glm::cross(axis, v) * sinAngle + axis * (glm::dot(axis, v) * (1.0f - cosAngle));
+}
+
+} // namespace
+
+// PhaseSpaceSurface
+PhaseSpaceSurface PhaseSpaceSurface::plane(const glm::vec3& point, const glm::vec3& normal) {
+    PhaseSpaceSurface surface;
+    surface.kind = Kind::PLANE;
+    surface.point = point;
+    surface.normal = glm::normalize(normal);
+    return surface;
+}
+
+PhaseSpaceSurface PhaseSpaceSurface::boxExit(const glm::vec3& minPoint, const glm::vec3& maxPoint) {
+    PhaseSpaceSurface surface;
+    surface.kind = Kind::BOX;
+    surface.box = AABB(minPoint, maxPoint);
+    return surface;
+}
+
+bool PhaseSpaceSurface::crossing(const glm::vec3& start, const glm::vec3& end, glm::vec3& result) const {
+    if (kind == Kind::PLANE) {
+        float d0 = glm::dot(start - point, normal);
+        float d1 = glm::dot(end - point, normal);
+        if (d0 >= 0.0f || d1 < 0.0f) return false;
+        result = start + (end - start) * (d0 / (d0 - d1));
+        return true;
+    }
+
+    if (!box.contains(start) || box.contains(end)) return false;
+    Ray ray(start, end - start);
+    ray.tMin = 0.0f;
+    float tMin = 0.0f, tMax = 0.0f;
+    if (!box.intersects(ray, tMin, tMax)) return false;
+    result = ray.at(std::min(tMax, glm::length(end - start)));
+    return true;
+}
+
+// PhaseSpaceSource
+PhaseSpaceSource::PhaseSpaceSource(const std::string& name, const std::string& filename)
+    : Source(name, SourceType::PHASE_SPACE, RadiationType::GAMMA), m_filename(filename), m_file(filename) {
+    Header header;
+    if (m_file.size() < sizeof(header)) {
+        throw std::runtime_error("Fichier d'espace des phases invalide: " + filename);
+    }
+    std::memcpy(&header, m_file.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Fichier d'espace des phases invalide: " + filename);
+    }
+    if (header.endianTag != ENDIAN_TAG || header.version > VERSION || header.recordSize != sizeof(Record)) {
+        throw std::runtime_error("Version ou boutisme .rphs non supporté: " + filename);
+    }
+
+    // Enregistrements ajoutés après la dernière mise à jour de l'en-tête : ignorés
+    uint64_t available = (m_file.size() - sizeof(header)) / sizeof(Record);
+    m_recordCount = std::min(header.recordCount, available);
+    m_histories = header.histories;
+    m_records = reinterpret_cast<const Record*>(m_file.data() + sizeof(header));
+    if (m_recordCount == 0) {
+        throw std::runtime_error("Fichier d'espace des phases vide: " + filename);
+    }
+    if (m_histories == 0) {
+        Log::warning("Espace des phases sans nombre d'histoires, poids non renormalisés: " + filename);
+    }
+    m_weightScale = m_histories > 0 ? static_cast<float>(static_cast<double>(m_recordCount) / m_histories) : 1.0f;
+
+    glm::vec3 a(header.surface[0], header.surface[1], header.surface[2]);
+    glm::vec3 b(header.surface[3], header.surface[4], header.surface[5]);
+    m_surface = header.surfaceKind == static_cast<uint32_t>(PhaseSpaceSurface::Kind::BOX)
+                    ? PhaseSpaceSurface::boxExit(a, b)
+                    : PhaseSpaceSurface::plane(a, b);
+    m_position = m_surface.center();
+    m_radiationType = static_cast<RadiationType>(m_records[0].type);
+
+    Log::info("Espace des phases " + filename + " : " + std::to_string(m_recordCount) + " particules pour " +
+              std::to_string(m_histories) + " histoires");
+}
+
+void PhaseSpaceSource::setRotationSymmetry(bool enabled, const glm::vec3& origin, const glm::vec3& axis) {
+    m_rotationSymmetry = enabled;
+    m_rotationOrigin = origin;
+    m_rotationAxis = glm::normalize(axis);
+}
+
+Particle PhaseSpaceSource::emitParticle() const {
+    // Runs reproductibles : enregistrement fixé par le n° global d'histoire, identique quel que
+    // soit le découpage entre threads et nœuds ; sinon curseur partagé du processus
+    uint64_t emission = RandomGenerator::history != RandomGenerator::NO_HISTORY
+                            ? RandomGenerator::history
+                            : m_cursor.fetch_add(1, std::memory_order_relaxed);
+    uint64_t index = (emission / m_reuseCount) % m_recordCount;
+    const Record& record = m_records[index];
+
+    glm::vec3 position(record.position[0], record.position[1], record.position[2]);
+    float w = std::sqrt(std::max(0.0f, 1.0f - record.u * record.u - record.v * record.v));
+    glm::vec3 direction(record.u, record.v, record.flags & FLAG_NEGATIVE_W ? -w : w);
+
+    if (m_rotationSymmetry) {
+        float angle = RandomGenerator::randomRange(0.0f, TWO_PI);
+        float c = std::cos(angle), s = std::sin(angle);
+        position = m_rotationOrigin + rotateAround(position - m_rotationOrigin, m_rotationAxis, c, s);
+        direction = rotateAround(direction, m_rotationAxis, c, s);
+    }
+
+    Particle particle(static_cast<RadiationType>(record.type), record.energy, position, direction);
+    particle.setWeight(record.weight * m_weightScale);
+
+    incrementEmitted();
+    return particle;
+}
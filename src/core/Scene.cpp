@@ -1,4 +1,6 @@
 #include "core/Scene.h"
+#include "core/SceneSerializer.h"
+#include "utils/Profiler.h"
 #include <algorithm>
 #include <fstream>
 
@@ -20,6 +22,18 @@ void Scene::addObject(std::shared_ptr<Object3D> object) {
     markBVHDirty();
 }
 
+void Scene::addObjects(const std::vector<std::shared_ptr<Object3D>>& objects) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    m_objects.insert(m_objects.end(), objects.begin(), objects.end());
+    for (const auto& object : objects) {
+        m_objectsByName[object->getName()] = object;
+        m_objectsById[object->getId()] = object;
+    }
+    
+    markBVHDirty();
+}
+
 void Scene::removeObject(const std::string& name) {
     std::lock_guard<std::mutex> lock(m_mutex);
     
@@ -114,6 +128,7 @@ std::shared_ptr<Source> Scene::getSource(const std::string& name) const {
 // Intersection avec les rayons
 IntersectionResult Scene::intersectRay(const Ray& ray) const {
     std::lock_guard<std::mutex> lock(m_mutex);
+    PROFILE_COUNT(ProfileCounter::RAYS, 1);
     
     // Utiliser le BVH si disponible et valide
     if (m_bvh && m_bvh->isValid()) {
@@ -123,6 +138,7 @@ IntersectionResult Scene::intersectRay(const Ray& ray) const {
     // Fallback : test brute force
     IntersectionResult closestHit;
     closestHit.distance = std::numeric_limits<float>::max();
+    PROFILE_COUNT(ProfileCounter::PRIMITIVE_TESTS, m_objects.size());
     
     for (const auto& object : m_objects) {
         IntersectionResult hit = object->intersect(ray);
@@ -136,6 +152,7 @@ IntersectionResult Scene::intersectRay(const Ray& ray) const {
 
 bool Scene::intersectRayAny(const Ray& ray) const {
     std::lock_guard<std::mutex> lock(m_mutex);
+    PROFILE_COUNT(ProfileCounter::RAYS, 1);
     
     // Utiliser le BVH si disponible
     if (m_bvh && m_bvh->isValid()) {
@@ -144,6 +161,7 @@ bool Scene::intersectRayAny(const Ray& ray) const {
     
     // Fallback : test brute force
     for (const auto& object : m_objects) {
+        PROFILE_COUNT(ProfileCounter::PRIMITIVE_TESTS, 1);
         IntersectionResult hit = object->intersect(ray);
         if (hit.hit) {
             return true;
@@ -153,6 +171,12 @@ bool Scene::intersectRayAny(const Ray& ray) const {
     return false;
 }
 
+float Scene::computeOpticalDepth(const glm::vec3& from, const glm::vec3& to, RadiationType type, float energy,
+                                 const std::shared_ptr<Material>& worldMaterial) const {
+    return opticalDepthAlong(from, to, type, energy, worldMaterial.get(),
+                             [this](const Ray& ray) { return intersectRay(ray); });
+}
+
 // Boîte englobante de la scène
 AABB Scene::getSceneBounds() const {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -191,47 +215,53 @@ void Scene::updateAccelerationStructure() {
     }
 }
 
-// Sérialisation (implémentation simplifiée)
+// Sérialisation
 void Scene::saveToFile(const std::string& filename) const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Impossible d'ouvrir le fichier pour écriture: " + filename);
+    SceneData data;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        data.objects = m_objects;
+        data.sources = m_sources;
+        data.sensors = m_sensors;
+        data.backgroundLevels = m_backgroundLevels;
     }
     
-    // Format JSON simple (sans bibliothèque JSON pour la simplicité)
-    file << "{\n";
-    file << "  \"version\": \"1.0\",\n";
-    file << "  \"objects\": " << m_objects.size() << ",\n";
-    file << "  \"sensors\": " << m_sensors.size() << ",\n";
-    file << "  \"sources\": " << m_sources.size() << "\n";
-    file << "}\n";
-    
-    file.close();
+    SceneSerializer::save(filename, data, SceneSerializer::formatFromExtension(filename));
     Log::info("Scène sauvegardée dans: " + filename);
 }
 
-void Scene::loadFromFile(const std::string& filename) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Impossible d'ouvrir le fichier pour lecture: " + filename);
+void Scene::loadFromFile(const std::string& filename, uint32_t threadCount) {
+    // Décodage hors verrou : la scène reste utilisable pendant la lecture
+    SceneData data = SceneSerializer::load(filename, threadCount);
+    // Comptes relevés avant le transfert : la scène peut être modifiée dès le verrou relâché
+    const std::string summary = std::to_string(data.objects.size()) + " objets, " +
+                                std::to_string(data.sources.size()) + " sources, " +
+                                std::to_string(data.sensors.size()) + " capteurs";
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        clearUnlocked();
+        
+        m_objects = std::move(data.objects);
+        m_sources = std::move(data.sources);
+        m_sensors = std::move(data.sensors);
+        if (!data.backgroundLevels.empty()) {
+            m_backgroundLevels = std::move(data.backgroundLevels);
+        }
+        rebuildIndices();
+        markBVHDirty();
     }
     
-    // Lecture simplifiée - dans une vraie implémentation, on utiliserait
-    // une bibliothèque JSON comme nlohmann::json
-    
-    clear();
-    
-    file.close();
-    Log::info("Scène chargée depuis: " + filename);
+    Log::info("Scène chargée depuis: " + filename + " (" + summary + ")");
 }
 
 void Scene::clear() {
     std::lock_guard<std::mutex> lock(m_mutex);
-    
+    clearUnlocked();
+    Log::info("Scène vidée");
+}
+
+void Scene::clearUnlocked() {
     m_objects.clear();
     m_sensors.clear();
     m_sources.clear();
@@ -245,8 +275,6 @@ void Scene::clear() {
         m_bvh->clear();
     }
     m_bvhDirty = true;
-    
-    Log::info("Scène vidée");
 }
 
 // Sélection
@@ -0,0 +1,1117 @@
+#include "core/SceneSerializer.h"
+#include "core/Material.h"
+#include "core/PhaseSpaceSource.h"
+#include "geometry/Box.h"
+#include "utils/BinaryIO.h"
+#include "utils/JsonCursor.h"
+#include "utils/MappedFile.h"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <set>
+
+namespace {
+
+constexpr char BINARY_MAGIC[8] = {'R', 'A', 'D', 'S', 'C', 'E', 'N', 'E'};
+constexpr uint32_t ENDIAN_TAG = 0x01020304;
+constexpr uint32_t NO_MATERIAL = 0xFFFFFFFFu;
+constexpr size_t OBJECTS_PER_CHUNK = 4096; // Granularité du découpage entre threads
+
+enum class ShapeKind : uint8_t { BOX }; // Seules les formes implémentées dans geometry/
+enum class SourceKind : uint8_t { ISOTROPIC, DIRECTIONAL, AMBIENT, PHASE_SPACE };
+
+struct BinaryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endianTag;
+    uint32_t sourceCount;
+    uint32_t sensorCount;
+    uint32_t materialCount;
+    uint32_t reserved;
+    uint64_t objectCount;
+    uint64_t metaOffset;      // Fond, sources, capteurs (longueur variable)
+    uint64_t materialsOffset; // Noms de matériaux référencés par index
+    uint64_t objectsOffset;   // ObjectRecord[objectCount]
+    uint64_t stringsOffset;   // Noms d'objets
+    uint64_t fileSize;
+};
+
+struct ObjectRecord {
+    uint64_t nameOffset;
+    uint32_t nameLength;
+    uint32_t materialIndex; // NO_MATERIAL si aucun
+    uint8_t shape;
+    uint8_t visible;
+    uint8_t reserved0[2];
+    float opacity;
+    float position[3];
+    float rotation[4];      // w, x, y, z
+    float scale[3];
+    float color[3];
+    float params[4];        // Dimensions propres à la forme (boîte : taille)
+    uint8_t reserved1[4];
+};
+
+static_assert(sizeof(BinaryHeader) == 80, "En-tête de scène binaire de 80 octets");
+static_assert(sizeof(ObjectRecord) == 96, "ObjectRecord de 96 octets");
+
+// Découpage d'un intervalle en blocs traités par plusieurs threads ; la première erreur est relancée
+template <typename Func>
+void parallelChunks(size_t count, uint32_t threadCount, Func&& func) {
+    size_t chunks = (count + OBJECTS_PER_CHUNK - 1) / OBJECTS_PER_CHUNK;
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t workers = std::min<size_t>(threadCount, chunks);
+    if (workers <= 1) {
+        if (count > 0) func(size_t(0), count);
+        return;
+    }
+
+    std::atomic<size_t> nextChunk{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < workers; ++t) {
+        threads.emplace_back([&]() {
+            try {
+                for (size_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++) {
+                    size_t begin = chunk * OBJECTS_PER_CHUNK;
+                    func(begin, std::min(count, begin + OBJECTS_PER_CHUNK));
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+                nextChunk = chunks;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+// Correspondance nom de matériau → matériau, noms inconnus signalés une seule fois
+class MaterialResolver {
+public:
+    std::shared_ptr<Material> resolve(const std::string& name) {
+        if (name.empty()) return nullptr;
+        auto material = MaterialLibrary::getInstance().getMaterial(name);
+        if (!material) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_missing.insert(name);
+        }
+        return material;
+    }
+
+    void report() const {
+        for (const auto& name : m_missing) {
+            Log::warning("Matériau inconnu dans la scène (objet sans matériau): " + name);
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::set<std::string> m_missing;
+};
+
+bool shapeOf(const Object3D& object, ShapeKind& kind) {
+    if (dynamic_cast<const Box*>(&object)) kind = ShapeKind::BOX;
+    else return false;
+    return true;
+}
+
+bool sourceKindOf(const Source& source, SourceKind& kind) {
+    if (dynamic_cast<const PhaseSpaceSource*>(&source)) kind = SourceKind::PHASE_SPACE;
+    else if (dynamic_cast<const DirectionalSource*>(&source)) kind = SourceKind::DIRECTIONAL;
+    else if (dynamic_cast<const AmbientSource*>(&source)) kind = SourceKind::AMBIENT;
+    else if (dynamic_cast<const IsotropicSource*>(&source)) kind = SourceKind::ISOTROPIC;
+    else return false;
+    return true;
+}
+
+// Paramètres de forme partagés par les deux formats
+struct ShapeParams {
+    ShapeKind kind = ShapeKind::BOX;
+    float params[4] = {1.0f, 1.0f, 1.0f, 0.0f};
+};
+
+ShapeParams shapeParams(const Object3D& object, ShapeKind kind) {
+    ShapeParams shape;
+    shape.kind = kind;
+    const auto& size = static_cast<const Box&>(object).getSize();
+    shape.params[0] = size.x;
+    shape.params[1] = size.y;
+    shape.params[2] = size.z;
+    return shape;
+}
+
+std::shared_ptr<Object3D> createShape(const std::string& name, const ShapeParams& shape) {
+    return std::make_shared<Box>(name, glm::vec3(shape.params[0], shape.params[1], shape.params[2]));
+}
+
+// Biaisage lu (JSON ou binaire) : message d'erreur, vide s'il est valide. Comparaisons écrites
+// pour rejeter aussi les NaN, qui donneraient des poids non finis
+std::string validateBiasing(const RegionBiasing& biasing) {
+    if (!(biasing.exponentialTransform >= 0.0f && biasing.exponentialTransform < 1.0f)) {
+        return "exponentialTransform hors de [0, 1[";
+    }
+    float length = glm::length(biasing.preferredDirection);
+    if (!(length > 0.0f) || !std::isfinite(length)) return "direction de biaisage nulle";
+    return {};
+}
+
+// ---------------------------------------------------------------------------
+// Écriture JSON
+// ---------------------------------------------------------------------------
+void appendNumber(std::string& out, float value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escape[8];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+                    out += escape;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+void appendVec3(std::string& out, const glm::vec3& v) {
+    out += '[';
+    appendNumber(out, v.x); out += ", ";
+    appendNumber(out, v.y); out += ", ";
+    appendNumber(out, v.z);
+    out += ']';
+}
+
+void appendKey(std::string& out, const char* key) {
+    out += ", \"";
+    out += key;
+    out += "\": ";
+}
+
+void appendPairs(std::string& out, const std::vector<std::pair<float, float>>& pairs) {
+    out += '[';
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        if (i > 0) out += ", ";
+        out += '[';
+        appendNumber(out, pairs[i].first); out += ", ";
+        appendNumber(out, pairs[i].second);
+        out += ']';
+    }
+    out += ']';
+}
+
+void appendBinning(std::string& out, const Binning& binning) {
+    out += "{\"scale\": ";
+    out += binning.getScale() == Binning::Scale::LOG ? "\"log\"" : "\"linear\"";
+    appendKey(out, "min"); appendNumber(out, binning.getMin());
+    appendKey(out, "max"); appendNumber(out, binning.getMax());
+    appendKey(out, "count"); out += std::to_string(binning.getCount());
+    out += '}';
+}
+
+void appendSource(std::string& out, const Source& source, SourceKind kind) {
+    static const char* kinds[] = {"isotropic", "directional", "ambient", "phaseSpace"};
+    out += "{\"name\": "; appendString(out, source.getName());
+    appendKey(out, "kind"); out += '"'; out += kinds[static_cast<int>(kind)]; out += '"';
+    appendKey(out, "radiation"); out += '"'; out += radiationTypeName(source.getRadiationType()); out += '"';
+    appendKey(out, "position"); appendVec3(out, source.getPosition());
+    appendKey(out, "direction"); appendVec3(out, source.getDirection());
+    appendKey(out, "intensity"); appendNumber(out, source.getIntensity());
+    appendKey(out, "enabled"); out += source.isEnabled() ? "true" : "false";
+    appendKey(out, "visible"); out += source.isVisible() ? "true" : "false";
+    appendKey(out, "color"); appendVec3(out, source.getColor());
+
+    if (kind == SourceKind::DIRECTIONAL) {
+        appendKey(out, "beamAngle");
+        appendNumber(out, static_cast<const DirectionalSource&>(source).getBeamAngle());
+    } else if (kind == SourceKind::AMBIENT) {
+        const auto& ambient = static_cast<const AmbientSource&>(source);
+        appendKey(out, "boundsMin"); appendVec3(out, ambient.getMinBounds());
+        appendKey(out, "boundsMax"); appendVec3(out, ambient.getMaxBounds());
+    } else if (kind == SourceKind::PHASE_SPACE) {
+        const auto& phaseSpace = static_cast<const PhaseSpaceSource&>(source);
+        appendKey(out, "file"); appendString(out, phaseSpace.getFilename());
+        appendKey(out, "reuse"); out += std::to_string(phaseSpace.getReuseCount());
+        if (phaseSpace.hasRotationSymmetry()) {
+            appendKey(out, "rotationOrigin"); appendVec3(out, phaseSpace.getRotationOrigin());
+            appendKey(out, "rotationAxis"); appendVec3(out, phaseSpace.getRotationAxis());
+        }
+    }
+
+    const auto& spectrum = source.getSpectrum();
+    static const char* spectrumTypes[] = {"monoenergetic", "continuous", "discrete"};
+    appendKey(out, "spectrum");
+    out += "{\"type\": \""; out += spectrumTypes[spectrum.type]; out += '"';
+    appendKey(out, "energy"); appendNumber(out, spectrum.energy);
+    if (!spectrum.spectrum.empty()) {
+        appendKey(out, "lines"); appendPairs(out, spectrum.spectrum);
+    }
+    out += "}}";
+}
+
+void appendSensor(std::string& out, const Sensor& sensor) {
+    static const char* types[] = {"point", "volume", "surface"};
+    out += "{\"name\": "; appendString(out, sensor.getName());
+    appendKey(out, "type"); out += '"'; out += types[static_cast<int>(sensor.getType())]; out += '"';
+    appendKey(out, "position"); appendVec3(out, sensor.getPosition());
+    appendKey(out, "orientation"); appendVec3(out, sensor.getOrientation());
+    appendKey(out, "size"); appendVec3(out, sensor.getSize());
+    appendKey(out, "radius"); appendNumber(out, sensor.getRadius());
+    appendKey(out, "enabled"); out += sensor.isEnabled() ? "true" : "false";
+    appendKey(out, "visible"); out += sensor.isVisible() ? "true" : "false";
+    appendKey(out, "color"); appendVec3(out, sensor.getColor());
+    appendKey(out, "energyRange");
+    out += '['; appendNumber(out, sensor.getMinEnergy()); out += ", "; appendNumber(out, sensor.getMaxEnergy()); out += ']';
+
+    if (!sensor.getRadiationFilter().empty()) {
+        appendKey(out, "radiationFilter");
+        out += '[';
+        for (size_t i = 0; i < sensor.getRadiationFilter().size(); ++i) {
+            if (i > 0) out += ", ";
+            out += '"'; out += radiationTypeName(sensor.getRadiationFilter()[i]); out += '"';
+        }
+        out += ']';
+    }
+    if (!sensor.getFluxToDoseFactors().empty()) {
+        appendKey(out, "fluxToDose"); appendPairs(out, sensor.getFluxToDoseFactors());
+    }
+
+    const auto& spectrum = sensor.getSpectrum();
+    if (spectrum.getEnergyBins().isEnabled() || spectrum.getTimeBins().isEnabled()) {
+        appendKey(out, "spectrum");
+        out += "{\"quantity\": ";
+        out += sensor.getSpectrumQuantity() == SpectrumQuantity::FLUENCE ? "\"fluence\"" : "\"counts\"";
+        if (spectrum.getEnergyBins().isEnabled()) {
+            appendKey(out, "energy"); appendBinning(out, spectrum.getEnergyBins());
+        }
+        if (spectrum.getTimeBins().isEnabled()) {
+            appendKey(out, "time"); appendBinning(out, spectrum.getTimeBins());
+        }
+        out += '}';
+    }
+    out += '}';
+}
+
+void appendObject(std::string& out, const Object3D& object, ShapeKind kind) {
+    ShapeParams shape = shapeParams(object, kind);
+    const Transform& transform = object.getTransform();
+
+    out += "{\"name\": "; appendString(out, object.getName());
+    appendKey(out, "shape"); out += "\"box\"";
+    if (object.getMaterial()) {
+        appendKey(out, "material"); appendString(out, object.getMaterial()->getName());
+    }
+    appendKey(out, "position"); appendVec3(out, transform.position);
+    appendKey(out, "rotation");
+    out += '[';
+    appendNumber(out, transform.rotation.w); out += ", ";
+    appendNumber(out, transform.rotation.x); out += ", ";
+    appendNumber(out, transform.rotation.y); out += ", ";
+    appendNumber(out, transform.rotation.z);
+    out += ']';
+    appendKey(out, "scale"); appendVec3(out, transform.scale);
+
+    appendKey(out, "size"); appendVec3(out, glm::vec3(shape.params[0], shape.params[1], shape.params[2]));
+    appendKey(out, "color"); appendVec3(out, object.getColor());
+    appendKey(out, "opacity"); appendNumber(out, object.getOpacity());
+    appendKey(out, "visible"); out += object.isVisible() ? "true" : "false";
+
+    const RegionBiasing& biasing = object.getBiasing();
+    if (biasing.isActive()) {
+        appendKey(out, "biasing");
+        out += "{\"forcedCollisions\": ";
+        out += biasing.forcedCollisions ? "true" : "false";
+        appendKey(out, "exponentialTransform"); appendNumber(out, biasing.exponentialTransform);
+        appendKey(out, "direction"); appendVec3(out, biasing.preferredDirection);
+        out += '}';
+    }
+    out += '}';
+}
+
+// ---------------------------------------------------------------------------
+// Lecture JSON
+// ---------------------------------------------------------------------------
+RadiationType readRadiation(JsonCursor& cursor) {
+    std::string name = cursor.readString();
+    RadiationType type;
+    if (!parseRadiationType(name, type)) cursor.fail("type de rayonnement inconnu: " + name);
+    return type;
+}
+
+Binning readBinning(JsonCursor& cursor) {
+    bool logScale = false;
+    float min = 0.0f, max = 0.0f;
+    uint32_t count = 0;
+    cursor.readObject([&](const std::string& key) {
+        if (key == "scale") logScale = cursor.readString() == "log";
+        else if (key == "min") min = cursor.readFloat();
+        else if (key == "max") max = cursor.readFloat();
+        else if (key == "count") count = static_cast<uint32_t>(cursor.readNumber());
+        else cursor.skipValue();
+    });
+    return logScale ? Binning::logarithmic(min, max, count) : Binning::linear(min, max, count);
+}
+
+std::shared_ptr<Source> readSource(JsonCursor& cursor) {
+    std::string name, kind = "isotropic";
+    RadiationType radiation = RadiationType::GAMMA;
+    glm::vec3 position(0.0f), direction(0.0f, 0.0f, 1.0f), color(1.0f, 1.0f, 0.0f);
+    glm::vec3 boundsMin(-10.0f), boundsMax(10.0f);
+    float intensity = 1.0f, beamAngle = 0.1f;
+    bool enabled = true, visible = true;
+    EnergySpectrum spectrum;
+    std::string phaseSpaceFile;
+    uint32_t reuse = 1;
+    bool rotation = false;
+    glm::vec3 rotationOrigin(0.0f), rotationAxis(0.0f, 0.0f, 1.0f);
+
+    cursor.readObject([&](const std::string& key) {
+        if (key == "name") name = cursor.readString();
+        else if (key == "kind") kind = cursor.readString();
+        else if (key == "radiation") radiation = readRadiation(cursor);
+        else if (key == "position") position = cursor.readVec3();
+        else if (key == "direction") direction = cursor.readVec3();
+        else if (key == "intensity") intensity = cursor.readFloat();
+        else if (key == "enabled") enabled = cursor.readBool();
+        else if (key == "visible") visible = cursor.readBool();
+        else if (key == "color") color = cursor.readVec3();
+        else if (key == "beamAngle") beamAngle = cursor.readFloat();
+        else if (key == "boundsMin") boundsMin = cursor.readVec3();
+        else if (key == "boundsMax") boundsMax = cursor.readVec3();
+        else if (key == "file") phaseSpaceFile = cursor.readString();
+        else if (key == "reuse") reuse = static_cast<uint32_t>(cursor.readNumber());
+        else if (key == "rotationOrigin") { rotationOrigin = cursor.readVec3(); rotation = true; }
+        else if (key == "rotationAxis") { rotationAxis = cursor.readVec3(); rotation = true; }
+        else if (key == "spectrum") {
+            cursor.readObject([&](const std::string& field) {
+                if (field == "type") {
+                    std::string type = cursor.readString();
+                    spectrum.type = type == "continuous" ? EnergySpectrum::CONTINUOUS
+                                  : type == "discrete"   ? EnergySpectrum::DISCRETE
+                                                         : EnergySpectrum::MONOENERGETIC;
+                } else if (field == "energy") {
+                    spectrum.energy = cursor.readFloat();
+                } else if (field == "lines") {
+                    spectrum.spectrum = cursor.readPairs();
+                } else {
+                    cursor.skipValue();
+                }
+            });
+        } else {
+            cursor.skipValue();
+        }
+    });
+
+    std::shared_ptr<Source> source;
+    if (kind == "directional") {
+        auto directional = std::make_shared<DirectionalSource>(name, radiation);
+        directional->setBeamAngle(beamAngle);
+        source = directional;
+    } else if (kind == "ambient") {
+        auto ambient = std::make_shared<AmbientSource>(name, radiation);
+        ambient->setBounds(boundsMin, boundsMax);
+        source = ambient;
+    } else if (kind == "isotropic") {
+        source = std::make_shared<IsotropicSource>(name, radiation);
+    } else if (kind == "phaseSpace") {
+        auto phaseSpace = std::make_shared<PhaseSpaceSource>(name, phaseSpaceFile);
+        phaseSpace->setReuseCount(reuse);
+        phaseSpace->setRotationSymmetry(rotation, rotationOrigin, rotationAxis);
+        source = phaseSpace;
+    } else {
+        cursor.fail("type de source inconnu: " + kind);
+    }
+
+    source->setPosition(position);
+    source->setDirection(direction);
+    source->setIntensity(intensity);
+    source->setEnabled(enabled);
+    source->setVisible(visible);
+    source->setColor(color);
+    source->setSpectrum(spectrum);
+    return source;
+}
+
+std::shared_ptr<Sensor> readSensor(JsonCursor& cursor) {
+    std::string name;
+    SensorType type = SensorType::POINT;
+    glm::vec3 position(0.0f), orientation(0.0f, 0.0f, 1.0f), size(1.0f), color(0.0f, 1.0f, 0.0f);
+    float radius = 0.05f, minEnergy = 0.0f, maxEnergy = 10000.0f;
+    bool enabled = true, visible = true;
+    std::vector<RadiationType> filter;
+    std::vector<std::pair<float, float>> fluxToDose;
+    Binning energyBins, timeBins;
+    SpectrumQuantity quantity = SpectrumQuantity::COUNTS;
+
+    cursor.readObject([&](const std::string& key) {
+        if (key == "name") name = cursor.readString();
+        else if (key == "type") {
+            std::string text = cursor.readString();
+            type = text == "volume" ? SensorType::VOLUME : text == "surface" ? SensorType::SURFACE : SensorType::POINT;
+        }
+        else if (key == "position") position = cursor.readVec3();
+        else if (key == "orientation") orientation = cursor.readVec3();
+        else if (key == "size") size = cursor.readVec3();
+        else if (key == "radius") radius = cursor.readFloat();
+        else if (key == "enabled") enabled = cursor.readBool();
+        else if (key == "visible") visible = cursor.readBool();
+        else if (key == "color") color = cursor.readVec3();
+        else if (key == "energyRange") {
+            auto range = cursor.readFloats();
+            if (range.size() != 2) cursor.fail("energyRange : [min, max] attendu");
+            minEnergy = range[0];
+            maxEnergy = range[1];
+        }
+        else if (key == "radiationFilter") cursor.readArray([&]() { filter.push_back(readRadiation(cursor)); });
+        else if (key == "fluxToDose") fluxToDose = cursor.readPairs();
+        else if (key == "spectrum") {
+            cursor.readObject([&](const std::string& field) {
+                if (field == "quantity") {
+                    quantity = cursor.readString() == "fluence" ? SpectrumQuantity::FLUENCE : SpectrumQuantity::COUNTS;
+                } else if (field == "energy") {
+                    energyBins = readBinning(cursor);
+                } else if (field == "time") {
+                    timeBins = readBinning(cursor);
+                } else {
+                    cursor.skipValue();
+                }
+            });
+        }
+        else cursor.skipValue();
+    });
+
+    auto sensor = std::make_shared<Sensor>(name, type, position);
+    sensor->setOrientation(orientation);
+    sensor->setSize(size);
+    sensor->setRadius(radius);
+    sensor->setEnabled(enabled);
+    sensor->setVisible(visible);
+    sensor->setColor(color);
+    sensor->setEnergyRange(minEnergy, maxEnergy);
+    sensor->setRadiationFilter(filter);
+    if (!fluxToDose.empty()) sensor->setFluxToDoseFactors(fluxToDose);
+    if (energyBins.isEnabled() || timeBins.isEnabled()) sensor->setSpectrumBinning(energyBins, timeBins, quantity);
+    return sensor;
+}
+
+std::shared_ptr<Object3D> readObject(JsonCursor& cursor, MaterialResolver& materials) {
+    std::string name, shapeText = "box", materialName;
+    ShapeParams shape;
+    Transform transform;
+    glm::vec3 color(0.7f, 0.7f, 0.7f);
+    float opacity = 1.0f;
+    bool visible = true;
+    RegionBiasing biasing;
+
+    cursor.readObject([&](const std::string& key) {
+        if (key == "name") name = cursor.readString();
+        else if (key == "shape") shapeText = cursor.readString();
+        else if (key == "material") materialName = cursor.readString();
+        else if (key == "position") transform.position = cursor.readVec3();
+        else if (key == "rotation") {
+            auto q = cursor.readFloats();
+            if (q.size() != 4) cursor.fail("rotation : quaternion [w, x, y, z] attendu");
+            transform.rotation = glm::quat(q[0], q[1], q[2], q[3]);
+        }
+        else if (key == "scale") transform.scale = cursor.readVec3();
+        else if (key == "size") {
+            glm::vec3 size = cursor.readVec3();
+            shape.params[0] = size.x; shape.params[1] = size.y; shape.params[2] = size.z;
+        }
+        else if (key == "color") color = cursor.readVec3();
+        else if (key == "opacity") opacity = cursor.readFloat();
+        else if (key == "visible") visible = cursor.readBool();
+        else if (key == "biasing") {
+            cursor.readObject([&](const std::string& field) {
+                if (field == "forcedCollisions") biasing.forcedCollisions = cursor.readBool();
+                else if (field == "exponentialTransform") biasing.exponentialTransform = cursor.readFloat();
+                else if (field == "direction") biasing.preferredDirection = cursor.readVec3();
+                else cursor.skipValue();
+            });
+            std::string error = validateBiasing(biasing);
+            if (!error.empty()) cursor.fail(error);
+        }
+        else cursor.skipValue();
+    });
+
+    if (shapeText != "box") cursor.fail("forme non supportée: " + shapeText);
+
+    auto object = createShape(name, shape);
+    object->setTransform(transform);
+    object->setMaterial(materials.resolve(materialName));
+    object->setColor(color);
+    object->setOpacity(opacity);
+    object->setVisible(visible);
+    object->setBiasing(biasing);
+    return object;
+}
+
+SceneData loadJson(const MappedFile& file, uint32_t threadCount) {
+    const char* base = reinterpret_cast<const char*>(file.data());
+    JsonCursor cursor(base, base + file.size(), base);
+    SceneData data;
+    std::vector<std::pair<const char*, const char*>> objectSpans;
+    std::string materialLibrary;
+
+    cursor.readObject([&](const std::string& key) {
+        if (key == "format") {
+            if (cursor.readString() != "radsim-scene") cursor.fail("format de scène inconnu");
+        } else if (key == "version") {
+            if (cursor.readNumber() > SceneSerializer::VERSION) cursor.fail("version de scène non supportée");
+        } else if (key == "materialLibrary") {
+            materialLibrary = cursor.readString();
+        } else if (key == "background") {
+            cursor.readObject([&](const std::string& typeName) {
+                RadiationType type;
+                if (!parseRadiationType(typeName, type)) cursor.fail("type de rayonnement inconnu: " + typeName);
+                data.backgroundLevels[type] = cursor.readFloat();
+            });
+        } else if (key == "sources") {
+            cursor.readArray([&]() { data.sources.push_back(readSource(cursor)); });
+        } else if (key == "sensors") {
+            cursor.readArray([&]() { data.sensors.push_back(readSensor(cursor)); });
+        } else if (key == "objects") {
+            // Seules les bornes des éléments sont relevées ici ; décodage parallèle ensuite
+            cursor.readArray([&]() {
+                cursor.skipWhitespace();
+                const char* start = cursor.position();
+                cursor.skipValue();
+                objectSpans.emplace_back(start, cursor.position());
+            });
+        } else {
+            cursor.skipValue();
+        }
+    });
+
+    if (!materialLibrary.empty()) {
+        MaterialLibrary::getInstance().loadFromFile(materialLibrary);
+    }
+
+    MaterialResolver materials;
+    data.objects.resize(objectSpans.size());
+    parallelChunks(objectSpans.size(), threadCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            JsonCursor objectCursor(objectSpans[i].first, objectSpans[i].second, base);
+            data.objects[i] = readObject(objectCursor, materials);
+        }
+    });
+    materials.report();
+
+    return data;
+}
+
+// ---------------------------------------------------------------------------
+// Format binaire
+// ---------------------------------------------------------------------------
+void putVec3(ByteWriter& writer, const glm::vec3& v) {
+    writer.put(v.x);
+    writer.put(v.y);
+    writer.put(v.z);
+}
+
+glm::vec3 getVec3(ByteReader& reader) {
+    float x = reader.get<float>();
+    float y = reader.get<float>();
+    float z = reader.get<float>();
+    return glm::vec3(x, y, z);
+}
+
+void putPairs(ByteWriter& writer, const std::vector<std::pair<float, float>>& pairs) {
+    writer.put(static_cast<uint32_t>(pairs.size()));
+    for (const auto& pair : pairs) {
+        writer.put(pair.first);
+        writer.put(pair.second);
+    }
+}
+
+std::vector<std::pair<float, float>> getPairs(ByteReader& reader) {
+    std::vector<std::pair<float, float>> pairs(reader.get<uint32_t>());
+    for (auto& pair : pairs) {
+        pair.first = reader.get<float>();
+        pair.second = reader.get<float>();
+    }
+    return pairs;
+}
+
+void putBinning(ByteWriter& writer, const Binning& binning) {
+    writer.put(static_cast<uint8_t>(binning.isEnabled()));
+    writer.put(static_cast<uint8_t>(binning.getScale() == Binning::Scale::LOG));
+    writer.put(binning.getMin());
+    writer.put(binning.getMax());
+    writer.put(binning.getCount());
+}
+
+Binning getBinning(ByteReader& reader) {
+    bool enabled = reader.get<uint8_t>() != 0;
+    bool logScale = reader.get<uint8_t>() != 0;
+    float min = reader.get<float>();
+    float max = reader.get<float>();
+    uint32_t count = reader.get<uint32_t>();
+    if (!enabled) return Binning();
+    return logScale ? Binning::logarithmic(min, max, count) : Binning::linear(min, max, count);
+}
+
+void putSource(ByteWriter& writer, const Source& source, SourceKind kind) {
+    writer.putString(source.getName());
+    writer.put(static_cast<uint8_t>(kind));
+    writer.put(static_cast<uint32_t>(source.getRadiationType()));
+    putVec3(writer, source.getPosition());
+    putVec3(writer, source.getDirection());
+    writer.put(source.getIntensity());
+    writer.put(static_cast<uint8_t>(source.isEnabled()));
+    writer.put(static_cast<uint8_t>(source.isVisible()));
+    putVec3(writer, source.getColor());
+
+    float beamAngle = 0.0f;
+    glm::vec3 boundsMin(0.0f), boundsMax(0.0f);
+    if (kind == SourceKind::DIRECTIONAL) {
+        beamAngle = static_cast<const DirectionalSource&>(source).getBeamAngle();
+    } else if (kind == SourceKind::AMBIENT) {
+        boundsMin = static_cast<const AmbientSource&>(source).getMinBounds();
+        boundsMax = static_cast<const AmbientSource&>(source).getMaxBounds();
+    }
+    writer.put(beamAngle);
+    putVec3(writer, boundsMin);
+    putVec3(writer, boundsMax);
+
+    const auto& spectrum = source.getSpectrum();
+    writer.put(static_cast<uint8_t>(spectrum.type));
+    writer.put(spectrum.energy);
+    putPairs(writer, spectrum.spectrum);
+
+    if (kind == SourceKind::PHASE_SPACE) {
+        const auto& phaseSpace = static_cast<const PhaseSpaceSource&>(source);
+        writer.putString(phaseSpace.getFilename());
+        writer.put(phaseSpace.getReuseCount());
+        writer.put(static_cast<uint8_t>(phaseSpace.hasRotationSymmetry()));
+        putVec3(writer, phaseSpace.getRotationOrigin());
+        putVec3(writer, phaseSpace.getRotationAxis());
+    }
+}
+
+std::shared_ptr<Source> getSource(ByteReader& reader) {
+    std::string name = reader.getString();
+    auto kind = static_cast<SourceKind>(reader.get<uint8_t>());
+    auto radiation = static_cast<RadiationType>(reader.get<uint32_t>());
+    glm::vec3 position = getVec3(reader);
+    glm::vec3 direction = getVec3(reader);
+    float intensity = reader.get<float>();
+    bool enabled = reader.get<uint8_t>() != 0;
+    bool visible = reader.get<uint8_t>() != 0;
+    glm::vec3 color = getVec3(reader);
+    float beamAngle = reader.get<float>();
+    glm::vec3 boundsMin = getVec3(reader);
+    glm::vec3 boundsMax = getVec3(reader);
+
+    EnergySpectrum spectrum;
+    spectrum.type = static_cast<EnergySpectrum::Type>(reader.get<uint8_t>());
+    spectrum.energy = reader.get<float>();
+    spectrum.spectrum = getPairs(reader);
+
+    std::shared_ptr<Source> source;
+    switch (kind) {
+        case SourceKind::DIRECTIONAL: {
+            auto directional = std::make_shared<DirectionalSource>(name, radiation);
+            directional->setBeamAngle(beamAngle);
+            source = directional;
+            break;
+        }
+        case SourceKind::AMBIENT: {
+            auto ambient = std::make_shared<AmbientSource>(name, radiation);
+            ambient->setBounds(boundsMin, boundsMax);
+            source = ambient;
+            break;
+        }
+        case SourceKind::ISOTROPIC:
+            source = std::make_shared<IsotropicSource>(name, radiation);
+            break;
+        case SourceKind::PHASE_SPACE: {
+            std::string file = reader.getString();
+            auto phaseSpace = std::make_shared<PhaseSpaceSource>(name, file);
+            phaseSpace->setReuseCount(reader.get<uint32_t>());
+            bool rotation = reader.get<uint8_t>() != 0;
+            glm::vec3 origin = getVec3(reader);
+            glm::vec3 axis = getVec3(reader);
+            phaseSpace->setRotationSymmetry(rotation, origin, axis);
+            source = phaseSpace;
+            break;
+        }
+        default:
+            throw std::runtime_error("Scène binaire corrompue (type de source)");
+    }
+
+    source->setPosition(position);
+    source->setDirection(direction);
+    source->setIntensity(intensity);
+    source->setEnabled(enabled);
+    source->setVisible(visible);
+    source->setColor(color);
+    source->setSpectrum(spectrum);
+    return source;
+}
+
+void putSensor(ByteWriter& writer, const Sensor& sensor) {
+    writer.putString(sensor.getName());
+    writer.put(static_cast<uint8_t>(sensor.getType()));
+    putVec3(writer, sensor.getPosition());
+    putVec3(writer, sensor.getOrientation());
+    putVec3(writer, sensor.getSize());
+    writer.put(sensor.getRadius());
+    writer.put(static_cast<uint8_t>(sensor.isEnabled()));
+    writer.put(static_cast<uint8_t>(sensor.isVisible()));
+    putVec3(writer, sensor.getColor());
+    writer.put(sensor.getMinEnergy());
+    writer.put(sensor.getMaxEnergy());
+
+    writer.put(static_cast<uint32_t>(sensor.getRadiationFilter().size()));
+    for (RadiationType type : sensor.getRadiationFilter()) {
+        writer.put(static_cast<uint32_t>(type));
+    }
+    putPairs(writer, sensor.getFluxToDoseFactors());
+
+    writer.put(static_cast<uint8_t>(sensor.getSpectrumQuantity()));
+    putBinning(writer, sensor.getSpectrum().getEnergyBins());
+    putBinning(writer, sensor.getSpectrum().getTimeBins());
+}
+
+std::shared_ptr<Sensor> getSensor(ByteReader& reader) {
+    std::string name = reader.getString();
+    auto type = static_cast<SensorType>(reader.get<uint8_t>());
+    glm::vec3 position = getVec3(reader);
+    auto sensor = std::make_shared<Sensor>(name, type, position);
+    sensor->setOrientation(getVec3(reader));
+    sensor->setSize(getVec3(reader));
+    sensor->setRadius(reader.get<float>());
+    sensor->setEnabled(reader.get<uint8_t>() != 0);
+    sensor->setVisible(reader.get<uint8_t>() != 0);
+    sensor->setColor(getVec3(reader));
+    float minEnergy = reader.get<float>();
+    float maxEnergy = reader.get<float>();
+    sensor->setEnergyRange(minEnergy, maxEnergy);
+
+    std::vector<RadiationType> filter(reader.get<uint32_t>());
+    for (auto& filterType : filter) {
+        filterType = static_cast<RadiationType>(reader.get<uint32_t>());
+    }
+    sensor->setRadiationFilter(filter);
+
+    auto fluxToDose = getPairs(reader);
+    if (!fluxToDose.empty()) sensor->setFluxToDoseFactors(fluxToDose);
+
+    auto quantity = static_cast<SpectrumQuantity>(reader.get<uint8_t>());
+    Binning energyBins = getBinning(reader);
+    Binning timeBins = getBinning(reader);
+    if (energyBins.isEnabled() || timeBins.isEnabled()) sensor->setSpectrumBinning(energyBins, timeBins, quantity);
+    return sensor;
+}
+
+void saveBinary(const SceneData& data, std::vector<std::pair<const Object3D*, ShapeKind>>& objects,
+                std::vector<std::pair<const Source*, SourceKind>>& sources, ByteWriter& writer) {
+    BinaryHeader header{};
+    std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = SceneSerializer::VERSION;
+    header.endianTag = ENDIAN_TAG;
+    header.sourceCount = static_cast<uint32_t>(sources.size());
+    header.sensorCount = static_cast<uint32_t>(data.sensors.size());
+    header.objectCount = objects.size();
+    writer.reserve(sizeof(BinaryHeader));
+
+    // Fond, sources et capteurs
+    header.metaOffset = writer.align(8);
+    writer.put(static_cast<uint32_t>(data.backgroundLevels.size()));
+    for (const auto& [type, level] : data.backgroundLevels) {
+        writer.put(static_cast<uint32_t>(type));
+        writer.put(level);
+    }
+    for (const auto& [source, kind] : sources) {
+        putSource(writer, *source, kind);
+    }
+    for (const auto& sensor : data.sensors) {
+        putSensor(writer, *sensor);
+    }
+
+    // Biaisage par région (version 2) : table des seuls objets biaisés, par indice d'enregistrement
+    std::vector<uint64_t> biased;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (objects[i].first->getBiasing().isActive()) biased.push_back(i);
+    }
+    writer.put(static_cast<uint32_t>(biased.size()));
+    for (uint64_t index : biased) {
+        const RegionBiasing& biasing = objects[index].first->getBiasing();
+        writer.put(index);
+        writer.put(static_cast<uint8_t>(biasing.forcedCollisions ? 1 : 0));
+        writer.put(biasing.exponentialTransform);
+        for (int k = 0; k < 3; ++k) writer.put(biasing.preferredDirection[k]);
+    }
+
+    // Table des matériaux
+    std::map<std::string, uint32_t> materialIndices;
+    for (const auto& [object, kind] : objects) {
+        if (object->getMaterial()) {
+            materialIndices.emplace(object->getMaterial()->getName(), 0);
+        }
+    }
+    header.materialsOffset = writer.align(8);
+    header.materialCount = static_cast<uint32_t>(materialIndices.size());
+    uint32_t materialIndex = 0;
+    for (auto& [name, index] : materialIndices) {
+        index = materialIndex++;
+        writer.putString(name);
+    }
+
+    // Objets : enregistrements de taille fixe, noms dans une table séparée
+    header.objectsOffset = writer.align(64);
+    uint64_t recordsOffset = writer.reserve(sizeof(ObjectRecord) * objects.size());
+    std::string names;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        const Object3D& object = *objects[i].first;
+        ShapeParams shape = shapeParams(object, objects[i].second);
+        const Transform& transform = object.getTransform();
+
+        ObjectRecord record{};
+        record.nameOffset = names.size();
+        record.nameLength = static_cast<uint32_t>(object.getName().size());
+        names += object.getName();
+        record.materialIndex = object.getMaterial() ? materialIndices[object.getMaterial()->getName()] : NO_MATERIAL;
+        record.shape = static_cast<uint8_t>(shape.kind);
+        record.visible = object.isVisible() ? 1 : 0;
+        record.opacity = object.getOpacity();
+        for (int k = 0; k < 3; ++k) {
+            record.position[k] = transform.position[k];
+            record.scale[k] = transform.scale[k];
+            record.color[k] = object.getColor()[k];
+        }
+        record.rotation[0] = transform.rotation.w;
+        record.rotation[1] = transform.rotation.x;
+        record.rotation[2] = transform.rotation.y;
+        record.rotation[3] = transform.rotation.z;
+        std::copy(shape.params, shape.params + 4, record.params);
+        writer.patch(recordsOffset + i * sizeof(ObjectRecord), record);
+    }
+
+    header.stringsOffset = writer.align(8);
+    writer.append(names.data(), names.size());
+    header.fileSize = writer.position();
+    writer.patch(0, header);
+}
+
+SceneData loadBinary(const MappedFile& file, uint32_t threadCount) {
+    if constexpr (std::endian::native != std::endian::little) {
+        throw std::runtime_error("Scène binaire : hôte gros-boutiste non supporté");
+    }
+    if (file.size() < sizeof(BinaryHeader)) {
+        throw std::runtime_error("Scène binaire tronquée");
+    }
+
+    BinaryHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.endianTag != ENDIAN_TAG || header.version > SceneSerializer::VERSION) {
+        throw std::runtime_error("Version ou boutisme de scène binaire non supporté");
+    }
+    if (header.fileSize != file.size() || header.metaOffset > file.size() || header.materialsOffset > file.size() ||
+        header.stringsOffset > file.size() || header.objectsOffset > file.size() ||
+        header.objectCount > (file.size() - header.objectsOffset) / sizeof(ObjectRecord)) {
+        throw std::runtime_error("Scène binaire tronquée");
+    }
+
+    SceneData data;
+    ByteReader reader(file.data(), file.size());
+    reader.seek(header.metaOffset);
+    uint32_t backgroundCount = reader.get<uint32_t>();
+    for (uint32_t i = 0; i < backgroundCount; ++i) {
+        auto type = static_cast<RadiationType>(reader.get<uint32_t>());
+        data.backgroundLevels[type] = reader.get<float>();
+    }
+    for (uint32_t i = 0; i < header.sourceCount; ++i) {
+        data.sources.push_back(getSource(reader));
+    }
+    for (uint32_t i = 0; i < header.sensorCount; ++i) {
+        data.sensors.push_back(getSensor(reader));
+    }
+    std::vector<std::pair<uint64_t, RegionBiasing>> biasing;
+    if (header.version >= 2) {
+        biasing.resize(reader.get<uint32_t>());
+        for (auto& [index, region] : biasing) {
+            index = reader.get<uint64_t>();
+            region.forcedCollisions = reader.get<uint8_t>() != 0;
+            region.exponentialTransform = reader.get<float>();
+            for (int k = 0; k < 3; ++k) region.preferredDirection[k] = reader.get<float>();
+            if (index >= header.objectCount) {
+                throw std::runtime_error("Scène binaire corrompue (biaisage de l'objet " + std::to_string(index) + ")");
+            }
+            std::string error = validateBiasing(region);
+            if (!error.empty()) {
+                throw std::runtime_error("Scène binaire corrompue (objet " + std::to_string(index) + " : " + error + ")");
+            }
+        }
+    }
+
+    MaterialResolver resolver;
+    std::vector<std::shared_ptr<Material>> materials;
+    reader.seek(header.materialsOffset);
+    for (uint32_t i = 0; i < header.materialCount; ++i) {
+        materials.push_back(resolver.resolve(reader.getString()));
+    }
+
+    const auto* records = reinterpret_cast<const ObjectRecord*>(file.data() + header.objectsOffset);
+    const char* names = reinterpret_cast<const char*>(file.data() + header.stringsOffset);
+    uint64_t namesSize = file.size() - header.stringsOffset;
+
+    data.objects.resize(header.objectCount);
+    parallelChunks(header.objectCount, threadCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ObjectRecord record;
+            std::memcpy(&record, &records[i], sizeof(record));
+            if (record.nameOffset > namesSize || record.nameLength > namesSize - record.nameOffset ||
+                record.shape > static_cast<uint8_t>(ShapeKind::BOX) ||
+                (record.materialIndex != NO_MATERIAL && record.materialIndex >= materials.size())) {
+                throw std::runtime_error("Scène binaire corrompue (objet " + std::to_string(i) + ")");
+            }
+
+            ShapeParams shape;
+            shape.kind = static_cast<ShapeKind>(record.shape);
+            std::copy(record.params, record.params + 4, shape.params);
+
+            auto object = createShape(std::string(names + record.nameOffset, record.nameLength), shape);
+            Transform transform;
+            transform.position = glm::vec3(record.position[0], record.position[1], record.position[2]);
+            transform.rotation = glm::quat(record.rotation[0], record.rotation[1], record.rotation[2], record.rotation[3]);
+            transform.scale = glm::vec3(record.scale[0], record.scale[1], record.scale[2]);
+            object->setTransform(transform);
+            object->setMaterial(record.materialIndex == NO_MATERIAL ? nullptr : materials[record.materialIndex]);
+            object->setColor(glm::vec3(record.color[0], record.color[1], record.color[2]));
+            object->setOpacity(record.opacity);
+            object->setVisible(record.visible != 0);
+            data.objects[i] = object;
+        }
+    });
+    for (const auto& [index, region] : biasing) {
+        data.objects[index]->setBiasing(region);
+    }
+    resolver.report();
+
+    return data;
+}
+
+} // namespace
+
+SceneFileFormat SceneSerializer::formatFromExtension(const std::string& filename) {
+    auto dot = filename.find_last_of('.');
+    std::string extension = dot == std::string::npos ? "" : filename.substr(dot + 1);
+    return extension == "rsb" ? SceneFileFormat::BINARY : SceneFileFormat::JSON;
+}
+
+void SceneSerializer::save(const std::string& filename, const SceneData& data, SceneFileFormat format) {
+    // Types concrets, éléments non sérialisables ignorés avec avertissement
+    std::vector<std::pair<const Object3D*, ShapeKind>> objects;
+    objects.reserve(data.objects.size());
+    for (const auto& object : data.objects) {
+        ShapeKind kind;
+        if (shapeOf(*object, kind)) {
+            objects.emplace_back(object.get(), kind);
+        } else {
+            Log::warning("Objet non sérialisable ignoré: " + object->getName());
+        }
+    }
+
+    std::vector<std::pair<const Source*, SourceKind>> sources;
+    for (const auto& source : data.sources) {
+        SourceKind kind;
+        if (sourceKindOf(*source, kind)) {
+            sources.emplace_back(source.get(), kind);
+        } else {
+            Log::warning("Source non sérialisable ignorée: " + source->getName());
+        }
+    }
+
+    std::string temporary = filename + ".tmp";
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour écriture: " + temporary);
+    }
+
+    if (format == SceneFileFormat::BINARY) {
+        ByteWriter writer;
+        saveBinary(data, objects, sources, writer);
+        file.write(reinterpret_cast<const char*>(writer.bytes().data()),
+                   static_cast<std::streamsize>(writer.bytes().size()));
+    } else {
+        std::string out = "{\n  \"format\": \"radsim-scene\",\n  \"version\": " + std::to_string(VERSION) + ",\n";
+
+        out += "  \"background\": {";
+        bool first = true;
+        for (const auto& [type, level] : data.backgroundLevels) {
+            out += first ? "\"" : ", \"";
+            out += radiationTypeName(type);
+            out += "\": ";
+            appendNumber(out, level);
+            first = false;
+        }
+        out += "},\n  \"sources\": [";
+        for (size_t i = 0; i < sources.size(); ++i) {
+            out += i == 0 ? "\n    " : ",\n    ";
+            appendSource(out, *sources[i].first, sources[i].second);
+        }
+        out += sources.empty() ? "],\n  \"sensors\": [" : "\n  ],\n  \"sensors\": [";
+        for (size_t i = 0; i < data.sensors.size(); ++i) {
+            out += i == 0 ? "\n    " : ",\n    ";
+            appendSensor(out, *data.sensors[i]);
+        }
+        out += data.sensors.empty() ? "],\n  \"objects\": [" : "\n  ],\n  \"objects\": [";
+        file.write(out.data(), static_cast<std::streamsize>(out.size()));
+
+        // Objets : un par ligne, formatés par blocs en parallèle puis écrits dans l'ordre
+        size_t chunkCount = (objects.size() + OBJECTS_PER_CHUNK - 1) / OBJECTS_PER_CHUNK;
+        std::vector<std::string> chunks(chunkCount);
+        parallelChunks(objects.size(), 0, [&](size_t begin, size_t end) {
+            std::string& chunk = chunks[begin / OBJECTS_PER_CHUNK];
+            for (size_t i = begin; i < end; ++i) {
+                chunk += i == 0 ? "\n    " : ",\n    ";
+                appendObject(chunk, *objects[i].first, objects[i].second);
+            }
+        });
+        for (const auto& chunk : chunks) {
+            file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        }
+
+        std::string tail = objects.empty() ? "]\n}\n" : "\n  ]\n}\n";
+        file.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+    }
+
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Erreur d'écriture: " + temporary);
+    }
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Impossible de remplacer le fichier: " + filename);
+    }
+}
+
+SceneData SceneSerializer::load(const std::string& filename, uint32_t threadCount) {
+    MappedFile file(filename);
+    bool binary = file.size() >= sizeof(BINARY_MAGIC) &&
+                  std::memcmp(file.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+    return binary ? loadBinary(file, threadCount) : loadJson(file, threadCount);
+}
@@ -36,7 +36,7 @@ bool Sensor::detectsParticle(const Particle& particle) const {
 void Sensor::recordDetection(const Particle& particle) {
     if (!detectsParticle(particle)) return;
 
-    accumulateDetection(particle);
+    accumulateDetection(particle, m_stats);
 }
 
 bool Sensor::intersectsSegment(const glm::vec3& p0, const glm::vec3& p1) const {
@@ -58,50 +58,87 @@ bool Sensor::intersectsSegment(const glm::vec3& p0, const glm::vec3& p1) const {
 
         case SensorType::VOLUME:
         case SensorType::SURFACE: {
-            glm::vec3 halfExtents = glm::max(m_size * 0.5f, glm::vec3(1e-4f));
-            glm::vec3 minBounds = m_position - halfExtents;
-            glm::vec3 maxBounds = m_position + halfExtents;
-
-            glm::vec3 d = p1 - p0;
             float tMin = 0.0f;
             float tMax = 1.0f;
+            return clipSegment(p0, p1, tMin, tMax);
+        }
+    }
+
+    return false;
+}
+
+bool Sensor::clipSegment(const glm::vec3& p0, const glm::vec3& p1, float& tMin, float& tMax) const {
+    glm::vec3 halfExtents = glm::max(m_size * 0.5f, glm::vec3(1e-4f));
+    glm::vec3 minBounds = m_position - halfExtents;
+    glm::vec3 maxBounds = m_position + halfExtents;
 
-            for (int axis = 0; axis < 3; ++axis) {
-                float origin = p0[axis];
-                float direction = d[axis];
-                float minVal = minBounds[axis];
-                float maxVal = maxBounds[axis];
-
-                if (std::abs(direction) < 1e-8f) {
-                    if (origin < minVal || origin > maxVal) {
-                        return false;
-                    }
-                    continue;
-                }
-
-                float invDir = 1.0f / direction;
-                float t1 = (minVal - origin) * invDir;
-                float t2 = (maxVal - origin) * invDir;
-                if (t1 > t2) std::swap(t1, t2);
-
-                tMin = std::max(tMin, t1);
-                tMax = std::min(tMax, t2);
-                if (tMin > tMax) {
-                    return false;
-                }
+    glm::vec3 d = p1 - p0;
+    tMin = 0.0f;
+    tMax = 1.0f;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        float origin = p0[axis];
+        float direction = d[axis];
+        float minVal = minBounds[axis];
+        float maxVal = maxBounds[axis];
+
+        if (std::abs(direction) < 1e-8f) {
+            if (origin < minVal || origin > maxVal) {
+                return false;
             }
+            continue;
+        }
 
-            return tMax >= 0.0f && tMin <= 1.0f;
+        float invDir = 1.0f / direction;
+        float t1 = (minVal - origin) * invDir;
+        float t2 = (maxVal - origin) * invDir;
+        if (t1 > t2) std::swap(t1, t2);
+
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) {
+            return false;
         }
     }
 
-    return false;
+    return tMax >= 0.0f && tMin <= 1.0f;
 }
 
-void Sensor::recordParticle(const Particle& particle) {
-    if (!passesFilters(particle)) return;
+float Sensor::distanceFrom(const glm::vec3& point) const {
+    if (m_type == SensorType::POINT) {
+        return std::max(0.0f, glm::length(point - m_position) - effectiveRadius());
+    }
+
+    // Boîte du capteur (mêmes demi-dimensions que clipSegment)
+    glm::vec3 halfExtents = glm::max(m_size * 0.5f, glm::vec3(1e-4f));
+    glm::vec3 outside = glm::max(glm::abs(point - m_position) - halfExtents, glm::vec3(0.0f));
+    return glm::length(outside);
+}
+
+float Sensor::clippedSegmentLength(const glm::vec3& p0, const glm::vec3& p1) const {
+    if (!m_enabled || m_type == SensorType::POINT) return 0.0f;
+
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+    if (!clipSegment(p0, p1, tMin, tMax)) return 0.0f;
+
+    return (tMax - tMin) * glm::length(p1 - p0);
+}
+
+bool Sensor::recordParticle(const Particle& particle, uint32_t threadSlot, float time, DetectionStats* stats) {
+    if (!passesFilters(particle)) return false;
+
+    accumulateDetection(particle, stats ? *stats : m_stats);
+    if (m_spectrumQuantity == SpectrumQuantity::COUNTS) {
+        m_spectrum.score(threadSlot, particle.getEnergy(), time < 0.0f ? particle.getAge() : time,
+                         particle.getWeight());
+    }
+    return true;
+}
 
-    accumulateDetection(particle);
+void Sensor::setSpectrumBinning(const Binning& energyBins, const Binning& timeBins, SpectrumQuantity quantity) {
+    m_spectrumQuantity = quantity;
+    m_spectrum.configure(energyBins, timeBins);
 }
 
 double Sensor::getCountRate() const {
@@ -144,12 +181,16 @@ double Sensor::getAttenuationFactor(double incidentIntensity) const {
 }
 
 bool Sensor::passesFilters(const Particle& particle) const {
+    return acceptsRadiation(particle.getType(), particle.getEnergy());
+}
+
+bool Sensor::acceptsRadiation(RadiationType type, float energy) const {
     if (!m_enabled) return false;
 
     if (!m_radiationFilter.empty()) {
         bool typeMatch = false;
-        for (RadiationType type : m_radiationFilter) {
-            if (particle.getType() == type) {
+        for (RadiationType accepted : m_radiationFilter) {
+            if (accepted == type) {
                 typeMatch = true;
                 break;
             }
@@ -157,7 +198,6 @@ bool Sensor::passesFilters(const Particle& particle) const {
         if (!typeMatch) return false;
     }
 
-    float energy = particle.getEnergy();
     if (energy < m_minEnergy || energy > m_maxEnergy) {
         return false;
     }
@@ -165,29 +205,102 @@ bool Sensor::passesFilters(const Particle& particle) const {
     return true;
 }
 
-void Sensor::accumulateDetection(const Particle& particle) {
-    m_stats.totalCounts.fetch_add(1);
+void Sensor::recordTrackLength(const Particle& particle, float length, uint32_t threadSlot, float time,
+                               DetectionStats* stats) {
+    if (length <= 0.0f || !passesFilters(particle)) return;
+    DetectionStats& target = stats ? *stats : m_stats;
+
+    // Fluence moyenne dans le volume : w·L / V
+    double fluence = static_cast<double>(particle.getWeight()) * length / getVolume();
+    target.trackLengthFluence.fetch_add(fluence);
+    if (m_spectrumQuantity == SpectrumQuantity::FLUENCE) {
+        m_spectrum.score(threadSlot, particle.getEnergy(), time < 0.0f ? particle.getAge() : time, fluence);
+    }
+
+    if (!m_fluxToDose.empty()) {
+        double fluencePerCm2 = fluence * 1e-4;
+        target.trackLengthDose.fetch_add(fluencePerCm2 * getFluxToDoseFactor(particle.getEnergy()));
+    }
+}
+
+double Sensor::getVolume() const {
+    glm::vec3 extents = glm::max(m_size, glm::vec3(2e-4f));
+    return static_cast<double>(extents.x) * extents.y * extents.z;
+}
+
+void Sensor::setFluxToDoseFactors(const std::vector<std::pair<float, float>>& factors) {
+    m_fluxToDose = factors;
+    std::sort(m_fluxToDose.begin(), m_fluxToDose.end());
+}
+
+float Sensor::getFluxToDoseFactor(float energy) const {
+    return interpolateFluxToDose(m_fluxToDose, energy);
+}
+
+float Sensor::interpolateFluxToDose(const std::vector<std::pair<float, float>>& factors, float energy) {
+    if (factors.empty()) return 0.0f;
+    if (energy <= factors.front().first) return factors.front().second;
+    if (energy >= factors.back().first) return factors.back().second;
+
+    auto upper = std::upper_bound(factors.begin(), factors.end(), energy,
+                                  [](float e, const std::pair<float, float>& point) { return e < point.first; });
+    auto lower = upper - 1;
+
+    // Interpolation log-log entre les deux points encadrants
+    if (lower->second <= 0.0f || upper->second <= 0.0f) {
+        float t = (energy - lower->first) / (upper->first - lower->first);
+        return lower->second + t * (upper->second - lower->second);
+    }
+    float t = std::log(energy / lower->first) / std::log(upper->first / lower->first);
+    return lower->second * std::pow(upper->second / lower->second, t);
+}
+
+std::vector<std::pair<float, float>> Sensor::ambientDoseFactorsPhotons() {
+    // Équivalent de dose ambiant H*(10)/Φ pour les photons (pSv·cm²)
+    return {{10.0f, 0.061f},   {15.0f, 0.83f},    {20.0f, 1.05f},    {30.0f, 0.81f},    {40.0f, 0.64f},
+            {50.0f, 0.55f},    {60.0f, 0.51f},    {80.0f, 0.53f},    {100.0f, 0.61f},   {150.0f, 0.89f},
+            {200.0f, 1.20f},   {300.0f, 1.80f},   {400.0f, 2.38f},   {500.0f, 2.93f},   {600.0f, 3.44f},
+            {800.0f, 4.38f},   {1000.0f, 5.20f},  {1500.0f, 6.90f},  {2000.0f, 8.60f},  {3000.0f, 11.1f},
+            {4000.0f, 13.4f},  {5000.0f, 15.5f},  {6000.0f, 17.6f},  {8000.0f, 21.6f},  {10000.0f, 25.6f}};
+}
+
+void Sensor::recordNextEvent(double fluence, float energy, float time, uint32_t threadSlot, DetectionStats* stats) {
+    DetectionStats& target = stats ? *stats : m_stats;
+    target.nextEventScores.fetch_add(1);
+    target.nextEventFluence.fetch_add(fluence);
+    target.nextEventEnergyFluence.fetch_add(fluence * energy);
+    if (m_spectrumQuantity == SpectrumQuantity::FLUENCE) {
+        m_spectrum.score(threadSlot, energy, time, fluence);
+    }
+}
+
+void Sensor::accumulateDetection(const Particle& particle, DetectionStats& stats) {
+    stats.totalCounts.fetch_add(1);
 
     switch (particle.getType()) {
         case RadiationType::GAMMA:
         case RadiationType::X_RAY:
-            m_stats.gammaCounts.fetch_add(1);
+            stats.gammaCounts.fetch_add(1);
             break;
         case RadiationType::NEUTRON:
-            m_stats.neutronCounts.fetch_add(1);
+            stats.neutronCounts.fetch_add(1);
             break;
         case RadiationType::MUON:
-            m_stats.muonCounts.fetch_add(1);
+            stats.muonCounts.fetch_add(1);
             break;
         default:
             break;
     }
 
-    double energy = static_cast<double>(particle.getEnergy());
-    m_stats.totalEnergy.fetch_add(energy);
+    // Énergie et dose pondérées par le poids statistique (réduction de variance)
+    double weight = static_cast<double>(particle.getWeight());
+    stats.weightedCounts.fetch_add(weight);
+
+    double energy = weight * static_cast<double>(particle.getEnergy());
+    stats.totalEnergy.fetch_add(energy);
 
     double dose = energy * 1.6e-16;
-    m_stats.totalDose.fetch_add(dose);
+    stats.totalDose.fetch_add(dose);
 }
 
 float Sensor::effectiveRadius() const {
@@ -1,5 +1,6 @@
 #include "core/Source.h"
 #include "simulation/Particle.h"
+#include <algorithm>
 
 // EnergySpectrum implementation
 float EnergySpectrum::sampleEnergy() const {
@@ -58,6 +59,82 @@ float EnergySpectrum::interpolateIntensity(float e) const {
     return 1.0f;
 }
 
+std::vector<double> EnergySpectrum::groupProbabilities(const std::vector<float>& groupBounds) const {
+    size_t groupCount = groupBounds.size() > 1 ? groupBounds.size() - 1 : 1;
+    std::vector<double> probabilities(groupCount, 0.0);
+
+    // Énergie hors des bornes : rattachée au premier ou au dernier groupe
+    auto groupOf = [&](float e) -> size_t {
+        auto it = std::upper_bound(groupBounds.begin(), groupBounds.end(), e);
+        size_t index = static_cast<size_t>(std::max<std::ptrdiff_t>(0, (it - groupBounds.begin()) - 1));
+        return std::min(index, groupCount - 1);
+    };
+
+    if (type == MONOENERGETIC || spectrum.empty()) {
+        probabilities[groupOf(energy)] = 1.0;
+        return probabilities;
+    }
+
+    if (spectrum.size() == 1) {
+        probabilities[groupOf(spectrum.front().first)] = 1.0;
+        return probabilities;
+    }
+
+    double total = integrateIntensity(spectrum.front().first, spectrum.back().first);
+    if (total <= 0.0) {
+        probabilities[groupOf(spectrum.front().first)] = 1.0;
+        return probabilities;
+    }
+
+    for (size_t g = 0; g < groupCount; ++g) {
+        float low = g == 0 ? std::numeric_limits<float>::lowest() : groupBounds[g];
+        float high = g + 1 == groupCount ? std::numeric_limits<float>::max() : groupBounds[g + 1];
+        probabilities[g] = integrateIntensity(low, high) / total;
+    }
+
+    return probabilities;
+}
+
+float EnergySpectrum::sampleEnergyInRange(float minEnergy, float maxEnergy) const {
+    if (type == MONOENERGETIC || spectrum.size() < 2) {
+        return sampleEnergy();
+    }
+
+    float low = std::max(minEnergy, spectrum.front().first);
+    float high = std::min(maxEnergy, spectrum.back().first);
+    if (low >= high) return std::clamp(energy, spectrum.front().first, spectrum.back().first);
+
+    float maxIntensity = 0.0f;
+    for (const auto& point : spectrum) {
+        maxIntensity = std::max(maxIntensity, point.second);
+    }
+
+    // Même méthode de rejet que sampleEnergy(), restreinte à [low, high]
+    for (int attempt = 0; attempt < 1000; ++attempt) {
+        float e = RandomGenerator::randomRange(low, high);
+        if (RandomGenerator::random() * maxIntensity <= interpolateIntensity(e)) {
+            return e;
+        }
+    }
+
+    return (low + high) * 0.5f;
+}
+
+double EnergySpectrum::integrateIntensity(float minEnergy, float maxEnergy) const {
+    double area = 0.0;
+
+    // Intégration exacte (trapèzes) de l'interpolation linéaire par morceaux
+    for (size_t i = 0; i + 1 < spectrum.size(); ++i) {
+        float a = std::max(minEnergy, spectrum[i].first);
+        float b = std::min(maxEnergy, spectrum[i + 1].first);
+        if (b <= a) continue;
+
+        area += 0.5 * (interpolateIntensity(a) + interpolateIntensity(b)) * (b - a);
+    }
+
+    return area;
+}
+
 // Source implementation
 Source::Source(const std::string& name, SourceType type, RadiationType radiationType)
     : m_name(name), m_sourceType(type), m_radiationType(radiationType) {
@@ -73,6 +150,12 @@ glm::vec3 Source::samplePosition() const {
     return m_position;
 }
 
+float Source::directionPdf(const glm::vec3& direction) const {
+    // Direction fixe : distribution de Dirac, aucune densité finie
+    (void)direction;
+    return 0.0f;
+}
+
 // IsotropicSource implementation
 IsotropicSource::IsotropicSource(const std::string& name, RadiationType radiationType)
     : Source(name, SourceType::ISOTROPIC, radiationType) {
@@ -95,6 +178,11 @@ glm::vec3 IsotropicSource::sampleDirection() const {
     return RandomGenerator::randomDirection();
 }
 
+float IsotropicSource::directionPdf(const glm::vec3& direction) const {
+    (void)direction;
+    return 1.0f / (4.0f * PI);
+}
+
 // DirectionalSource implementation
 DirectionalSource::DirectionalSource(const std::string& name, RadiationType radiationType)
     : Source(name, SourceType::DIRECTIONAL, radiationType) {
@@ -139,6 +227,16 @@ glm::vec3 DirectionalSource::sampleDirection() const {
     return localDir.x * u + localDir.y * v + localDir.z * w;
 }
 
+float DirectionalSource::directionPdf(const glm::vec3& direction) const {
+    // Tirage uniforme dans le cône d'ouverture m_beamAngle
+    if (m_beamAngle <= 0.0f) return 0.0f;
+
+    float cosBeam = std::cos(m_beamAngle);
+    if (glm::dot(direction, glm::normalize(m_direction)) < cosBeam) return 0.0f;
+
+    return 1.0f / (TWO_PI * (1.0f - cosBeam));
+}
+
 // AmbientSource implementation
 AmbientSource::AmbientSource(const std::string& name, RadiationType radiationType)
     : Source(name, SourceType::AMBIENT, radiationType) {
@@ -161,6 +259,11 @@ glm::vec3 AmbientSource::sampleDirection() const {
     return RandomGenerator::randomDirection();
 }
 
+float AmbientSource::directionPdf(const glm::vec3& direction) const {
+    (void)direction;
+    return 1.0f / (4.0f * PI);
+}
+
 glm::vec3 AmbientSource::samplePosition() const {
     // Position aléatoire dans les limites définies
     return glm::vec3(
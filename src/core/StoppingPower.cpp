@@ -0,0 +1,174 @@
+#include "core/StoppingPower.h"
+#include "core/Material.h"
+
+namespace {
+
+constexpr double BETHE_K = 0.307075;       // MeV cm²/mol
+constexpr double PLASMA_ENERGY = 28.816;   // eV, ħω_p = 28.816 √(ρ Z/A)
+constexpr uint32_t POINTS_PER_DECADE = 20;
+
+double restMassOf(RadiationType type) {
+    switch (type) {
+        case RadiationType::MUON: return 105658.4;  // keV/c²
+        case RadiationType::ALPHA: return 3727379.4;
+        default: return Physics::ELECTRON_MASS_KEV;
+    }
+}
+
+int chargeOf(RadiationType type) {
+    return type == RadiationType::ALPHA ? 2 : 1;
+}
+
+// Énergie moyenne d'excitation (eV) : hydrogène tabulé, sinon approximation de Sternheimer
+double meanExcitationEnergy(int Z) {
+    if (Z <= 1) return 19.2;
+    if (Z < 13) return 12.0 * Z + 7.0;
+    return 9.76 * Z + 58.8 * std::pow(static_cast<double>(Z), -0.19);
+}
+
+// Longueur de radiation d'un élément (g/cm²), formule de Dahl
+double elementRadiationLength(int Z, double A) {
+    return 716.4 * A / (Z * (Z + 1.0) * std::log(287.0 / std::sqrt(static_cast<double>(Z))));
+}
+
+} // namespace
+
+StoppingPowerTable::StoppingPowerTable(const std::vector<ElementComposition>& composition, float density,
+                                       RadiationType type)
+    : m_type(type), m_restMass(restMassOf(type)), m_charge(chargeOf(type)) {
+    // Grandeurs moyennes de la composition (additivité de Bragg)
+    double zOverA = 0.0, logI = 0.0, inverseX0 = 0.0, zSquaredOverA = 0.0;
+    for (const auto& element : composition) {
+        if (element.atomicNumber <= 0 || element.atomicMass <= 0.0f) continue;
+        double electrons = element.massFraction * element.atomicNumber / element.atomicMass;
+        zOverA += electrons;
+        logI += electrons * std::log(meanExcitationEnergy(element.atomicNumber) * 1e-3); // keV
+        zSquaredOverA += electrons * element.atomicNumber;
+        inverseX0 += element.massFraction / elementRadiationLength(element.atomicNumber, element.atomicMass);
+    }
+    if (zOverA <= 0.0 || density <= 0.0f || inverseX0 <= 0.0) return;
+
+    const double I = std::exp(logI / zOverA);       // keV
+    const double zEffective = zSquaredOverA / zOverA; // Z moyen vu par les électrons
+    const double radiationLength = 1.0 / inverseX0;  // g/cm²
+    const double plasmaEnergy = PLASMA_ENERGY * std::sqrt(density * zOverA) * 1e-3; // keV
+    const double me = Physics::ELECTRON_MASS_KEV;
+    m_radiationLength = radiationLength / density / 100.0;
+
+    const uint32_t decades = static_cast<uint32_t>(std::round(std::log10(MAX_ENERGY / MIN_ENERGY)));
+    const uint32_t count = decades * POINTS_PER_DECADE + 1;
+    std::vector<double> collision(count), radiative(count, 0.0);
+    m_energies.resize(count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const double T = MIN_ENERGY * std::pow(10.0, static_cast<double>(i) / POINTS_PER_DECADE);
+        m_energies[i] = static_cast<float>(T);
+
+        const double gamma = 1.0 + T / m_restMass;
+        const double beta2 = 1.0 - 1.0 / (gamma * gamma);
+        const double betaGamma = std::sqrt(beta2) * gamma;
+        const double delta = std::max(0.0, 2.0 * std::log(plasmaEnergy / I) + 2.0 * std::log(betaGamma) - 1.0);
+
+        if (m_type == RadiationType::BETA) {
+            // Rohrlich-Carlson (électrons), puis freinage : rapport Z T / 800 MeV borné par E / X0
+            const double tau = T / me;
+            const double f = 1.0 - beta2 + (tau * tau / 8.0 - (2.0 * tau + 1.0) * std::log(2.0)) /
+                                               ((tau + 1.0) * (tau + 1.0));
+            const double bracket = std::log(tau * tau * (tau + 2.0) / (2.0 * (I / me) * (I / me))) + f - delta;
+            collision[i] = 0.5 * BETHE_K * zOverA / beta2 * bracket;
+            radiative[i] = std::min(collision[i] * zEffective * T * 1e-3 / 800.0, (T + me) * 1e-3 / radiationLength);
+        } else {
+            // Bethe, transfert maximal à un électron libre
+            const double ratio = me / m_restMass;
+            const double tMax = 2.0 * me * betaGamma * betaGamma / (1.0 + 2.0 * gamma * ratio + ratio * ratio);
+            const double bracket = 0.5 * std::log(2.0 * me * betaGamma * betaGamma * tMax / (I * I)) - beta2 - 0.5 * delta;
+            collision[i] = BETHE_K * m_charge * m_charge * zOverA / beta2 * bracket;
+        }
+    }
+
+    // Sous le pic de Bragg de la formule (hors de son domaine) : S ∝ √E
+    const uint32_t peak = static_cast<uint32_t>(std::max_element(collision.begin(), collision.end()) - collision.begin());
+    m_stoppingPowers.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        double massStopping = i < peak ? collision[peak] * std::sqrt(m_energies[i] / m_energies[peak])
+                                       : collision[i] + radiative[i];
+        m_stoppingPowers[i] = static_cast<float>(massStopping * density * 1e5); // MeV cm²/g → keV/m
+    }
+
+    integrateRanges();
+}
+
+std::shared_ptr<const StoppingPowerTable> StoppingPowerTable::lowerEnvelope(
+    const std::vector<const StoppingPowerTable*>& tables) {
+    if (tables.empty()) throw std::runtime_error("Enveloppe de pouvoirs d'arrêt sans table");
+
+    std::shared_ptr<StoppingPowerTable> envelope(new StoppingPowerTable(*tables.front()));
+    for (const StoppingPowerTable* table : tables) {
+        if (table->m_energies.size() != envelope->m_energies.size() || table->m_type != envelope->m_type) {
+            throw std::runtime_error("Enveloppe de pouvoirs d'arrêt : tables incompatibles");
+        }
+        for (size_t i = 0; i < envelope->m_stoppingPowers.size(); ++i) {
+            envelope->m_stoppingPowers[i] = std::min(envelope->m_stoppingPowers[i], table->m_stoppingPowers[i]);
+        }
+        envelope->m_radiationLength = std::max(envelope->m_radiationLength, table->m_radiationLength);
+    }
+    envelope->integrateRanges();
+    return envelope;
+}
+
+void StoppingPowerTable::integrateRanges() {
+    // Portée CSDA : ∫ dE / S (trapèzes), sous la grille S ∝ √E
+    m_ranges.resize(m_energies.size());
+    m_ranges[0] = 2.0f * m_energies[0] / m_stoppingPowers[0];
+    for (size_t i = 1; i < m_energies.size(); ++i) {
+        double step = (m_energies[i] - m_energies[i - 1]) * 0.5 *
+                      (1.0 / m_stoppingPowers[i] + 1.0 / m_stoppingPowers[i - 1]);
+        m_ranges[i] = static_cast<float>(m_ranges[i - 1] + step);
+    }
+}
+
+float StoppingPowerTable::stoppingPower(float energy) const {
+    if (energy <= m_energies.front()) return m_stoppingPowers.front() * std::sqrt(energy / m_energies.front());
+    if (energy >= m_energies.back()) return m_stoppingPowers.back();
+
+    float position = std::log10(energy / MIN_ENERGY) * POINTS_PER_DECADE;
+    size_t i = std::min(static_cast<size_t>(position), m_energies.size() - 2);
+    float t = position - i;
+    return std::exp((1.0f - t) * std::log(m_stoppingPowers[i]) + t * std::log(m_stoppingPowers[i + 1]));
+}
+
+float StoppingPowerTable::range(float energy) const {
+    if (energy <= 0.0f) return 0.0f;
+    if (energy <= m_energies.front()) return m_ranges.front() * std::sqrt(energy / m_energies.front());
+    if (energy >= m_energies.back()) return m_ranges.back() + (energy - m_energies.back()) / m_stoppingPowers.back();
+
+    float position = std::log10(energy / MIN_ENERGY) * POINTS_PER_DECADE;
+    size_t i = std::min(static_cast<size_t>(position), m_energies.size() - 2);
+    float t = position - i;
+    return std::exp((1.0f - t) * std::log(m_ranges[i]) + t * std::log(m_ranges[i + 1]));
+}
+
+float StoppingPowerTable::energyAtRange(float range) const {
+    if (range <= 0.0f) return 0.0f;
+    if (range <= m_ranges.front()) {
+        float ratio = range / m_ranges.front();
+        return m_energies.front() * ratio * ratio;
+    }
+    if (range >= m_ranges.back()) return m_energies.back() + (range - m_ranges.back()) * m_stoppingPowers.back();
+
+    // Inverse exact de range() : même interpolation log-log
+    size_t i = std::upper_bound(m_ranges.begin(), m_ranges.end(), range) - m_ranges.begin() - 1;
+    i = std::min(i, m_ranges.size() - 2);
+    float t = std::log(range / m_ranges[i]) / std::log(m_ranges[i + 1] / m_ranges[i]);
+    return std::exp((1.0f - t) * std::log(m_energies[i]) + t * std::log(m_energies[i + 1]));
+}
+
+float StoppingPowerTable::highlandAngle(float energy, float step) const {
+    if (energy <= 0.0f || step <= 0.0f || m_radiationLength <= 0.0) return 0.0f;
+
+    double momentum = std::sqrt(energy * (energy + 2.0 * m_restMass)) * 1e-3; // MeV/c
+    double beta = momentum * 1e3 / (energy + m_restMass);
+    double thickness = step / m_radiationLength;
+    double correction = std::max(0.0, 1.0 + 0.038 * std::log(thickness * m_charge * m_charge / (beta * beta)));
+    return static_cast<float>(13.6 / (beta * momentum) * m_charge * std::sqrt(thickness) * correction);
+}
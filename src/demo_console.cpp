@@ -6,15 +6,25 @@
 #include "geometry/Box.h"
 #include "geometry/Sphere.h"
 #include "simulation/MonteCarloEngine.h"
+#include "simulation/BatchRunner.h"
+#include "simulation/ResultsWriter.h"
+#include "simulation/TrackRecorder.h"
+#include "simulation/PhaseSpace.h"
+#include "simulation/DistributedRun.h"
+#include "utils/Profiler.h"
 
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
 
 // Version console pour démonstration sans Qt
 class ConsoleDemo {
 public:
-    static void runDemo() {
+    static void runDemo(const std::string& resultsFile = "", const std::string& tracksFile = "",
+                        uint32_t trackSampleEvery = 100) {
         std::cout << "=== SIMULATEUR D'ATTÉNUATION DE RADIATION ===" << std::endl;
         std::cout << "Version Console de Démonstration" << std::endl;
         std::cout << "=============================================" << std::endl << std::endl;
@@ -30,13 +40,208 @@ public:
             SimulationConfig config = getTestConfig();
             
             // Exécution de la simulation
-            runSimulation(scene, config);
+            runSimulation(scene, config, resultsFile, tracksFile, trackSampleEvery);
             
         } catch (const std::exception& e) {
             std::cerr << "ERREUR: " << e.what() << std::endl;
         }
     }
     
+    // Démonstration profilée : rapport par étape et trace Chrome (build ENABLE_PROFILING)
+    static int profileDemo(const std::string& traceFile) {
+        if (!Profiler::isCompiledIn()) {
+            std::cerr << Profiler::getInstance().report();
+            return 1;
+        }
+        
+        Profiler& profiler = Profiler::getInstance();
+        profiler.setTraceCapacity(200000);
+        profiler.reset();
+        runDemo();
+        
+        std::cout << std::endl << profiler.report();
+        try {
+            profiler.writeChromeTrace(traceFile);
+            std::cout << "Trace enregistrée: " << traceFile << std::endl;
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "ERREUR: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    // Relecture d'un fichier de traces : résumé puis détail des premières histoires
+    static int showTracks(const std::string& tracksFile, size_t historyCount) {
+        try {
+            TrackData data = TrackRecorder::readFile(tracksFile);
+            std::vector<uint64_t> histories = data.histories();
+            std::cout << data.steps.size() << " étapes, " << histories.size() << " histoires, "
+                      << data.droppedEvents << " étapes perdues" << std::endl;
+            
+            for (size_t h = 0; h < std::min(historyCount, histories.size()); ++h) {
+                uint64_t id = histories[h];
+                std::cout << std::endl << "Histoire " << (id >> 40) << ":" << (id & ((uint64_t(1) << 40) - 1))
+                          << std::endl;
+                for (const auto& step : data.history(id)) {
+                    std::cout << "  " << std::setw(8) << radiationTypeName(step.particle) << " "
+                              << std::setw(12) << data.materials[step.material] << " "
+                              << std::fixed << std::setprecision(4)
+                              << "(" << step.start.x << ", " << step.start.y << ", " << step.start.z << ") -> ("
+                              << step.end.x << ", " << step.end.y << ", " << step.end.z << ") "
+                              << std::setprecision(1) << step.energy << " keV, poids "
+                              << std::setprecision(3) << step.weight << " : " << trackEventTypeName(step.type)
+                              << std::endl;
+                }
+            }
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "ERREUR: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    // Enregistrement d'un espace des phases : les particules traversant la surface sont écrites
+    // puis abandonnées ; la scène extérieure est ensuite simulée avec une source "phaseSpace"
+    static int recordPhaseSpace(const std::string& sceneFile, const std::string& outputFile,
+                                const std::string& kind, const std::string& values, uint64_t particles) {
+        try {
+            std::vector<float> v;
+            std::stringstream stream(values);
+            for (std::string item; std::getline(stream, item, ',');) v.push_back(std::stof(item));
+            if (v.size() != 6 || (kind != "plane" && kind != "box")) {
+                throw std::runtime_error("Surface attendue : plane x,y,z,nx,ny,nz ou box x0,y0,z0,x1,y1,z1");
+            }
+            glm::vec3 a(v[0], v[1], v[2]), b(v[3], v[4], v[5]);
+            PhaseSpaceSurface surface = kind == "box" ? PhaseSpaceSurface::boxExit(a, b)
+                                                      : PhaseSpaceSurface::plane(a, b);
+            
+            MaterialLibrary::getInstance().loadDefaults();
+            auto scene = std::make_shared<Scene>();
+            scene->loadFromFile(sceneFile);
+            
+            SimulationConfig config = getTestConfig();
+            config.maxParticles = particles;
+            config.numThreads = std::max(1u, std::thread::hardware_concurrency());
+            
+            auto writer = std::make_shared<PhaseSpaceWriter>(outputFile, surface, true);
+            MonteCarloEngine engine(scene);
+            engine.setConfig(config);
+            engine.setPhaseSpaceWriter(writer);
+            engine.startSimulation();
+            engine.waitForCompletion();
+            
+            std::cout << writer->getRecordCount() << " particules enregistrées pour "
+                      << engine.getStats().particlesEmitted.load() << " histoires -> " << outputFile << std::endl;
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "ERREUR: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    // Balayage de variantes sans affichage : scène et spécification JSON, sortie CSV
+    static int runBatch(const std::string& sceneFile, const std::string& sweepFile, const std::string& outputFile) {
+        try {
+            MaterialLibrary::getInstance().loadDefaults();
+            
+            auto scene = std::make_shared<Scene>();
+            scene->loadFromFile(sceneFile);
+            
+            BatchRunner runner(scene, SweepSpec::loadFromFile(sweepFile));
+            BatchSummary summary = runner.run(outputFile);
+            
+            std::cout << summary.variants << " variantes en " << std::fixed << std::setprecision(2)
+                      << summary.elapsedSeconds << " s (" << summary.bvhBuilds << " constructions BVH) -> "
+                      << outputFile << std::endl;
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "ERREUR: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    // Coordinateur d'un run distribué ; localWorkers > 0 : workers lancés en sous-processus
+    // (même exécutable, option --worker) sur la même machine
+    static int runCoordinator(const std::string& sceneFile, const std::string& address, uint64_t histories,
+                              double targetError, uint32_t localWorkers = 0, const std::string& executable = "") {
+        std::vector<pid_t> children;
+        int status = 0;
+        try {
+            MaterialLibrary::getInstance().loadDefaults();
+            auto scene = std::make_shared<Scene>();
+            scene->loadFromFile(sceneFile);
+            
+            SimulationConfig config = getTestConfig();
+            config.maxParticles = histories;
+            MonteCarloEngine engine(scene);
+            engine.setConfig(config);
+            
+            DistributedConfig distributed;
+            distributed.address = address;
+            distributed.targetRelativeError = targetError;
+            distributed.historiesPerRange = std::max<uint64_t>(config.historiesPerStream, histories / 100);
+            if (localWorkers > 0) distributed.idleTimeoutMs = 30000;
+            DistributedCoordinator coordinator(engine, distributed);
+            
+            uint32_t threadsPerWorker = std::max(1u, std::thread::hardware_concurrency() / std::max(1u, localWorkers));
+            for (uint32_t i = 0; i < localWorkers; ++i) {
+                pid_t pid = fork();
+                if (pid == 0) {
+                    std::string threads = std::to_string(threadsPerWorker);
+                    execl(executable.c_str(), executable.c_str(), "--worker", sceneFile.c_str(),
+                          coordinator.getAddress().c_str(), threads.c_str(), static_cast<char*>(nullptr));
+                    _exit(127);
+                }
+                if (pid > 0) children.push_back(pid);
+            }
+            
+            DistributedSummary summary = coordinator.run();
+            std::cout << summary.histories << " histoires, " << summary.ranges << " plages, " << summary.workers
+                      << " workers (" << summary.reassignedRanges << " plages reprises) en " << std::fixed
+                      << std::setprecision(2) << summary.elapsedSeconds << " s" << std::endl;
+            if (targetError > 0.0) {
+                std::cout << (summary.converged ? "Convergence atteinte" : "Convergence non atteinte")
+                          << " (erreur relative max " << std::setprecision(4) << summary.maxRelativeError << ")"
+                          << std::endl;
+            }
+            std::cout << std::endl;
+            displayResults(scene, engine.getStats());
+        } catch (const std::exception& e) {
+            std::cerr << "ERREUR: " << e.what() << std::endl;
+            status = 1;
+        }
+        for (pid_t pid : children) waitpid(pid, nullptr, 0);
+        return status;
+    }
+    
+    static int runWorker(const std::string& sceneFile, const std::string& address, uint32_t threads) {
+        try {
+            MaterialLibrary::getInstance().loadDefaults();
+            auto scene = std::make_shared<Scene>();
+            scene->loadFromFile(sceneFile);
+            
+            SimulationConfig config = getTestConfig();
+            config.numThreads = std::max(1u, threads);
+            MonteCarloEngine engine(scene);
+            engine.setConfig(config);
+            
+            DistributedWorker worker(engine);
+            uint64_t ranges = worker.run(address);
+            std::cout << "Worker terminé: " << ranges << " plages traitées" << std::endl;
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "ERREUR: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    // Export de la scène de démonstration (point de départ pour --batch)
+    static int exportDemoScene(const std::string& filename) {
+        MaterialLibrary::getInstance().loadDefaults();
+        createTestScene()->saveToFile(filename);
+        return 0;
+    }
+    
 private:
     static void initializeMaterials() {
         std::cout << "Initialisation de la bibliothèque de matériaux..." << std::endl;
@@ -135,7 +340,9 @@ private:
         return config;
     }
     
-    static void runSimulation(std::shared_ptr<Scene> scene, const SimulationConfig& config) {
+    static void runSimulation(std::shared_ptr<Scene> scene, const SimulationConfig& config,
+                              const std::string& resultsFile, const std::string& tracksFile,
+                              uint32_t trackSampleEvery) {
         std::cout << "Configuration de la simulation:" << std::endl;
         std::cout << "  - " << config.maxParticles << " particules maximum" << std::endl;
         std::cout << "  - " << config.numThreads << " threads de calcul" << std::endl;
@@ -145,12 +352,25 @@ private:
         // Création du moteur Monte Carlo
         MonteCarloEngine engine(scene);
         engine.setConfig(config);
+        if (!tracksFile.empty()) {
+            TrackRecorderConfig trackConfig;
+            trackConfig.sampleEvery = trackSampleEvery;
+            engine.setTrackRecorder(std::make_shared<TrackRecorder>(tracksFile, trackConfig));
+        }
         
         std::cout << "Démarrage de la simulation..." << std::endl;
         auto startTime = std::chrono::steady_clock::now();
         
         engine.startSimulation();
         
+        // Résultats intermédiaires toutes les secondes, lisibles pendant le calcul
+        std::unique_ptr<ResultsWriter> results;
+        if (!resultsFile.empty()) {
+            results = std::make_unique<ResultsWriter>(resultsFile, false, ColumnWriter::isCompressionAvailable());
+        }
+        uint64_t resultsBatch = 0;
+        int ticks = 0;
+        
         // Affichage du progrès
         std::cout << "Progrès: [";
         const int barWidth = 50;
@@ -172,6 +392,20 @@ private:
                       << stats.particlesTransported.load() << " particules)" << std::flush;
             
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (results && ++ticks % 10 == 0) {
+                results->writeStats(resultsBatch, engine.getStats());
+                results->writeSensors(resultsBatch, scene->getAllSensors());
+                ++resultsBatch;
+            }
+        }
+        engine.waitForCompletion();
+        if (results) {
+            results->writeBatch(resultsBatch, *scene, engine);
+            std::cout << std::endl << "Résultats enregistrés dans: " << resultsFile;
+        }
+        if (auto recorder = engine.getTrackRecorder()) {
+            std::cout << std::endl << "Traces enregistrées dans: " << tracksFile << " ("
+                      << recorder->getRecordedEvents() << " étapes, " << recorder->getDroppedEvents() << " perdues)";
         }
         
         std::cout << std::endl << std::endl;
@@ -200,6 +434,15 @@ private:
         std::cout << "  Particules détectées:   " << stats.particlesDetected.load() << std::endl;
         std::cout << "  Particules échappées:   " << stats.particlesEscaped.load() << std::endl;
         std::cout << "  Intersections de rayons: " << stats.rayIntersections.load() << std::endl;
+        std::cout << "  Secondaires produits:   " << stats.secondariesProduced.load();
+        if (stats.secondariesDropped.load() > 0) {
+            std::cout << " (" << stats.secondariesDropped.load() << " abandonnés, plafond atteint)";
+        }
+        std::cout << std::endl;
+        if (stats.particlesCulled.load() > 0) {
+            std::cout << "  Particules éliminées:   " << stats.particlesCulled.load()
+                      << " (hors d'atteinte des capteurs)" << std::endl;
+        }
         std::cout << "  Taux de simulation:     " << std::fixed << std::setprecision(0) 
                   << stats.getParticleRate() << " particules/s" << std::endl;
         std::cout << std::endl;
@@ -332,11 +575,110 @@ int main(int argc, char* argv[]) {
             std::cout << "OPTIONS:" << std::endl;
             std::cout << "  --help, -h    Afficher cette aide" << std::endl;
             std::cout << "  --version     Afficher la version" << std::endl;
+            std::cout << "  --results <fichier.rcol>" << std::endl;
+            std::cout << "                Enregistrer les résultats de la démonstration (colonnes binaires)" << std::endl;
+            std::cout << "  --tracks <fichier.rtrk> [N]" << std::endl;
+            std::cout << "                Enregistrer les traces d'une histoire sur N (100 par défaut)" << std::endl;
+            std::cout << "  --show-tracks <fichier.rtrk> [histoires]" << std::endl;
+            std::cout << "                Afficher les traces enregistrées (10 histoires par défaut)" << std::endl;
+            std::cout << "  --phase-space <scène> <sortie.rphs> <plane|box> <6 valeurs> [particules]" << std::endl;
+            std::cout << "                Enregistrer les particules traversant un plan (point, normale)" << std::endl;
+            std::cout << "                ou sortant d'une boîte (min, max), valeurs séparées par des virgules" << std::endl;
+            std::cout << "  --profile <trace.json>" << std::endl;
+            std::cout << "                Profiler la démonstration (build ENABLE_PROFILING), trace Chrome" << std::endl;
+            std::cout << "  --batch <scène> <balayage.json> [sortie.csv|sortie.rcol]" << std::endl;
+            std::cout << "                Exécuter toutes les variantes d'un balayage de paramètres" << std::endl;
+            std::cout << "  --coordinator <scène> <adresse> [histoires] [erreur_cible]" << std::endl;
+            std::cout << "                Coordonner un run distribué (adresse hôte:port ou unix:/chemin)" << std::endl;
+            std::cout << "  --worker <scène> <adresse> [threads]" << std::endl;
+            std::cout << "                Traiter les plages d'histoires d'un coordinateur" << std::endl;
+            std::cout << "  --distributed <scène> <workers> [histoires] [erreur_cible]" << std::endl;
+            std::cout << "                Run distribué local (workers en sous-processus)" << std::endl;
+            std::cout << "  --export-scene <fichier>" << std::endl;
+            std::cout << "                Enregistrer la scène de démonstration (.json ou .rsb)" << std::endl;
             std::cout << std::endl;
             return 0;
         } else if (arg == "--version") {
             std::cout << "Version 1.0.0 - Démonstration Console" << std::endl;
             return 0;
+        } else if (arg == "--batch") {
+            if (argc < 4) {
+                std::cerr << "Usage: " << argv[0] << " --batch <scène> <balayage.json> [sortie.csv]" << std::endl;
+                return 1;
+            }
+            return ConsoleDemo::runBatch(argv[2], argv[3], argc > 4 ? argv[4] : "batch_results.csv");
+        } else if (arg == "--results") {
+            if (argc < 3) {
+                std::cerr << "Usage: " << argv[0] << " --results <fichier.rcol>" << std::endl;
+                return 1;
+            }
+            try {
+                ConsoleDemo::runDemo(argv[2]);
+                return 0;
+            } catch (const std::exception& e) {
+                std::cerr << "Erreur fatale: " << e.what() << std::endl;
+                return 1;
+            }
+        } else if (arg == "--tracks") {
+            if (argc < 3) {
+                std::cerr << "Usage: " << argv[0] << " --tracks <fichier.rtrk> [N]" << std::endl;
+                return 1;
+            }
+            try {
+                uint32_t sampleEvery = argc > 3 ? static_cast<uint32_t>(std::stoul(argv[3])) : 100;
+                ConsoleDemo::runDemo("", argv[2], std::max(1u, sampleEvery));
+                return 0;
+            } catch (const std::exception& e) {
+                std::cerr << "Erreur fatale: " << e.what() << std::endl;
+                return 1;
+            }
+        } else if (arg == "--show-tracks") {
+            if (argc < 3) {
+                std::cerr << "Usage: " << argv[0] << " --show-tracks <fichier.rtrk> [histoires]" << std::endl;
+                return 1;
+            }
+            return ConsoleDemo::showTracks(argv[2], argc > 3 ? std::stoul(argv[3]) : 10);
+        } else if (arg == "--phase-space") {
+            if (argc < 6) {
+                std::cerr << "Usage: " << argv[0]
+                          << " --phase-space <scène> <sortie.rphs> <plane|box> <6 valeurs> [particules]" << std::endl;
+                return 1;
+            }
+            return ConsoleDemo::recordPhaseSpace(argv[2], argv[3], argv[4], argv[5],
+                                                 argc > 6 ? std::stoull(argv[6]) : 100000);
+        } else if (arg == "--profile") {
+            return ConsoleDemo::profileDemo(argc > 2 ? argv[2] : "profile_trace.json");
+        } else if (arg == "--coordinator") {
+            if (argc < 4) {
+                std::cerr << "Usage: " << argv[0] << " --coordinator <scène> <adresse> [histoires] [erreur_cible]"
+                          << std::endl;
+                return 1;
+            }
+            return ConsoleDemo::runCoordinator(argv[2], argv[3], argc > 4 ? std::stoull(argv[4]) : 1000000,
+                                               argc > 5 ? std::stod(argv[5]) : 0.0);
+        } else if (arg == "--worker") {
+            if (argc < 4) {
+                std::cerr << "Usage: " << argv[0] << " --worker <scène> <adresse> [threads]" << std::endl;
+                return 1;
+            }
+            return ConsoleDemo::runWorker(argv[2], argv[3], argc > 4 ? static_cast<uint32_t>(std::stoul(argv[4]))
+                                                                     : std::thread::hardware_concurrency());
+        } else if (arg == "--distributed") {
+            if (argc < 4) {
+                std::cerr << "Usage: " << argv[0] << " --distributed <scène> <workers> [histoires] [erreur_cible]"
+                          << std::endl;
+                return 1;
+            }
+            std::string address = "unix:/tmp/radiation_sim_" + std::to_string(getpid()) + ".sock";
+            return ConsoleDemo::runCoordinator(argv[2], address, argc > 4 ? std::stoull(argv[4]) : 1000000,
+                                               argc > 5 ? std::stod(argv[5]) : 0.0,
+                                               static_cast<uint32_t>(std::stoul(argv[3])), argv[0]);
+        } else if (arg == "--export-scene") {
+            if (argc < 3) {
+                std::cerr << "Usage: " << argv[0] << " --export-scene <fichier>" << std::endl;
+                return 1;
+            }
+            return ConsoleDemo::exportDemoScene(argv[2]);
         }
     }
     
@@ -66,6 +66,30 @@ AABB Box::computeLocalBounds() const {
     return AABB(-halfSize, halfSize);
 }
 
+float Box::surfaceDistanceBound(const glm::vec3& point) const {
+    const AABB& bounds = getBounds();
+    if (!bounds.contains(point)) {
+        return bounds.distanceTo(point);
+    }
+
+    // Repère local sans matrice complète (appelé à chaque pas par l'élimination du moteur)
+    glm::vec3 local = point - m_transform.position;
+    const glm::quat& rotation = m_transform.rotation;
+    if (rotation.w < 1.0f) {
+        local = glm::vec3(glm::mat4_cast(glm::conjugate(rotation)) * glm::vec4(local, 0.0f));
+    }
+    const glm::vec3& scale = m_transform.scale;
+    local = glm::vec3(local.x / scale.x, local.y / scale.y, local.z / scale.z);
+    if (!containsPoint(local)) {
+        return 0.0f;
+    }
+
+    // Face la plus proche dans l'espace local, ramenée au monde par la plus petite échelle
+    glm::vec3 margin = m_size * 0.5f - glm::abs(local);
+    float minScale = std::min({std::abs(scale.x), std::abs(scale.y), std::abs(scale.z)});
+    return std::min({margin.x, margin.y, margin.z}) * minScale;
+}
+
 bool Box::containsPoint(const glm::vec3& point) const {
     glm::vec3 halfSize = m_size * 0.5f;
     return (point.x >= -halfSize.x && point.x <= halfSize.x &&
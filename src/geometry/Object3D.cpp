@@ -1,6 +1,6 @@
 #include "geometry/Object3D.h"
 
-uint32_t Object3D::s_nextId = 1;
+std::atomic<uint32_t> Object3D::s_nextId{1};
 
 // Transform implementation
 glm::mat4 Transform::getMatrix() const {
@@ -67,6 +67,11 @@ bool AABB::contains(const glm::vec3& point) const {
             point.z >= min.z && point.z <= max.z);
 }
 
+float AABB::distanceTo(const glm::vec3& point) const {
+    glm::vec3 outside = glm::max(glm::max(min - point, point - max), glm::vec3(0.0f));
+    return glm::length(outside);
+}
+
 bool AABB::intersects(const AABB& other) const {
     return (min.x <= other.max.x && max.x >= other.min.x &&
             min.y <= other.max.y && max.y >= other.min.y &&
@@ -141,6 +146,21 @@ const AABB& Object3D::getBounds() const {
     return m_bounds;
 }
 
+void Object3D::setBiasing(const RegionBiasing& biasing) {
+    if (biasing.exponentialTransform < 0.0f || biasing.exponentialTransform >= 1.0f) {
+        throw std::runtime_error("Transformation exponentielle de " + m_name + " : paramètre hors de [0, 1[");
+    }
+    if (glm::length(biasing.preferredDirection) <= 0.0f) {
+        throw std::runtime_error("Transformation exponentielle de " + m_name + " : direction nulle");
+    }
+    m_biasing = biasing;
+    m_biasing.preferredDirection = glm::normalize(biasing.preferredDirection);
+}
+
+float Object3D::surfaceDistanceBound(const glm::vec3& point) const {
+    return getBounds().distanceTo(point);
+}
+
 // GeometricPrimitive implementation
 IntersectionResult GeometricPrimitive::intersect(const Ray& ray) const {
     // Transformation du rayon vers l'espace local
@@ -0,0 +1,1017 @@
+#include "common.h"
+#include "core/Scene.h"
+#include "core/Material.h"
+#include "core/Sensor.h"
+#include "core/Source.h"
+#include "geometry/Box.h"
+#include "simulation/MonteCarloEngine.h"
+#include "simulation/Particle.h"
+#include "utils/BVH.h"
+#include "utils/NumaTopology.h"
+#include "utils/Profiler.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+#ifndef BENCH_BUILD_TYPE
+#define BENCH_BUILD_TYPE ""
+#endif
+
+// Suite de mesures de performance : micro-benchmarks (BVH, matériaux, spectres, capteurs),
+// transport complet (scène de démonstration, installation synthétique), passage à l'échelle
+// en threads et facteur de mérite de la réduction de variance. Chaque cas est répété ; le
+// fichier JSON conserve tous les échantillons pour la comparaison entre versions (bench_compare).
+
+namespace {
+
+// Compteurs d'allocations et de libérations sur le tas (opérateurs globaux remplacés
+// ci-dessous), actifs pendant les runs mesurés des cas allocations/
+std::atomic<bool> g_countAllocations{false};
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_deallocations{0};
+
+// Point unique d'allocation et de libération de toutes les formes remplacées (scalaire,
+// tableau, dimensionnée, alignée, nothrow). Hors ligne : le compilateur ne voit pas free()
+// appliqué au résultat d'operator new (-Wmismatched-new-delete)
+[[gnu::noinline]] void* countedAllocate(std::size_t size, std::size_t alignment) noexcept {
+    if (g_countAllocations.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    size = size ? size : 1;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) return std::malloc(size);
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+[[gnu::noinline]] void countedRelease(void* memory) noexcept {
+    if (!memory) return;
+    if (g_countAllocations.load(std::memory_order_relaxed)) {
+        g_deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::free(memory);
+}
+
+void* allocateOrThrow(std::size_t size, std::size_t alignment) {
+    if (void* memory = countedAllocate(size, alignment)) return memory;
+    throw std::bad_alloc();
+}
+
+constexpr std::size_t DEFAULT_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+} // namespace
+
+void* operator new(std::size_t size) { return allocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, DEFAULT_ALIGNMENT);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, DEFAULT_ALIGNMENT);
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept { countedRelease(memory); }
+void operator delete[](void* memory) noexcept { countedRelease(memory); }
+void operator delete(void* memory, std::size_t) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { countedRelease(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { countedRelease(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { countedRelease(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { countedRelease(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { countedRelease(memory); }
+
+namespace {
+
+struct BenchOptions {
+    std::string output = "bench_results.json";
+    std::string filter;       // Préfixe du nom des cas à exécuter (vide : tous)
+    uint32_t repeat = 5;
+    uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    bool quick = false;       // Tailles réduites (CTest, vérification rapide)
+    bool checkAllocations = false; // Échec si le transport alloue en régime établi
+    bool checkAttenuation = false; // Échec si un cas variance/absorber/ s'écarte de exp(-μx)
+
+    uint32_t bvhObjects() const { return quick ? 1024 : 16384; }
+    uint32_t rayCount() const { return quick ? 20000 : 200000; }
+    uint32_t lookupCount() const { return quick ? 100000 : 2000000; }
+    uint32_t facilityRooms() const { return quick ? 4 : 10; } // Salles par côté
+    uint64_t demoHistories() const { return quick ? 5000 : 50000; }
+    uint64_t facilityHistories() const { return quick ? 1000 : 20000; }
+    uint64_t weakHistoriesPerThread() const { return quick ? 500 : 5000; }
+    uint32_t varianceBatches() const { return quick ? 10 : 20; }
+    uint64_t varianceHistories() const { return quick ? 500 : 5000; } // Par lot
+};
+
+struct Metric {
+    std::string name;
+    std::string unit;
+    bool higherIsBetter = false;
+    std::vector<double> samples;
+
+    double median() const {
+        if (samples.empty()) return 0.0;
+        std::vector<double> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        size_t mid = sorted.size() / 2;
+        return sorted.size() % 2 ? sorted[mid] : 0.5 * (sorted[mid - 1] + sorted[mid]);
+    }
+};
+
+struct BenchCase {
+    std::string name;
+    uint32_t threads = 1;
+    uint64_t operations = 0; // Opérations (rayons, tirages, histoires) par échantillon
+    std::vector<Metric> metrics;
+    std::vector<std::pair<std::string, double>> info; // Valeurs descriptives, non comparées
+
+    double infoValue(const std::string& key) const {
+        for (const auto& [name, value] : info) {
+            if (name == key) return value;
+        }
+        return 0.0;
+    }
+};
+
+// Empêche l'élimination des boucles mesurées par l'optimiseur
+volatile double g_sink = 0.0;
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Une passe de chauffe puis `repeat` échantillons de ns/opération
+template <typename Func>
+Metric timePerOperation(const std::string& name, uint32_t repeat, uint64_t operations, Func&& run) {
+    Metric metric{name, "ns", false, {}};
+    g_sink = g_sink + run();
+    for (uint32_t r = 0; r < repeat; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        double result = run();
+        metric.samples.push_back(elapsedNs(start) / static_cast<double>(operations));
+        g_sink = g_sink + result;
+    }
+    return metric;
+}
+
+std::vector<glm::vec3> randomPoints(const AABB& bounds, size_t count) {
+    std::vector<glm::vec3> points(count);
+    for (auto& point : points) {
+        point = glm::vec3(RandomGenerator::randomRange(bounds.min.x, bounds.max.x),
+                          RandomGenerator::randomRange(bounds.min.y, bounds.max.y),
+                          RandomGenerator::randomRange(bounds.min.z, bounds.max.z));
+    }
+    return points;
+}
+
+// Nuage de boîtes de tailles variées dans un cube de côté proportionnel à N^(1/3)
+std::vector<std::shared_ptr<Object3D>> syntheticBoxes(uint32_t count) {
+    auto& materials = MaterialLibrary::getInstance();
+    auto lead = materials.getMaterial("Plomb");
+    auto concrete = materials.getMaterial("Béton");
+
+    float extent = 2.0f * std::cbrt(static_cast<float>(count));
+    std::vector<std::shared_ptr<Object3D>> objects;
+    objects.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        glm::vec3 size(RandomGenerator::randomRange(0.1f, 1.0f), RandomGenerator::randomRange(0.1f, 1.0f),
+                       RandomGenerator::randomRange(0.1f, 1.0f));
+        auto box = std::make_shared<Box>("Boite_" + std::to_string(i), size);
+        box->setPosition(glm::vec3(RandomGenerator::randomRange(-extent, extent),
+                                   RandomGenerator::randomRange(-extent, extent),
+                                   RandomGenerator::randomRange(-extent, extent)));
+        box->setMaterial(i % 4 == 0 ? lead : concrete);
+        objects.push_back(box);
+    }
+    return objects;
+}
+
+// Scène de la démonstration console : source Cs-137, plomb 5 cm puis béton 30 cm
+std::shared_ptr<Scene> demoScene() {
+    auto& materials = MaterialLibrary::getInstance();
+    auto scene = std::make_shared<Scene>();
+
+    auto leadWall = std::make_shared<Box>("Mur_Plomb", glm::vec3(2.0f, 2.0f, 0.05f));
+    leadWall->setMaterial(materials.getMaterial("Plomb"));
+    scene->addObject(leadWall);
+
+    auto concreteWall = std::make_shared<Box>("Mur_Beton", glm::vec3(2.0f, 2.0f, 0.3f));
+    concreteWall->setMaterial(materials.getMaterial("Béton"));
+    concreteWall->setPosition(glm::vec3(0.0f, 0.0f, 0.5f));
+    scene->addObject(concreteWall);
+
+    auto source = std::make_shared<IsotropicSource>("Cs-137", RadiationType::GAMMA);
+    source->setPosition(glm::vec3(0.0f, 0.0f, -1.0f));
+    source->setIntensity(1e6);
+    EnergySpectrum spectrum;
+    spectrum.energy = 662.0f;
+    source->setSpectrum(spectrum);
+    scene->addSource(source);
+
+    scene->addSensor(std::make_shared<Sensor>("Avant_Blindage", SensorType::POINT, glm::vec3(0.0f, 0.0f, -0.5f)));
+    scene->addSensor(std::make_shared<Sensor>("Apres_Plomb", SensorType::POINT, glm::vec3(0.0f, 0.0f, 0.1f)));
+    scene->addSensor(std::make_shared<Sensor>("Apres_Beton", SensorType::POINT, glm::vec3(0.0f, 0.0f, 1.0f)));
+
+    scene->buildAccelerationStructure();
+    return scene;
+}
+
+// Installation synthétique : grille de salles 6 m × 6 m séparées par des murs de béton percés
+// d'une porte, dalle et plafond, un blindage de plomb et une armoire d'acier par salle,
+// un capteur par salle et une source dans une salle sur quatre (Cs-137 ou Co-60)
+std::shared_ptr<Scene> facilityScene(uint32_t rooms) {
+    auto& materials = MaterialLibrary::getInstance();
+    auto concrete = materials.getMaterial("Béton");
+    auto lead = materials.getMaterial("Plomb");
+    auto steel = materials.getMaterial("Acier");
+    auto scene = std::make_shared<Scene>();
+
+    const float room = 6.0f, height = 3.0f, wall = 0.3f, door = 1.0f;
+    const float half = 0.5f * room * rooms;
+    const float segment = 0.5f * (room - door); // Mur de part et d'autre de la porte
+    std::vector<std::shared_ptr<Object3D>> objects;
+
+    auto addBox = [&](const std::string& name, const glm::vec3& size, const glm::vec3& position,
+                      std::shared_ptr<Material> material) {
+        auto box = std::make_shared<Box>(name, size);
+        box->setPosition(position);
+        box->setMaterial(material);
+        objects.push_back(box);
+    };
+
+    float span = room * rooms + wall;
+    addBox("Dalle", glm::vec3(span, span, wall), glm::vec3(0.0f, 0.0f, -0.5f * wall), concrete);
+    addBox("Plafond", glm::vec3(span, span, wall), glm::vec3(0.0f, 0.0f, height + 0.5f * wall), concrete);
+
+    for (uint32_t line = 0; line <= rooms; ++line) {
+        float fixed = -half + line * room;
+        for (uint32_t cell = 0; cell < rooms; ++cell) {
+            float start = -half + cell * room;
+            for (int side = 0; side < 2; ++side) {
+                // Les murs Y couvrent les angles, les murs X s'arrêtent à leur face (pas de recouvrement)
+                float center = start + (side == 0 ? 0.5f * segment : room - 0.5f * segment);
+                float shortened = segment - 0.5f * wall;
+                float centerX = start + (side == 0 ? 0.5f * wall + 0.5f * shortened : room - 0.5f * wall - 0.5f * shortened);
+                std::string suffix = std::to_string(line) + "_" + std::to_string(cell) + "_" + std::to_string(side);
+                addBox("MurX_" + suffix, glm::vec3(wall, shortened, height), glm::vec3(fixed, centerX, 0.5f * height),
+                       concrete);
+                addBox("MurY_" + suffix, glm::vec3(segment, wall, height), glm::vec3(center, fixed, 0.5f * height),
+                       concrete);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < rooms; ++i) {
+        for (uint32_t j = 0; j < rooms; ++j) {
+            glm::vec3 center(-half + (i + 0.5f) * room, -half + (j + 0.5f) * room, 0.0f);
+            std::string suffix = std::to_string(i) + "_" + std::to_string(j);
+            addBox("Blindage_" + suffix, glm::vec3(0.1f, 1.0f, 1.0f), center + glm::vec3(1.0f, 0.0f, 1.0f), lead);
+            addBox("Armoire_" + suffix, glm::vec3(0.6f, 1.2f, 2.0f), center + glm::vec3(-2.0f, 2.0f, 1.0f), steel);
+
+            scene->addSensor(std::make_shared<Sensor>("Capteur_" + suffix, SensorType::POINT,
+                                                      center + glm::vec3(2.0f, 0.0f, 1.0f)));
+
+            if ((i + j * rooms) % 4 == 0) {
+                auto source = std::make_shared<IsotropicSource>("Source_" + suffix, RadiationType::GAMMA);
+                source->setPosition(center + glm::vec3(0.0f, 0.0f, 1.0f));
+                source->setIntensity(1e6);
+                EnergySpectrum spectrum;
+                if ((i + j) % 2 == 0) {
+                    spectrum.energy = 662.0f;
+                } else {
+                    spectrum.type = EnergySpectrum::DISCRETE;
+                    spectrum.spectrum = {{1173.2f, 1.0f}, {1332.5f, 1.0f}};
+                }
+                source->setSpectrum(spectrum);
+                scene->addSource(source);
+            }
+        }
+    }
+
+    scene->addObjects(objects);
+    scene->buildAccelerationStructure();
+    return scene;
+}
+
+// Écran d'eau de huit libres parcours à 662 keV (Cs-137 en faisceau étroit), capteur volumique
+// derrière, toutes énergies : la fluence y est surtout diffusée, après plusieurs collisions
+// dont chacune peut finir en absorption photoélectrique (cas de la capture implicite)
+std::shared_ptr<Scene> shieldingScene() {
+    auto water = MaterialLibrary::getInstance().getMaterial("Eau");
+    const float thickness = 8.0f / water->getLinearAttenuationPerMeter(RadiationType::GAMMA, 662.0f);
+    auto scene = std::make_shared<Scene>();
+
+    auto wall = std::make_shared<Box>("Ecran_Eau", glm::vec3(2.0f, 2.0f, thickness));
+    wall->setMaterial(water);
+    wall->setPosition(glm::vec3(0.0f, 0.0f, 0.5f * thickness));
+    scene->addObject(wall);
+
+    auto source = std::make_shared<DirectionalSource>("Cs-137", RadiationType::GAMMA);
+    source->setPosition(glm::vec3(0.0f, 0.0f, -0.5f));
+    source->setDirection(glm::vec3(0.0f, 0.0f, 1.0f));
+    source->setBeamAngle(0.1f);
+    source->setIntensity(1e6);
+    EnergySpectrum spectrum;
+    spectrum.energy = 662.0f;
+    source->setSpectrum(spectrum);
+    scene->addSource(source);
+
+    auto sensor = std::make_shared<Sensor>("Derriere_Ecran", SensorType::VOLUME,
+                                           glm::vec3(0.0f, 0.0f, thickness + 0.1f));
+    sensor->setSize(glm::vec3(1.0f, 1.0f, 0.1f));
+    scene->addSensor(sensor);
+
+    scene->buildAccelerationStructure();
+    return scene;
+}
+
+// Écran absorbant pur (photoélectrique seul, μ = 10 m⁻¹, trois libres parcours) en faisceau
+// étroit. Aucune particule diffusée : la fluence par histoire du capteur (1 m² × 0,1 m, traversé
+// sur 0,1 m, soit L / V = 1 m⁻²) vaut la transmission exp(-μx), biaisage compris
+constexpr float ABSORBER_MU = 10.0f;       // m⁻¹
+constexpr float ABSORBER_THICKNESS = 0.3f; // m
+
+std::shared_ptr<Scene> absorberScene(const RegionBiasing& biasing) {
+    auto absorber = std::make_shared<Material>("Absorbeur_Pur", 1.0f);
+    for (float energy : {10.0f, 100.0f, 662.0f, 3000.0f}) {
+        AttenuationData data;
+        data.energy = energy;
+        data.linearCoeff = ABSORBER_MU * 0.01f; // cm⁻¹
+        data.photoelectric = 1.0f;
+        absorber->addAttenuationData(RadiationType::GAMMA, data);
+    }
+    absorber->finalize();
+
+    auto scene = std::make_shared<Scene>();
+    auto slab = std::make_shared<Box>("Ecran_Absorbant", glm::vec3(4.0f, 4.0f, ABSORBER_THICKNESS));
+    slab->setMaterial(absorber);
+    slab->setPosition(glm::vec3(0.0f, 0.0f, 0.5f * ABSORBER_THICKNESS));
+    slab->setBiasing(biasing);
+    scene->addObject(slab);
+
+    auto source = std::make_shared<DirectionalSource>("Faisceau", RadiationType::GAMMA);
+    source->setPosition(glm::vec3(0.0f, 0.0f, -0.1f));
+    source->setDirection(glm::vec3(0.0f, 0.0f, 1.0f));
+    source->setBeamAngle(0.0f);
+    source->setIntensity(1e6);
+    EnergySpectrum spectrum;
+    spectrum.energy = 662.0f;
+    source->setSpectrum(spectrum);
+    scene->addSource(source);
+
+    auto sensor = std::make_shared<Sensor>("Derriere_Absorbant", SensorType::VOLUME,
+                                           glm::vec3(0.0f, 0.0f, ABSORBER_THICKNESS + 0.1f));
+    sensor->setSize(glm::vec3(1.0f, 1.0f, 0.1f));
+    scene->addSensor(sensor);
+
+    scene->buildAccelerationStructure();
+    return scene;
+}
+
+SimulationConfig transportConfig(uint64_t histories, uint32_t threads) {
+    SimulationConfig config;
+    config.maxParticles = histories;
+    config.maxBounces = 20;
+    config.energyCutoff = 10.0f;
+    config.timeCutoff = 1e6f;
+    config.enableBackgroundSubtraction = false;
+    config.useRussianRoulette = true;
+    config.russianRouletteThreshold = 0.1f;
+    config.numThreads = threads;
+    return config;
+}
+
+// Transport complet : histoires/s et ns par lancer de rayon (temps mur / rayons)
+BenchCase runTransport(const std::string& name, std::shared_ptr<Scene> scene, uint64_t histories, uint32_t threads,
+                       uint32_t repeat, bool numaPlacement = false) {
+    BenchCase result;
+    result.name = name;
+    result.threads = threads;
+    result.operations = histories;
+
+    Metric rate{"histories_per_s", "1/s", true, {}};
+    Metric perRay{"ns_per_ray", "ns", false, {}};
+
+    MonteCarloEngine engine(scene);
+    SimulationConfig config = transportConfig(histories, threads);
+    config.pinThreads = numaPlacement;
+    config.numaReplicas = numaPlacement;
+    engine.setConfig(config);
+    for (uint32_t r = 0; r <= repeat; ++r) {
+        for (const auto& sensor : scene->getAllSensors()) {
+            sensor->clearStats();
+        }
+        engine.resetStats();
+        engine.startSimulation();
+        engine.waitForCompletion();
+
+        if (r == 0) continue; // Chauffe
+        const auto& stats = engine.getStats();
+        double seconds = stats.getElapsedTime();
+        uint64_t rays = stats.rayIntersections.load();
+        rate.samples.push_back(seconds > 0.0 ? stats.particlesEmitted.load() / seconds : 0.0);
+        perRay.samples.push_back(rays > 0 ? seconds * 1e9 / static_cast<double>(rays) : 0.0);
+        if (r == repeat) {
+            result.info.push_back({"rays_per_history", static_cast<double>(rays) / std::max<uint64_t>(1, histories)});
+        }
+    }
+
+    result.metrics = {rate, perRay};
+    return result;
+}
+
+// Allocations d'un run complet de histories histoires sur un moteur déjà configuré
+// (libérations du même run dans deallocations si fourni)
+uint64_t countRunAllocations(MonteCarloEngine& engine, uint64_t histories, uint64_t* deallocations = nullptr) {
+    SimulationConfig config = engine.getConfig();
+    config.maxParticles = histories;
+    engine.setConfig(config);
+    for (const auto& sensor : engine.getScene()->getAllSensors()) {
+        sensor->clearStats();
+    }
+    engine.resetStats();
+
+    g_allocations = 0;
+    g_deallocations = 0;
+    g_countAllocations = true;
+    engine.startSimulation();
+    engine.waitForCompletion();
+    g_countAllocations = false;
+    if (deallocations) *deallocations = g_deallocations.load();
+    return g_allocations.load();
+}
+
+// Allocations par histoire en régime établi : runs de N puis 2N histoires après chauffe.
+// La préparation du run (threads, contextes, journal) est la même : la différence ne
+// contient que le transport, attendu sans allocation (arènes par thread)
+BenchCase runAllocations(const std::string& name, MonteCarloEngine& engine, uint64_t histories, uint32_t repeat) {
+    BenchCase result;
+    result.name = name;
+    result.threads = engine.getConfig().numThreads;
+    result.operations = histories;
+
+    Metric perHistory{"allocations_per_history", "1", false, {}};
+    countRunAllocations(engine, 2 * histories); // Chauffe : arènes, blocs des tallies
+    uint64_t single = 0, singleFrees = 0;
+    for (uint32_t r = 0; r < repeat; ++r) {
+        single = countRunAllocations(engine, histories, &singleFrees);
+        uint64_t twice = countRunAllocations(engine, 2 * histories);
+        double steady = twice > single ? static_cast<double>(twice - single) : 0.0;
+        perHistory.samples.push_back(steady / static_cast<double>(histories));
+    }
+    result.info.push_back({"run_allocations", static_cast<double>(single)});
+    result.info.push_back({"run_deallocations", static_cast<double>(singleFrees)});
+    result.metrics = {perHistory};
+    return result;
+}
+
+// Facteur de mérite 1 / (R² T) de la fluence du premier capteur : R erreur relative entre lots
+// de graines distinctes (reproductibles), T temps de calcul cumulé
+BenchCase runFigureOfMerit(const std::string& name, std::shared_ptr<Scene> scene, const SimulationConfig& base,
+                           uint32_t batches, uint64_t histories, uint32_t repeat) {
+    BenchCase result;
+    result.name = name;
+    result.threads = 1;
+    result.operations = batches * histories;
+
+    Metric fom{"figure_of_merit", "1/s", true, {}};
+    Metric rate{"histories_per_s", "1/s", true, {}};
+    const auto& sensor = scene->getAllSensors().front();
+    MonteCarloEngine engine(scene);
+    double mean = 0.0, relativeError = 0.0;
+    for (uint32_t r = 0; r < repeat; ++r) {
+        double sum = 0.0, sumSquares = 0.0, seconds = 0.0;
+        for (uint32_t b = 0; b < batches; ++b) {
+            SimulationConfig config = base;
+            config.maxParticles = histories;
+            config.numThreads = 1;
+            config.rngSeed = 1 + static_cast<uint64_t>(r) * batches + b;
+            engine.setConfig(config);
+            sensor->clearStats();
+            engine.resetStats();
+            engine.startSimulation();
+            engine.waitForCompletion();
+
+            double fluence = sensor->getStats().trackLengthFluence.load() / static_cast<double>(histories);
+            sum += fluence;
+            sumSquares += fluence * fluence;
+            seconds += engine.getStats().getElapsedTime();
+        }
+        mean = sum / batches;
+        double variance = std::max(0.0, (sumSquares / batches - mean * mean) * batches / (batches - 1.0));
+        relativeError = mean > 0.0 ? std::sqrt(variance / batches) / mean : 0.0;
+        fom.samples.push_back(relativeError > 0.0 && seconds > 0.0 ? 1.0 / (relativeError * relativeError * seconds)
+                                                                    : 0.0);
+        rate.samples.push_back(seconds > 0.0 ? batches * histories / seconds : 0.0);
+    }
+
+    result.info = {{"fluence", mean}, {"relative_error", relativeError}};
+    result.metrics = {fom, rate};
+    return result;
+}
+
+std::vector<uint32_t> threadCounts(uint32_t maxThreads) {
+    std::vector<uint32_t> counts;
+    for (uint32_t t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+class BenchSuite {
+public:
+    explicit BenchSuite(const BenchOptions& options) : m_options(options) {}
+
+    void run() {
+        if (selected("bvh")) benchBvh();
+        if (selected("material")) benchMaterials();
+        if (selected("spectrum")) benchSpectra();
+        if (selected("sensor")) benchSensors();
+        if (selected("transport")) benchTransport();
+        if (selected("scaling")) benchScaling();
+        if (selected("allocations")) benchAllocations();
+        if (selected("variance")) benchVarianceReduction();
+        if (selected("variance/absorber")) benchRegionBiasing();
+    }
+
+    // Somme des allocations par histoire (médianes) des cas allocations/
+    double steadyStateAllocations() const {
+        double total = 0.0;
+        for (const auto& benchCase : m_cases) {
+            if (benchCase.name.rfind("allocations/", 0) == 0) total += benchCase.metrics[0].median();
+        }
+        return total;
+    }
+
+    // Cas variance/absorber/ dont la fluence s'écarte de la transmission analytique de plus de
+    // cinq erreurs statistiques (plancher relatif 1e-4 : arrondis en simple précision)
+    std::vector<std::string> attenuationFailures() const {
+        std::vector<std::string> failures;
+        for (const auto& benchCase : m_cases) {
+            if (benchCase.name.rfind("variance/absorber/", 0) != 0) continue;
+            double fluence = benchCase.infoValue("fluence");
+            double expected = benchCase.infoValue("analytical");
+            double error = benchCase.infoValue("relative_error") * fluence;
+            if (std::abs(fluence - expected) > 5.0 * error + 1e-4 * expected) failures.push_back(benchCase.name);
+        }
+        return failures;
+    }
+
+    void writeJson(const std::string& filename) const;
+    void printSummary() const;
+
+private:
+    BenchOptions m_options;
+    std::vector<BenchCase> m_cases;
+
+    bool selected(const std::string& group) const {
+        const std::string& filter = m_options.filter;
+        return filter.empty() || filter.rfind(group, 0) == 0 || group.rfind(filter, 0) == 0;
+    }
+
+    void add(BenchCase benchCase) {
+        if (benchCase.name.rfind(m_options.filter, 0) != 0) return;
+        std::cout << "  " << std::left << std::setw(32) << benchCase.name << std::right;
+        for (const auto& metric : benchCase.metrics) {
+            std::cout << "  " << metric.name << " = " << std::setprecision(4) << metric.median();
+        }
+        std::cout << std::endl;
+        m_cases.push_back(std::move(benchCase));
+    }
+
+    void benchBvh() {
+        uint32_t objectCount = m_options.bvhObjects();
+        auto objects = syntheticBoxes(objectCount);
+
+        BenchCase build{"bvh/build/" + std::to_string(objectCount), 1, objectCount, {}, {}};
+        build.metrics.push_back(timePerOperation("ns_per_object", m_options.repeat, objectCount, [&]() {
+            BVH bvh;
+            bvh.build(objects);
+            return static_cast<double>(bvh.getNodeCount());
+        }));
+        add(build);
+
+        BVH bvh;
+        bvh.build(objects);
+        auto statistics = bvh.getStatistics();
+
+        AABB bounds;
+        for (const auto& object : objects) bounds.expand(object->getBounds());
+        uint32_t rayCount = m_options.rayCount();
+        auto origins = randomPoints(bounds, rayCount);
+        std::vector<glm::vec3> directions(rayCount);
+        for (auto& direction : directions) direction = RandomGenerator::randomDirection();
+
+        BenchCase closest{"bvh/traverse/" + std::to_string(objectCount), 1, rayCount, {}, {}};
+        closest.metrics.push_back(timePerOperation("ns_per_ray", m_options.repeat, rayCount, [&]() {
+            double sum = 0.0;
+            for (uint32_t i = 0; i < rayCount; ++i) {
+                IntersectionResult hit = bvh.intersect(Ray(origins[i], directions[i]));
+                if (hit.hit) sum += hit.distance;
+            }
+            return sum;
+        }));
+        closest.info = {{"nodes", static_cast<double>(statistics.totalNodes)},
+                        {"max_depth", static_cast<double>(statistics.maxDepth)}};
+        add(closest);
+
+        BenchCase occlusion{"bvh/occlusion/" + std::to_string(objectCount), 1, rayCount, {}, {}};
+        occlusion.metrics.push_back(timePerOperation("ns_per_ray", m_options.repeat, rayCount, [&]() {
+            double hits = 0.0;
+            for (uint32_t i = 0; i < rayCount; ++i) {
+                if (bvh.intersectAny(Ray(origins[i], directions[i]))) hits += 1.0;
+            }
+            return hits;
+        }));
+        add(occlusion);
+    }
+
+    void benchMaterials() {
+        auto& library = MaterialLibrary::getInstance();
+        std::vector<std::shared_ptr<Material>> materials = {library.getMaterial("Plomb"), library.getMaterial("Béton"),
+                                                            library.getMaterial("Air")};
+        uint32_t count = m_options.lookupCount();
+        std::vector<float> energies(count);
+        for (auto& energy : energies) energy = std::exp(RandomGenerator::randomRange(std::log(10.0f), std::log(3000.0f)));
+
+        BenchCase attenuation{"material/attenuation", 1, count, {}, {}};
+        attenuation.metrics.push_back(timePerOperation("ns_per_lookup", m_options.repeat, count, [&]() {
+            double sum = 0.0;
+            for (uint32_t i = 0; i < count; ++i) {
+                sum += materials[i % materials.size()]->getLinearAttenuationPerMeter(RadiationType::GAMMA, energies[i]);
+            }
+            return sum;
+        }));
+        add(attenuation);
+
+        BenchCase interaction{"material/interaction", 1, count, {}, {}};
+        interaction.metrics.push_back(timePerOperation("ns_per_sample", m_options.repeat, count, [&]() {
+            double sum = 0.0;
+            for (uint32_t i = 0; i < count; ++i) {
+                sum += static_cast<double>(
+                    materials[i % materials.size()]->sampleInteraction(RadiationType::GAMMA, energies[i]));
+            }
+            return sum;
+        }));
+        add(interaction);
+    }
+
+    void benchSpectra() {
+        uint32_t count = m_options.lookupCount();
+
+        EnergySpectrum discrete;
+        discrete.type = EnergySpectrum::DISCRETE;
+        for (int line = 0; line < 16; ++line) {
+            discrete.spectrum.push_back({100.0f + 150.0f * line, 1.0f + static_cast<float>(line % 5)});
+        }
+
+        EnergySpectrum continuous;
+        continuous.type = EnergySpectrum::CONTINUOUS;
+        for (int point = 0; point <= 64; ++point) {
+            float energy = 10.0f + 30.0f * point;
+            continuous.spectrum.push_back({energy, std::exp(-energy / 500.0f)});
+        }
+
+        for (const auto& [name, spectrum] : {std::make_pair(std::string("discrete"), &discrete),
+                                             std::make_pair(std::string("continuous"), &continuous)}) {
+            BenchCase sampling{"spectrum/" + name, 1, count, {}, {}};
+            sampling.metrics.push_back(timePerOperation("ns_per_sample", m_options.repeat, count, [&]() {
+                double sum = 0.0;
+                for (uint32_t i = 0; i < count; ++i) sum += spectrum->sampleEnergy();
+                return sum;
+            }));
+            add(sampling);
+        }
+    }
+
+    void benchSensors() {
+        uint32_t count = m_options.rayCount();
+        Sensor point("Point", SensorType::POINT, glm::vec3(0.0f));
+        point.setFluxToDoseFactors(Sensor::ambientDoseFactorsPhotons());
+        point.setSpectrumBinning(Binning::logarithmic(10.0f, 3000.0f, 128));
+        point.prepareSpectrum(1);
+
+        Sensor volume("Volume", SensorType::VOLUME, glm::vec3(0.0f));
+        volume.setSize(glm::vec3(0.5f));
+        volume.setFluxToDoseFactors(Sensor::ambientDoseFactorsPhotons());
+
+        std::vector<Particle> particles;
+        std::vector<glm::vec3> ends;
+        particles.reserve(count);
+        ends.reserve(count);
+        AABB around(glm::vec3(-1.0f), glm::vec3(1.0f));
+        auto starts = randomPoints(around, count);
+        for (uint32_t i = 0; i < count; ++i) {
+            glm::vec3 direction = RandomGenerator::randomDirection();
+            particles.emplace_back(RadiationType::GAMMA, RandomGenerator::randomRange(10.0f, 2000.0f), starts[i],
+                                   direction);
+            ends.push_back(starts[i] + direction * 2.0f);
+        }
+
+        BenchCase pointCase{"sensor/point", 1, count, {}, {}};
+        pointCase.metrics.push_back(timePerOperation("ns_per_score", m_options.repeat, count, [&]() {
+            double scored = 0.0;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (point.intersectsSegment(particles[i].getPosition(), ends[i]) && point.recordParticle(particles[i]))
+                    scored += 1.0;
+            }
+            return scored;
+        }));
+        add(pointCase);
+
+        BenchCase volumeCase{"sensor/track_length", 1, count, {}, {}};
+        volumeCase.metrics.push_back(timePerOperation("ns_per_score", m_options.repeat, count, [&]() {
+            double total = 0.0;
+            for (uint32_t i = 0; i < count; ++i) {
+                float length = volume.clippedSegmentLength(particles[i].getPosition(), ends[i]);
+                if (length > 0.0f) {
+                    volume.recordTrackLength(particles[i], length);
+                    total += length;
+                }
+            }
+            return total;
+        }));
+        add(volumeCase);
+    }
+
+    void benchTransport() {
+        uint32_t threads = m_options.maxThreads;
+        add(runTransport("transport/demo", demoScene(), m_options.demoHistories(), threads, m_options.repeat));
+
+        auto facility = facilityScene(m_options.facilityRooms());
+        BenchCase facilityCase = runTransport("transport/facility", facility, m_options.facilityHistories(), threads,
+                                              m_options.repeat);
+        facilityCase.info.push_back({"objects", static_cast<double>(facility->getObjectCount())});
+        facilityCase.info.push_back({"sensors", static_cast<double>(facility->getSensorCount())});
+        add(facilityCase);
+    }
+
+    // Passage à l'échelle sur l'installation : charge fixe (forte) ou proportionnelle aux threads (faible)
+    void benchScaling() {
+        auto facility = facilityScene(m_options.facilityRooms());
+        uint64_t strongHistories = m_options.facilityHistories();
+        uint64_t weakHistories = m_options.weakHistoriesPerThread();
+
+        double strongReference = 0.0, weakReference = 0.0;
+        for (uint32_t threads : threadCounts(m_options.maxThreads)) {
+            BenchCase strong = runTransport("scaling/strong/" + std::to_string(threads), facility, strongHistories,
+                                            threads, m_options.repeat);
+            double rate = strong.metrics[0].median();
+            if (threads == 1) strongReference = rate;
+            strong.info.push_back({"efficiency", strongReference > 0.0 ? rate / (strongReference * threads) : 0.0});
+            add(strong);
+
+            BenchCase weak = runTransport("scaling/weak/" + std::to_string(threads), facility,
+                                          weakHistories * threads, threads, m_options.repeat);
+            rate = weak.metrics[0].median();
+            if (threads == 1) weakReference = rate;
+            weak.info.push_back({"efficiency", weakReference > 0.0 ? rate / (weakReference * threads) : 0.0});
+            add(weak);
+        }
+
+        // Placement NUMA (épinglage, répliques par nœud) face à la scène partagée, tous threads :
+        // gain attendu sur plusieurs nœuds, identique à la référence sur un seul
+        const NumaTopology& topology = NumaTopology::getInstance();
+        uint32_t threads = m_options.maxThreads;
+        BenchCase shared = runTransport("scaling/numa/shared", facility, strongHistories, threads, m_options.repeat);
+        BenchCase placed = runTransport("scaling/numa/replicas", facility, strongHistories, threads, m_options.repeat,
+                                        true);
+        double sharedRate = shared.metrics[0].median();
+        placed.info.push_back({"nodes", static_cast<double>(topology.getNodeCount())});
+        placed.info.push_back({"emulated", topology.isEmulated() ? 1.0 : 0.0});
+        placed.info.push_back({"gain", sharedRate > 0.0 ? placed.metrics[0].median() / sharedRate : 0.0});
+        add(shared);
+        add(placed);
+    }
+
+    // Allocations du transport en régime établi : installation (analogique), démonstration
+    // avec fenêtres de poids (progéniture du splitting dans la banque)
+    void benchAllocations() {
+        uint32_t threads = m_options.maxThreads;
+        uint64_t histories = m_options.facilityHistories();
+
+        MonteCarloEngine facility(facilityScene(m_options.facilityRooms()));
+        facility.setConfig(transportConfig(histories, threads));
+        add(runAllocations("allocations/facility", facility, histories, m_options.repeat));
+
+        MonteCarloEngine windows(demoScene());
+        windows.setConfig(transportConfig(histories, threads));
+        WeightWindowGenerationConfig generation;
+        generation.nx = generation.ny = generation.nz = 8;
+        generation.historiesPerIteration = m_options.quick ? 2000 : 20000;
+        generation.maxIterations = 2;
+        windows.generateWeightWindows(generation);
+        add(runAllocations("allocations/weight_windows", windows, histories, m_options.repeat));
+    }
+
+    // Capture implicite face à l'absorption analogique, mêmes graines : gain de facteur de mérite
+    void benchVarianceReduction() {
+        auto shielding = shieldingScene();
+        uint32_t batches = m_options.varianceBatches();
+        uint64_t histories = m_options.varianceHistories();
+
+        SimulationConfig analog = transportConfig(histories, 1);
+        BenchCase reference = runFigureOfMerit("variance/analog", shielding, analog, batches, histories,
+                                               m_options.repeat);
+
+        SimulationConfig implicit = analog;
+        implicit.implicitCaptureTypes = {RadiationType::GAMMA, RadiationType::X_RAY};
+        BenchCase capture = runFigureOfMerit("variance/implicit_capture", shielding, implicit, batches, histories,
+                                             m_options.repeat);
+        double analogFom = reference.metrics[0].median();
+        capture.info.push_back({"fom_gain", analogFom > 0.0 ? capture.metrics[0].median() / analogFom : 0.0});
+        add(reference);
+        add(capture);
+    }
+
+    // Biaisage par région sur l'écran absorbant pur : analogique, collisions forcées et
+    // transformation exponentielle, comparés à SimplifiedSolver::analyticalAttenuation
+    void benchRegionBiasing() {
+        uint32_t batches = m_options.varianceBatches();
+        uint64_t histories = m_options.varianceHistories();
+        const double expected = SimplifiedSolver::analyticalAttenuation(ABSORBER_THICKNESS, ABSORBER_MU);
+
+        RegionBiasing forced;
+        forced.forcedCollisions = true;
+        RegionBiasing stretched;
+        stretched.exponentialTransform = 0.5f;
+        stretched.preferredDirection = glm::vec3(0.0f, 0.0f, 1.0f);
+        const std::vector<std::pair<std::string, RegionBiasing>> variants = {
+            {"analog", RegionBiasing()}, {"forced_collisions", forced}, {"exponential_transform", stretched}};
+
+        SimulationConfig config = transportConfig(histories, 1);
+        for (const auto& [name, biasing] : variants) {
+            BenchCase benchCase = runFigureOfMerit("variance/absorber/" + name, absorberScene(biasing), config,
+                                                   batches, histories, m_options.repeat);
+            double fluence = benchCase.infoValue("fluence");
+            double error = benchCase.infoValue("relative_error") * fluence;
+            benchCase.info.push_back({"analytical", expected});
+            benchCase.info.push_back({"deviation_sigma", error > 0.0 ? (fluence - expected) / error : 0.0});
+            add(benchCase);
+        }
+    }
+};
+
+std::string jsonString(const std::string& value) {
+    std::string escaped = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+void BenchSuite::writeJson(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour écriture: " + filename);
+    }
+    file << std::setprecision(9);
+
+    file << "{\n";
+    file << "  \"format\": \"radiation-bench\",\n";
+    file << "  \"version\": 1,\n";
+    file << "  \"build\": {\"type\": " << jsonString(BENCH_BUILD_TYPE) << ", \"compiler\": "
+         << jsonString(__VERSION__) << ", \"openmp\": "
+#ifdef USE_OPENMP
+         << "true"
+#else
+         << "false"
+#endif
+         << ", \"profiling\": " << (Profiler::isCompiledIn() ? "true" : "false") << "},\n";
+    file << "  \"hardwareThreads\": " << std::thread::hardware_concurrency() << ",\n";
+    file << "  \"quick\": " << (m_options.quick ? "true" : "false") << ",\n";
+    file << "  \"repeat\": " << m_options.repeat << ",\n";
+    file << "  \"cases\": [";
+
+    for (size_t c = 0; c < m_cases.size(); ++c) {
+        const BenchCase& benchCase = m_cases[c];
+        file << (c ? ",\n" : "\n") << "    {\"name\": " << jsonString(benchCase.name)
+             << ", \"threads\": " << benchCase.threads << ", \"operations\": " << benchCase.operations
+             << ",\n     \"metrics\": [";
+        for (size_t m = 0; m < benchCase.metrics.size(); ++m) {
+            const Metric& metric = benchCase.metrics[m];
+            file << (m ? ",\n       " : "\n       ") << "{\"name\": " << jsonString(metric.name)
+                 << ", \"unit\": " << jsonString(metric.unit)
+                 << ", \"higherIsBetter\": " << (metric.higherIsBetter ? "true" : "false")
+                 << ", \"median\": " << metric.median() << ", \"samples\": [";
+            for (size_t s = 0; s < metric.samples.size(); ++s) {
+                file << (s ? ", " : "") << metric.samples[s];
+            }
+            file << "]}";
+        }
+        file << "]";
+        if (!benchCase.info.empty()) {
+            file << ",\n     \"info\": {";
+            for (size_t i = 0; i < benchCase.info.size(); ++i) {
+                file << (i ? ", " : "") << jsonString(benchCase.info[i].first) << ": " << benchCase.info[i].second;
+            }
+            file << "}";
+        }
+        file << "}";
+    }
+    file << "\n  ]\n}\n";
+}
+
+void BenchSuite::printSummary() const {
+    std::cout << std::endl << m_cases.size() << " cas mesurés, " << m_options.repeat << " répétitions" << std::endl;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Mesures de performance du simulateur" << std::endl;
+    std::cout << "Usage: " << program << " [OPTIONS]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "  --output <fichier.json>  Résultats (bench_results.json par défaut)" << std::endl;
+    std::cout << "  --repeat <N>             Répétitions de chaque cas (5 par défaut)" << std::endl;
+    std::cout << "  --threads <N>            Threads maximum (transport, passage à l'échelle)" << std::endl;
+    std::cout << "  --filter <préfixe>       Cas dont le nom commence par le préfixe (bvh, material," << std::endl;
+    std::cout << "                           spectrum, sensor, transport/demo, scaling/strong, allocations, variance, ...)" << std::endl;
+    std::cout << "  --quick                  Tailles réduites" << std::endl;
+    std::cout << "  --check-allocations      Code 3 si le transport alloue en régime établi (cas allocations/)"
+              << std::endl;
+    std::cout << "  --check-attenuation      Code 4 si un cas variance/absorber/ s'écarte de exp(-μx)" << std::endl;
+    std::cout << "  --help, -h               Afficher cette aide" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--output" && hasValue) {
+            options.output = argv[++i];
+        } else if (arg == "--repeat" && hasValue) {
+            options.repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            options.maxThreads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--check-allocations") {
+            options.checkAllocations = true;
+        } else if (arg == "--check-attenuation") {
+            options.checkAttenuation = true;
+        } else {
+            std::cerr << "Option inconnue ou incomplète: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    try {
+        RandomGenerator::seed(12345); // Entrées des micro-benchmarks reproductibles
+        MaterialLibrary::getInstance().loadDefaults();
+
+        std::cout << "=== RADIATION BENCH ===" << std::endl;
+        BenchSuite suite(options);
+        suite.run();
+        suite.printSummary();
+        suite.writeJson(options.output);
+        std::cout << "Résultats: " << options.output << std::endl;
+
+        if (options.checkAllocations) {
+            double allocations = suite.steadyStateAllocations();
+            if (allocations > 0.0) {
+                std::cerr << "ÉCHEC : " << allocations << " allocations par histoire en régime établi" << std::endl;
+                return 3;
+            }
+            std::cout << "Aucune allocation en régime établi" << std::endl;
+        }
+        if (options.checkAttenuation) {
+            auto failures = suite.attenuationFailures();
+            for (const auto& name : failures) {
+                std::cerr << "ÉCHEC : " << name << " s'écarte de la transmission analytique" << std::endl;
+            }
+            if (!failures.empty()) return 4;
+            std::cout << "Transmissions conformes à exp(-μx)" << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur fatale: " << e.what() << std::endl;
+        return 1;
+    }
+}
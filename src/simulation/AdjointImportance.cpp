@@ -0,0 +1,337 @@
+#include "simulation/AdjointImportance.h"
+#include "core/Sensor.h"
+#include <algorithm>
+
+namespace {
+
+// Direction uniforme dans un cône d'axe donné (cosinus du demi-angle cosHalfAngle)
+glm::vec3 sampleCone(const glm::vec3& axis, float cosHalfAngle) {
+    float z = RandomGenerator::randomRange(cosHalfAngle, 1.0f);
+    float phi = RandomGenerator::randomRange(0.0f, TWO_PI);
+    float sinTheta = std::sqrt(std::max(0.0f, 1.0f - z * z));
+
+    glm::vec3 w = axis;
+    glm::vec3 u = std::abs(w.x) > 0.1f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    u = glm::normalize(glm::cross(u, w));
+    glm::vec3 v = glm::cross(w, u);
+
+    return glm::normalize(sinTheta * std::cos(phi) * u + sinTheta * std::sin(phi) * v + z * w);
+}
+
+// Demi-angle minimal des lobes (2°) pour garder un support non dégénéré
+constexpr float MIN_LOBE_COS = 0.99939083f;
+
+float lobeCosHalfAngle(float distance, float radius) {
+    if (distance <= radius) return -1.0f;
+    float sinHalf = radius / distance;
+    return std::min(MIN_LOBE_COS, std::sqrt(1.0f - sinHalf * sinHalf));
+}
+
+} // namespace
+
+// AdjointImportanceMap implementation
+AdjointImportanceMap::AdjointImportanceMap(const RegularGrid& grid, const std::vector<float>& groupBounds)
+    : m_grid(grid), m_groupBounds(groupBounds) {
+    if (m_groupBounds.size() < 2) {
+        m_groupBounds = {0.0f, std::numeric_limits<float>::max()};
+    }
+    std::sort(m_groupBounds.begin(), m_groupBounds.end());
+    m_values.assign(static_cast<size_t>(m_grid.getCellCount()) * getGroupCount(), 0.0);
+}
+
+uint32_t AdjointImportanceMap::groupIndex(float energy) const {
+    // Premier et dernier groupes ouverts (même convention que WeightWindowMesh)
+    auto it = std::upper_bound(m_groupBounds.begin() + 1, m_groupBounds.end() - 1, energy);
+    return static_cast<uint32_t>(it - (m_groupBounds.begin() + 1));
+}
+
+float AdjointImportanceMap::groupEnergy(uint32_t group) const {
+    float low = std::max(m_groupBounds[group], 1e-3f);
+    float high = std::max(m_groupBounds[group + 1], low);
+    return std::sqrt(low * high);
+}
+
+double AdjointImportanceMap::getValue(const glm::vec3& position, float energy) const {
+    int cell = m_grid.cellIndex(position);
+    if (cell < 0) return 0.0;
+
+    return getValue(static_cast<uint32_t>(cell), groupIndex(energy));
+}
+
+std::shared_ptr<WeightWindowMesh> AdjointImportanceMap::buildWeightWindows(double response, float upperRatio) const {
+    auto mesh = std::make_shared<WeightWindowMesh>(m_grid.getBounds(), m_grid.getNx(), m_grid.getNy(), m_grid.getNz());
+    mesh->setUpperRatio(upperRatio);
+    mesh->setEnergyGroups(std::vector<float>(m_groupBounds.begin() + 1, m_groupBounds.end()));
+
+    // Centre de fenêtre R / φ† : poids de naissance des particules biaisées
+    const double centerToLower = 2.0 / (1.0 + mesh->getUpperRatio());
+    const double maxBound = 1e30;
+
+    for (uint32_t group = 0; group < getGroupCount(); ++group) {
+        for (uint32_t cell = 0; cell < m_grid.getCellCount(); ++cell) {
+            double importance = getValue(cell, group);
+            if (importance <= 0.0) continue; // Pas de fenêtre
+
+            double lower = std::min(maxBound, centerToLower * response / importance);
+            mesh->setLowerBound(cell, group, static_cast<float>(lower));
+        }
+    }
+
+    return mesh;
+}
+
+// CadisSourceBiasing implementation
+CadisSourceBiasing::CadisSourceBiasing(std::shared_ptr<const AdjointImportanceMap> importance,
+                                       const std::vector<std::shared_ptr<Source>>& sources,
+                                       const std::vector<std::shared_ptr<Sensor>>& targets, const CadisConfig& config)
+    : m_importance(importance), m_config(config) {
+    if (!m_importance) return;
+
+    const RegularGrid& grid = m_importance->getGrid();
+    const auto& groupBounds = m_importance->getGroupBounds();
+    const uint32_t groupCount = m_importance->getGroupCount();
+
+    for (const auto& source : sources) {
+        if (source && source->isEnabled()) {
+            BiasedSource biased;
+            biased.source = source;
+            biased.volume = std::dynamic_pointer_cast<AmbientSource>(source) != nullptr;
+            biased.isotropic = biased.volume || std::dynamic_pointer_cast<IsotropicSource>(source) != nullptr;
+            biased.opaque = !biased.isotropic && !std::dynamic_pointer_cast<DirectionalSource>(source);
+            m_sources.push_back(biased);
+        }
+    }
+    if (m_sources.empty()) return;
+
+    // Probabilité analogique de chaque source : tirage uniforme (comme le moteur)
+    const double sourceProbability = 1.0 / m_sources.size();
+
+    struct Option {
+        Candidate candidate;
+        double probability;
+        double importance;
+    };
+    std::vector<Option> options;
+
+    for (uint32_t s = 0; s < m_sources.size(); ++s) {
+        BiasedSource& biased = m_sources[s];
+        const auto& source = biased.source;
+
+        // Cellules couvertes par l'émission et fraction de volume associée
+        std::vector<std::pair<uint32_t, double>> cellFractions;
+        AABB emission(source->getPosition(), source->getPosition());
+        if (biased.volume) {
+            auto ambient = std::static_pointer_cast<AmbientSource>(source);
+            emission = AABB(ambient->getMinBounds(), ambient->getMaxBounds());
+            double volume = emission.volume();
+
+            for (uint32_t cell = 0; cell < grid.getCellCount() && volume > 0.0; ++cell) {
+                AABB cellBounds = grid.cellBounds(cell);
+                if (!cellBounds.intersects(emission)) continue;
+
+                AABB overlap(glm::max(cellBounds.min, emission.min), glm::min(cellBounds.max, emission.max));
+                double fraction = overlap.volume() / volume;
+                if (fraction > 0.0) cellFractions.emplace_back(cell, fraction);
+            }
+        } else {
+            int cell = grid.cellIndex(source->getPosition());
+            if (cell >= 0) cellFractions.emplace_back(static_cast<uint32_t>(cell), 1.0);
+        }
+
+        std::vector<double> groupProbabilities = source->getSpectrum().groupProbabilities(groupBounds);
+
+        auto importanceOf = [&](int cell, int group) {
+            double value = 0.0;
+            for (const auto& [c, fraction] : cellFractions) {
+                if (cell >= 0 && static_cast<int>(c) != cell) continue;
+                double cellWeight = cell >= 0 ? 1.0 : fraction;
+                for (uint32_t g = 0; g < groupCount; ++g) {
+                    if (group >= 0 && static_cast<int>(g) != group) continue;
+                    double groupWeight = group >= 0 ? 1.0 : groupProbabilities[g];
+                    value += cellWeight * groupWeight * m_importance->getValue(c, g);
+                }
+            }
+            return value;
+        };
+
+        // Composantes biaisées (position si volumique, énergie si spectre), sinon analogiques
+        std::vector<std::pair<int, double>> cellOptions;
+        if (biased.volume && config.biasPosition && !biased.opaque) {
+            for (const auto& [cell, fraction] : cellFractions) cellOptions.emplace_back(static_cast<int>(cell), fraction);
+        }
+        if (cellOptions.empty()) cellOptions.emplace_back(-1, 1.0);
+
+        std::vector<std::pair<int, double>> groupOptions;
+        if (config.biasEnergy && !biased.opaque) {
+            for (uint32_t g = 0; g < groupCount; ++g) {
+                if (groupProbabilities[g] > 0.0) groupOptions.emplace_back(static_cast<int>(g), groupProbabilities[g]);
+            }
+        }
+        if (groupOptions.empty()) groupOptions.emplace_back(-1, 1.0);
+
+        for (const auto& [cell, cellFraction] : cellOptions) {
+            for (const auto& [group, groupProbability] : groupOptions) {
+                Option option;
+                option.candidate.source = s;
+                option.candidate.cell = cell;
+                option.candidate.group = group;
+                option.candidate.region = emission;
+                if (cell >= 0) {
+                    AABB cellBounds = grid.cellBounds(static_cast<uint32_t>(cell));
+                    option.candidate.region = AABB(glm::max(cellBounds.min, emission.min),
+                                                   glm::min(cellBounds.max, emission.max));
+                }
+                option.probability = sourceProbability * cellFraction * groupProbability;
+                option.importance = importanceOf(cell, group);
+                options.push_back(option);
+            }
+        }
+
+        // Lobes de direction vers les capteurs (poids ∝ 1/d² depuis le centre d'émission)
+        if (biased.isotropic && config.biasDirection) {
+            double total = 0.0;
+            for (const auto& sensor : targets) {
+                glm::vec3 extent = sensor->getType() == SensorType::POINT ? glm::vec3(sensor->getRadius())
+                                                                          : sensor->getSize() * 0.5f;
+                float radius = std::max(glm::length(extent), 1e-3f);
+                float distance = std::max(glm::length(sensor->getPosition() - emission.center()), radius);
+
+                Lobe lobe{sensor->getPosition(), radius, 1.0 / (distance * distance)};
+                total += lobe.probability;
+                biased.lobes.push_back(lobe);
+            }
+            for (auto& lobe : biased.lobes) lobe.probability /= total;
+        }
+    }
+
+    // Réponse estimée et loi biasée, avec une part analogique défensive
+    for (const auto& option : options) {
+        m_response += option.probability * option.importance;
+    }
+    if (m_response <= 0.0) return;
+
+    const double defensive = std::clamp(static_cast<double>(config.defensiveFraction), 0.0, 1.0);
+    double cumulative = 0.0;
+    for (const auto& option : options) {
+        double biasedProbability = (1.0 - defensive) * option.probability * option.importance / m_response +
+                                   defensive * option.probability;
+        if (biasedProbability <= 0.0) continue;
+
+        Candidate candidate = option.candidate;
+        candidate.weight = option.probability / biasedProbability;
+        cumulative += biasedProbability;
+
+        m_candidates.push_back(candidate);
+        m_cdf.push_back(cumulative);
+    }
+    for (auto& value : m_cdf) value /= cumulative;
+}
+
+bool CadisSourceBiasing::sample(Particle& particle) const {
+    const Source* emitter = nullptr;
+    float emissionWeight = 0.0f;
+    return sample(particle, emitter, emissionWeight);
+}
+
+bool CadisSourceBiasing::sample(Particle& particle, const Source*& emitter, float& emissionWeight) const {
+    if (m_candidates.empty()) return false;
+
+    float xi = RandomGenerator::random();
+    size_t index = std::lower_bound(m_cdf.begin(), m_cdf.end(), static_cast<double>(xi)) - m_cdf.begin();
+    const Candidate& candidate = m_candidates[std::min(index, m_candidates.size() - 1)];
+    const BiasedSource& biased = m_sources[candidate.source];
+    const auto& source = biased.source;
+    emitter = source.get();
+
+    if (biased.opaque) {
+        particle = source->emitParticle();
+        particle.setWeight(particle.getWeight() * static_cast<float>(candidate.weight));
+        emissionWeight = particle.getWeight();
+        return true;
+    }
+
+    // Position
+    glm::vec3 position = source->samplePosition();
+    if (biased.volume && candidate.cell >= 0) {
+        const AABB& region = candidate.region;
+        position = glm::vec3(RandomGenerator::randomRange(region.min.x, region.max.x),
+                             RandomGenerator::randomRange(region.min.y, region.max.y),
+                             RandomGenerator::randomRange(region.min.z, region.max.z));
+    }
+
+    // Énergie (groupes extrêmes ouverts)
+    float energy = 0.0f;
+    if (candidate.group >= 0) {
+        const auto& bounds = m_importance->getGroupBounds();
+        uint32_t group = static_cast<uint32_t>(candidate.group);
+        float low = group == 0 ? std::numeric_limits<float>::lowest() : bounds[group];
+        float high = group + 1 == m_importance->getGroupCount() ? std::numeric_limits<float>::max() : bounds[group + 1];
+        energy = source->getSpectrum().sampleEnergyInRange(low, high);
+    } else {
+        energy = source->getSpectrum().sampleEnergy();
+    }
+
+    // Direction
+    double directionWeight = 1.0;
+    glm::vec3 direction = sampleDirection(biased, position, directionWeight);
+
+    particle = Particle(source->getRadiationType(), energy, position, direction);
+    particle.setWeight(static_cast<float>(candidate.weight * directionWeight));
+    emissionWeight = static_cast<float>(candidate.weight);
+    source->incrementEmitted();
+    return true;
+}
+
+glm::vec3 CadisSourceBiasing::sampleDirection(const BiasedSource& biased, const glm::vec3& position,
+                                              double& weightFactor) const {
+    weightFactor = 1.0;
+    if (!biased.isotropic || biased.lobes.empty()) {
+        return biased.source->sampleDirection();
+    }
+
+    const double alpha = std::clamp(static_cast<double>(m_config.directionBiasFraction), 0.0, 1.0);
+    glm::vec3 direction;
+
+    if (RandomGenerator::random() < alpha) {
+        // Choix du lobe puis tirage uniforme dans son cône
+        double xi = RandomGenerator::random();
+        const Lobe* chosen = &biased.lobes.back();
+        for (const auto& lobe : biased.lobes) {
+            if (xi < lobe.probability) {
+                chosen = &lobe;
+                break;
+            }
+            xi -= lobe.probability;
+        }
+
+        glm::vec3 toTarget = chosen->target - position;
+        float distance = glm::length(toTarget);
+        if (distance <= 0.0f) {
+            direction = RandomGenerator::randomDirection();
+        } else {
+            direction = sampleCone(toTarget / distance, lobeCosHalfAngle(distance, chosen->targetRadius));
+        }
+    } else {
+        direction = RandomGenerator::randomDirection();
+    }
+
+    // Densité du mélange (par stéradian) au point tiré
+    const double isotropicPdf = 1.0 / (4.0 * PI);
+    double pdf = (1.0 - alpha) * isotropicPdf;
+    for (const auto& lobe : biased.lobes) {
+        glm::vec3 toTarget = lobe.target - position;
+        float distance = glm::length(toTarget);
+        if (distance <= 0.0f) {
+            pdf += alpha * lobe.probability * isotropicPdf;
+            continue;
+        }
+
+        float cosHalfAngle = lobeCosHalfAngle(distance, lobe.targetRadius);
+        if (glm::dot(direction, toTarget / distance) >= cosHalfAngle) {
+            pdf += alpha * lobe.probability / (TWO_PI * (1.0 - cosHalfAngle));
+        }
+    }
+
+    weightFactor = isotropicPdf / pdf;
+    return direction;
+}
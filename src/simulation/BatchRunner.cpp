@@ -0,0 +1,416 @@
+#include "simulation/BatchRunner.h"
+#include "simulation/ResultsWriter.h"
+#include "core/Material.h"
+#include "geometry/Box.h"
+#include "utils/JsonCursor.h"
+#include "utils/MappedFile.h"
+#include <charconv>
+#include <fstream>
+
+namespace {
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// Valeurs : liste explicite, ou plage {"from", "to", "count"} à pas constant
+void readValues(JsonCursor& cursor, SweepParameter& parameter) {
+    cursor.skipWhitespace();
+    if (cursor.consume('{')) {
+        double from = 0.0, to = 0.0;
+        uint32_t count = 0;
+        do {
+            std::string key = cursor.readString();
+            cursor.expect(':');
+            if (key == "from") from = cursor.readNumber();
+            else if (key == "to") to = cursor.readNumber();
+            else if (key == "count") count = static_cast<uint32_t>(cursor.readNumber());
+            else cursor.skipValue();
+        } while (cursor.consume(','));
+        cursor.expect('}');
+
+        if (count == 0) cursor.fail("plage de valeurs vide");
+        for (uint32_t i = 0; i < count; ++i) {
+            double t = count > 1 ? static_cast<double>(i) / (count - 1) : 0.0;
+            parameter.numericValues.push_back({static_cast<float>(from + t * (to - from))});
+        }
+        return;
+    }
+
+    cursor.readArray([&]() {
+        cursor.skipWhitespace();
+        if (cursor.consume('[')) {
+            std::vector<float> vector;
+            if (!cursor.consume(']')) {
+                do {
+                    vector.push_back(cursor.readFloat());
+                } while (cursor.consume(','));
+                cursor.expect(']');
+            }
+            parameter.numericValues.push_back(vector);
+        } else if (cursor.peek() == '"') {
+            parameter.textValues.push_back(cursor.readString());
+        } else {
+            parameter.numericValues.push_back({cursor.readFloat()});
+        }
+    });
+
+    if (!parameter.textValues.empty() && !parameter.numericValues.empty()) {
+        cursor.fail("valeurs mixtes (texte et nombres) pour " + parameter.element);
+    }
+}
+
+SweepParameter readParameter(JsonCursor& cursor) {
+    SweepParameter parameter;
+    cursor.readObject([&](const std::string& key) {
+        if (key == "name") parameter.column = cursor.readString();
+        else if (key == "object") { parameter.target = SweepParameter::Target::OBJECT; parameter.element = cursor.readString(); }
+        else if (key == "source") { parameter.target = SweepParameter::Target::SOURCE; parameter.element = cursor.readString(); }
+        else if (key == "sensor") { parameter.target = SweepParameter::Target::SENSOR; parameter.element = cursor.readString(); }
+        else if (key == "property") parameter.property = cursor.readString();
+        else if (key == "values") readValues(cursor, parameter);
+        else cursor.skipValue();
+    });
+
+    if (parameter.column.empty()) parameter.column = parameter.element + "." + parameter.property;
+    return parameter;
+}
+
+} // namespace
+
+bool SweepParameter::affectsGeometry() const {
+    return target == Target::OBJECT && property != "material";
+}
+
+SweepSpec SweepSpec::loadFromFile(const std::string& filename) {
+    MappedFile file(filename);
+    const char* base = reinterpret_cast<const char*>(file.data());
+    JsonCursor cursor(base, base + file.size(), base);
+
+    SweepSpec spec;
+    cursor.readObject([&](const std::string& key) {
+        if (key == "parameters") {
+            cursor.readArray([&]() { spec.parameters.push_back(readParameter(cursor)); });
+        } else if (key == "mode") {
+            spec.zip = cursor.readString() == "zip";
+        } else if (key == "materialLibrary") {
+            spec.materialLibrary = cursor.readString();
+        } else if (key == "particles") {
+            spec.config.maxParticles = static_cast<uint64_t>(cursor.readNumber());
+        } else if (key == "threads") {
+            spec.config.numThreads = std::max(1u, static_cast<uint32_t>(cursor.readNumber()));
+        } else if (key == "maxBounces") {
+            spec.config.maxBounces = static_cast<uint32_t>(cursor.readNumber());
+        } else if (key == "energyCutoff") {
+            spec.config.energyCutoff = cursor.readFloat();
+        } else if (key == "nextEvent") {
+            spec.config.useNextEventEstimator = cursor.readBool();
+        } else if (key == "culling") {
+            spec.config.useCulling = cursor.readBool();
+        } else if (key == "implicitCapture") {
+            cursor.readArray([&]() {
+                std::string name = cursor.readString();
+                RadiationType type;
+                if (!parseRadiationType(name, type)) cursor.fail("type de rayonnement inconnu: " + name);
+                spec.config.implicitCaptureTypes.push_back(type);
+            });
+        } else {
+            cursor.skipValue();
+        }
+    });
+
+    if (spec.parameters.empty()) {
+        throw std::runtime_error("Balayage sans paramètre: " + filename);
+    }
+    return spec;
+}
+
+BatchRunner::BatchRunner(std::shared_ptr<Scene> scene, SweepSpec spec)
+    : m_scene(scene), m_spec(std::move(spec)) {
+    if (!m_spec.materialLibrary.empty()) {
+        MaterialLibrary::getInstance().loadFromFile(m_spec.materialLibrary);
+    }
+    validate();
+
+    // Paramètres géométriques en boucle externe (ordre de la spécification conservé sinon)
+    for (size_t i = 0; i < m_spec.parameters.size(); ++i) {
+        m_loopOrder.push_back(i);
+    }
+    std::stable_sort(m_loopOrder.begin(), m_loopOrder.end(), [this](size_t a, size_t b) {
+        return m_spec.parameters[a].affectsGeometry() && !m_spec.parameters[b].affectsGeometry();
+    });
+    m_appliedValues.assign(m_spec.parameters.size(), SIZE_MAX);
+}
+
+void BatchRunner::validate() const {
+    auto& materials = MaterialLibrary::getInstance();
+
+    for (const auto& parameter : m_spec.parameters) {
+        const std::string where = parameter.column + " : ";
+        if (parameter.getValueCount() == 0) {
+            throw std::runtime_error(where + "aucune valeur");
+        }
+
+        switch (parameter.target) {
+            case SweepParameter::Target::OBJECT: {
+                auto object = m_scene->getObject(parameter.element);
+                if (!object) throw std::runtime_error(where + "objet introuvable");
+                bool isBox = std::dynamic_pointer_cast<Box>(object) != nullptr;
+                if ((parameter.property == "thickness" || parameter.property == "size") && !isBox) {
+                    throw std::runtime_error(where + "dimensions modifiables seulement pour une boîte");
+                }
+                if (parameter.property == "material") {
+                    for (const auto& name : parameter.textValues) {
+                        if (!materials.getMaterial(name)) throw std::runtime_error(where + "matériau inconnu " + name);
+                    }
+                } else if (parameter.property != "thickness" && parameter.property != "size" &&
+                           parameter.property != "position") {
+                    throw std::runtime_error(where + "propriété d'objet inconnue");
+                }
+                break;
+            }
+            case SweepParameter::Target::SOURCE:
+                if (!m_scene->getSource(parameter.element)) throw std::runtime_error(where + "source introuvable");
+                if (parameter.property != "energy" && parameter.property != "intensity" &&
+                    parameter.property != "position") {
+                    throw std::runtime_error(where + "propriété de source inconnue");
+                }
+                break;
+            case SweepParameter::Target::SENSOR:
+                if (!m_scene->getSensor(parameter.element)) throw std::runtime_error(where + "capteur introuvable");
+                if (parameter.property != "position") throw std::runtime_error(where + "propriété de capteur inconnue");
+                break;
+        }
+
+        bool needsText = parameter.property == "material";
+        if (needsText == parameter.textValues.empty()) {
+            throw std::runtime_error(where + (needsText ? "noms de matériaux attendus" : "valeurs numériques attendues"));
+        }
+        size_t components = parameter.isVector() ? 3 : 1;
+        for (const auto& value : parameter.numericValues) {
+            if (value.size() != components) {
+                throw std::runtime_error(where + std::to_string(components) + " composante(s) attendue(s) par valeur");
+            }
+        }
+        if (m_spec.zip && parameter.getValueCount() != m_spec.parameters.front().getValueCount()) {
+            throw std::runtime_error(where + "mode zip : même nombre de valeurs requis pour tous les paramètres");
+        }
+    }
+}
+
+size_t BatchRunner::getVariantCount() const {
+    if (m_spec.zip) return m_spec.parameters.front().getValueCount();
+
+    size_t count = 1;
+    for (const auto& parameter : m_spec.parameters) {
+        count *= parameter.getValueCount();
+    }
+    return count;
+}
+
+std::vector<size_t> BatchRunner::valueIndices(size_t variant) const {
+    std::vector<size_t> indices(m_spec.parameters.size(), variant);
+    if (m_spec.zip) return indices;
+
+    // Numération mixte : dernier paramètre de la boucle le plus rapide
+    for (auto it = m_loopOrder.rbegin(); it != m_loopOrder.rend(); ++it) {
+        size_t count = m_spec.parameters[*it].getValueCount();
+        indices[*it] = variant % count;
+        variant /= count;
+    }
+    return indices;
+}
+
+bool BatchRunner::applyVariant(const std::vector<size_t>& indices) {
+    bool geometryChanged = false;
+    for (size_t i = 0; i < m_spec.parameters.size(); ++i) {
+        if (m_appliedValues[i] == indices[i]) continue;
+
+        applyValue(m_spec.parameters[i], indices[i]);
+        m_appliedValues[i] = indices[i];
+        geometryChanged = geometryChanged || m_spec.parameters[i].affectsGeometry();
+    }
+    return geometryChanged;
+}
+
+void BatchRunner::applyValue(const SweepParameter& parameter, size_t valueIndex) {
+    const std::vector<float>* numeric = parameter.numericValues.empty() ? nullptr : &parameter.numericValues[valueIndex];
+    auto vec3 = [numeric]() { return glm::vec3((*numeric)[0], (*numeric)[1], (*numeric)[2]); };
+
+    switch (parameter.target) {
+        case SweepParameter::Target::OBJECT: {
+            auto object = m_scene->getObject(parameter.element);
+            if (parameter.property == "material") {
+                object->setMaterial(MaterialLibrary::getInstance().getMaterial(parameter.textValues[valueIndex]));
+            } else if (parameter.property == "thickness") {
+                std::static_pointer_cast<Box>(object)->setDepth((*numeric)[0]);
+            } else if (parameter.property == "size") {
+                std::static_pointer_cast<Box>(object)->setSize(vec3());
+            } else {
+                object->setPosition(vec3());
+            }
+            break;
+        }
+        case SweepParameter::Target::SOURCE: {
+            auto source = m_scene->getSource(parameter.element);
+            if (parameter.property == "energy") {
+                EnergySpectrum spectrum;
+                spectrum.type = EnergySpectrum::MONOENERGETIC;
+                spectrum.energy = (*numeric)[0];
+                source->setSpectrum(spectrum);
+            } else if (parameter.property == "intensity") {
+                source->setIntensity((*numeric)[0]);
+            } else {
+                source->setPosition(vec3());
+            }
+            break;
+        }
+        case SweepParameter::Target::SENSOR:
+            m_scene->getSensor(parameter.element)->setPosition(vec3());
+            break;
+    }
+}
+
+std::string BatchRunner::headerLine() const {
+    std::string line = "variant";
+    for (const auto& parameter : m_spec.parameters) {
+        if (parameter.isVector()) {
+            line += "," + parameter.column + ".x," + parameter.column + ".y," + parameter.column + ".z";
+        } else {
+            line += "," + parameter.column;
+        }
+    }
+    line += ",histories,seconds,bvh_rebuilt";
+    for (const auto& sensor : m_scene->getAllSensors()) {
+        const std::string& name = sensor->getName();
+        line += "," + name + ".counts," + name + ".weight," + name + ".fluence," + name + ".dose";
+    }
+    return line + "\n";
+}
+
+std::string BatchRunner::resultLine(size_t variant, const std::vector<size_t>& indices, uint64_t histories,
+                                    double seconds, bool rebuilt) const {
+    std::string line = std::to_string(variant);
+    for (size_t i = 0; i < m_spec.parameters.size(); ++i) {
+        const auto& parameter = m_spec.parameters[i];
+        if (!parameter.textValues.empty()) {
+            line += ',';
+            line += parameter.textValues[indices[i]];
+            continue;
+        }
+        for (float component : parameter.numericValues[indices[i]]) {
+            line += ',';
+            appendNumber(line, component);
+        }
+    }
+
+    line += ',';
+    line += std::to_string(histories);
+    line += ',';
+    appendNumber(line, seconds);
+    line += rebuilt ? ",1" : ",0";
+
+    // Grandeurs par histoire source : poids détecté, fluence (m⁻²), dose (pSv)
+    double norm = histories > 0 ? 1.0 / static_cast<double>(histories) : 0.0;
+    for (const auto& sensor : m_scene->getAllSensors()) {
+        const auto& stats = sensor->getStats();
+        double fluence = sensor->getType() == SensorType::POINT ? stats.nextEventFluence.load()
+                       : sensor->getType() == SensorType::VOLUME ? stats.trackLengthFluence.load()
+                                                                 : 0.0;
+        line += ',';
+        line += std::to_string(stats.totalCounts.load());
+        line += ',';
+        appendNumber(line, stats.weightedCounts.load() * norm);
+        line += ',';
+        appendNumber(line, fluence * norm);
+        line += ',';
+        appendNumber(line, stats.trackLengthDose.load() * norm);
+    }
+    return line + "\n";
+}
+
+ColumnTable BatchRunner::variantTable(size_t variant, const std::vector<size_t>& indices, uint64_t histories,
+                                      double seconds, bool rebuilt) const {
+    ColumnTable table;
+    table.name = "variants";
+    table.batch = variant;
+    table.columns.push_back(Column::uint64("variant", {variant}));
+    for (size_t i = 0; i < m_spec.parameters.size(); ++i) {
+        const auto& parameter = m_spec.parameters[i];
+        if (!parameter.textValues.empty()) {
+            table.columns.push_back(Column::strings(parameter.column, {parameter.textValues[indices[i]]}));
+        } else if (parameter.isVector()) {
+            const auto& value = parameter.numericValues[indices[i]];
+            table.columns.push_back(Column::float64(parameter.column + ".x", {value[0]}));
+            table.columns.push_back(Column::float64(parameter.column + ".y", {value[1]}));
+            table.columns.push_back(Column::float64(parameter.column + ".z", {value[2]}));
+        } else {
+            table.columns.push_back(Column::float64(parameter.column, {parameter.numericValues[indices[i]][0]}));
+        }
+    }
+    table.columns.push_back(Column::uint64("histories", {histories}));
+    table.columns.push_back(Column::float64("seconds", {seconds}));
+    table.columns.push_back(Column::uint32("bvh_rebuilt", {rebuilt ? 1u : 0u}));
+    return table;
+}
+
+BatchSummary BatchRunner::run(const std::string& outputFile) {
+    // .rcol : tables "variants", "stats", "sensors" et spectres, un lot par variante ; sinon CSV
+    bool binary = outputFile.size() > 5 && outputFile.compare(outputFile.size() - 5, 5, ".rcol") == 0;
+    std::unique_ptr<ResultsWriter> results;
+    std::ofstream file;
+    if (binary) {
+        results = std::make_unique<ResultsWriter>(outputFile, false, ColumnWriter::isCompressionAvailable());
+    } else {
+        file.open(outputFile, std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Impossible d'ouvrir le fichier pour écriture: " + outputFile);
+        }
+        file << headerLine();
+    }
+
+    BatchSummary summary;
+    summary.variants = getVariantCount();
+    auto batchStart = std::chrono::steady_clock::now();
+
+    // Un seul moteur pour toutes les variantes
+    MonteCarloEngine engine(m_scene);
+    engine.setConfig(m_spec.config);
+
+    Log::info("Balayage: " + std::to_string(summary.variants) + " variantes, " +
+              std::to_string(m_spec.config.maxParticles) + " histoires chacune");
+
+    for (size_t variant = 0; variant < summary.variants; ++variant) {
+        std::vector<size_t> indices = valueIndices(variant);
+        bool rebuild = applyVariant(indices) || !m_scene->isAccelerationStructureValid();
+        if (rebuild) {
+            m_scene->buildAccelerationStructure();
+            ++summary.bvhBuilds;
+        }
+
+        for (const auto& sensor : m_scene->getAllSensors()) {
+            sensor->clearStats();
+        }
+        engine.resetStats();
+        engine.startSimulation();
+        engine.waitForCompletion();
+
+        const auto& stats = engine.getStats();
+        if (results) {
+            results->writeTable(variantTable(variant, indices, stats.particlesEmitted.load(), stats.getElapsedTime(),
+                                             rebuild));
+            results->writeBatch(variant, *m_scene, engine);
+        } else {
+            file << resultLine(variant, indices, stats.particlesEmitted.load(), stats.getElapsedTime(), rebuild);
+            file.flush(); // Résultats partiels lisibles pendant le balayage
+        }
+    }
+
+    summary.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - batchStart).count();
+    Log::info("Balayage terminé: " + std::to_string(summary.variants) + " variantes, " +
+              std::to_string(summary.bvhBuilds) + " constructions BVH, résultats dans " + outputFile);
+    return summary;
+}
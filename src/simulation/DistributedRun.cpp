@@ -0,0 +1,441 @@
+#include "simulation/DistributedRun.h"
+#include "core/Scene.h"
+#include "core/Sensor.h"
+#include "core/Source.h"
+#include "utils/BinaryIO.h"
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <poll.h>
+
+using namespace DistributedProtocol;
+
+namespace {
+
+constexpr uint64_t MAX_MESSAGE_SIZE = 1ull << 34;
+
+void sendMessage(SocketConnection& connection, MessageType type, const std::vector<uint8_t>& payload = {}) {
+    MessageHeader header{MAGIC, static_cast<uint32_t>(type), payload.size()};
+    connection.sendAll(&header, sizeof(header));
+    if (!payload.empty()) connection.sendAll(payload.data(), payload.size());
+}
+
+std::vector<uint8_t> receiveMessage(SocketConnection& connection, MessageType& type) {
+    MessageHeader header;
+    connection.receiveAll(&header, sizeof(header));
+    if (header.magic != MAGIC || header.size > MAX_MESSAGE_SIZE) {
+        throw std::runtime_error("Message de run distribué invalide");
+    }
+    type = static_cast<MessageType>(header.type);
+    std::vector<uint8_t> payload(header.size);
+    if (!payload.empty()) connection.receiveAll(payload.data(), payload.size());
+    return payload;
+}
+
+uint64_t hashString(uint64_t hash, const std::string& text) {
+    // FNV-1a 64 bits
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return (hash ^ 0xFF) * 1099511628211ull; // Séparateur
+}
+
+// Configuration de transport : tous les champs sauf le nombre de threads (propre à chaque worker)
+void putConfig(ByteWriter& writer, const SimulationConfig& config) {
+    writer.put(config.maxParticles);
+    writer.put(config.maxBounces);
+    writer.put(config.energyCutoff);
+    writer.put(config.timeCutoff);
+    writer.put(static_cast<uint8_t>(config.enableBackgroundSubtraction));
+    writer.put(static_cast<uint8_t>(config.enableVarianceReduction));
+    writer.put(static_cast<uint8_t>(config.useRussianRoulette));
+    writer.put(config.russianRouletteThreshold);
+    writer.put(static_cast<uint8_t>(config.useSplitting));
+    writer.put(config.splittingFactor);
+    writer.put(static_cast<uint8_t>(config.useWeightWindows));
+    writer.put(static_cast<uint8_t>(config.useNextEventEstimator));
+    writer.put(config.nextEventMaxDistance);
+    writer.put(config.nextEventRouletteThreshold);
+    writer.put(config.rngSeed);
+    writer.put(config.historiesPerStream);
+    writer.put(static_cast<uint8_t>(config.produceSecondaries));
+    writer.put(config.maxSecondariesPerHistory);
+    writer.put(config.chargedStepFraction);
+    writer.put(config.maxChargedSteps);
+    writer.put(static_cast<uint8_t>(config.chargedRangeRejection));
+    writer.put(static_cast<uint8_t>(config.useCulling));
+    writer.put(config.cullingOpticalDepth);
+    writer.put(static_cast<uint32_t>(config.implicitCaptureTypes.size()));
+    for (RadiationType type : config.implicitCaptureTypes) writer.put(static_cast<uint32_t>(type));
+    writer.put(config.implicitCaptureWeightCutoff);
+    writer.put(config.implicitCaptureSurvivalWeight);
+}
+
+void getConfig(ByteReader& reader, SimulationConfig& config) {
+    config.maxParticles = reader.get<uint64_t>();
+    config.maxBounces = reader.get<uint32_t>();
+    config.energyCutoff = reader.get<float>();
+    config.timeCutoff = reader.get<float>();
+    config.enableBackgroundSubtraction = reader.get<uint8_t>() != 0;
+    config.enableVarianceReduction = reader.get<uint8_t>() != 0;
+    config.useRussianRoulette = reader.get<uint8_t>() != 0;
+    config.russianRouletteThreshold = reader.get<float>();
+    config.useSplitting = reader.get<uint8_t>() != 0;
+    config.splittingFactor = reader.get<uint32_t>();
+    config.useWeightWindows = reader.get<uint8_t>() != 0;
+    config.useNextEventEstimator = reader.get<uint8_t>() != 0;
+    config.nextEventMaxDistance = reader.get<float>();
+    config.nextEventRouletteThreshold = reader.get<float>();
+    config.rngSeed = reader.get<uint64_t>();
+    config.historiesPerStream = reader.get<uint32_t>();
+    config.produceSecondaries = reader.get<uint8_t>() != 0;
+    config.maxSecondariesPerHistory = reader.get<uint32_t>();
+    config.chargedStepFraction = reader.get<float>();
+    config.maxChargedSteps = reader.get<uint32_t>();
+    config.chargedRangeRejection = reader.get<uint8_t>() != 0;
+    config.useCulling = reader.get<uint8_t>() != 0;
+    config.cullingOpticalDepth = reader.get<float>();
+    config.implicitCaptureTypes.resize(reader.get<uint32_t>());
+    for (RadiationType& type : config.implicitCaptureTypes) type = static_cast<RadiationType>(reader.get<uint32_t>());
+    config.implicitCaptureWeightCutoff = reader.get<float>();
+    config.implicitCaptureSurvivalWeight = reader.get<float>();
+}
+
+void putMeshTally(ByteWriter& writer, const MeshTally& tally) {
+    const RegularGrid& grid = tally.getGrid();
+    writer.putString(tally.getName());
+    writer.put(grid.getBounds().min);
+    writer.put(grid.getBounds().max);
+    writer.put(grid.getNx());
+    writer.put(grid.getNy());
+    writer.put(grid.getNz());
+
+    writer.put(static_cast<uint32_t>(tally.getEnergyBins().size()));
+    for (float bound : tally.getEnergyBins()) writer.put(bound);
+    writer.put(static_cast<uint32_t>(tally.getFluxToDoseFactors().size()));
+    for (const auto& [energy, factor] : tally.getFluxToDoseFactors()) {
+        writer.put(energy);
+        writer.put(factor);
+    }
+    writer.put(static_cast<uint32_t>(tally.getRadiationFilter().size()));
+    for (RadiationType type : tally.getRadiationFilter()) writer.put(static_cast<uint32_t>(type));
+}
+
+std::shared_ptr<MeshTally> getMeshTally(ByteReader& reader) {
+    std::string name = reader.getString();
+    glm::vec3 minPoint = reader.get<glm::vec3>();
+    glm::vec3 maxPoint = reader.get<glm::vec3>();
+    uint32_t nx = reader.get<uint32_t>();
+    uint32_t ny = reader.get<uint32_t>();
+    uint32_t nz = reader.get<uint32_t>();
+    auto tally = std::make_shared<MeshTally>(name, AABB(minPoint, maxPoint), nx, ny, nz);
+
+    std::vector<float> bins(reader.get<uint32_t>());
+    for (float& bound : bins) bound = reader.get<float>();
+    if (!bins.empty()) tally->setEnergyBins(bins);
+
+    std::vector<std::pair<float, float>> factors(reader.get<uint32_t>());
+    for (auto& [energy, factor] : factors) {
+        energy = reader.get<float>();
+        factor = reader.get<float>();
+    }
+    if (!factors.empty()) tally->setFluxToDoseFactors(factors);
+
+    std::vector<RadiationType> filter(reader.get<uint32_t>());
+    for (RadiationType& type : filter) type = static_cast<RadiationType>(reader.get<uint32_t>());
+    tally->setRadiationFilter(filter);
+    return tally;
+}
+
+} // namespace
+
+uint64_t distributedFingerprint(const Scene& scene) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const auto& object : scene.getAllObjects()) hash = hashString(hash, object->getName());
+    for (const auto& sensor : scene.getAllSensors()) {
+        hash = hashString(hash, sensor->getName() + "#" + std::to_string(static_cast<int>(sensor->getType())));
+    }
+    for (const auto& source : scene.getAllSources()) hash = hashString(hash, source->getName());
+    return hash;
+}
+
+// DistributedCoordinator
+DistributedCoordinator::DistributedCoordinator(MonteCarloEngine& engine, const DistributedConfig& config)
+    : m_engine(engine), m_config(config), m_listener(config.address) {
+    auto scene = engine.getScene();
+    if (!scene) throw std::runtime_error("Run distribué sans scène");
+
+    if (!m_config.convergenceSensor.empty() && !scene->getSensor(m_config.convergenceSensor)) {
+        throw std::runtime_error("Capteur de convergence introuvable: " + m_config.convergenceSensor);
+    }
+
+    // Graine commune à tous les workers (tirée ici si la configuration n'en fixe pas)
+    SimulationConfig transport = engine.getConfig();
+    if (transport.rngSeed == 0) {
+        std::random_device device;
+        transport.rngSeed = (static_cast<uint64_t>(device()) << 32) | device() | 1;
+    }
+    transport.historiesPerStream = std::max(1u, transport.historiesPerStream);
+    engine.setConfig(transport);
+
+    ByteWriter writer;
+    putConfig(writer, transport);
+    writer.put(static_cast<uint32_t>(engine.getMeshTallies().size()));
+    for (const auto& tally : engine.getMeshTallies()) putMeshTally(writer, *tally);
+    m_configMessage = writer.bytes();
+
+    Log::info("Coordinateur en écoute sur " + m_listener.getAddress() + " (graine " +
+              std::to_string(transport.rngSeed) + ")");
+}
+
+DistributedSummary DistributedCoordinator::run() {
+    auto scene = m_engine.getScene();
+    const SimulationConfig& transport = m_engine.getConfig();
+    const uint64_t fingerprint = distributedFingerprint(*scene);
+    const auto start = std::chrono::steady_clock::now();
+
+    DistributedSummary summary;
+    m_results = TallySnapshot();
+    m_batchSum.assign(scene->getSensorCount(), 0.0);
+    m_batchSumSqOverN.assign(scene->getSensorCount(), 0.0);
+    m_histories = 0;
+    m_batches = 0;
+
+    // Plages alignées sur les flux aléatoires
+    const uint64_t streamSize = transport.historiesPerStream;
+    const uint64_t rangeSize = std::max<uint64_t>(1, (m_config.historiesPerRange + streamSize / 2) / streamSize) *
+                               streamSize;
+    std::deque<std::pair<uint64_t, uint64_t>> pending;
+    for (uint64_t first = 0; first < transport.maxParticles; first += rangeSize) {
+        pending.emplace_back(first, std::min(rangeSize, transport.maxParticles - first));
+    }
+
+    std::vector<std::unique_ptr<WorkerSlot>> workers;
+    bool stopIssuing = false;
+    auto lastActivity = std::chrono::steady_clock::now();
+
+    auto assignNext = [&](WorkerSlot& worker) {
+        if (!stopIssuing && !pending.empty()) {
+            auto [first, count] = pending.front();
+            pending.pop_front();
+            ByteWriter writer;
+            writer.put(first);
+            writer.put(count);
+            sendMessage(worker.connection, MessageType::ASSIGN, writer.bytes());
+            worker.busy = true;
+            worker.firstHistory = first;
+            worker.count = count;
+        } else {
+            sendMessage(worker.connection, MessageType::STOP);
+            worker.connection.close();
+        }
+    };
+
+    while (true) {
+        bool anyBusy = std::any_of(workers.begin(), workers.end(), [](const auto& w) { return w->busy; });
+        if ((pending.empty() || stopIssuing) && !anyBusy) break;
+
+        std::vector<pollfd> fds;
+        fds.push_back({m_listener.fd(), POLLIN, 0});
+        for (const auto& worker : workers) fds.push_back({worker->connection.fd(), POLLIN, 0});
+
+        int ready = ::poll(fds.data(), fds.size(), 1000);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Erreur d'attente des workers: ") + std::strerror(errno));
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (!anyBusy && m_config.idleTimeoutMs > 0 &&
+            now - lastActivity > std::chrono::milliseconds(m_config.idleTimeoutMs)) {
+            throw std::runtime_error("Aucun worker actif depuis " + std::to_string(m_config.idleTimeoutMs) + " ms (" +
+                                     std::to_string(pending.size()) + " plages restantes)");
+        }
+
+        if (fds[0].revents & POLLIN) {
+            auto worker = std::make_unique<WorkerSlot>();
+            worker->connection = m_listener.accept();
+            worker->label = "worker " + std::to_string(++summary.workers);
+            workers.push_back(std::move(worker));
+            lastActivity = now;
+        }
+
+        for (size_t i = 1; i < fds.size(); ++i) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            WorkerSlot& worker = *workers[i - 1];
+            lastActivity = now;
+
+            try {
+                MessageType type;
+                std::vector<uint8_t> payload = receiveMessage(worker.connection, type);
+                ByteReader reader(payload.data(), payload.size());
+
+                if (type == MessageType::HELLO) {
+                    uint32_t version = reader.get<uint32_t>();
+                    uint64_t workerFingerprint = reader.get<uint64_t>();
+                    uint32_t threads = reader.get<uint32_t>();
+                    if (version != VERSION || workerFingerprint != fingerprint) {
+                        Log::error(worker.label + " refusé : version ou scène différente");
+                        sendMessage(worker.connection, MessageType::STOP);
+                        worker.connection.close();
+                        continue;
+                    }
+                    worker.label += " (" + std::to_string(threads) + " threads)";
+                    worker.ready = true;
+                    sendMessage(worker.connection, MessageType::CONFIG, m_configMessage);
+                    assignNext(worker);
+                } else if (type == MessageType::RESULT && worker.busy) {
+                    uint64_t first = reader.get<uint64_t>();
+                    uint64_t count = reader.get<uint64_t>();
+                    if (first != worker.firstHistory || count != worker.count) {
+                        throw std::runtime_error("plage renvoyée inattendue");
+                    }
+                    TallySnapshot batch = TallySnapshot::deserialize(payload.data() + reader.position(),
+                                                                     payload.size() - reader.position());
+                    m_results.merge(batch);
+                    recordBatch(batch);
+                    worker.busy = false;
+                    ++summary.ranges;
+
+                    double maxError = 0.0;
+                    if (m_config.targetRelativeError > 0.0 && m_batches >= m_config.minRanges && !stopIssuing &&
+                        isConverged(maxError)) {
+                        Log::info("Convergence atteinte après " + std::to_string(m_histories) + " histoires");
+                        stopIssuing = true;
+                        summary.converged = true;
+                    }
+                    assignNext(worker);
+                } else {
+                    throw std::runtime_error("message inattendu");
+                }
+            } catch (const std::exception& e) {
+                Log::warning(worker.label + " perdu: " + e.what());
+                if (worker.busy) {
+                    pending.emplace_front(worker.firstHistory, worker.count);
+                    ++summary.reassignedRanges;
+                    worker.busy = false;
+                }
+                worker.connection.close();
+            }
+        }
+
+        workers.erase(std::remove_if(workers.begin(), workers.end(),
+                                     [](const auto& w) { return !w->connection.isOpen(); }),
+                      workers.end());
+    }
+
+    // Workers restés connectés sans plage (arrivés après la dernière attribution)
+    for (auto& worker : workers) {
+        if (worker->connection.isOpen()) {
+            try {
+                sendMessage(worker->connection, MessageType::STOP);
+            } catch (const std::exception&) {
+            }
+        }
+    }
+
+    summary.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    summary.histories = m_histories;
+    isConverged(summary.maxRelativeError);
+    if (m_batches > 0) {
+        m_results.applyTo(*scene, m_engine, summary.elapsedSeconds);
+    }
+
+    Log::info("Run distribué terminé: " + std::to_string(summary.histories) + " histoires, " +
+              std::to_string(summary.ranges) + " plages, " + std::to_string(summary.workers) + " workers");
+    return summary;
+}
+
+void DistributedCoordinator::recordBatch(const TallySnapshot& batch) {
+    uint64_t histories = batch.counters.emitted;
+    if (histories == 0) return;
+
+    for (size_t i = 0; i < batch.sensors.size() && i < m_batchSum.size(); ++i) {
+        double value = batch.sensors[i].stats.weightedCounts.load();
+        m_batchSum[i] += value;
+        m_batchSumSqOverN[i] += value * value / static_cast<double>(histories);
+    }
+    m_histories += histories;
+    ++m_batches;
+}
+
+double DistributedCoordinator::relativeError(size_t sensorIndex) const {
+    if (sensorIndex >= m_batchSum.size() || m_batches < 2 || m_histories == 0) return 0.0;
+
+    // Même estimateur que BinnedTally : lots de tailles n_b, Var(m) = Σ n_b (x_b - m)² / ((B - 1) N)
+    const double n = static_cast<double>(m_histories);
+    double mean = m_batchSum[sensorIndex] / n;
+    if (mean <= 0.0) return 0.0;
+    double spread = std::max(0.0, m_batchSumSqOverN[sensorIndex] - n * mean * mean);
+    return std::sqrt(spread / ((m_batches - 1) * n)) / mean;
+}
+
+bool DistributedCoordinator::isConverged(double& maxError) const {
+    maxError = 0.0;
+    const auto& sensors = m_engine.getScene()->getAllSensors();
+    bool anyScored = false;
+    for (size_t i = 0; i < sensors.size() && i < m_batchSum.size(); ++i) {
+        if (!m_config.convergenceSensor.empty() && sensors[i]->getName() != m_config.convergenceSensor) continue;
+        if (m_batchSum[i] <= 0.0) continue;
+        anyScored = true;
+        maxError = std::max(maxError, relativeError(i));
+    }
+    return anyScored && m_batches >= 2 && maxError <= m_config.targetRelativeError;
+}
+
+// DistributedWorker
+uint64_t DistributedWorker::run(const std::string& address, uint32_t connectTimeoutMs) {
+    auto scene = m_engine.getScene();
+    if (!scene) throw std::runtime_error("Worker sans scène");
+
+    SocketConnection connection = SocketConnection::connect(address, connectTimeoutMs);
+    {
+        ByteWriter writer;
+        writer.put(VERSION);
+        writer.put(distributedFingerprint(*scene));
+        writer.put(std::max(1u, m_engine.getConfig().numThreads));
+        sendMessage(connection, MessageType::HELLO, writer.bytes());
+    }
+
+    uint64_t ranges = 0;
+    while (true) {
+        MessageType type;
+        std::vector<uint8_t> payload = receiveMessage(connection, type);
+        ByteReader reader(payload.data(), payload.size());
+
+        if (type == MessageType::STOP) break;
+
+        if (type == MessageType::CONFIG) {
+            SimulationConfig config = m_engine.getConfig();
+            uint32_t threads = config.numThreads;
+            getConfig(reader, config);
+            config.numThreads = std::max(1u, threads);
+            m_engine.setConfig(config);
+
+            m_engine.clearMeshTallies();
+            uint32_t meshCount = reader.get<uint32_t>();
+            for (uint32_t i = 0; i < meshCount; ++i) m_engine.addMeshTally(getMeshTally(reader));
+        } else if (type == MessageType::ASSIGN) {
+            uint64_t first = reader.get<uint64_t>();
+            uint64_t count = reader.get<uint64_t>();
+
+            // Résultats de la seule plage : le coordinateur fait la somme
+            for (const auto& sensor : scene->getAllSensors()) sensor->clearStats();
+            for (const auto& tally : m_engine.getMeshTallies()) tally->clear();
+            m_engine.resetStats();
+            m_engine.runHistoryRange(first, count);
+
+            ByteWriter writer;
+            writer.put(first);
+            writer.put(count);
+            std::vector<uint8_t> results = TallySnapshot::capture(*scene, m_engine).serialize();
+            writer.append(results.data(), results.size());
+            sendMessage(connection, MessageType::RESULT, writer.bytes());
+            ++ranges;
+        } else {
+            throw std::runtime_error("Message inattendu du coordinateur");
+        }
+    }
+    return ranges;
+}
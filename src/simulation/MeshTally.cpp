@@ -0,0 +1,167 @@
+#include "simulation/MeshTally.h"
+#include "simulation/Particle.h"
+#include "core/Sensor.h"
+#include <algorithm>
+#include <fstream>
+
+MeshTally::MeshTally(const std::string& name, const AABB& bounds, uint32_t nx, uint32_t ny, uint32_t nz)
+    : m_name(name), m_grid(bounds, nx, ny, nz) {
+    clear();
+}
+
+void MeshTally::setEnergyBins(const std::vector<float>& bounds) {
+    m_binBounds = bounds;
+    std::sort(m_binBounds.begin(), m_binBounds.end());
+    m_threadBuffers.clear();
+    clear();
+}
+
+uint32_t MeshTally::binIndex(float energy) const {
+    if (m_binBounds.size() < 3) return 0;
+
+    auto it = std::upper_bound(m_binBounds.begin() + 1, m_binBounds.end() - 1, energy);
+    return static_cast<uint32_t>(it - (m_binBounds.begin() + 1));
+}
+
+void MeshTally::setFluxToDoseFactors(const std::vector<std::pair<float, float>>& factors) {
+    m_fluxToDose = factors;
+    std::sort(m_fluxToDose.begin(), m_fluxToDose.end());
+}
+
+void MeshTally::ensureThreadSlots(uint32_t threadCount) {
+    if (m_threadBuffers.size() < threadCount) {
+        m_threadBuffers.resize(threadCount);
+    }
+}
+
+void MeshTally::ThreadBuffer::add(size_t index, double value) {
+    size_t block = index / BLOCK_SIZE;
+    if (!dirty[block]) {
+        if (!blocks[block]) {
+            blocks[block] = std::make_unique<double[]>(BLOCK_SIZE); // Initialisé à zéro
+        }
+        dirty[block] = 1;
+        touched.push_back(static_cast<uint32_t>(block));
+    }
+    blocks[block][index % BLOCK_SIZE] += value;
+}
+
+bool MeshTally::accepts(const Particle& particle) const {
+    if (m_radiationFilter.empty()) return true;
+
+    return std::find(m_radiationFilter.begin(), m_radiationFilter.end(), particle.getType()) !=
+           m_radiationFilter.end();
+}
+
+void MeshTally::scoreSegment(uint32_t threadSlot, const glm::vec3& p0, const glm::vec3& p1, const Particle& particle) {
+    if (threadSlot >= m_threadBuffers.size() || !accepts(particle)) return;
+
+    ThreadBuffer& buffer = m_threadBuffers[threadSlot];
+    if (buffer.blocks.empty()) {
+        buffer.blocks.resize((slotCount() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+        buffer.dirty.assign(buffer.blocks.size(), 0);
+    }
+
+    const uint32_t cellCount = m_grid.getCellCount();
+    const size_t fluenceOffset = static_cast<size_t>(binIndex(particle.getEnergy())) * cellCount;
+    const size_t doseOffset = m_fluence.size();
+
+    // Fluence moyenne du voxel : w·L / V
+    const glm::vec3 cellSize = m_grid.getCellSize();
+    const double invVolume = 1.0 / (static_cast<double>(cellSize.x) * cellSize.y * cellSize.z);
+    const double weight = particle.getWeight() * invVolume;
+    const double doseFactor = m_fluxToDose.empty()
+                                  ? 0.0
+                                  : 1e-4 * Sensor::interpolateFluxToDose(m_fluxToDose, particle.getEnergy());
+
+    m_grid.traverseSegment(p0, p1, [&](uint32_t cell, float length) {
+        double fluence = weight * length;
+        buffer.add(fluenceOffset + cell, fluence);
+        if (doseFactor > 0.0) {
+            buffer.add(doseOffset + cell, fluence * doseFactor);
+        }
+    });
+}
+
+void MeshTally::mergeThreadBuffers() {
+    const size_t fluenceSize = m_fluence.size();
+    const size_t total = slotCount();
+
+    for (auto& buffer : m_threadBuffers) {
+        for (uint32_t block : buffer.touched) {
+            double* values = buffer.blocks[block].get();
+            size_t begin = static_cast<size_t>(block) * BLOCK_SIZE;
+            size_t end = std::min(begin + BLOCK_SIZE, total);
+
+            for (size_t i = begin; i < end; ++i) {
+                double value = values[i - begin];
+                if (i < fluenceSize) {
+                    m_fluence[i] += value;
+                } else {
+                    m_dose[i - fluenceSize] += value;
+                }
+            }
+            // Bloc remis à zéro mais conservé pour le lot suivant
+            std::fill(values, values + BLOCK_SIZE, 0.0);
+            buffer.dirty[block] = 0;
+        }
+        buffer.touched.clear();
+    }
+}
+
+void MeshTally::addTotals(const std::vector<double>& fluence, const std::vector<double>& dose) {
+    if (fluence.size() != m_fluence.size() || dose.size() != m_dose.size()) {
+        throw std::runtime_error("Fusion du tally maillé " + m_name + " : dimensions différentes");
+    }
+    for (size_t i = 0; i < fluence.size(); ++i) m_fluence[i] += fluence[i];
+    for (size_t i = 0; i < dose.size(); ++i) m_dose[i] += dose[i];
+}
+
+void MeshTally::clear() {
+    m_fluence.assign(static_cast<size_t>(m_grid.getCellCount()) * getBinCount(), 0.0);
+    m_dose.assign(m_grid.getCellCount(), 0.0);
+
+    for (auto& buffer : m_threadBuffers) {
+        buffer.blocks.clear();
+        buffer.dirty.clear();
+        buffer.touched.clear();
+    }
+}
+
+double MeshTally::getTotalFluence(uint32_t cell) const {
+    double total = 0.0;
+    for (uint32_t bin = 0; bin < getBinCount(); ++bin) {
+        total += getFluence(cell, bin);
+    }
+    return total;
+}
+
+void MeshTally::exportCsv(const std::string& filename, uint64_t histories) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier: " + filename);
+    }
+
+    const double norm = histories > 0 ? 1.0 / static_cast<double>(histories) : 1.0;
+    const uint32_t bins = getBinCount();
+
+    file << "x,y,z,fluence_m2,dose_pSv";
+    if (bins > 1) {
+        for (uint32_t bin = 0; bin < bins; ++bin) {
+            file << ",fluence_" << m_binBounds[bin] << "_" << m_binBounds[bin + 1] << "keV";
+        }
+    }
+    file << "\n";
+
+    for (uint32_t cell = 0; cell < m_grid.getCellCount(); ++cell) {
+        glm::vec3 center = m_grid.cellCenter(cell);
+        file << center.x << "," << center.y << "," << center.z << "," << getTotalFluence(cell) * norm << ","
+             << getDose(cell) * norm;
+        if (bins > 1) {
+            for (uint32_t bin = 0; bin < bins; ++bin) {
+                file << "," << getFluence(cell, bin) * norm;
+            }
+        }
+        file << "\n";
+    }
+}
@@ -2,6 +2,9 @@
 #include "simulation/MonteCarloEngine.h"
 #include "simulation/Particle.h"
 #include "core/Material.h"
+#include "core/KleinNishina.h"
+#include "core/StoppingPower.h"
+#include "utils/Profiler.h"
 #include <algorithm>
 #include <cmath>
 #include <future>
@@ -10,6 +13,12 @@
 // Générateur aléatoire thread-local pour le moteur Monte Carlo
 thread_local std::mt19937 MonteCarloEngine::s_rng(std::random_device{}());
 
+namespace
+{
+constexpr float BOUNDARY_NUDGE = 1e-4f;   // m, décalage après franchissement d'une frontière
+constexpr float MIN_CHARGED_STEP = 1e-6f; // m, pas condensé minimal
+}
+
 MonteCarloEngine::MonteCarloEngine(std::shared_ptr<Scene> scene)
     : m_scene(scene)
 {
@@ -22,17 +31,66 @@ MonteCarloEngine::~MonteCarloEngine()
 }
 
 void MonteCarloEngine::startSimulation()
+{
+    startRange(0, m_config.maxParticles);
+}
+
+void MonteCarloEngine::runHistoryRange(uint64_t firstHistory, uint64_t count)
+{
+    if (m_config.rngSeed == 0)
+        throw std::runtime_error("Plage d'histoires sans graine reproductible (SimulationConfig::rngSeed)");
+    if (firstHistory % std::max(1u, m_config.historiesPerStream) != 0)
+        throw std::runtime_error("Plage d'histoires non alignée sur les flux aléatoires: " +
+                                 std::to_string(firstHistory));
+
+    startRange(firstHistory, firstHistory + count);
+    waitForCompletion();
+}
+
+void MonteCarloEngine::startRange(uint64_t firstHistory, uint64_t endHistory)
 {
     std::lock_guard<std::mutex> lock(m_stateMutex);
 
     if (m_state == SimulationState::RUNNING)
         return;
 
+    m_nextHistory = firstHistory;
+    m_rangeEnd = endHistory;
+
     m_shouldStop = false;
     m_shouldPause = false;
     m_state = SimulationState::RUNNING;
     m_stats.startTime = std::chrono::steady_clock::now();
 
+    // Contextes de transport par thread ; les arènes survivent au run (blocs déjà alloués)
+    m_threadContexts.clear();
+    m_threadContexts.resize(m_config.numThreads);
+    while (m_threadArenas.size() < m_config.numThreads)
+    {
+        m_threadArenas.push_back(std::make_unique<MonotonicArena>());
+    }
+    for (uint32_t i = 0; i < m_config.numThreads; ++i)
+    {
+        m_threadContexts[i].threadId = i;
+        m_threadContexts[i].attachArena(m_threadArenas[i].get());
+    }
+
+    prepareChargedTransport();
+    prepareCulling();
+    prepareImplicitCapture();
+    prepareNumaPlacement();
+    prepareTallies(m_config.numThreads);
+    if (m_phaseSpaceWriter)
+        m_phaseSpaceWriter->prepare(m_config.numThreads);
+    if (m_trackRecorder)
+    {
+        m_trackRecorder->prepare(m_config.numThreads);
+        for (auto &ctx : m_threadContexts)
+        {
+            attachTrackChannel(ctx);
+        }
+    }
+
     // Lancement des threads de travail
     m_workers.clear();
     for (uint32_t i = 0; i < m_config.numThreads; ++i)
@@ -64,11 +122,43 @@ void MonteCarloEngine::stopSimulation()
         }
     }
     m_workers.clear();
+    mergeMeshTallies();
+    mergeReplicaStats();
+    if (m_trackRecorder)
+        m_trackRecorder->flush();
+    if (m_phaseSpaceWriter)
+        m_phaseSpaceWriter->flush(m_stats.particlesEmitted.load());
 
     m_stats.endTime = std::chrono::steady_clock::now();
     Log::info("Simulation arrêtée");
 }
 
+void MonteCarloEngine::waitForCompletion()
+{
+    // Les threads s'arrêtent d'eux-mêmes une fois la limite d'histoires atteinte
+    for (auto &worker : m_workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+    mergeMeshTallies();
+    mergeReplicaStats();
+    if (m_trackRecorder)
+        m_trackRecorder->flush();
+    if (m_phaseSpaceWriter)
+        m_phaseSpaceWriter->flush(m_stats.particlesEmitted.load());
+
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        if (m_state == SimulationState::RUNNING)
+            m_state = SimulationState::COMPLETED;
+    }
+    m_stats.endTime = std::chrono::steady_clock::now();
+}
+
 void MonteCarloEngine::pauseSimulation()
 {
     std::lock_guard<std::mutex> lock(m_stateMutex);
@@ -97,26 +187,44 @@ void MonteCarloEngine::runBatch(uint32_t numParticles)
     if (!m_scene)
         return;
 
-    auto sources = m_scene->getAllSources();
+    const auto &sources = m_scene->getAllSources();
     if (sources.empty())
         return;
 
-    std::uniform_int_distribution<size_t> sourceDist(0, sources.size() - 1);
-
+    PROFILE_SCOPE(ProfileStage::BATCH);
+    TransportContext ctx;
+    ctx.attachArena(&m_batchArena);
+    prepareChargedTransport();
+    prepareCulling();
+    prepareImplicitCapture();
+    prepareTallies(1);
+    if (m_phaseSpaceWriter)
+        m_phaseSpaceWriter->prepare(1);
+    if (m_trackRecorder)
+    {
+        m_trackRecorder->prepare(1);
+        attachTrackChannel(ctx);
+    }
+    uint64_t histories = 0;
     for (uint32_t i = 0; i < numParticles; ++i)
     {
-        // Sélection aléatoire d'une source
-        auto source = sources[sourceDist(s_rng)];
-        if (!source->isEnabled())
+        Particle particle;
+        if (!sampleSourceParticle(sources, particle, ctx))
             continue;
 
-        // Émission d'une particule
-        Particle particle = source->emitParticle();
         m_stats.particlesEmitted.fetch_add(1);
+        ++histories;
 
         // Transport
-        transportParticleInternal(particle);
+        transportParticleInternal(particle, ctx);
     }
+    endTallyBatch(ctx.threadId, histories);
+    ctx.resetArena();
+    mergeMeshTallies();
+    if (m_trackRecorder)
+        m_trackRecorder->flush();
+    if (m_phaseSpaceWriter)
+        m_phaseSpaceWriter->flush(m_stats.particlesEmitted.load());
 }
 
 float MonteCarloEngine::getProgress() const
@@ -129,6 +237,11 @@ void MonteCarloEngine::workerThread(uint32_t threadId)
 {
     const uint32_t batchSize = 1000;
 
+    if (m_threadContexts[threadId].pinnedCpu >= 0)
+    {
+        NumaTopology::pinCurrentThread(static_cast<uint32_t>(m_threadContexts[threadId].pinnedCpu));
+    }
+
     while (!m_shouldStop)
     {
         // Vérification de pause
@@ -141,6 +254,21 @@ void MonteCarloEngine::workerThread(uint32_t threadId)
                 break;
         }
 
+        if (m_config.rngSeed != 0)
+        {
+            // Flux suivant de la plage : découpage indépendant du nombre de threads
+            const uint32_t streamSize = std::max(1u, m_config.historiesPerStream);
+            uint64_t first = m_nextHistory.fetch_add(streamSize);
+            if (first >= m_rangeEnd)
+            {
+                std::lock_guard<std::mutex> lock(m_stateMutex);
+                m_state = SimulationState::COMPLETED;
+                break;
+            }
+            emitAndTransportStream(first, std::min<uint64_t>(streamSize, m_rangeEnd - first), threadId);
+            continue;
+        }
+
         // Vérification si on a atteint la limite
         if (m_stats.particlesEmitted.load() >= m_config.maxParticles)
         {
@@ -154,43 +282,171 @@ void MonteCarloEngine::workerThread(uint32_t threadId)
     }
 }
 
+void MonteCarloEngine::emitAndTransportStream(uint64_t firstHistory, uint64_t count, uint32_t threadId)
+{
+    if (!m_scene)
+        return;
+
+    const auto &sources = m_scene->getAllSources();
+    if (sources.empty())
+        return;
+
+    PROFILE_SCOPE(ProfileStage::BATCH);
+    TransportContext &ctx = m_threadContexts[threadId];
+
+    // Générateurs du thread repositionnés sur le flux (un flux par historiesPerStream histoires)
+    const uint64_t stream = firstHistory / std::max(1u, m_config.historiesPerStream);
+    RandomGenerator::seedStream(m_config.rngSeed, stream);
+    s_rng.seed(RandomGenerator::generator());
+
+    uint64_t histories = 0;
+    for (uint64_t i = 0; i < count && !m_shouldStop; ++i)
+    {
+        // N° global de l'histoire : les espaces des phases en déduisent l'enregistrement rejoué
+        RandomGenerator::setHistory(firstHistory + i);
+        Particle particle;
+        if (!sampleSourceParticle(sources, particle, ctx))
+            continue;
+
+        m_stats.particlesEmitted.fetch_add(1);
+        ++histories;
+        transportParticleInternal(particle, ctx);
+    }
+    RandomGenerator::setHistory(RandomGenerator::NO_HISTORY);
+
+    endTallyBatch(threadId, histories);
+    if (ctx.replica)
+        mergeReplicaStats(*ctx.replica);
+    ctx.resetArena();
+}
+
 void MonteCarloEngine::emitAndTransportBatch(uint32_t batchSize, uint32_t threadId)
 {
     if (!m_scene)
         return;
 
-    auto sources = m_scene->getAllSources();
+    const auto &sources = m_scene->getAllSources();
     if (sources.empty())
         return;
 
-    std::uniform_int_distribution<size_t> sourceDist(0, sources.size() - 1);
+    PROFILE_SCOPE(ProfileStage::BATCH);
+    TransportContext &ctx = m_threadContexts[threadId];
+    uint64_t histories = 0;
 
     for (uint32_t i = 0; i < batchSize && !m_shouldStop; ++i)
     {
         if (m_stats.particlesEmitted.load() >= m_config.maxParticles)
             break;
 
-        // Sélection d'une source active
-        auto source = sources[sourceDist(s_rng)];
-        if (!source->isEnabled())
+        // Émission depuis une source active
+        Particle particle;
+        if (!sampleSourceParticle(sources, particle, ctx))
             continue;
 
-        // Émission
-        Particle particle = source->emitParticle();
-        source->incrementEmitted();
         m_stats.particlesEmitted.fetch_add(1);
+        ++histories;
 
         // Transport
-        transportParticleInternal(particle);
+        transportParticleInternal(particle, ctx);
     }
+
+    endTallyBatch(threadId, histories);
+    if (ctx.replica)
+        mergeReplicaStats(*ctx.replica);
+    ctx.resetArena();
+}
+
+bool MonteCarloEngine::sampleSourceParticle(const std::vector<std::shared_ptr<Source>> &sources, Particle &particle,
+                                            TransportContext &ctx)
+{
+    PROFILE_SCOPE(ProfileStage::SOURCE_SAMPLING);
+
+    // Source biaisée par l'importance adjointe (CADIS)
+    if (m_sourceBiasing)
+        return m_sourceBiasing->sample(particle, ctx.emitter, ctx.emissionWeight);
+
+    std::uniform_int_distribution<size_t> sourceDist(0, sources.size() - 1);
+
+    // Sélection aléatoire d'une source
+    auto source = sources[sourceDist(s_rng)];
+    if (!source->isEnabled())
+        return false;
+
+    // emitParticle() incrémente déjà le compteur de la source
+    particle = source->emitParticle();
+    ctx.emitter = source.get();
+    ctx.emissionWeight = particle.getWeight();
+    return true;
 }
 
 void MonteCarloEngine::transportParticle(Particle &particle)
 {
-    transportParticleInternal(particle);
+    MonotonicArena arena(4096);
+    TransportContext ctx;
+    ctx.attachArena(&arena);
+    transportParticleInternal(particle, ctx);
+}
+
+void MonteCarloEngine::transportParticleInternal(Particle &particle, TransportContext &ctx)
+{
+    if (ctx.importance)
+    {
+        ctx.importance->beginHistory();
+    }
+    ctx.lastCell = -1;
+    ctx.historySecondaries = 0;
+    ctx.recordTrack = ctx.tracks && ctx.tracks->beginHistory();
+
+    // Contribution next-event du point d'émission
+    if (ctx.emitter)
+    {
+        if (m_config.useNextEventEstimator)
+        {
+            scoreNextEventAtEmission(particle, ctx);
+        }
+        ctx.emitter = nullptr;
+    }
+
+    transportTrack(particle, ctx);
+
+    while (true)
+    {
+        // Progéniture issue du splitting : même histoire
+        while (!ctx.bank.empty())
+        {
+            Particle progeny = ctx.bank.back();
+            ctx.bank.pop_back();
+
+            // Le poids de la copie est déjà compté dans l'entrée de la cellule parente
+            ctx.lastCell = m_weightWindows ? m_weightWindows->cellIndex(progeny.getPosition()) : -1;
+            transportTrack(progeny, ctx);
+        }
+
+        // Secondaires, une fois la trace parente (et ses copies) terminée
+        if (ctx.secondaries.empty())
+            break;
+        Particle secondary = ctx.secondaries.back();
+        ctx.secondaries.pop_back();
+
+        // Émission isotrope : contribution next-event du point de production
+        if (m_config.useNextEventEstimator)
+        {
+            PROFILE_SCOPE(ProfileStage::NEXT_EVENT);
+            scoreNextEvent(secondary, secondary.getWeight(),
+                           [](const glm::vec3 &, float &) { return 1.0 / (4.0 * PI); }, ctx);
+        }
+        ctx.lastCell = -1;
+        transportTrack(secondary, ctx);
+    }
+
+    if (ctx.importance)
+    {
+        ctx.importance->endHistory();
+    }
+    ctx.recordTrack = false;
 }
 
-void MonteCarloEngine::transportParticleInternal(Particle &particle)
+void MonteCarloEngine::transportTrack(Particle &particle, TransportContext &ctx)
 {
     m_stats.particlesTransported.fetch_add(1);
 
@@ -198,10 +454,19 @@ void MonteCarloEngine::transportParticleInternal(Particle &particle)
     {
         particle.setCurrentMaterial(m_worldMaterial);
     }
+    if (ctx.replica)
+    {
+        // Matériaux du nœud : les comparaisons aux frontières portent sur les copies locales
+        particle.setCurrentMaterial(ctx.replica->localMaterial(particle.getCurrentMaterial()));
+    }
+
+    recordImportance(particle, ctx);
 
+    const bool useWeightWindows = m_config.useWeightWindows && m_weightWindows;
     uint32_t bounceCount = 0;
+    uint32_t chargedSteps = 0;
 
-    while (particle.isActive() && bounceCount < m_config.maxBounces)
+    while (particle.isActive() && bounceCount < m_config.maxBounces && chargedSteps < m_config.maxChargedSteps)
     {
         if (m_shouldStop)
             break;
@@ -209,6 +474,8 @@ void MonteCarloEngine::transportParticleInternal(Particle &particle)
         // Énergie minimale
         if (particle.getEnergy() < m_config.energyCutoff)
         {
+            recordTrackEvent(ctx, TrackEventType::ENERGY_CUTOFF, particle, particle.getCurrentMaterial().get(),
+                             particle.getPosition(), particle.getEnergy(), particle.getWeight());
             particle.absorb();
             break;
         }
@@ -216,28 +483,72 @@ void MonteCarloEngine::transportParticleInternal(Particle &particle)
         // Temps maximum
         if (particle.getAge() > m_config.timeCutoff)
         {
+            recordTrackEvent(ctx, TrackEventType::TIME_CUTOFF, particle, particle.getCurrentMaterial().get(),
+                             particle.getPosition(), particle.getEnergy(), particle.getWeight());
             particle.escape();
             break;
         }
 
-        // Étape de transport
-        if (!stepParticle(particle))
+        // Étape de transport : histoire condensée pour les particules chargées (matériau avec tables)
+        const Material *material = particle.getCurrentMaterial().get();
+        const StoppingPowerTable *stopping = material ? material->getStoppingPowerTable(particle.getType()) : nullptr;
+
+        // Particules neutres hors d'atteinte des cibles (les chargées : rejet sur portée)
+        if (!stopping && m_config.useCulling && cullParticle(particle, ctx))
+        {
+            break;
+        }
+
+        if (stopping ? !stepCondensedHistory(particle, *stopping, ctx) : !stepParticle(particle, ctx))
         {
             break;
         }
 
-        ++bounceCount;
+        ++(stopping ? chargedSteps : bounceCount);
+        recordImportance(particle, ctx);
 
-        // Roulette russe pour terminer les particules de faible poids
-        if (m_config.useRussianRoulette && particle.getWeight() < m_config.russianRouletteThreshold)
+        if (useWeightWindows)
+        {
+            // Splitting / roulette selon la fenêtre de la cellule courante
+            float weight = particle.getWeight();
+            if (!applyWeightWindow(particle, ctx))
+            {
+                recordTrackEvent(ctx, TrackEventType::ROULETTE, particle, particle.getCurrentMaterial().get(),
+                                 particle.getPosition(), particle.getEnergy(), weight);
+                break;
+            }
+        }
+        else if (implicitCapture(particle.getType()))
+        {
+            // Capture implicite : le poids ne fait que décroître, la roulette termine l'histoire
+            float weight = particle.getWeight();
+            if (weight < m_config.implicitCaptureWeightCutoff &&
+                russianRoulette(particle, m_config.implicitCaptureSurvivalWeight))
+            {
+                recordTrackEvent(ctx, TrackEventType::ROULETTE, particle, particle.getCurrentMaterial().get(),
+                                 particle.getPosition(), particle.getEnergy(), weight);
+                break;
+            }
+        }
+        else if (m_config.useRussianRoulette && particle.getWeight() < m_config.russianRouletteThreshold)
         {
-            if (!russianRoulette(particle))
+            // Roulette russe pour terminer les particules de faible poids
+            float weight = particle.getWeight();
+            if (russianRoulette(particle, m_config.russianRouletteThreshold))
             {
+                recordTrackEvent(ctx, TrackEventType::ROULETTE, particle, particle.getCurrentMaterial().get(),
+                                 particle.getPosition(), particle.getEnergy(), weight);
                 break;
             }
         }
     }
 
+    if ((bounceCount >= m_config.maxBounces || chargedSteps >= m_config.maxChargedSteps) && particle.isActive())
+    {
+        recordTrackEvent(ctx, TrackEventType::BOUNCE_LIMIT, particle, particle.getCurrentMaterial().get(),
+                         particle.getPosition(), particle.getEnergy(), particle.getWeight());
+    }
+
     // Statistiques finales
     switch (particle.getState())
     {
@@ -255,34 +566,72 @@ void MonteCarloEngine::transportParticleInternal(Particle &particle)
     }
 }
 
-bool MonteCarloEngine::stepParticle(Particle &particle)
+bool MonteCarloEngine::stepParticle(Particle &particle, TransportContext &ctx)
 {
     glm::vec3 startPos = particle.getPosition();
     auto currentMaterial = particle.getCurrentMaterial();
+    const float startEnergy = particle.getEnergy();
+    const float startWeight = particle.getWeight();
 
+    PROFILE_COUNT(ProfileCounter::STEPS, 1);
     float mu = 0.0f;
     if (currentMaterial)
     {
+        PROFILE_SCOPE(ProfileStage::CROSS_SECTION);
         mu = currentMaterial->getLinearAttenuationPerMeter(particle.getType(), particle.getEnergy());
     }
 
+    // Biaisage de la région : collision forcée, ou libre parcours tiré avec μ* (transformation exponentielle)
+    const RegionBiasing *biasing = regionBiasing(particle);
+    const bool forced = biasing && biasing->forcedCollisions && mu > 0.0f;
+    float sampledMu = mu;
+    if (biasing && !forced && biasing->exponentialTransform > 0.0f)
+    {
+        float cosTheta = glm::dot(particle.getDirection(), biasing->preferredDirection);
+        sampledMu = mu * (1.0f - biasing->exponentialTransform * cosTheta);
+    }
+    const float stretch = mu - sampledMu;
+
     float freePath = std::numeric_limits<float>::infinity();
-    if (mu > 0.0f)
+    if (sampledMu > 0.0f && !forced)
     {
         float xi = RandomGenerator::random();
         xi = std::clamp(xi, 1e-6f, 1.0f - 1e-6f);
-        freePath = -std::log(1.0f - xi) / mu;
+        freePath = -std::log(1.0f - xi) / sampledMu;
     }
 
     Ray ray = particle.getRay();
-    IntersectionResult hit = m_scene->intersectRay(ray);
-    m_stats.rayIntersections.fetch_add(1);
+    IntersectionResult hit;
+    {
+        PROFILE_SCOPE(ProfileStage::RAY_CAST);
+        hit = ctx.replica ? ctx.replica->intersectRay(ray) : m_scene->intersectRay(ray);
+    }
+    (ctx.replica ? ctx.replica->rayIntersections : m_stats.rayIntersections).fetch_add(1);
 
     float boundaryDistance = hit.hit ? hit.distance : std::numeric_limits<float>::infinity();
+
+    // Collision forcée : part collisionnée mise en banque, la particule traverse sans collision.
+    // Frontière non vue (plus proche que le tMin du rayon) : libre parcours analogique
+    if (forced && hit.hit)
+    {
+        forceCollision(particle, currentMaterial, mu, boundaryDistance, ctx);
+        if (particle.getWeight() <= 0.0f)
+        {
+            particle.absorb();
+            return false;
+        }
+    }
+    else if (forced)
+    {
+        float xi = std::clamp(RandomGenerator::random(), 1e-6f, 1.0f - 1e-6f);
+        freePath = -std::log(1.0f - xi) / mu;
+    }
     float stepDistance = std::min(freePath, boundaryDistance);
 
     if (!std::isfinite(stepDistance) || stepDistance <= 0.0f)
     {
+        recordTrackEvent(ctx, TrackEventType::ESCAPE, particle, currentMaterial.get(), startPos, startEnergy,
+                         startWeight);
         particle.escape();
         return false;
     }
@@ -290,153 +639,1250 @@ bool MonteCarloEngine::stepParticle(Particle &particle)
     particle.move(stepDistance);
     glm::vec3 endPos = particle.getPosition();
 
-    const auto &sensors = m_scene->getAllSensors();
-    for (const auto &sensor : sensors)
+    // Espace des phases : enregistrement à la traversée, fin de trace si la surface découple
+    bool leavesPhaseSpace = false;
+    glm::vec3 crossing;
+    if (m_phaseSpaceWriter && m_phaseSpaceWriter->getSurface().crossing(startPos, endPos, crossing))
     {
-        if (sensor && sensor->intersectsSegment(startPos, endPos))
+        m_phaseSpaceWriter->record(ctx.threadId, particle, crossing);
+        if (m_phaseSpaceWriter->terminatesParticles())
         {
-            sensor->recordParticle(particle);
+            particle.setPosition(crossing);
+            endPos = crossing;
+            leavesPhaseSpace = true;
         }
     }
 
+    if (stretch != 0.0f)
+    {
+        scoreStretchedSegment(particle, startPos, endPos, stretch, ctx);
+    }
+    else
+    {
+        scoreSegment(particle, startPos, endPos, ctx);
+    }
+
+    if (leavesPhaseSpace)
+    {
+        recordTrackEvent(ctx, TrackEventType::ESCAPE, particle, currentMaterial.get(), startPos, startEnergy,
+                         startWeight);
+        particle.escape();
+        return false;
+    }
+
     if (freePath < boundaryDistance)
     {
         if (currentMaterial)
         {
-            InteractionType interaction = sampleInteraction(particle, currentMaterial);
-            processInteraction(particle, interaction, currentMaterial);
-            m_stats.totalCollisions.fetch_add(1);
+            // Transformation exponentielle : rapport des densités de collision analogique et biaisée
+            if (stretch != 0.0f)
+            {
+                particle.setWeight(startWeight * mu / sampledMu * std::exp(-stretch * freePath));
+            }
+            if (m_config.useNextEventEstimator)
+            {
+                scoreNextEventAtCollision(particle, currentMaterial, ctx);
+            }
+
+            InteractionChannel channel = sampleInteraction(particle, currentMaterial);
+            InteractionType interaction = processInteraction(particle, channel, currentMaterial, ctx);
+            (ctx.replica ? ctx.replica->totalCollisions : m_stats.totalCollisions).fetch_add(1);
+            recordTrackEvent(ctx, trackEventType(interaction), particle, currentMaterial.get(), startPos,
+                             startEnergy, startWeight);
         }
         return particle.isActive();
     }
 
     if (!hit.hit)
     {
+        recordTrackEvent(ctx, TrackEventType::ESCAPE, particle, currentMaterial.get(), startPos, startEnergy,
+                         startWeight);
         particle.escape();
         return false;
     }
 
-    if (currentMaterial && hit.material == currentMaterial)
+    // Transformation exponentielle : rapport des probabilités de traversée sans collision
+    if (stretch != 0.0f)
     {
-        particle.setCurrentMaterial(m_worldMaterial);
-    }
-    else
-    {
-        particle.setCurrentMaterial(hit.material ? hit.material : m_worldMaterial);
+        particle.setWeight(startWeight * std::exp(-stretch * boundaryDistance));
     }
-
-    particle.move(1e-4f);
+    recordTrackEvent(ctx, TrackEventType::BOUNDARY, particle, currentMaterial.get(), startPos, startEnergy,
+                     startWeight);
+    crossBoundary(particle, hit, currentMaterial, ctx);
 
     return particle.isActive();
 }
 
-InteractionType MonteCarloEngine::sampleInteraction(const Particle &particle,
-                                                    std::shared_ptr<Material> material)
+const RegionBiasing *MonteCarloEngine::regionBiasing(const Particle &particle) const
 {
-    return material->sampleInteraction(particle.getType(), particle.getEnergy());
+    // Sans effet avec un espace des phases : chaque traversée doit y figurer avec le poids analogique
+    const Object3D *region = particle.getRegion();
+    if (!region || m_phaseSpaceWriter || !region->getBiasing().isActive())
+        return nullptr;
+    return &region->getBiasing();
 }
 
-void MonteCarloEngine::processInteraction(Particle &particle, InteractionType interaction,
-                                          std::shared_ptr<Material> material)
+void MonteCarloEngine::forceCollision(Particle &particle, const std::shared_ptr<Material> &material, float mu,
+                                      float distance, TransportContext &ctx)
 {
-    switch (interaction)
+    const glm::vec3 startPos = particle.getPosition();
+    const float startEnergy = particle.getEnergy();
+    const float weight = particle.getWeight();
+    const float transmission = std::exp(-mu * distance);
+
+    // Part collisionnée : point d'interaction tiré dans l'exponentielle tronquée à la traversée
+    Particle collided = particle;
+    collided.setWeight(weight * (1.0f - transmission));
+    const float collidedWeight = collided.getWeight();
+    float xi = RandomGenerator::random();
+    collided.move(-std::log(1.0f - xi * (1.0f - transmission)) / mu);
+    scoreSegment(collided, startPos, collided.getPosition(), ctx);
+
+    if (m_config.useNextEventEstimator)
     {
-    case InteractionType::ABSORPTION:
+        scoreNextEventAtCollision(collided, material, ctx);
+    }
+    InteractionChannel channel = sampleInteraction(collided, material);
+    InteractionType interaction = processInteraction(collided, channel, material, ctx);
+    (ctx.replica ? ctx.replica->totalCollisions : m_stats.totalCollisions).fetch_add(1);
+    recordTrackEvent(ctx, trackEventType(interaction), collided, material.get(), startPos, startEnergy,
+                     collidedWeight);
+    if (collided.isActive())
+    {
+        ctx.bank.push_back(collided);
+    }
+
+    // Part non collisionnée
+    particle.setWeight(weight * transmission);
+}
+
+bool MonteCarloEngine::stepCondensedHistory(Particle &particle, const StoppingPowerTable &table,
+                                            TransportContext &ctx)
+{
+    const glm::vec3 startPos = particle.getPosition();
+    const auto currentMaterial = particle.getCurrentMaterial();
+    const float startEnergy = particle.getEnergy();
+    const float startWeight = particle.getWeight();
+
+    PROFILE_COUNT(ProfileCounter::STEPS, 1);
+
+    // Rejet sur portée : la portée majorante (matériaux de la scène) n'atteint aucune cible
+    auto bound = m_rangeBounds.find(particle.getType());
+    if (bound != m_rangeBounds.end() && distanceToTargets(startPos, ctx) > bound->second->range(startEnergy))
+    {
+        recordTrackEvent(ctx, TrackEventType::RANGE_CUTOFF, particle, currentMaterial.get(), startPos, startEnergy,
+                         startWeight);
         particle.absorb();
-        break;
+        m_stats.particlesCulled.fetch_add(1);
+        return false;
+    }
 
-    case InteractionType::SCATTERING:
+    // Pas : fraction de la portée résiduelle, tronqué à la frontière suivante
+    const float range = table.range(startEnergy);
+    float step = std::min(std::max(m_config.chargedStepFraction * range, MIN_CHARGED_STEP), range);
+    bool stops = step >= range;
+
+    Ray ray = particle.getRay();
+    IntersectionResult hit;
     {
-        glm::vec3 newDir = material->sampleScattering(particle.getDirection(),
-                                                      particle.getType(),
-                                                      particle.getEnergy());
+        PROFILE_SCOPE(ProfileStage::RAY_CAST);
+        hit = ctx.replica ? ctx.replica->intersectRay(ray) : m_scene->intersectRay(ray);
+    }
+    (ctx.replica ? ctx.replica->rayIntersections : m_stats.rayIntersections).fetch_add(1);
 
-        // Perte d'énergie (simplifiée)
-        float energyLoss = 0.1f * particle.getEnergy() * RandomGenerator::random();
-        particle.scatter(newDir, energyLoss);
-        break;
+    const bool crossing = hit.hit && hit.distance <= step;
+    if (crossing)
+    {
+        step = hit.distance;
+        stops = false;
     }
 
-    case InteractionType::CAPTURE:
+    // Perte continue : énergie dont la portée est celle restant après le pas ; l'énergie moyenne
+    // du pas sert au temps de vol, aux comptages et à la diffusion multiple
+    const float endEnergy = stops ? 0.0f : table.energyAtRange(range - step);
+    particle.setEnergy(0.5f * (startEnergy + endEnergy));
+    particle.move(step);
+    glm::vec3 endPos = particle.getPosition();
+
+    bool leavesPhaseSpace = false;
+    glm::vec3 phaseSpaceCrossing;
+    if (m_phaseSpaceWriter && m_phaseSpaceWriter->getSurface().crossing(startPos, endPos, phaseSpaceCrossing))
+    {
+        m_phaseSpaceWriter->record(ctx.threadId, particle, phaseSpaceCrossing);
+        if (m_phaseSpaceWriter->terminatesParticles())
+        {
+            particle.setPosition(phaseSpaceCrossing);
+            endPos = phaseSpaceCrossing;
+            leavesPhaseSpace = true;
+        }
+    }
+
+    scoreSegment(particle, startPos, endPos, ctx);
+
+    if (leavesPhaseSpace)
+    {
+        recordTrackEvent(ctx, TrackEventType::ESCAPE, particle, currentMaterial.get(), startPos, startEnergy,
+                         startWeight);
+        particle.escape();
+        return false;
+    }
+
+    if (stops)
+    {
+        recordTrackEvent(ctx, TrackEventType::ABSORPTION, particle, currentMaterial.get(), startPos, startEnergy,
+                         startWeight);
         particle.absorb();
-        break;
+        return false;
+    }
 
-    case InteractionType::TRANSMISSION:
-        // Pas d'interaction - continue
-        break;
+    glm::vec3 direction = sampleCoulombScattering(particle, table, step);
+    particle.setEnergy(endEnergy);
+
+    if (!crossing)
+    {
+        recordTrackEvent(ctx, TrackEventType::SCATTERING, particle, currentMaterial.get(), startPos, startEnergy,
+                         startWeight);
+        particle.setDirection(direction);
+        return particle.isActive();
+    }
+
+    // Frontière : déviation refusée si elle ramène la particule du côté quitté
+    if (glm::dot(direction, hit.normal) * glm::dot(particle.getDirection(), hit.normal) > 0.0f)
+    {
+        particle.setDirection(direction);
     }
+    recordTrackEvent(ctx, TrackEventType::BOUNDARY, particle, currentMaterial.get(), startPos, startEnergy,
+                     startWeight);
+    crossBoundary(particle, hit, currentMaterial, ctx);
+
+    // Pertes sur le décalage de franchissement, dans le nouveau milieu
+    const auto &nextMaterial = particle.getCurrentMaterial();
+    if (const StoppingPowerTable *next = nextMaterial ? nextMaterial->getStoppingPowerTable(particle.getType()) : nullptr)
+    {
+        particle.setEnergy(next->energyAtRange(next->range(particle.getEnergy()) - BOUNDARY_NUDGE));
+        if (particle.getEnergy() <= 0.0f)
+        {
+            particle.absorb();
+            return false;
+        }
+    }
+
+    return particle.isActive();
 }
 
-bool MonteCarloEngine::russianRoulette(Particle &particle)
+void MonteCarloEngine::crossBoundary(Particle &particle, const IntersectionResult &hit,
+                                     const std::shared_ptr<Material> &currentMaterial, const TransportContext &ctx)
 {
-    float thr = std::max(1e-6f, m_config.russianRouletteThreshold);
-    float survivalProb = std::min(1.0f, particle.getWeight() / thr);
-    float r = RandomGenerator::random();
-    if (r < survivalProb)
+    const auto &worldMaterial = ctx.replica ? ctx.replica->getWorldMaterial() : m_worldMaterial;
+    if (currentMaterial && hit.material == currentMaterial)
     {
-        particle.setWeight(particle.getWeight() / survivalProb);
-        return false; // continue
+        particle.setCurrentMaterial(worldMaterial);
+        particle.setRegion(nullptr);
     }
     else
     {
-        particle.absorb();
-        return true; // stop
+        particle.setCurrentMaterial(hit.material ? hit.material : worldMaterial);
+        particle.setRegion(hit.material ? hit.object.get() : nullptr);
     }
+
+    particle.move(BOUNDARY_NUDGE);
 }
 
-std::vector<Particle> MonteCarloEngine::splitting(const Particle &particle)
+glm::vec3 MonteCarloEngine::sampleCoulombScattering(const Particle &particle, const StoppingPowerTable &table,
+                                                    float step)
 {
-    std::vector<Particle> split;
+    // Diffusion multiple : angles projetés gaussiens d'écart θ0 (Highland), soit un angle polaire
+    // de Rayleigh ; au-delà d'un radian, direction isotrope (particule diffusée)
+    float theta0 = table.highlandAngle(particle.getEnergy(), step);
+    if (theta0 <= 0.0f)
+        return particle.getDirection();
+    if (theta0 >= 1.0f)
+        return RandomGenerator::randomDirection();
+
+    float theta = theta0 * std::sqrt(-2.0f * std::log(std::max(1.0f - RandomGenerator::random(), 1e-12f)));
+    float phi = RandomGenerator::randomRange(0.0f, TWO_PI);
+
+    glm::vec3 w = particle.getDirection();
+    glm::vec3 u = std::abs(w.x) > 0.1f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    u = glm::normalize(glm::cross(u, w));
+    glm::vec3 v = glm::cross(w, u);
+
+    float sinTheta = std::sin(theta);
+    return glm::normalize(sinTheta * std::cos(phi) * u + sinTheta * std::sin(phi) * v + std::cos(theta) * w);
+}
 
-    float newWeight = particle.getWeight() / m_config.splittingFactor;
+void MonteCarloEngine::scoreStretchedSegment(const Particle &particle, const glm::vec3 &startPos,
+                                             const glm::vec3 &endPos, float stretch, TransportContext &ctx)
+{
+    // Le poids analogique d'un point à la distance t varie en exp(-Δ t) : sous-segment tronqué au
+    // hasard, d'espérance exacte pour les longueurs de trace comme pour les traversées
+    const float length = glm::length(endPos - startPos);
+    if (length <= 0.0f)
+        return;
+    const glm::vec3 direction = (endPos - startPos) / length;
+    const float cut = std::min(-std::log(std::max(1.0f - RandomGenerator::random(), 1e-12f)) / std::abs(stretch),
+                               length);
 
-    for (uint32_t i = 0; i < m_config.splittingFactor; ++i)
+    if (stretch > 0.0f)
     {
-        Particle newParticle = particle;
-        newParticle.setWeight(newWeight);
-        newParticle.setGeneration(particle.getGeneration() + 1);
-        split.push_back(newParticle);
+        // exp(-Δ t) : probabilité que le point t soit compté
+        scoreSegment(particle, startPos, startPos + direction * cut, ctx, length - cut);
+        return;
     }
 
-    return split;
+    // exp(|Δ| t) = exp(|Δ| L) exp(-|Δ| (L - t)) : fin de segment comptée avec le poids majoré
+    Particle scored = particle;
+    scored.setWeight(particle.getWeight() * std::exp(-stretch * length));
+    scoreSegment(scored, endPos - direction * cut, endPos, ctx);
 }
 
-void MonteCarloEngine::handleError(const std::string &message)
+void MonteCarloEngine::scoreSegment(const Particle &particle, const glm::vec3 &startPos, const glm::vec3 &endPos,
+                                    TransportContext &ctx, float remaining)
 {
-    Log::error("Erreur simulation: " + message);
-    std::lock_guard<std::mutex> lock(m_stateMutex);
-    m_state = SimulationState::ERROR;
-}
+    PROFILE_SCOPE(ProfileStage::SENSOR_SCORING);
 
-// SimplifiedSolver
-float SimplifiedSolver::calculateAttenuationFactor(const glm::vec3 &source,
-                                                   const glm::vec3 &detector,
-                                                   RadiationType type, float energy,
-                                                   std::shared_ptr<Scene> scene)
-{
-    Ray ray(source, glm::normalize(detector - source));
-    float totalAttenuation = 0.0f;
-    float distance = glm::length(detector - source);
+    const auto &sensors = ctx.replica ? ctx.replica->getSensors() : m_scene->getAllSensors();
+    const float stepLength = glm::length(endPos - startPos);
+    for (size_t index = 0; index < sensors.size(); ++index)
+    {
+        const auto &sensor = sensors[index];
+        if (!sensor)
+            continue;
 
-    // Échantillonnage le long du rayon
-    const int numSamples = 100;
-    float stepSize = distance / numSamples;
+        bool crossed = false;
+        float length = 0.0f;
+        if (sensor->getType() == SensorType::VOLUME)
+        {
+            // Estimateur longueur de trace : le découpage du segment sert aussi de test de traversée
+            length = sensor->clippedSegmentLength(startPos, endPos);
+            crossed = length > 0.0f;
+        }
+        else
+        {
+            crossed = sensor->intersectsSegment(startPos, endPos);
+        }
+        if (!crossed)
+            continue;
 
-    for (int i = 0; i < numSamples; ++i)
-    {
-        glm::vec3 pos = source + ray.direction * (i * stepSize);
-        Ray sampleRay(pos, ray.direction);
-        sampleRay.tMax = stepSize;
+        // Instant de passage au plus près du capteur (l'âge de la particule est celui de fin d'étape)
+        float along = stepLength > 0.0f ? glm::dot(sensor->getPosition() - startPos, endPos - startPos) / stepLength
+                                        : 0.0f;
+        along = std::clamp(along, 0.0f, stepLength);
+        float velocity = particle.getVelocity();
+        float crossingTime =
+            particle.getAge() - (velocity > 0.0f ? (stepLength - along + remaining) / velocity * 1e9f : 0.0f);
 
-        IntersectionResult hit = scene->intersectRay(sampleRay);
-        if (hit.hit && hit.material)
+        DetectionStats *stats = ctx.replica ? ctx.replica->sensorStats(index) : nullptr;
+        if (length > 0.0f)
         {
-            float mu = hit.material->getLinearAttenuation(type, energy);
-            totalAttenuation += mu * stepSize;
+            sensor->recordTrackLength(particle, length, ctx.threadId, crossingTime, stats);
+        }
+        if (sensor->recordParticle(particle, ctx.threadId, crossingTime, stats) && ctx.importance &&
+            isImportanceTarget(sensor.get()))
+        {
+            ctx.importance->recordScore(particle.getWeight());
+        }
+    }
+
+    for (const auto &tally : m_meshTallies)
+    {
+        tally->scoreSegment(ctx.threadId, startPos, endPos, particle);
+    }
+}
+
+InteractionChannel MonteCarloEngine::sampleInteraction(const Particle &particle,
+                                                       std::shared_ptr<Material> material)
+{
+    PROFILE_SCOPE(ProfileStage::CROSS_SECTION);
+    return material->sampleChannel(particle.getType(), particle.getEnergy());
+}
+
+InteractionType MonteCarloEngine::processInteraction(Particle &particle, InteractionChannel channel,
+                                                     std::shared_ptr<Material> material, TransportContext &ctx)
+{
+    PROFILE_SCOPE(ProfileStage::INTERACTION);
+    InteractionType outcome = Material::channelOutcome(channel);
+    if (outcome != InteractionType::TRANSMISSION && implicitCapture(particle.getType()))
+    {
+        // Capture implicite : une voie d'absorption tirée émet ses secondaires au poids entrant
+        // (espérance inchangée), puis la particule diffuse au poids réduit de la probabilité d'absorption
+        if (outcome != InteractionType::SCATTERING && m_config.produceSecondaries)
+            produceSecondaries(particle, channel, *material, ctx);
+        float survival = material->getScatteringProbability(particle.getType(), particle.getEnergy());
+        if (survival <= 0.0f)
+        {
+            particle.absorb();
+            return outcome;
+        }
+        particle.setWeight(particle.getWeight() * survival);
+        outcome = InteractionType::SCATTERING;
+    }
+
+    switch (outcome)
+    {
+    case InteractionType::ABSORPTION:
+        if (m_config.produceSecondaries)
+            produceSecondaries(particle, channel, *material, ctx);
+        particle.absorb();
+        break;
+
+    case InteractionType::SCATTERING:
+    {
+        glm::vec3 newDir = material->sampleScattering(particle.getDirection(),
+                                                      particle.getType(),
+                                                      particle.getEnergy());
+
+        float cosTheta = glm::dot(particle.getDirection(), newDir);
+        float energyLoss = particle.getEnergy() - sampleScatteredEnergy(particle, cosTheta);
+        particle.scatter(newDir, energyLoss);
+        break;
+    }
+
+    case InteractionType::CAPTURE:
+        if (m_config.produceSecondaries)
+            produceSecondaries(particle, channel, *material, ctx);
+        particle.absorb();
+        break;
+
+    case InteractionType::TRANSMISSION:
+        // Pas d'interaction - continue
+        break;
+    }
+    return outcome;
+}
+
+void MonteCarloEngine::produceSecondaries(const Particle &particle, InteractionChannel channel,
+                                          const Material &material, TransportContext &ctx)
+{
+    const bool photon = particle.getType() == RadiationType::GAMMA || particle.getType() == RadiationType::X_RAY;
+    switch (channel)
+    {
+    case InteractionChannel::PHOTOELECTRIC:
+        // Réarrangement du cortège : raie K isotrope (le photoélectron dépose sur place).
+        // Suivie comme GAMMA : les matériaux ne portent de tables photons que pour ce type.
+        if (photon)
+        {
+            float energy = material.sampleFluorescence(particle.getEnergy());
+            if (energy > 0.0f)
+                bankSecondary(particle, RadiationType::GAMMA, energy, RandomGenerator::randomDirection(), ctx);
+        }
+        break;
+
+    case InteractionChannel::PAIR:
+        // Positon annihilé au repos sur place : deux photons de 511 keV dos à dos
+        if (photon)
+        {
+            const float energy = static_cast<float>(Physics::ELECTRON_MASS_KEV);
+            glm::vec3 direction = RandomGenerator::randomDirection();
+            bankSecondary(particle, RadiationType::GAMMA, energy, direction, ctx);
+            bankSecondary(particle, RadiationType::GAMMA, energy, -direction, ctx);
+        }
+        break;
+
+    case InteractionChannel::CAPTURE:
+        if (particle.getType() == RadiationType::NEUTRON)
+        {
+            float energy = material.sampleCaptureGamma();
+            if (energy > 0.0f)
+                bankSecondary(particle, RadiationType::GAMMA, energy, RandomGenerator::randomDirection(), ctx);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void MonteCarloEngine::bankSecondary(const Particle &parent, RadiationType type, float energy,
+                                     const glm::vec3 &direction, TransportContext &ctx)
+{
+    if (energy < m_config.energyCutoff)
+        return;
+    if (ctx.historySecondaries >= m_config.maxSecondariesPerHistory)
+    {
+        m_stats.secondariesDropped.fetch_add(1);
+        return;
+    }
+    ++ctx.historySecondaries;
+    m_stats.secondariesProduced.fetch_add(1);
+
+    Particle secondary(type, energy, parent.getPosition(), direction);
+    secondary.setWeight(parent.getWeight());
+    secondary.setGeneration(parent.getGeneration() + 1);
+    secondary.incrementAge(parent.getAge());
+    secondary.setCurrentMaterial(parent.getCurrentMaterial());
+    secondary.setCullingDepth(parent.getCullingDepth());
+    secondary.setRegion(parent.getRegion());
+    ctx.secondaries.push_back(secondary);
+}
+
+float MonteCarloEngine::sampleScatteredEnergy(const Particle &particle, float cosTheta)
+{
+    // Photons : cinématique Compton, énergie fixée par l'angle
+    if (particle.getType() == RadiationType::GAMMA || particle.getType() == RadiationType::X_RAY)
+        return KleinNishina::scatteredEnergy(particle.getEnergy(), cosTheta);
+
+    // Autres rayonnements : perte d'énergie simplifiée, jusqu'à 10 %
+    return particle.getEnergy() * (1.0f - 0.1f * RandomGenerator::random());
+}
+
+template <typename AngularLaw>
+void MonteCarloEngine::scoreNextEvent(const Particle &particle, double weight, AngularLaw &&angularLaw,
+                                      const TransportContext &ctx)
+{
+    const glm::vec3 position = particle.getPosition();
+    const RadiationType type = particle.getType();
+    const float velocity = particle.getVelocity(); // Vitesse avant collision (approximation pour le temps)
+
+    // Fluence non collisionnée au point : w p(Ω) exp(-τ(E')) / r²
+    const auto &sensors = ctx.replica ? ctx.replica->getSensors() : m_scene->getAllSensors();
+    for (size_t index = 0; index < sensors.size(); ++index)
+    {
+        const auto &sensor = sensors[index];
+        if (!sensor || sensor->getType() != SensorType::POINT || !sensor->isEnabled())
+            continue;
+
+        glm::vec3 toSensor = sensor->getPosition() - position;
+        float distance = glm::length(toSensor);
+
+        // Élagage par distance
+        if (m_config.nextEventMaxDistance > 0.0f && distance > m_config.nextEventMaxDistance)
+            continue;
+
+        // Densité angulaire et énergie de sortie vers le capteur
+        glm::vec3 direction = distance > 0.0f ? toSensor / distance : glm::vec3(0.0f, 0.0f, 1.0f);
+        float energy = particle.getEnergy();
+        double pdf = angularLaw(direction, energy);
+        if (pdf <= 0.0 || energy < m_config.energyCutoff || !sensor->acceptsRadiation(type, energy))
+            continue;
+
+        // Dans la sphère d'exclusion : moyenne de 1/r² sur la sphère (3 / R0²)
+        float exclusionRadius = std::max(sensor->getRadius(), 1e-4f);
+        double geometric = distance > exclusionRadius ? 1.0 / (static_cast<double>(distance) * distance)
+                                                      : 3.0 / (static_cast<double>(exclusionRadius) * exclusionRadius);
+        double bound = weight * pdf * geometric;
+
+        // Élagage par importance : roulette non biaisée avant le calcul de la corde
+        double threshold = m_config.nextEventRouletteThreshold;
+        if (bound < threshold)
+        {
+            if (RandomGenerator::random() * threshold >= bound)
+                continue;
+            bound = threshold;
+        }
+
+        float tau = ctx.replica
+                        ? ctx.replica->computeOpticalDepth(position, sensor->getPosition(), type, energy)
+                        : m_scene->computeOpticalDepth(position, sensor->getPosition(), type, energy, m_worldMaterial);
+        (ctx.replica ? ctx.replica->rayIntersections : m_stats.rayIntersections).fetch_add(1);
+
+        double fluence = bound * std::exp(-static_cast<double>(tau));
+        if (fluence > 0.0)
+        {
+            float arrival = particle.getAge() + (velocity > 0.0f ? distance / velocity * 1e9f : 0.0f);
+            sensor->recordNextEvent(fluence, energy, arrival, ctx.threadId,
+                                    ctx.replica ? ctx.replica->sensorStats(index) : nullptr);
+        }
+    }
+}
+
+void MonteCarloEngine::scoreNextEventAtEmission(const Particle &particle, const TransportContext &ctx)
+{
+    PROFILE_SCOPE(ProfileStage::NEXT_EVENT);
+    const Source *source = ctx.emitter;
+    scoreNextEvent(particle, ctx.emissionWeight,
+                   [source](const glm::vec3 &direction, float &)
+                   { return static_cast<double>(source->directionPdf(direction)); },
+                   ctx);
+}
+
+void MonteCarloEngine::scoreNextEventAtCollision(const Particle &particle, const std::shared_ptr<Material> &material,
+                                                 const TransportContext &ctx)
+{
+    PROFILE_SCOPE(ProfileStage::NEXT_EVENT);
+
+    // Seule la diffusion produit une particule sortante
+    float scatterProbability = material->getScatteringProbability(particle.getType(), particle.getEnergy());
+    if (scatterProbability <= 0.0f)
+        return;
+
+    const glm::vec3 incident = particle.getDirection();
+    scoreNextEvent(particle, particle.getWeight() * scatterProbability,
+                   [&](const glm::vec3 &direction, float &energy)
+                   {
+                       float cosTheta = glm::dot(incident, direction);
+                       energy = sampleScatteredEnergy(particle, cosTheta);
+                       return static_cast<double>(
+                           material->getScatteringPdf(particle.getType(), particle.getEnergy(), cosTheta));
+                   },
+                   ctx);
+}
+
+bool MonteCarloEngine::russianRoulette(Particle &particle, float survivalWeight)
+{
+    PROFILE_SCOPE(ProfileStage::VARIANCE_REDUCTION);
+    float thr = std::max(1e-6f, survivalWeight);
+    float survivalProb = std::min(1.0f, particle.getWeight() / thr);
+    float r = RandomGenerator::random();
+    if (r < survivalProb)
+    {
+        particle.setWeight(particle.getWeight() / survivalProb);
+        return false; // continue
+    }
+    else
+    {
+        particle.absorb();
+        return true; // stop
+    }
+}
+
+void MonteCarloEngine::splitting(Particle &particle, uint32_t copies, TransportContext &ctx)
+{
+    particle.setWeight(particle.getWeight() / copies);
+    for (uint32_t i = 1; i < copies; ++i)
+    {
+        Particle copy = particle;
+        copy.setGeneration(particle.getGeneration() + 1);
+        ctx.bank.push_back(copy);
+    }
+}
+
+void MonteCarloEngine::prepareImplicitCapture()
+{
+    m_implicitCaptureMask = 0;
+    if (m_config.implicitCaptureTypes.empty())
+        return;
+
+    // Survivants au-dessus du seuil : sinon un survivant repasse aussitôt la roulette
+    if (!(m_config.implicitCaptureWeightCutoff > 0.0f) ||
+        !(m_config.implicitCaptureSurvivalWeight > m_config.implicitCaptureWeightCutoff))
+    {
+        throw std::runtime_error("Capture implicite : poids de survie à choisir supérieur au poids de coupure (> 0)");
+    }
+    for (RadiationType type : m_config.implicitCaptureTypes)
+    {
+        m_implicitCaptureMask |= 1u << static_cast<int>(type);
+    }
+}
+
+bool MonteCarloEngine::applyWeightWindow(Particle &particle, TransportContext &ctx)
+{
+    PROFILE_SCOPE(ProfileStage::VARIANCE_REDUCTION);
+    float lowerBound = m_weightWindows->getLowerBound(particle.getPosition(), particle.getEnergy());
+    if (lowerBound <= 0.0f)
+        return true; // Pas de fenêtre dans cette cellule
+
+    float weight = particle.getWeight();
+    float upperBound = lowerBound * m_weightWindows->getUpperRatio();
+
+    if (weight > upperBound)
+    {
+        // Splitting : copies de poids égal, dans la fenêtre autant que possible
+        uint32_t copies = std::min(m_weightWindows->getMaxSplit(),
+                                   static_cast<uint32_t>(std::ceil(weight / upperBound)));
+        splitting(particle, copies, ctx);
+        return true;
+    }
+
+    if (weight < lowerBound)
+    {
+        // Roulette vers le poids de survie
+        float survivalWeight = std::min(lowerBound * m_weightWindows->getSurvivalRatio(), upperBound);
+        if (RandomGenerator::random() * survivalWeight < weight)
+        {
+            particle.setWeight(survivalWeight);
+            return true;
+        }
+
+        particle.absorb();
+        return false;
+    }
+
+    return true;
+}
+
+void MonteCarloEngine::recordImportance(const Particle &particle, TransportContext &ctx)
+{
+    if (!ctx.importance || !m_weightWindows || !particle.isActive())
+        return;
+
+    int cell = m_weightWindows->cellIndex(particle.getPosition());
+    if (cell >= 0 && cell != ctx.lastCell)
+    {
+        ctx.importance->recordEntry(static_cast<uint32_t>(cell), particle.getWeight());
+    }
+    ctx.lastCell = cell;
+}
+
+void MonteCarloEngine::addMeshTally(std::shared_ptr<MeshTally> tally)
+{
+    if (tally && !isRunning())
+    {
+        m_meshTallies.push_back(tally);
+    }
+}
+
+void MonteCarloEngine::prepareTallies(uint32_t threadCount)
+{
+    threadCount = std::max(1u, threadCount);
+    for (const auto &sensor : m_scene->getAllSensors())
+    {
+        sensor->prepareSpectrum(threadCount);
+    }
+    for (const auto &tally : m_meshTallies)
+    {
+        tally->ensureThreadSlots(threadCount);
+    }
+}
+
+void MonteCarloEngine::endTallyBatch(uint32_t threadSlot, uint64_t histories)
+{
+    // Fusion des histogrammes du thread : un lot pour la variance par groupe
+    for (const auto &sensor : m_scene->getAllSensors())
+    {
+        sensor->endSpectrumBatch(threadSlot, histories);
+    }
+}
+
+void MonteCarloEngine::mergeMeshTallies()
+{
+    // Appelé uniquement quand aucun thread ne transporte
+    for (const auto &tally : m_meshTallies)
+    {
+        tally->mergeThreadBuffers();
+    }
+}
+
+void MonteCarloEngine::prepareChargedTransport()
+{
+    m_rangeBounds.clear();
+
+    // Matériaux rencontrés (monde compris) ; tables construites pour ceux jamais finalisés
+    std::vector<std::shared_ptr<Material>> materials{m_worldMaterial};
+    for (const auto &object : m_scene->getAllObjects())
+    {
+        if (object && object->getMaterial())
+            materials.push_back(object->getMaterial());
+    }
+    std::sort(materials.begin(), materials.end());
+    materials.erase(std::unique(materials.begin(), materials.end()), materials.end());
+    for (const auto &material : materials)
+    {
+        if (material && !material->getStoppingPowerTable(RadiationType::BETA))
+            material->buildStoppingPowerTables();
+    }
+
+    // Rejet exclu avec un espace des phases (toutes les traversées doivent y figurer) et pour un
+    // type dont un matériau n'a pas de table (parcours sans perte possible)
+    if (!m_config.chargedRangeRejection || m_phaseSpaceWriter)
+        return;
+    for (RadiationType type : {RadiationType::BETA, RadiationType::ALPHA, RadiationType::MUON})
+    {
+        std::vector<const StoppingPowerTable *> tables;
+        for (const auto &material : materials)
+        {
+            const StoppingPowerTable *table = material ? material->getStoppingPowerTable(type) : nullptr;
+            if (!table)
+            {
+                tables.clear();
+                break;
+            }
+            tables.push_back(table);
+        }
+        if (!tables.empty())
+            m_rangeBounds[type] = StoppingPowerTable::lowerEnvelope(tables);
+    }
+}
+
+float MonteCarloEngine::distanceToTargets(const glm::vec3 &position, const TransportContext &ctx) const
+{
+    // Minorant de la distance à toute zone de comptage (capteurs, même désactivés, et tallies)
+    float distance = std::numeric_limits<float>::infinity();
+    const auto &sensors = ctx.replica ? ctx.replica->getSensors() : m_scene->getAllSensors();
+    for (const auto &sensor : sensors)
+    {
+        if (sensor)
+            distance = std::min(distance, sensor->distanceFrom(position));
+    }
+    for (const auto &tally : m_meshTallies)
+    {
+        distance = std::min(distance, tally->getGrid().getBounds().distanceTo(position));
+    }
+    return distance;
+}
+
+void MonteCarloEngine::prepareCulling()
+{
+    m_photonCullingEnergy = 0.0f;
+    m_opticalCulling = false;
+    m_cullingMaterials.clear();
+    m_cullingObjects.clear();
+
+    // Sans cible, rien à protéger ni à gagner ; l'espace des phases doit voir toutes les traversées
+    const auto &sensors = m_scene->getAllSensors();
+    if (!m_config.useCulling || m_phaseSpaceWriter || (sensors.empty() && m_meshTallies.empty()))
+        return;
+
+    // Seuil photons : plus petit seuil bas des cibles acceptant les photons (la fluorescence est
+    // suivie comme GAMMA) ; les tallies maillés comptent toute énergie
+    auto acceptsPhotons = [](const std::vector<RadiationType> &filter)
+    {
+        return filter.empty() ||
+               std::find(filter.begin(), filter.end(), RadiationType::GAMMA) != filter.end() ||
+               std::find(filter.begin(), filter.end(), RadiationType::X_RAY) != filter.end();
+    };
+    m_photonCullingEnergy = std::numeric_limits<float>::infinity();
+    for (const auto &sensor : sensors)
+    {
+        if (sensor && acceptsPhotons(sensor->getRadiationFilter()))
+            m_photonCullingEnergy = std::min(m_photonCullingEnergy, sensor->getMinEnergy());
+    }
+    for (const auto &tally : m_meshTallies)
+    {
+        if (acceptsPhotons(tally->getRadiationFilter()))
+            m_photonCullingEnergy = 0.0f;
+    }
+
+    // Roulette optique : les fenêtres de poids remonteraient aussitôt la population éliminée
+    if (m_config.useWeightWindows && m_weightWindows)
+        return;
+    m_opticalCulling = true;
+    if (m_worldMaterial)
+        m_cullingMaterials.push_back(m_worldMaterial.get());
+    for (const auto &object : m_scene->getAllObjects())
+    {
+        if (!object)
+            continue;
+        object->getBounds(); // Boîte en cache avant le partage entre threads
+        m_cullingObjects.push_back(object.get());
+        if (object->getMaterial())
+            m_cullingMaterials.push_back(object->getMaterial().get());
+    }
+    std::sort(m_cullingMaterials.begin(), m_cullingMaterials.end());
+    m_cullingMaterials.erase(std::unique(m_cullingMaterials.begin(), m_cullingMaterials.end()),
+                             m_cullingMaterials.end());
+}
+
+bool MonteCarloEngine::cullParticle(Particle &particle, TransportContext &ctx)
+{
+    const RadiationType type = particle.getType();
+    const bool photon = type == RadiationType::GAMMA || type == RadiationType::X_RAY;
+    if (!photon && type != RadiationType::NEUTRON)
+        return false;
+
+    // Photon sous tous les seuils : ni lui ni sa descendance (moins énergétique) ne comptent
+    if (photon && particle.getEnergy() < m_photonCullingEnergy)
+    {
+        recordTrackEvent(ctx, TrackEventType::ENERGY_CUTOFF, particle, particle.getCurrentMaterial().get(),
+                         particle.getPosition(), particle.getEnergy(), particle.getWeight());
+        particle.absorb();
+        m_stats.particlesCulled.fetch_add(1);
+        return true;
+    }
+    if (!m_opticalCulling)
+        return false;
+
+    PROFILE_SCOPE(ProfileStage::VARIANCE_REDUCTION);
+
+    // Test grossier d'abord : la profondeur minorée ne dépasse pas μ_min(milieu courant) × distance
+    const float threshold = std::max(m_config.cullingOpticalDepth, particle.getCullingDepth());
+    const float targetDistance = distanceToTargets(particle.getPosition(), ctx);
+    const Material *material = particle.getCurrentMaterial().get();
+    const float muCurrent = material ? material->getMinimumAttenuationPerMeter(type, particle.getEnergy()) : 0.0f;
+    if (muCurrent * targetDistance <= threshold)
+        return false;
+
+    const float depth = minimumOpticalDepth(particle, targetDistance, ctx);
+    if (depth <= threshold)
+        return false;
+
+    // Roulette sur l'excédent de profondeur : exp(-τ) est la transmission sans collision la plus
+    // forte possible jusqu'aux cibles ; seul l'excédent depuis la dernière roulette est joué
+    const float weight = particle.getWeight();
+    const float survival = std::exp(threshold - depth);
+    particle.setCullingDepth(depth);
+    if (RandomGenerator::random() < survival)
+    {
+        particle.setWeight(weight / survival);
+        return false;
+    }
+
+    recordTrackEvent(ctx, TrackEventType::ROULETTE, particle, material, particle.getPosition(),
+                     particle.getEnergy(), weight);
+    particle.absorb();
+    m_stats.particlesCulled.fetch_add(1);
+    return true;
+}
+
+float MonteCarloEngine::minimumOpticalDepth(const Particle &particle, float targetDistance,
+                                            const TransportContext &ctx) const
+{
+    const RadiationType type = particle.getType();
+    const float energy = particle.getEnergy();
+    const glm::vec3 position = particle.getPosition();
+
+    // μ minimal du milieu courant et de tous les matériaux de la scène, à énergie au plus égale
+    const Material *material = particle.getCurrentMaterial().get();
+    const float muCurrent = material ? material->getMinimumAttenuationPerMeter(type, energy) : 0.0f;
+    float muEnvelope = muCurrent;
+    const auto &materials = ctx.replica ? ctx.replica->getCullingMaterials() : m_cullingMaterials;
+    for (const Material *sceneMaterial : materials)
+    {
+        muEnvelope = std::min(muEnvelope, sceneMaterial->getMinimumAttenuationPerMeter(type, energy));
+    }
+
+    // Boule sans surface autour du point : tout chemin vers une cible la traverse dans le milieu courant
+    float freeRadius = targetDistance;
+    const auto &objects = ctx.replica ? ctx.replica->getCullingObjects() : m_cullingObjects;
+    for (const Object3D *object : objects)
+    {
+        freeRadius = std::min(freeRadius, object->surfaceDistanceBound(position));
+        if (freeRadius <= 0.0f)
+            break;
+    }
+    return muCurrent * freeRadius + muEnvelope * (targetDistance - freeRadius);
+}
+
+void MonteCarloEngine::prepareNumaPlacement()
+{
+    m_replicas.clear();
+    if (!m_config.pinThreads && !m_config.numaReplicas)
+        return;
+
+    const NumaTopology &topology = NumaTopology::getInstance();
+    const auto placements = topology.distributeThreads(m_config.numThreads);
+    for (uint32_t i = 0; i < m_config.numThreads; ++i)
+    {
+        if (m_config.pinThreads)
+            m_threadContexts[i].pinnedCpu = static_cast<int>(placements[i].cpu);
+    }
+
+    // Un seul nœud : la scène partagée est déjà locale
+    if (!m_config.numaReplicas || topology.getNodeCount() < 2)
+        return;
+
+    // Chaque réplique est construite par un thread épinglé sur son nœud (première écriture)
+    m_replicas.resize(topology.getNodeCount());
+    std::vector<std::thread> builders;
+    for (uint32_t node = 0; node < topology.getNodeCount(); ++node)
+    {
+        bool used = std::any_of(placements.begin(), placements.end(),
+                                [node](const NumaTopology::Placement &p) { return p.node == node; });
+        if (!used)
+            continue;
+        builders.emplace_back([this, node, &topology]
+                              {
+                                  NumaTopology::pinCurrentThread(topology.getNodeCpus(node));
+                                  m_replicas[node] = std::make_unique<NodeReplica>(node, *m_scene, m_worldMaterial);
+                              });
+    }
+    for (auto &builder : builders)
+        builder.join();
+
+    for (uint32_t i = 0; i < m_config.numThreads; ++i)
+    {
+        m_threadContexts[i].replica = m_replicas[placements[i].node].get();
+    }
+    Log::info("Répliques de scène sur " + std::to_string(builders.size()) + " nœuds NUMA");
+}
+
+void MonteCarloEngine::mergeReplicaStats()
+{
+    for (const auto &replica : m_replicas)
+    {
+        if (replica)
+            mergeReplicaStats(*replica);
+    }
+}
+
+void MonteCarloEngine::mergeReplicaStats(NodeReplica &replica)
+{
+    // Transfert par échange : sûr pendant que les autres threads du nœud comptent ; les
+    // lectures en cours de run (getStats, capteurs) voient les lots terminés
+    m_stats.rayIntersections.fetch_add(replica.rayIntersections.exchange(0));
+    m_stats.totalCollisions.fetch_add(replica.totalCollisions.exchange(0));
+    replica.mergeSensorStats();
+}
+
+void MonteCarloEngine::attachTrackChannel(TransportContext &ctx)
+{
+    ctx.tracks = m_trackRecorder ? m_trackRecorder->getChannel(ctx.threadId) : nullptr;
+    ctx.recordTrack = false;
+}
+
+bool MonteCarloEngine::isImportanceTarget(const Sensor *sensor) const
+{
+    return m_importanceTargets.empty() ||
+           std::find(m_importanceTargets.begin(), m_importanceTargets.end(), sensor) != m_importanceTargets.end();
+}
+
+std::shared_ptr<WeightWindowMesh> MonteCarloEngine::generateWeightWindows(const WeightWindowGenerationConfig &config)
+{
+    if (!m_scene || m_scene->getAllSources().empty() || isRunning())
+        return m_weightWindows;
+
+    // Domaine du maillage : géométrie, sources et capteurs
+    AABB bounds = m_scene->getSceneBounds();
+    for (const auto &source : m_scene->getAllSources())
+    {
+        bounds.expand(source->getPosition());
+    }
+    m_importanceTargets.clear();
+    for (const auto &sensor : m_scene->getAllSensors())
+    {
+        bounds.expand(sensor->getPosition());
+
+        bool selected = config.targetSensors.empty() ||
+                        std::find(config.targetSensors.begin(), config.targetSensors.end(), sensor->getName()) !=
+                            config.targetSensors.end();
+        if (selected)
+        {
+            m_importanceTargets.push_back(sensor.get());
+        }
+    }
+    if (!bounds.isValid() || m_importanceTargets.empty())
+        return m_weightWindows;
+
+    bounds.min -= glm::vec3(config.boundsPadding);
+    bounds.max += glm::vec3(config.boundsPadding);
+
+    const uint32_t numThreads = std::max(1u, m_config.numThreads);
+    const uint32_t cellCount = config.nx * config.ny * config.nz;
+
+    // Première itération analogique : le maillage ne sert qu'au repérage des cellules
+    m_weightWindows = std::make_shared<WeightWindowMesh>(bounds, config.nx, config.ny, config.nz);
+    m_config.useWeightWindows = false;
+    m_shouldStop = false;
+    prepareChargedTransport();
+    prepareCulling();
+    prepareImplicitCapture();
+    prepareTallies(numThreads);
+
+    for (uint32_t iteration = 0; iteration < config.maxIterations; ++iteration)
+    {
+        std::vector<ImportanceTally> tallies(numThreads);
+        std::vector<std::thread> threads;
+        const auto &sources = m_scene->getAllSources();
+
+        for (uint32_t t = 0; t < numThreads; ++t)
+        {
+            tallies[t].resize(cellCount);
+            uint64_t histories = config.historiesPerIteration / numThreads +
+                                 (t < config.historiesPerIteration % numThreads ? 1 : 0);
+
+            threads.emplace_back([this, &tallies, &sources, histories, t]()
+                                 {
+                MonotonicArena arena;
+                TransportContext ctx;
+                ctx.attachArena(&arena);
+                ctx.threadId = t;
+                ctx.importance = &tallies[t];
+                for (uint64_t h = 0; h < histories; ++h)
+                {
+                    Particle particle;
+                    if (sampleSourceParticle(sources, particle, ctx))
+                    {
+                        transportParticleInternal(particle, ctx);
+                    }
+                } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        ImportanceTally total = tallies.front();
+        for (size_t t = 1; t < tallies.size(); ++t)
+        {
+            total.merge(tallies[t]);
+        }
+
+        auto mesh = WeightWindowBuilder::fromImportance(bounds, config.nx, config.ny, config.nz, total);
+        float change = WeightWindowBuilder::relativeChange(*m_weightWindows, *mesh);
+        m_weightWindows = mesh;
+
+        Log::info("Fenêtres de poids - itération " + std::to_string(iteration + 1) +
+                  " : variation médiane " + std::to_string(change));
+
+        // Les itérations suivantes tirent parti des fenêtres déjà estimées
+        m_config.useWeightWindows = true;
+        if (iteration > 0 && change < config.convergenceTolerance)
+            break;
+    }
+
+    // Le pré-calcul ne doit pas polluer les résultats du calcul principal
+    for (const auto &sensor : m_scene->getAllSensors())
+    {
+        sensor->clearStats();
+    }
+    for (const auto &source : m_scene->getAllSources())
+    {
+        source->resetStats();
+    }
+    for (const auto &tally : m_meshTallies)
+    {
+        tally->clear();
+    }
+    m_stats.clear();
+    m_importanceTargets.clear();
+
+    m_config.useWeightWindows = true;
+    return m_weightWindows;
+}
+
+std::shared_ptr<const AdjointImportanceMap> MonteCarloEngine::setupCadis(const CadisConfig &config)
+{
+    if (!m_scene || isRunning())
+        return nullptr;
+
+    std::vector<std::shared_ptr<Source>> sources;
+    for (const auto &source : m_scene->getAllSources())
+    {
+        if (source->isEnabled())
+            sources.push_back(source);
+    }
+
+    std::vector<std::shared_ptr<Sensor>> targets;
+    for (const auto &sensor : m_scene->getAllSensors())
+    {
+        bool selected = config.targetSensors.empty() ||
+                        std::find(config.targetSensors.begin(), config.targetSensors.end(), sensor->getName()) !=
+                            config.targetSensors.end();
+        if (selected)
+            targets.push_back(sensor);
+    }
+
+    if (sources.empty() || targets.empty())
+    {
+        Log::warning("CADIS : aucune source active ou aucun capteur cible");
+        return nullptr;
+    }
+
+    // Domaine de la grille : géométrie, sources (volumes ambiants inclus) et capteurs
+    AABB bounds = m_scene->getSceneBounds();
+    float maxEnergy = 0.0f;
+    for (const auto &source : sources)
+    {
+        bounds.expand(source->getPosition());
+        if (auto ambient = std::dynamic_pointer_cast<AmbientSource>(source))
+        {
+            bounds.expand(ambient->getMinBounds());
+            bounds.expand(ambient->getMaxBounds());
+        }
+
+        const EnergySpectrum &spectrum = source->getSpectrum();
+        maxEnergy = std::max(maxEnergy, spectrum.energy);
+        for (const auto &[energy, intensity] : spectrum.spectrum)
+        {
+            maxEnergy = std::max(maxEnergy, energy);
+        }
+    }
+    for (const auto &sensor : targets)
+    {
+        bounds.expand(sensor->getPosition());
+    }
+    bounds.min -= glm::vec3(config.boundsPadding);
+    bounds.max += glm::vec3(config.boundsPadding);
+
+    // Groupes d'énergie log-espacés entre le seuil de coupure et l'énergie maximale
+    const uint32_t groupCount = std::max(1u, config.energyGroups);
+    float minEnergy = std::max(1.0f, m_config.energyCutoff);
+    maxEnergy = std::max(maxEnergy * 1.01f, minEnergy * 2.0f);
+
+    std::vector<float> groupBounds(groupCount + 1);
+    for (uint32_t g = 0; g <= groupCount; ++g)
+    {
+        groupBounds[g] = minEnergy * std::pow(maxEnergy / minEnergy, static_cast<float>(g) / groupCount);
+    }
+
+    // Une seule carte : type de rayonnement de la première source active
+    RadiationType type = sources.front()->getRadiationType();
+    for (const auto &source : sources)
+    {
+        if (source->getRadiationType() != type)
+        {
+            Log::warning("CADIS : sources de types différents, importance calculée pour le premier type");
+            break;
+        }
+    }
+
+    RegularGrid grid(bounds, config.nx, config.ny, config.nz);
+    auto importance = SimplifiedSolver::computeAdjointImportance(m_scene, grid, groupBounds, type, targets,
+                                                                 m_worldMaterial);
+
+    auto biasing = std::make_shared<CadisSourceBiasing>(importance, sources, targets, config);
+    if (!biasing->isValid())
+    {
+        Log::warning("CADIS : importance nulle au niveau des sources, simulation analogique conservée");
+        return importance;
+    }
+
+    m_sourceBiasing = biasing;
+    m_weightWindows = importance->buildWeightWindows(biasing->getResponseEstimate());
+    m_config.useWeightWindows = true;
+
+    Log::info("CADIS activé : " + std::to_string(grid.getCellCount()) + " cellules, " +
+              std::to_string(groupCount) + " groupes, réponse estimée " +
+              std::to_string(biasing->getResponseEstimate()));
+    return importance;
+}
+
+void MonteCarloEngine::handleError(const std::string &message)
+{
+    Log::error("Erreur simulation: " + message);
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_state = SimulationState::ERROR;
+}
+
+// SimplifiedSolver
+float SimplifiedSolver::calculateAttenuationFactor(const glm::vec3 &source,
+                                                   const glm::vec3 &detector,
+                                                   RadiationType type, float energy,
+                                                   std::shared_ptr<Scene> scene)
+{
+    if (!scene)
+        return 1.0f;
+
+    // Épaisseur optique exacte le long de la corde (traversée des surfaces)
+    auto air = MaterialLibrary::getInstance().getMaterial("Air");
+    return std::exp(-scene->computeOpticalDepth(source, detector, type, energy, air));
+}
+
+std::shared_ptr<AdjointImportanceMap> SimplifiedSolver::computeAdjointImportance(
+    std::shared_ptr<Scene> scene, const RegularGrid &grid, const std::vector<float> &groupBounds,
+    RadiationType type, const std::vector<std::shared_ptr<Sensor>> &targets,
+    std::shared_ptr<Material> worldMaterial)
+{
+    auto importance = std::make_shared<AdjointImportanceMap>(grid, groupBounds);
+    if (!scene)
+        return importance;
+
+    const glm::vec3 cellSize = grid.getCellSize();
+    const float halfDiagonal = 0.5f * glm::length(cellSize);
+
+    for (uint32_t cell = 0; cell < grid.getCellCount(); ++cell)
+    {
+        glm::vec3 center = grid.cellCenter(cell);
+
+        for (const auto &sensor : targets)
+        {
+            // Distance minimale : taille du capteur ou demi-diagonale de cellule (pas de singularité)
+            float sensorExtent = sensor->getType() == SensorType::POINT ? sensor->getRadius()
+                                                                        : 0.5f * glm::length(sensor->getSize());
+            float distance = std::max({glm::length(sensor->getPosition() - center), sensorExtent, halfDiagonal});
+            double geometric = 1.0 / (4.0 * PI * distance * distance);
+
+            for (uint32_t group = 0; group < importance->getGroupCount(); ++group)
+            {
+                float tau = scene->computeOpticalDepth(center, sensor->getPosition(), type,
+                                                       importance->groupEnergy(group), worldMaterial);
+                double value = importance->getValue(cell, group) + geometric * std::exp(-tau);
+                importance->setValue(cell, group, value);
+            }
         }
     }
 
-    return std::exp(-totalAttenuation);
+    return importance;
 }
 
 float SimplifiedSolver::analyticalAttenuation(float thickness, float mu)
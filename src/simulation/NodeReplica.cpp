@@ -0,0 +1,62 @@
+#include "simulation/NodeReplica.h"
+#include "utils/Profiler.h"
+
+NodeReplica::NodeReplica(uint32_t node, const Scene& scene, const std::shared_ptr<Material>& worldMaterial)
+    : m_node(node), m_sensors(scene.getAllSensors()), m_sensorStats(m_sensors.size()) {
+    auto replicate = [this](const std::shared_ptr<Material>& material) -> std::shared_ptr<Material> {
+        if (!material) return nullptr;
+        for (const auto& [original, copy] : m_materials) {
+            if (original == material.get()) return copy;
+        }
+        m_materials.emplace_back(material.get(), std::make_shared<Material>(*material));
+        return m_materials.back().second;
+    };
+
+    m_worldMaterial = replicate(worldMaterial);
+    m_objects.reserve(scene.getObjectCount());
+    for (const auto& object : scene.getAllObjects()) {
+        auto copy = object->clone();
+        copy->setMaterial(replicate(object->getMaterial()));
+        copy->getBounds(); // Boîte calculée ici plutôt qu'au premier rayon
+        m_objects.push_back(std::move(copy));
+    }
+    m_bvh.build(m_objects);
+
+    for (const auto& object : m_objects) {
+        m_cullingObjects.push_back(object.get());
+    }
+    for (const auto& [original, copy] : m_materials) {
+        m_cullingMaterials.push_back(copy.get());
+    }
+    std::sort(m_cullingMaterials.begin(), m_cullingMaterials.end());
+}
+
+IntersectionResult NodeReplica::intersectRay(const Ray& ray) const {
+    PROFILE_COUNT(ProfileCounter::RAYS, 1);
+    if (m_bvh.isValid()) {
+        return m_bvh.intersect(ray);
+    }
+
+    IntersectionResult closestHit;
+    closestHit.distance = std::numeric_limits<float>::max();
+    return closestHit;
+}
+
+float NodeReplica::computeOpticalDepth(const glm::vec3& from, const glm::vec3& to, RadiationType type,
+                                       float energy) const {
+    return Scene::opticalDepthAlong(from, to, type, energy, m_worldMaterial.get(),
+                                    [this](const Ray& ray) { return intersectRay(ray); });
+}
+
+void NodeReplica::mergeSensorStats() {
+    for (size_t i = 0; i < m_sensors.size(); ++i) {
+        if (m_sensors[i]) m_sensors[i]->transferStats(m_sensorStats[i]);
+    }
+}
+
+const std::shared_ptr<Material>& NodeReplica::localMaterial(const std::shared_ptr<Material>& material) const {
+    for (const auto& [original, copy] : m_materials) {
+        if (original == material.get()) return copy;
+    }
+    return material;
+}
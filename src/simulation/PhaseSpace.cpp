@@ -0,0 +1,84 @@
+#include "simulation/PhaseSpace.h"
+#include "simulation/Particle.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace PhaseSpaceFormat;
+
+// PhaseSpaceWriter
+PhaseSpaceWriter::PhaseSpaceWriter(const std::string& filename, const PhaseSpaceSurface& surface, bool terminate)
+    : m_filename(filename), m_surface(surface), m_terminate(terminate) {
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour écriture: " + filename);
+    }
+    writeHeader();
+}
+
+PhaseSpaceWriter::~PhaseSpaceWriter() {
+    flush(m_histories);
+    std::fclose(m_file);
+}
+
+void PhaseSpaceWriter::prepare(uint32_t threadCount) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_buffers.size() < threadCount) m_buffers.resize(threadCount);
+    for (auto& buffer : m_buffers) buffer.reserve(BUFFER_RECORDS);
+}
+
+void PhaseSpaceWriter::record(uint32_t threadId, const Particle& particle, const glm::vec3& position) {
+    const glm::vec3& direction = particle.getDirection();
+
+    Record record{};
+    record.type = static_cast<uint8_t>(particle.getType());
+    record.flags = direction.z < 0.0f ? FLAG_NEGATIVE_W : 0;
+    record.energy = particle.getEnergy();
+    record.position[0] = position.x;
+    record.position[1] = position.y;
+    record.position[2] = position.z;
+    record.u = direction.x;
+    record.v = direction.y;
+    record.weight = particle.getWeight();
+
+    auto& buffer = m_buffers[threadId];
+    buffer.push_back(record);
+    if (buffer.size() >= BUFFER_RECORDS) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        writeRecords(buffer);
+    }
+}
+
+void PhaseSpaceWriter::flush(uint64_t histories) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& buffer : m_buffers) writeRecords(buffer);
+    m_histories = histories;
+    writeHeader();
+    std::fflush(m_file);
+}
+
+void PhaseSpaceWriter::writeRecords(std::vector<Record>& buffer) {
+    if (buffer.empty()) return;
+    std::fseek(m_file, 0, SEEK_END);
+    std::fwrite(buffer.data(), sizeof(Record), buffer.size(), m_file);
+    m_recordCount += buffer.size();
+    buffer.clear();
+}
+
+void PhaseSpaceWriter::writeHeader() {
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.endianTag = ENDIAN_TAG;
+    header.recordCount = m_recordCount;
+    header.histories = m_histories;
+    header.surfaceKind = static_cast<uint32_t>(m_surface.kind);
+    header.recordSize = sizeof(Record);
+    glm::vec3 a = m_surface.kind == PhaseSpaceSurface::Kind::BOX ? m_surface.box.min : m_surface.point;
+    glm::vec3 b = m_surface.kind == PhaseSpaceSurface::Kind::BOX ? m_surface.box.max : m_surface.normal;
+    float surface[6] = {a.x, a.y, a.z, b.x, b.y, b.z};
+    std::memcpy(header.surface, surface, sizeof(surface));
+
+    std::fseek(m_file, 0, SEEK_SET);
+    std::fwrite(&header, sizeof(header), 1, m_file);
+    std::fseek(m_file, 0, SEEK_END);
+}
@@ -0,0 +1,146 @@
+#include "simulation/ResultsWriter.h"
+#include "core/Sensor.h"
+
+ResultsWriter::ResultsWriter(const std::string& filename, bool append, bool compress)
+    : m_writer(filename, append, compress ? ColumnCodec::SHUFFLE_ZLIB : ColumnCodec::NONE) {
+}
+
+void ResultsWriter::writeStats(uint64_t batch, const SimulationStats& stats) {
+    ColumnTable table;
+    table.name = "stats";
+    table.batch = batch;
+    table.columns.push_back(Column::uint64("emitted", {stats.particlesEmitted.load()}));
+    table.columns.push_back(Column::uint64("transported", {stats.particlesTransported.load()}));
+    table.columns.push_back(Column::uint64("absorbed", {stats.particlesAbsorbed.load()}));
+    table.columns.push_back(Column::uint64("detected", {stats.particlesDetected.load()}));
+    table.columns.push_back(Column::uint64("escaped", {stats.particlesEscaped.load()}));
+    table.columns.push_back(Column::uint64("collisions", {stats.totalCollisions.load()}));
+    table.columns.push_back(Column::uint64("ray_intersections", {stats.rayIntersections.load()}));
+    table.columns.push_back(Column::uint64("secondaries", {stats.secondariesProduced.load()}));
+    table.columns.push_back(Column::uint64("secondaries_dropped", {stats.secondariesDropped.load()}));
+    table.columns.push_back(Column::uint64("culled", {stats.particlesCulled.load()}));
+    table.columns.push_back(Column::float64("elapsed_s", {stats.getElapsedTime()}));
+    m_writer.write(table);
+}
+
+void ResultsWriter::writeSensors(uint64_t batch, const std::vector<std::shared_ptr<Sensor>>& sensors) {
+    std::vector<std::string> names;
+    std::vector<uint32_t> types;
+    std::vector<uint64_t> counts, gamma, neutron, muon, nextEventScores;
+    std::vector<double> weighted, energy, dose, nextEventFluence, nextEventEnergyFluence, trackFluence, trackDose;
+
+    for (const auto& sensor : sensors) {
+        const auto& stats = sensor->getStats();
+        names.push_back(sensor->getName());
+        types.push_back(static_cast<uint32_t>(sensor->getType()));
+        counts.push_back(stats.totalCounts.load());
+        gamma.push_back(stats.gammaCounts.load());
+        neutron.push_back(stats.neutronCounts.load());
+        muon.push_back(stats.muonCounts.load());
+        weighted.push_back(stats.weightedCounts.load());
+        energy.push_back(stats.totalEnergy.load());
+        dose.push_back(stats.totalDose.load());
+        nextEventScores.push_back(stats.nextEventScores.load());
+        nextEventFluence.push_back(stats.nextEventFluence.load());
+        nextEventEnergyFluence.push_back(stats.nextEventEnergyFluence.load());
+        trackFluence.push_back(stats.trackLengthFluence.load());
+        trackDose.push_back(stats.trackLengthDose.load());
+    }
+
+    ColumnTable table;
+    table.name = "sensors";
+    table.batch = batch;
+    table.columns.push_back(Column::strings("name", names));
+    table.columns.push_back(Column::uint32("type", types));
+    table.columns.push_back(Column::uint64("total_counts", counts));
+    table.columns.push_back(Column::uint64("gamma_counts", gamma));
+    table.columns.push_back(Column::uint64("neutron_counts", neutron));
+    table.columns.push_back(Column::uint64("muon_counts", muon));
+    table.columns.push_back(Column::float64("weighted_counts", weighted));
+    table.columns.push_back(Column::float64("total_energy_kev", energy));
+    table.columns.push_back(Column::float64("total_dose", dose));
+    table.columns.push_back(Column::uint64("next_event_scores", nextEventScores));
+    table.columns.push_back(Column::float64("next_event_fluence", nextEventFluence));
+    table.columns.push_back(Column::float64("next_event_energy_fluence", nextEventEnergyFluence));
+    table.columns.push_back(Column::float64("track_length_fluence", trackFluence));
+    table.columns.push_back(Column::float64("track_length_dose_psv", trackDose));
+    m_writer.write(table);
+}
+
+void ResultsWriter::writeSpectrum(uint64_t batch, const Sensor& sensor) {
+    const BinnedTally& spectrum = sensor.getSpectrum();
+    const Binning& energyBins = spectrum.getEnergyBins();
+    const Binning& timeBins = spectrum.getTimeBins();
+
+    std::vector<float> energyLow, energyHigh, timeLow, timeHigh;
+    std::vector<double> mean, relativeError;
+    for (uint32_t e = 0; e < energyBins.getCount(); ++e) {
+        for (uint32_t t = 0; t < timeBins.getCount(); ++t) {
+            energyLow.push_back(energyBins.lowerEdge(e));
+            energyHigh.push_back(energyBins.upperEdge(e));
+            timeLow.push_back(timeBins.lowerEdge(t));
+            timeHigh.push_back(timeBins.upperEdge(t));
+            mean.push_back(spectrum.getMean(e, t));
+            relativeError.push_back(spectrum.getRelativeError(e, t));
+        }
+    }
+
+    ColumnTable table;
+    table.name = "spectrum/" + sensor.getName();
+    table.batch = batch;
+    table.columns.push_back(Column::float32("energy_low_kev", energyLow));
+    table.columns.push_back(Column::float32("energy_high_kev", energyHigh));
+    table.columns.push_back(Column::float32("time_low_ns", timeLow));
+    table.columns.push_back(Column::float32("time_high_ns", timeHigh));
+    table.columns.push_back(Column::float64("mean", mean));
+    table.columns.push_back(Column::float64("relative_error", relativeError));
+    table.columns.push_back(Column::uint64("histories", std::vector<uint64_t>(mean.size(), spectrum.getHistories())));
+    m_writer.write(table);
+}
+
+void ResultsWriter::writeMeshTally(uint64_t batch, const MeshTally& tally, uint64_t histories) {
+    const RegularGrid& grid = tally.getGrid();
+    uint32_t cells = grid.getCellCount();
+    double norm = histories > 0 ? 1.0 / static_cast<double>(histories) : 0.0;
+
+    std::vector<float> x(cells), y(cells), z(cells);
+    std::vector<double> dose(cells);
+    for (uint32_t cell = 0; cell < cells; ++cell) {
+        glm::vec3 center = grid.cellCenter(cell);
+        x[cell] = center.x;
+        y[cell] = center.y;
+        z[cell] = center.z;
+        dose[cell] = tally.getDose(cell) * norm;
+    }
+
+    ColumnTable table;
+    table.name = "mesh/" + tally.getName();
+    table.batch = batch;
+    table.columns.push_back(Column::float32("x", x));
+    table.columns.push_back(Column::float32("y", y));
+    table.columns.push_back(Column::float32("z", z));
+
+    // Une colonne de fluence par groupe d'énergie (m⁻² par histoire)
+    std::vector<double> fluence(cells);
+    for (uint32_t bin = 0; bin < tally.getBinCount(); ++bin) {
+        for (uint32_t cell = 0; cell < cells; ++cell) {
+            fluence[cell] = tally.getFluence(cell, bin) * norm;
+        }
+        table.columns.push_back(Column::float64("fluence_g" + std::to_string(bin), fluence));
+    }
+    table.columns.push_back(Column::float64("dose_psv", dose));
+    m_writer.write(table);
+}
+
+void ResultsWriter::writeBatch(uint64_t batch, const Scene& scene, const MonteCarloEngine& engine) {
+    writeStats(batch, engine.getStats());
+    writeSensors(batch, scene.getAllSensors());
+    for (const auto& sensor : scene.getAllSensors()) {
+        if (sensor->getSpectrum().isEnabled()) {
+            writeSpectrum(batch, *sensor);
+        }
+    }
+    for (const auto& tally : engine.getMeshTallies()) {
+        writeMeshTally(batch, *tally, engine.getStats().particlesEmitted.load());
+    }
+}
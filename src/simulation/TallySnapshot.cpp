@@ -0,0 +1,218 @@
+#include "simulation/TallySnapshot.h"
+#include "simulation/MonteCarloEngine.h"
+#include "core/Scene.h"
+#include "utils/BinaryIO.h"
+
+namespace {
+
+constexpr uint32_t SNAPSHOT_VERSION = 3;
+
+void putDoubles(ByteWriter& writer, const std::vector<double>& values) {
+    writer.put(static_cast<uint64_t>(values.size()));
+    writer.append(values.data(), values.size() * sizeof(double));
+}
+
+std::vector<double> getDoubles(ByteReader& reader) {
+    uint64_t count = reader.get<uint64_t>();
+    if (count > (1ull << 40) / sizeof(double)) throw std::runtime_error("Tally sérialisé invalide");
+    std::vector<double> values(count);
+    std::memcpy(values.data(), reader.take(count * sizeof(double)), count * sizeof(double));
+    return values;
+}
+
+void putStats(ByteWriter& writer, const DetectionStats& stats) {
+    writer.put(stats.totalCounts.load());
+    writer.put(stats.gammaCounts.load());
+    writer.put(stats.neutronCounts.load());
+    writer.put(stats.muonCounts.load());
+    writer.put(stats.weightedCounts.load());
+    writer.put(stats.totalEnergy.load());
+    writer.put(stats.totalDose.load());
+    writer.put(stats.nextEventScores.load());
+    writer.put(stats.nextEventFluence.load());
+    writer.put(stats.nextEventEnergyFluence.load());
+    writer.put(stats.trackLengthFluence.load());
+    writer.put(stats.trackLengthDose.load());
+}
+
+void getStats(ByteReader& reader, DetectionStats& stats) {
+    stats.totalCounts = reader.get<uint64_t>();
+    stats.gammaCounts = reader.get<uint64_t>();
+    stats.neutronCounts = reader.get<uint64_t>();
+    stats.muonCounts = reader.get<uint64_t>();
+    stats.weightedCounts = reader.get<double>();
+    stats.totalEnergy = reader.get<double>();
+    stats.totalDose = reader.get<double>();
+    stats.nextEventScores = reader.get<uint64_t>();
+    stats.nextEventFluence = reader.get<double>();
+    stats.nextEventEnergyFluence = reader.get<double>();
+    stats.trackLengthFluence = reader.get<double>();
+    stats.trackLengthDose = reader.get<double>();
+}
+
+void addVectors(std::vector<double>& into, const std::vector<double>& values, const std::string& name) {
+    if (into.empty()) into.assign(values.size(), 0.0);
+    if (into.size() != values.size()) throw std::runtime_error("Fusion de tallies de dimensions différentes: " + name);
+    for (size_t i = 0; i < values.size(); ++i) into[i] += values[i];
+}
+
+} // namespace
+
+TallySnapshot TallySnapshot::capture(const Scene& scene, const MonteCarloEngine& engine) {
+    TallySnapshot snapshot;
+    const SimulationStats& stats = engine.getStats();
+    snapshot.counters.emitted = stats.particlesEmitted.load();
+    snapshot.counters.transported = stats.particlesTransported.load();
+    snapshot.counters.absorbed = stats.particlesAbsorbed.load();
+    snapshot.counters.detected = stats.particlesDetected.load();
+    snapshot.counters.escaped = stats.particlesEscaped.load();
+    snapshot.counters.collisions = stats.totalCollisions.load();
+    snapshot.counters.rays = stats.rayIntersections.load();
+    snapshot.counters.secondaries = stats.secondariesProduced.load();
+    snapshot.counters.secondariesDropped = stats.secondariesDropped.load();
+    snapshot.counters.culled = stats.particlesCulled.load();
+
+    for (const auto& sensor : scene.getAllSensors()) {
+        SensorResult result;
+        result.name = sensor->getName();
+        result.stats = sensor->getStats();
+        result.spectrum = sensor->getSpectrum().getState();
+        snapshot.sensors.push_back(std::move(result));
+    }
+    for (const auto& tally : engine.getMeshTallies()) {
+        snapshot.meshes.push_back({tally->getName(), tally->getFluenceData(), tally->getDoseData()});
+    }
+    return snapshot;
+}
+
+void TallySnapshot::merge(const TallySnapshot& other) {
+    counters.emitted += other.counters.emitted;
+    counters.transported += other.counters.transported;
+    counters.absorbed += other.counters.absorbed;
+    counters.detected += other.counters.detected;
+    counters.escaped += other.counters.escaped;
+    counters.collisions += other.counters.collisions;
+    counters.rays += other.counters.rays;
+    counters.secondaries += other.counters.secondaries;
+    counters.secondariesDropped += other.counters.secondariesDropped;
+    counters.culled += other.counters.culled;
+
+    // Instantané vide : prend la structure de l'autre
+    if (sensors.empty() && meshes.empty()) {
+        sensors = other.sensors;
+        meshes = other.meshes;
+        return;
+    }
+
+    if (sensors.size() != other.sensors.size() || meshes.size() != other.meshes.size()) {
+        throw std::runtime_error("Fusion de résultats de scènes différentes");
+    }
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        SensorResult& sensor = sensors[i];
+        const SensorResult& added = other.sensors[i];
+        if (sensor.name != added.name) {
+            throw std::runtime_error("Fusion de résultats : capteur " + added.name + " au lieu de " + sensor.name);
+        }
+        sensor.stats += added.stats;
+        addVectors(sensor.spectrum.sum, added.spectrum.sum, sensor.name);
+        addVectors(sensor.spectrum.sumSqOverN, added.spectrum.sumSqOverN, sensor.name);
+        sensor.spectrum.histories += added.spectrum.histories;
+        sensor.spectrum.batches += added.spectrum.batches;
+    }
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        if (meshes[i].name != other.meshes[i].name) {
+            throw std::runtime_error("Fusion de résultats : tally " + other.meshes[i].name + " au lieu de " +
+                                     meshes[i].name);
+        }
+        addVectors(meshes[i].fluence, other.meshes[i].fluence, meshes[i].name);
+        addVectors(meshes[i].dose, other.meshes[i].dose, meshes[i].name);
+    }
+}
+
+void TallySnapshot::applyTo(Scene& scene, MonteCarloEngine& engine, double elapsedSeconds) const {
+    const auto& sceneSensors = scene.getAllSensors();
+    if (sceneSensors.size() != sensors.size() || engine.getMeshTallies().size() != meshes.size()) {
+        throw std::runtime_error("Résultats incompatibles avec la scène (capteurs ou tallies maillés)");
+    }
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        if (sceneSensors[i]->getName() != sensors[i].name) {
+            throw std::runtime_error("Résultats incompatibles avec la scène : capteur " + sensors[i].name);
+        }
+        sceneSensors[i]->addResults(sensors[i].stats, sensors[i].spectrum);
+    }
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        engine.getMeshTallies()[i]->addTotals(meshes[i].fluence, meshes[i].dose);
+    }
+
+    SimulationStats stats;
+    stats.particlesEmitted = counters.emitted;
+    stats.particlesTransported = counters.transported;
+    stats.particlesAbsorbed = counters.absorbed;
+    stats.particlesDetected = counters.detected;
+    stats.particlesEscaped = counters.escaped;
+    stats.totalCollisions = counters.collisions;
+    stats.rayIntersections = counters.rays;
+    stats.secondariesProduced = counters.secondaries;
+    stats.secondariesDropped = counters.secondariesDropped;
+    stats.particlesCulled = counters.culled;
+    stats.endTime = std::chrono::steady_clock::now();
+    stats.startTime = stats.endTime - std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                          std::chrono::duration<double>(elapsedSeconds));
+    engine.addStats(stats);
+}
+
+std::vector<uint8_t> TallySnapshot::serialize() const {
+    ByteWriter writer;
+    writer.put(SNAPSHOT_VERSION);
+    writer.put(counters);
+
+    writer.put(static_cast<uint32_t>(sensors.size()));
+    for (const auto& sensor : sensors) {
+        writer.putString(sensor.name);
+        putStats(writer, sensor.stats);
+        putDoubles(writer, sensor.spectrum.sum);
+        putDoubles(writer, sensor.spectrum.sumSqOverN);
+        writer.put(sensor.spectrum.histories);
+        writer.put(sensor.spectrum.batches);
+    }
+
+    writer.put(static_cast<uint32_t>(meshes.size()));
+    for (const auto& mesh : meshes) {
+        writer.putString(mesh.name);
+        putDoubles(writer, mesh.fluence);
+        putDoubles(writer, mesh.dose);
+    }
+    return writer.bytes();
+}
+
+TallySnapshot TallySnapshot::deserialize(const uint8_t* data, size_t size) {
+    ByteReader reader(data, size);
+    if (reader.get<uint32_t>() != SNAPSHOT_VERSION) {
+        throw std::runtime_error("Version de résultats sérialisés non supportée");
+    }
+
+    TallySnapshot snapshot;
+    snapshot.counters = reader.get<Counters>();
+
+    uint32_t sensorCount = reader.get<uint32_t>();
+    for (uint32_t i = 0; i < sensorCount; ++i) {
+        SensorResult sensor;
+        sensor.name = reader.getString();
+        getStats(reader, sensor.stats);
+        sensor.spectrum.sum = getDoubles(reader);
+        sensor.spectrum.sumSqOverN = getDoubles(reader);
+        sensor.spectrum.histories = reader.get<uint64_t>();
+        sensor.spectrum.batches = reader.get<uint32_t>();
+        snapshot.sensors.push_back(std::move(sensor));
+    }
+
+    uint32_t meshCount = reader.get<uint32_t>();
+    for (uint32_t i = 0; i < meshCount; ++i) {
+        MeshResult mesh;
+        mesh.name = reader.getString();
+        mesh.fluence = getDoubles(reader);
+        mesh.dose = getDoubles(reader);
+        snapshot.meshes.push_back(std::move(mesh));
+    }
+    return snapshot;
+}
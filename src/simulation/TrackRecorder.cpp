@@ -0,0 +1,406 @@
+#include "simulation/TrackRecorder.h"
+#include "core/Material.h"
+#include "utils/BinaryIO.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+constexpr char MAGIC[8] = {'R', 'A', 'D', 'T', 'R', 'K', '0', '1'};
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t ENDIAN_TAG = 0x01020304;
+constexpr uint32_t BLOCK_MAGIC = 0x4B4C4254; // "TBLK"
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endianTag;
+};
+
+struct BlockHeader {
+    uint32_t magic;
+    uint8_t compressed;
+    uint8_t reserved[3];
+    uint64_t rawSize;
+    uint64_t storedSize;
+    uint64_t eventCount;
+};
+
+static_assert(sizeof(FileHeader) == 16, "En-tête .rtrk de 16 octets");
+static_assert(sizeof(BlockHeader) == 32, "BlockHeader de 32 octets");
+
+enum Section : uint8_t { SECTION_MATERIAL = 1, SECTION_STEPS = 2, SECTION_DROPPED = 3 };
+
+// Octet de type d'une étape : 4 bits de TrackEventType, indicateurs de répétition
+constexpr uint8_t TYPE_MASK = 0x0F;
+constexpr uint8_t START_CONTINUES = 0x10; // Départ = arrivée de l'étape précédente
+constexpr uint8_t SAME_WEIGHT = 0x20;
+constexpr uint8_t SAME_MATERIAL = 0x40;
+constexpr uint8_t SAME_PARTICLE = 0x80;
+
+constexpr double POSITION_SCALE = 1e6; // µm
+constexpr double ENERGY_SCALE = 1e3;   // eV
+
+struct Quantized {
+    int64_t x = 0, y = 0, z = 0;
+    bool operator==(const Quantized&) const = default;
+};
+
+Quantized quantize(const glm::vec3& p) {
+    return {std::llround(p.x * POSITION_SCALE), std::llround(p.y * POSITION_SCALE),
+            std::llround(p.z * POSITION_SCALE)};
+}
+
+glm::vec3 dequantize(const Quantized& q) {
+    return glm::vec3(static_cast<float>(q.x / POSITION_SCALE), static_cast<float>(q.y / POSITION_SCALE),
+                     static_cast<float>(q.z / POSITION_SCALE));
+}
+
+// État du codage delta, réinitialisé à chaque section d'étapes
+struct DeltaState {
+    uint64_t history = 0;
+    Quantized end;
+    int64_t energy = 0;
+    float weight = 1.0f;
+    uint32_t material = 0;
+    uint8_t particle = 0;
+};
+
+} // namespace
+
+const char* trackEventTypeName(TrackEventType type) {
+    switch (type) {
+        case TrackEventType::BOUNDARY: return "frontière";
+        case TrackEventType::ABSORPTION: return "absorption";
+        case TrackEventType::SCATTERING: return "diffusion";
+        case TrackEventType::TRANSMISSION: return "transmission";
+        case TrackEventType::CAPTURE: return "capture";
+        case TrackEventType::ESCAPE: return "fuite";
+        case TrackEventType::ENERGY_CUTOFF: return "coupure énergie";
+        case TrackEventType::TIME_CUTOFF: return "coupure temps";
+        case TrackEventType::ROULETTE: return "roulette";
+        case TrackEventType::BOUNCE_LIMIT: return "limite d'étapes";
+        case TrackEventType::RANGE_CUTOFF: return "coupure portée";
+    }
+    return "?";
+}
+
+TrackEventType trackEventType(InteractionType interaction) {
+    switch (interaction) {
+        case InteractionType::ABSORPTION: return TrackEventType::ABSORPTION;
+        case InteractionType::SCATTERING: return TrackEventType::SCATTERING;
+        case InteractionType::TRANSMISSION: return TrackEventType::TRANSMISSION;
+        case InteractionType::CAPTURE: return TrackEventType::CAPTURE;
+    }
+    return TrackEventType::ABSORPTION;
+}
+
+std::vector<uint64_t> TrackData::histories() const {
+    std::vector<uint64_t> ids;
+    for (const auto& step : steps) {
+        if (ids.empty() || ids.back() != step.history) ids.push_back(step.history);
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+std::vector<TrackStep> TrackData::history(uint64_t id) const {
+    std::vector<TrackStep> result;
+    for (const auto& step : steps) {
+        if (step.history == id) result.push_back(step);
+    }
+    return result;
+}
+
+TrackChannel::TrackChannel(uint32_t threadId, uint32_t capacity, uint32_t sampleEvery)
+    : m_ring(std::bit_ceil(std::max<uint32_t>(capacity, 2))), m_mask(m_ring.size() - 1), m_threadId(threadId),
+      m_sampleEvery(sampleEvery) {
+}
+
+TrackRecorder::TrackRecorder(const std::string& filename, const TrackRecorderConfig& config)
+    : m_filename(filename), m_config(config) {
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour écriture: " + filename);
+    }
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.endianTag = ENDIAN_TAG;
+    std::fwrite(&header, sizeof(header), 1, m_file);
+
+    m_drainThread = std::thread(&TrackRecorder::drainLoop, this);
+}
+
+TrackRecorder::~TrackRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_shouldStop = true;
+    }
+    m_wakeCondition.notify_all();
+    if (m_drainThread.joinable()) m_drainThread.join();
+
+    flush();
+    std::fclose(m_file);
+
+    uint64_t dropped = getDroppedEvents();
+    Log::info("Traces : " + std::to_string(m_recordedEvents.load()) + " événements écrits dans " + m_filename +
+              (dropped > 0 ? " (" + std::to_string(dropped) + " perdus, tampons pleins)" : ""));
+}
+
+void TrackRecorder::prepare(uint32_t threadCount) {
+    std::lock_guard<std::mutex> lock(m_drainMutex);
+    while (m_channels.size() < threadCount) {
+        uint32_t threadId = static_cast<uint32_t>(m_channels.size());
+        m_channels.emplace_back(new TrackChannel(threadId, m_config.ringCapacity, m_config.sampleEvery));
+    }
+}
+
+TrackChannel* TrackRecorder::getChannel(uint32_t threadId) {
+    std::lock_guard<std::mutex> lock(m_drainMutex);
+    return threadId < m_channels.size() ? m_channels[threadId].get() : nullptr;
+}
+
+void TrackRecorder::flush() {
+    std::lock_guard<std::mutex> lock(m_drainMutex);
+    drainAll();
+    std::fflush(m_file);
+}
+
+uint64_t TrackRecorder::getDroppedEvents() const {
+    uint64_t dropped = 0;
+    for (const auto& channel : m_channels) dropped += channel->getDroppedEvents();
+    return dropped;
+}
+
+void TrackRecorder::drainLoop() {
+    std::unique_lock<std::mutex> wakeLock(m_wakeMutex);
+    while (!m_shouldStop) {
+        m_wakeCondition.wait_for(wakeLock, std::chrono::milliseconds(m_config.drainIntervalMs),
+                                 [this] { return m_shouldStop; });
+        wakeLock.unlock();
+        {
+            std::lock_guard<std::mutex> lock(m_drainMutex);
+            drainAll();
+        }
+        wakeLock.lock();
+    }
+}
+
+void TrackRecorder::drainAll() {
+    ByteWriter payload;
+    uint64_t eventCount = 0;
+    // Adresses valides le temps du vidage seulement (matériaux du run en cours)
+    std::unordered_map<const Material*, uint32_t> drainIds;
+
+    for (const auto& channel : m_channels) {
+        uint64_t tail = channel->m_tail.load(std::memory_order_relaxed);
+        uint64_t head = channel->m_head.load(std::memory_order_acquire);
+
+        // Matériaux rencontrés pour la première fois : déclarés avant les étapes
+        for (uint64_t i = tail; i < head; ++i) {
+            const Material* material = channel->m_ring[i & channel->m_mask].material;
+            if (!material || drainIds.count(material)) continue;
+            auto [known, inserted] =
+                m_materialIds.emplace(material->getName(), static_cast<uint32_t>(m_materialIds.size() + 1));
+            drainIds.emplace(material, known->second);
+            if (!inserted) continue;
+            payload.put(SECTION_MATERIAL);
+            payload.putVarint(known->second);
+            payload.putString(material->getName());
+        }
+
+        if (head > tail) {
+            payload.put(SECTION_STEPS);
+            payload.putVarint(channel->m_threadId);
+            payload.putVarint(head - tail);
+
+            DeltaState state;
+            for (uint64_t i = tail; i < head; ++i) {
+                const TrackChannel::Entry& entry = channel->m_ring[i & channel->m_mask];
+                uint32_t material = entry.material ? drainIds[entry.material] : 0;
+                uint8_t particle = static_cast<uint8_t>(entry.particle);
+                Quantized start = quantize(entry.start);
+                Quantized end = quantize(entry.end);
+                int64_t energy = std::llround(entry.energy * ENERGY_SCALE);
+
+                uint8_t tag = static_cast<uint8_t>(entry.type) & TYPE_MASK;
+                if (start == state.end) tag |= START_CONTINUES;
+                if (entry.weight == state.weight) tag |= SAME_WEIGHT;
+                if (material == state.material) tag |= SAME_MATERIAL;
+                if (particle == state.particle) tag |= SAME_PARTICLE;
+
+                payload.putVarint(entry.history - state.history);
+                payload.put(tag);
+                if (!(tag & SAME_PARTICLE)) payload.put(particle);
+                if (!(tag & SAME_MATERIAL)) payload.putVarint(material);
+                if (!(tag & START_CONTINUES)) {
+                    payload.putSignedVarint(start.x - state.end.x);
+                    payload.putSignedVarint(start.y - state.end.y);
+                    payload.putSignedVarint(start.z - state.end.z);
+                }
+                payload.putSignedVarint(end.x - start.x);
+                payload.putSignedVarint(end.y - start.y);
+                payload.putSignedVarint(end.z - start.z);
+                payload.putSignedVarint(energy - state.energy);
+                if (!(tag & SAME_WEIGHT)) payload.put(entry.weight);
+
+                state.history = entry.history;
+                state.end = end;
+                state.energy = energy;
+                state.weight = entry.weight;
+                state.material = material;
+                state.particle = particle;
+            }
+            eventCount += head - tail;
+            channel->m_tail.store(head, std::memory_order_release);
+        }
+
+        uint64_t dropped = channel->getDroppedEvents();
+        if (dropped > channel->m_reportedDropped) {
+            payload.put(SECTION_DROPPED);
+            payload.putVarint(dropped - channel->m_reportedDropped);
+            channel->m_reportedDropped = dropped;
+        }
+    }
+
+    const std::vector<uint8_t>& raw = payload.bytes();
+    if (raw.empty()) return;
+
+    BlockHeader header{};
+    header.magic = BLOCK_MAGIC;
+    header.rawSize = raw.size();
+    header.storedSize = raw.size();
+    header.eventCount = eventCount;
+    const uint8_t* stored = raw.data();
+
+#ifdef USE_ZLIB
+    std::vector<uint8_t> compressed;
+    if (m_config.compress) {
+        uLongf size = compressBound(static_cast<uLong>(raw.size()));
+        compressed.resize(size);
+        // Niveau 1 : le vidage tourne pendant la simulation
+        if (compress2(compressed.data(), &size, raw.data(), static_cast<uLong>(raw.size()), 1) == Z_OK &&
+            size < raw.size()) {
+            header.compressed = 1;
+            header.storedSize = size;
+            stored = compressed.data();
+        }
+    }
+#endif
+
+    std::fwrite(&header, sizeof(header), 1, m_file);
+    std::fwrite(stored, 1, header.storedSize, m_file);
+    m_recordedEvents.fetch_add(eventCount);
+}
+
+TrackData TrackRecorder::readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour lecture: " + filename);
+    }
+
+    FileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Fichier de traces invalide: " + filename);
+    }
+    if (header.endianTag != ENDIAN_TAG || header.version > VERSION) {
+        throw std::runtime_error("Version ou boutisme .rtrk non supporté: " + filename);
+    }
+
+    TrackData data;
+    std::vector<uint8_t> stored, raw;
+    BlockHeader block;
+    while (file.read(reinterpret_cast<char*>(&block), sizeof(block))) {
+        if (block.magic != BLOCK_MAGIC) {
+            throw std::runtime_error("Bloc de traces corrompu: " + filename);
+        }
+        stored.resize(block.storedSize);
+        file.read(reinterpret_cast<char*>(stored.data()), static_cast<std::streamsize>(stored.size()));
+        if (static_cast<uint64_t>(file.gcount()) != block.storedSize) {
+            Log::warning("Fichier de traces tronqué, dernier bloc ignoré: " + filename);
+            break;
+        }
+
+        if (block.compressed) {
+#ifdef USE_ZLIB
+            raw.resize(block.rawSize);
+            uLongf size = static_cast<uLongf>(block.rawSize);
+            if (uncompress(raw.data(), &size, stored.data(), static_cast<uLong>(stored.size())) != Z_OK ||
+                size != block.rawSize) {
+                throw std::runtime_error("Décompression d'un bloc de traces impossible: " + filename);
+            }
+#else
+            throw std::runtime_error("Fichier de traces compressé : programme compilé sans zlib");
+#endif
+        } else {
+            raw.swap(stored);
+        }
+
+        ByteReader reader(raw.data(), raw.size());
+        while (!reader.atEnd()) {
+            uint8_t section = reader.get<uint8_t>();
+            if (section == SECTION_MATERIAL) {
+                uint64_t id = reader.getVarint();
+                std::string name = reader.getString();
+                if (id >= data.materials.size()) data.materials.resize(id + 1);
+                data.materials[id] = name;
+            } else if (section == SECTION_DROPPED) {
+                data.droppedEvents += reader.getVarint();
+            } else if (section == SECTION_STEPS) {
+                reader.getVarint(); // Thread : déjà contenu dans l'identifiant d'histoire
+                uint64_t count = reader.getVarint();
+                DeltaState state;
+                for (uint64_t i = 0; i < count; ++i) {
+                    TrackStep step;
+                    step.history = state.history + reader.getVarint();
+                    uint8_t tag = reader.get<uint8_t>();
+                    step.type = static_cast<TrackEventType>(tag & TYPE_MASK);
+                    uint8_t particle = tag & SAME_PARTICLE ? state.particle : reader.get<uint8_t>();
+                    step.particle = static_cast<RadiationType>(particle);
+                    step.material = tag & SAME_MATERIAL ? state.material
+                                                        : static_cast<uint32_t>(reader.getVarint());
+
+                    Quantized start = state.end;
+                    if (!(tag & START_CONTINUES)) {
+                        start.x += reader.getSignedVarint();
+                        start.y += reader.getSignedVarint();
+                        start.z += reader.getSignedVarint();
+                    }
+                    Quantized end = start;
+                    end.x += reader.getSignedVarint();
+                    end.y += reader.getSignedVarint();
+                    end.z += reader.getSignedVarint();
+                    int64_t energy = state.energy + reader.getSignedVarint();
+                    step.weight = tag & SAME_WEIGHT ? state.weight : reader.get<float>();
+
+                    step.start = dequantize(start);
+                    step.end = dequantize(end);
+                    step.energy = static_cast<float>(energy / ENERGY_SCALE);
+                    data.steps.push_back(step);
+
+                    state.history = step.history;
+                    state.end = end;
+                    state.energy = energy;
+                    state.weight = step.weight;
+                    state.material = step.material;
+                    state.particle = particle;
+                }
+            } else {
+                throw std::runtime_error("Section de traces inconnue: " + filename);
+            }
+        }
+    }
+
+    for (auto& step : data.steps) {
+        if (step.material >= data.materials.size()) step.material = 0;
+    }
+    return data;
+}
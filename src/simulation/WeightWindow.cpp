@@ -0,0 +1,125 @@
+#include "simulation/WeightWindow.h"
+#include <algorithm>
+
+// WeightWindowMesh implementation
+WeightWindowMesh::WeightWindowMesh(const AABB& bounds, uint32_t nx, uint32_t ny, uint32_t nz)
+    : m_grid(bounds, nx, ny, nz) {
+    m_lowerBounds.assign(getCellCount(), 0.0f);
+}
+
+void WeightWindowMesh::setEnergyGroups(const std::vector<float>& upperBounds) {
+    // Le dernier groupe est ouvert : seules les bornes intermédiaires sont conservées
+    m_groupUpperBounds = upperBounds;
+    std::sort(m_groupUpperBounds.begin(), m_groupUpperBounds.end());
+    if (!m_groupUpperBounds.empty()) {
+        m_groupUpperBounds.pop_back();
+    }
+    m_lowerBounds.assign(static_cast<size_t>(getCellCount()) * getGroupCount(), 0.0f);
+}
+
+uint32_t WeightWindowMesh::groupIndex(float energy) const {
+    auto it = std::upper_bound(m_groupUpperBounds.begin(), m_groupUpperBounds.end(), energy);
+    return static_cast<uint32_t>(it - m_groupUpperBounds.begin());
+}
+
+float WeightWindowMesh::getLowerBound(const glm::vec3& position, float energy) const {
+    int cell = cellIndex(position);
+    if (cell < 0) return 0.0f;
+
+    return getLowerBound(static_cast<uint32_t>(cell), groupIndex(energy));
+}
+
+// ImportanceTally implementation
+void ImportanceTally::resize(size_t cellCount) {
+    score.assign(cellCount, 0.0);
+    weight.assign(cellCount, 0.0);
+    history.clear();
+    historyScore = 0.0;
+    histories = 0;
+    totalScore = 0.0;
+}
+
+void ImportanceTally::beginHistory() {
+    history.clear();
+    historyScore = 0.0;
+}
+
+void ImportanceTally::recordEntry(uint32_t cell, float entryWeight) {
+    history.push_back({cell, entryWeight, historyScore});
+}
+
+void ImportanceTally::endHistory() {
+    // Le score attribué à une entrée est celui produit par la suite de l'histoire
+    // (progéniture incluse, puisqu'elle est transportée avant la fin de l'histoire)
+    for (const auto& entry : history) {
+        score[entry.cell] += historyScore - entry.scoreAtEntry;
+        weight[entry.cell] += entry.weight;
+    }
+
+    totalScore += historyScore;
+    ++histories;
+    history.clear();
+}
+
+void ImportanceTally::merge(const ImportanceTally& other) {
+    if (score.size() != other.score.size()) return;
+
+    for (size_t i = 0; i < score.size(); ++i) {
+        score[i] += other.score[i];
+        weight[i] += other.weight[i];
+    }
+    histories += other.histories;
+    totalScore += other.totalScore;
+}
+
+// WeightWindowBuilder implementation
+namespace WeightWindowBuilder {
+
+std::shared_ptr<WeightWindowMesh> fromImportance(const AABB& bounds, uint32_t nx, uint32_t ny, uint32_t nz,
+                                                 const ImportanceTally& tally) {
+    auto mesh = std::make_shared<WeightWindowMesh>(bounds, nx, ny, nz);
+    if (tally.histories == 0 || tally.totalScore <= 0.0) {
+        return mesh; // Aucun score : pas de fenêtre
+    }
+
+    // Importance de la source = score moyen par histoire (poids source unitaire)
+    double sourceImportance = tally.totalScore / static_cast<double>(tally.histories);
+
+    // Poids source au centre de la fenêtre [wL, ratio * wL]
+    double sourceLowerBound = 2.0 / (1.0 + mesh->getUpperRatio());
+    double normalization = sourceLowerBound * sourceImportance;
+
+    for (uint32_t cell = 0; cell < mesh->getCellCount(); ++cell) {
+        if (tally.weight[cell] <= 0.0 || tally.score[cell] <= 0.0) {
+            continue; // Importance inconnue : la cellule reste sans fenêtre
+        }
+
+        double importance = tally.score[cell] / tally.weight[cell];
+        mesh->setLowerBound(cell, 0, static_cast<float>(normalization / importance));
+    }
+
+    return mesh;
+}
+
+float relativeChange(const WeightWindowMesh& previous, const WeightWindowMesh& current) {
+    const auto& before = previous.getLowerBounds();
+    const auto& after = current.getLowerBounds();
+    if (before.size() != after.size()) return 1.0f;
+
+    std::vector<float> changes;
+    for (size_t i = 0; i < after.size(); ++i) {
+        float a = before[i];
+        float b = after[i];
+        if (a > 0.0f && b > 0.0f) {
+            changes.push_back(std::abs(b - a) / a);
+        }
+    }
+
+    if (changes.empty()) return 1.0f;
+
+    auto middle = changes.begin() + changes.size() / 2;
+    std::nth_element(changes.begin(), middle, changes.end());
+    return *middle;
+}
+
+} // namespace WeightWindowBuilder
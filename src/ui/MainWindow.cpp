@@ -4,6 +4,7 @@
 #include "ui/MaterialEditor.h"
 #include "ui/SensorEditor.h"
 #include "ui/SourceEditor.h"
+#include "simulation/ResultsWriter.h"
 #include <QHeaderView>
 #include <QApplication>
 #include <QFileDialog>
@@ -452,11 +453,21 @@ void MainWindow::saveProjectAs() {
 }
 
 void MainWindow::exportResults() {
-    QString filename = QFileDialog::getSaveFileName(this, "Exporter les résultats", "", "CSV (*.csv);;JSON (*.json)");
-    if (!filename.isEmpty()) {
-        // TODO: export réel
-        Log::info("Résultats exportés vers: " + filename.toStdString());
+    // Seul format d'export : colonnes binaires (.rcol)
+    QString filename = QFileDialog::getSaveFileName(this, "Exporter les résultats", "", "Colonnes binaires (*.rcol)");
+    if (filename.isEmpty())
+        return;
+    if (QFileInfo(filename).suffix() != "rcol")
+        filename += ".rcol";
+
+    try {
+        ResultsWriter writer(filename.toStdString(), false, ColumnWriter::isCompressionAvailable());
+        writer.writeBatch(0, *m_scene, *m_engine);
+    } catch (const std::exception &e) {
+        QMessageBox::critical(this, "Erreur", QString("Impossible d'exporter les résultats:\n%1").arg(e.what()));
+        return;
     }
+    Log::info("Résultats exportés vers: " + filename.toStdString());
 }
 
 // Vue
@@ -1,9 +1,12 @@
 #include "utils/BVH.h"
+#include "utils/Profiler.h"
 #include <algorithm>
 #include <queue>
 
 // BVHNode implementation
 bool BVHNode::intersect(const Ray& ray, IntersectionResult& result) const {
+    PROFILE_COUNT(ProfileCounter::BVH_NODES, 1);
+
     // Test d'intersection avec la boîte englobante
     float tMin, tMax;
     if (!bounds.intersects(ray, tMin, tMax)) {
@@ -16,6 +19,7 @@ bool BVHNode::intersect(const Ray& ray, IntersectionResult& result) const {
         IntersectionResult closestHit;
         closestHit.distance = std::numeric_limits<float>::max();
         
+        PROFILE_COUNT(ProfileCounter::PRIMITIVE_TESTS, objects.size());
         for (const auto& object : objects) {
             IntersectionResult objectHit = object->intersect(ray);
             if (objectHit.hit && objectHit.distance < closestHit.distance) {
@@ -52,6 +56,8 @@ bool BVHNode::intersect(const Ray& ray, IntersectionResult& result) const {
 }
 
 bool BVHNode::intersectAny(const Ray& ray) const {
+    PROFILE_COUNT(ProfileCounter::BVH_NODES, 1);
+
     // Test d'intersection avec la boîte englobante
     float tMin, tMax;
     if (!bounds.intersects(ray, tMin, tMax)) {
@@ -61,6 +67,7 @@ bool BVHNode::intersectAny(const Ray& ray) const {
     if (isLeaf) {
         // Nœud feuille - tester tous les objets
         for (const auto& object : objects) {
+            PROFILE_COUNT(ProfileCounter::PRIMITIVE_TESTS, 1);
             IntersectionResult hit = object->intersect(ray);
             if (hit.hit) {
                 return true;
@@ -0,0 +1,481 @@
+#include "utils/ColumnStore.h"
+#include "utils/BinaryIO.h"
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace ColumnFormat;
+
+namespace {
+
+constexpr size_t MIN_COMPRESSED_SIZE = 256; // Colonnes plus petites stockées telles quelles
+
+uint32_t fnv1a(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+template <typename T>
+Column makeColumn(const std::string& name, ColumnType type, const std::vector<T>& values) {
+    Column column;
+    column.name = name;
+    column.type = type;
+    column.data.resize(values.size() * sizeof(T));
+    if (!values.empty()) std::memcpy(column.data.data(), values.data(), column.data.size());
+    return column;
+}
+
+template <typename T>
+T loadValue(const uint8_t* data, size_t index) {
+    T value;
+    std::memcpy(&value, data + index * sizeof(T), sizeof(T));
+    return value;
+}
+
+// Regroupement des octets de même rang : les exposants et octets de poids fort
+// deviennent contigus, ce qui améliore nettement la compression des flottants
+std::vector<uint8_t> shuffle(const std::vector<uint8_t>& data, size_t elementSize, bool inverse) {
+    std::vector<uint8_t> result(data.size());
+    size_t count = data.size() / elementSize;
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t b = 0; b < elementSize; ++b) {
+            if (inverse) result[i * elementSize + b] = data[b * count + i];
+            else result[b * count + i] = data[i * elementSize + b];
+        }
+    }
+    return result;
+}
+
+// Renvoie le codec effectivement appliqué (NONE si la compression n'apporte rien)
+ColumnCodec encode(const Column& column, ColumnCodec codec, std::vector<uint8_t>& stored) {
+#ifdef USE_ZLIB
+    if (codec != ColumnCodec::NONE && column.data.size() >= MIN_COMPRESSED_SIZE) {
+        size_t elementSize = column.elementSize();
+        if (elementSize <= 1) codec = ColumnCodec::ZLIB;
+
+        std::vector<uint8_t> input = codec == ColumnCodec::SHUFFLE_ZLIB ? shuffle(column.data, elementSize, false)
+                                                                        : column.data;
+        uLongf size = compressBound(static_cast<uLong>(input.size()));
+        stored.resize(size);
+        // Niveau 1 : priorité au débit, l'écriture a lieu pendant la simulation
+        if (compress2(stored.data(), &size, input.data(), static_cast<uLong>(input.size()), 1) == Z_OK &&
+            size < column.data.size()) {
+            stored.resize(size);
+            return codec;
+        }
+    }
+#else
+    (void)codec;
+#endif
+    stored = column.data;
+    return ColumnCodec::NONE;
+}
+
+std::vector<uint8_t> decode(const uint8_t* stored, const ColumnRecord& record, size_t elementSize) {
+    auto codec = static_cast<ColumnCodec>(record.codec);
+    if (codec == ColumnCodec::NONE) {
+        if (record.storedSize != record.rawSize) throw std::runtime_error("Colonne .rcol corrompue");
+        return std::vector<uint8_t>(stored, stored + record.rawSize);
+    }
+
+#ifdef USE_ZLIB
+    std::vector<uint8_t> raw(record.rawSize);
+    uLongf size = static_cast<uLongf>(record.rawSize);
+    if (uncompress(raw.data(), &size, stored, static_cast<uLong>(record.storedSize)) != Z_OK || size != record.rawSize) {
+        throw std::runtime_error("Décompression d'une colonne .rcol impossible");
+    }
+    return codec == ColumnCodec::SHUFFLE_ZLIB && elementSize > 1 ? shuffle(raw, elementSize, true) : raw;
+#else
+    (void)elementSize;
+    throw std::runtime_error("Colonne .rcol compressée : programme compilé sans zlib");
+#endif
+}
+
+size_t typeSize(ColumnType type) {
+    switch (type) {
+        case ColumnType::FLOAT64: return 8;
+        case ColumnType::FLOAT32: return 4;
+        case ColumnType::UINT64: return 8;
+        case ColumnType::UINT32: return 4;
+        case ColumnType::STRING: return 0;
+    }
+    return 0;
+}
+
+uint64_t fileSize(std::ifstream& file) {
+    file.clear();
+    file.seekg(0, std::ios::end);
+    return static_cast<uint64_t>(file.tellg());
+}
+
+bool readAt(std::ifstream& file, uint64_t offset, void* data, size_t size) {
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    return static_cast<size_t>(file.gcount()) == size;
+}
+
+void checkFileHeader(std::ifstream& file, const std::string& filename) {
+    FileHeader header;
+    if (!readAt(file, 0, &header, sizeof(header)) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Fichier .rcol invalide: " + filename);
+    }
+    if (header.endianTag != ENDIAN_TAG || header.version > VERSION) {
+        throw std::runtime_error("Version ou boutisme .rcol non supporté: " + filename);
+    }
+}
+
+// Parcours des blocs complets à partir de offset ; renvoie la fin du dernier bloc complet
+template <typename Func>
+uint64_t scanChunks(std::ifstream& file, uint64_t offset, Func&& onChunk) {
+    uint64_t size = fileSize(file);
+    while (offset + sizeof(ChunkHeader) <= size) {
+        ChunkHeader header;
+        if (!readAt(file, offset, &header, sizeof(header)) || header.magic != CHUNK_MAGIC) break;
+        if (header.payloadSize > size - offset - sizeof(ChunkHeader)) break; // Bloc en cours d'écriture
+
+        uint32_t nameLength = 0;
+        readAt(file, offset + sizeof(ChunkHeader), &nameLength, sizeof(nameLength));
+        if (nameLength > header.payloadSize - sizeof(nameLength)) break;
+        std::string name(nameLength, '\0');
+        readAt(file, offset + sizeof(ChunkHeader) + sizeof(nameLength), name.data(), nameLength);
+
+        onChunk(name, header, offset);
+        offset += sizeof(ChunkHeader) + header.payloadSize;
+    }
+    return offset;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Column / ColumnTable
+// ---------------------------------------------------------------------------
+Column Column::float64(const std::string& name, const std::vector<double>& values) {
+    return makeColumn(name, ColumnType::FLOAT64, values);
+}
+
+Column Column::float32(const std::string& name, const std::vector<float>& values) {
+    return makeColumn(name, ColumnType::FLOAT32, values);
+}
+
+Column Column::uint64(const std::string& name, const std::vector<uint64_t>& values) {
+    return makeColumn(name, ColumnType::UINT64, values);
+}
+
+Column Column::uint32(const std::string& name, const std::vector<uint32_t>& values) {
+    return makeColumn(name, ColumnType::UINT32, values);
+}
+
+Column Column::strings(const std::string& name, const std::vector<std::string>& values) {
+    Column column;
+    column.name = name;
+    column.type = ColumnType::STRING;
+    for (const auto& value : values) {
+        uint32_t length = static_cast<uint32_t>(value.size());
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&length);
+        column.data.insert(column.data.end(), bytes, bytes + sizeof(length));
+        column.data.insert(column.data.end(), value.begin(), value.end());
+    }
+    return column;
+}
+
+size_t Column::elementSize() const {
+    return typeSize(type);
+}
+
+uint64_t Column::rowCount() const {
+    if (type != ColumnType::STRING) return data.size() / elementSize();
+
+    uint64_t rows = 0;
+    ByteReader reader(data.data(), data.size());
+    while (reader.position() < data.size()) {
+        reader.take(reader.get<uint32_t>());
+        ++rows;
+    }
+    return rows;
+}
+
+std::vector<double> Column::asDoubles() const {
+    std::vector<double> values(type == ColumnType::STRING ? 0 : rowCount());
+    for (size_t i = 0; i < values.size(); ++i) {
+        switch (type) {
+            case ColumnType::FLOAT64: values[i] = loadValue<double>(data.data(), i); break;
+            case ColumnType::FLOAT32: values[i] = loadValue<float>(data.data(), i); break;
+            case ColumnType::UINT64: values[i] = static_cast<double>(loadValue<uint64_t>(data.data(), i)); break;
+            case ColumnType::UINT32: values[i] = loadValue<uint32_t>(data.data(), i); break;
+            case ColumnType::STRING: break;
+        }
+    }
+    return values;
+}
+
+std::vector<uint64_t> Column::asUInt64() const {
+    if (type == ColumnType::UINT64) {
+        std::vector<uint64_t> values(rowCount());
+        if (!values.empty()) std::memcpy(values.data(), data.data(), data.size());
+        return values;
+    }
+    std::vector<double> doubles = asDoubles();
+    return std::vector<uint64_t>(doubles.begin(), doubles.end());
+}
+
+std::vector<std::string> Column::asStrings() const {
+    std::vector<std::string> values;
+    if (type != ColumnType::STRING) return values;
+
+    ByteReader reader(data.data(), data.size());
+    while (reader.position() < data.size()) {
+        values.push_back(reader.getString());
+    }
+    return values;
+}
+
+const Column* ColumnTable::find(const std::string& columnName) const {
+    for (const auto& column : columns) {
+        if (column.name == columnName) return &column;
+    }
+    return nullptr;
+}
+
+const Column& ColumnTable::at(const std::string& columnName) const {
+    const Column* column = find(columnName);
+    if (!column) throw std::runtime_error("Colonne absente de la table " + name + ": " + columnName);
+    return *column;
+}
+
+// ---------------------------------------------------------------------------
+// ColumnWriter
+// ---------------------------------------------------------------------------
+ColumnWriter::ColumnWriter(const std::string& filename, bool append, ColumnCodec codec)
+    : m_filename(filename), m_codec(codec) {
+    if constexpr (std::endian::native != std::endian::little) {
+        throw std::runtime_error("Format .rcol : hôte gros-boutiste non supporté");
+    }
+
+    bool resume = append && std::filesystem::exists(filename) && std::filesystem::file_size(filename) > 0;
+    if (resume) {
+        // Reprise : un éventuel bloc incomplet (arrêt brutal) est tronqué
+        uint64_t end;
+        {
+            std::ifstream existing(filename, std::ios::binary);
+            checkFileHeader(existing, filename);
+            end = scanChunks(existing, sizeof(FileHeader), [](const std::string&, const ChunkHeader&, uint64_t) {});
+        }
+        if (end < std::filesystem::file_size(filename)) {
+            Log::warning("Bloc incomplet tronqué en fin de fichier: " + filename);
+            std::filesystem::resize_file(filename, end);
+        }
+        m_file = std::fopen(filename.c_str(), "ab");
+    } else {
+        m_file = std::fopen(filename.c_str(), "wb");
+    }
+
+    if (!m_file) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour écriture: " + filename);
+    }
+
+    if (!resume) {
+        FileHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.endianTag = ENDIAN_TAG;
+        std::fwrite(&header, sizeof(header), 1, m_file);
+        std::fflush(m_file);
+    }
+
+    if (m_codec != ColumnCodec::NONE && !isCompressionAvailable()) {
+        Log::warning("Compression demandée mais zlib absente : colonnes non compressées");
+    }
+}
+
+ColumnWriter::~ColumnWriter() {
+    if (m_file) std::fclose(m_file);
+}
+
+bool ColumnWriter::isCompressionAvailable() {
+#ifdef USE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ColumnWriter::write(const ColumnTable& table) {
+    uint64_t rows = table.rowCount();
+    for (const auto& column : table.columns) {
+        if (column.rowCount() != rows) {
+            throw std::runtime_error("Table " + table.name + " : colonnes de longueurs différentes (" + column.name + ")");
+        }
+    }
+
+    // Charge utile : nom, répertoire des colonnes, puis données alignées sur 8 octets
+    ByteWriter payload;
+    payload.putString(table.name);
+    std::vector<uint64_t> recordOffsets;
+    for (const auto& column : table.columns) {
+        payload.putString(column.name);
+        recordOffsets.push_back(payload.reserve(sizeof(ColumnRecord)));
+    }
+
+    for (size_t i = 0; i < table.columns.size(); ++i) {
+        const Column& column = table.columns[i];
+        std::vector<uint8_t> stored;
+        ColumnCodec codec = encode(column, m_codec, stored);
+
+        ColumnRecord record{};
+        record.type = static_cast<uint8_t>(column.type);
+        record.codec = static_cast<uint8_t>(codec);
+        record.rawSize = column.data.size();
+        record.storedSize = stored.size();
+        record.dataOffset = payload.align(8);
+        payload.append(stored.data(), stored.size());
+        payload.patch(recordOffsets[i], record);
+    }
+
+    ChunkHeader header{};
+    header.magic = CHUNK_MAGIC;
+    header.checksum = fnv1a(payload.bytes().data(), payload.bytes().size());
+    header.payloadSize = payload.bytes().size();
+    header.batch = table.batch;
+    header.rowCount = rows;
+    header.columnCount = static_cast<uint32_t>(table.columns.size());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool ok = std::fwrite(&header, sizeof(header), 1, m_file) == 1 &&
+              std::fwrite(payload.bytes().data(), 1, payload.bytes().size(), m_file) == payload.bytes().size();
+    // Vidage immédiat : le bloc est lisible par un autre processus dès le retour
+    if (!ok || std::fflush(m_file) != 0) {
+        throw std::runtime_error("Erreur d'écriture: " + m_filename);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ColumnReader
+// ---------------------------------------------------------------------------
+ColumnReader::ColumnReader(const std::string& filename)
+    : m_filename(filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour lecture: " + filename);
+    }
+    checkFileHeader(file, filename);
+    refresh();
+}
+
+size_t ColumnReader::refresh() {
+    std::ifstream file(m_filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour lecture: " + m_filename);
+    }
+
+    m_scanOffset = scanChunks(file, m_scanOffset, [this](const std::string& name, const ChunkHeader& header,
+                                                          uint64_t offset) {
+        ChunkInfo info;
+        info.table = name;
+        info.batch = header.batch;
+        info.rowCount = header.rowCount;
+        info.offset = offset;
+        m_chunks.push_back(std::move(info));
+    });
+    return m_chunks.size();
+}
+
+std::vector<size_t> ColumnReader::findChunks(const std::string& table) const {
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+        if (m_chunks[i].table == table) indices.push_back(i);
+    }
+    return indices;
+}
+
+ColumnTable ColumnReader::read(size_t chunk, const std::vector<std::string>& columns) const {
+    if (chunk >= m_chunks.size()) {
+        throw std::out_of_range("Bloc .rcol inexistant: " + std::to_string(chunk));
+    }
+
+    std::ifstream file(m_filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour lecture: " + m_filename);
+    }
+
+    const ChunkInfo& info = m_chunks[chunk];
+    ChunkHeader header;
+    readAt(file, info.offset, &header, sizeof(header));
+    uint64_t payloadOffset = info.offset + sizeof(ChunkHeader);
+
+    // Lecture complète (avec contrôle d'intégrité) ou projection sur quelques colonnes
+    std::vector<uint8_t> payload;
+    bool projected = !columns.empty();
+    if (projected) {
+        // Répertoire seul : nom de table, puis (nom, enregistrement) par colonne
+        uint64_t directorySize = std::min<uint64_t>(header.payloadSize, 4096);
+        while (true) {
+            payload.resize(directorySize);
+            readAt(file, payloadOffset, payload.data(), payload.size());
+            try {
+                ByteReader reader(payload.data(), payload.size());
+                reader.getString();
+                for (uint32_t i = 0; i < header.columnCount; ++i) {
+                    reader.getString();
+                    reader.take(sizeof(ColumnRecord));
+                }
+                break;
+            } catch (const std::runtime_error&) {
+                if (directorySize == header.payloadSize) throw;
+                directorySize = std::min<uint64_t>(header.payloadSize, directorySize * 4);
+            }
+        }
+    } else {
+        payload.resize(header.payloadSize);
+        if (!readAt(file, payloadOffset, payload.data(), payload.size()) ||
+            fnv1a(payload.data(), payload.size()) != header.checksum) {
+            throw std::runtime_error("Bloc .rcol corrompu (somme de contrôle): " + m_filename);
+        }
+    }
+
+    ColumnTable table;
+    table.batch = header.batch;
+    ByteReader reader(payload.data(), payload.size());
+    table.name = reader.getString();
+
+    for (uint32_t i = 0; i < header.columnCount; ++i) {
+        std::string name = reader.getString();
+        ColumnRecord record = reader.get<ColumnRecord>();
+        if (projected && std::find(columns.begin(), columns.end(), name) == columns.end()) continue;
+        if (record.dataOffset > header.payloadSize || record.storedSize > header.payloadSize - record.dataOffset) {
+            throw std::runtime_error("Bloc .rcol corrompu (colonne " + name + "): " + m_filename);
+        }
+
+        Column column;
+        column.name = name;
+        column.type = static_cast<ColumnType>(record.type);
+        if (projected) {
+            std::vector<uint8_t> stored(record.storedSize);
+            readAt(file, payloadOffset + record.dataOffset, stored.data(), stored.size());
+            column.data = decode(stored.data(), record, column.elementSize());
+        } else {
+            column.data = decode(payload.data() + record.dataOffset, record, column.elementSize());
+        }
+        table.columns.push_back(std::move(column));
+    }
+    return table;
+}
+
+bool ColumnReader::readLatest(const std::string& table, ColumnTable& result) const {
+    for (size_t i = m_chunks.size(); i-- > 0;) {
+        if (m_chunks[i].table == table) {
+            result = read(i);
+            return true;
+        }
+    }
+    return false;
+}
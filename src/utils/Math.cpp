@@ -19,6 +19,44 @@
 //     return glm::dot(dir, normal) > 0.0f ? dir : -dir;
 // }
 
+// Noms des types de radiation
+const char* radiationTypeName(RadiationType type)
+{
+    switch (type)
+    {
+    case RadiationType::GAMMA: return "GAMMA";
+    case RadiationType::NEUTRON: return "NEUTRON";
+    case RadiationType::MUON: return "MUON";
+    case RadiationType::X_RAY: return "X_RAY";
+    case RadiationType::BETA: return "BETA";
+    case RadiationType::ALPHA: return "ALPHA";
+    }
+    return "GAMMA";
+}
+
+bool parseRadiationType(const std::string &name, RadiationType &type)
+{
+    std::string upper;
+    for (char c : name)
+    {
+        if (c != ' ' && c != '\t')
+            upper += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    if (upper == "XRAY")
+        upper = "X_RAY";
+
+    for (RadiationType candidate : {RadiationType::GAMMA, RadiationType::NEUTRON, RadiationType::MUON,
+                                    RadiationType::X_RAY, RadiationType::BETA, RadiationType::ALPHA})
+    {
+        if (upper == radiationTypeName(candidate))
+        {
+            type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
 // Implémentation des fonctions de logging
 namespace Log
 {
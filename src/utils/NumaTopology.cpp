@@ -0,0 +1,136 @@
+#include "utils/NumaTopology.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Liste de CPU au format du noyau : "0-3,8-11"
+std::vector<uint32_t> parseCpuList(const std::string& text) {
+    std::vector<uint32_t> cpus;
+    std::stringstream stream(text);
+    for (std::string item; std::getline(stream, item, ',');) {
+        item.erase(std::remove_if(item.begin(), item.end(), ::isspace), item.end());
+        if (item.empty()) continue;
+        size_t dash = item.find('-');
+        uint32_t first = static_cast<uint32_t>(std::stoul(item.substr(0, dash)));
+        uint32_t last = dash == std::string::npos ? first : static_cast<uint32_t>(std::stoul(item.substr(dash + 1)));
+        for (uint32_t cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+std::set<uint32_t> allowedCpus() {
+    std::set<uint32_t> cpus;
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &mask)) cpus.insert(cpu);
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        for (uint32_t cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) cpus.insert(cpu);
+    }
+    return cpus;
+}
+
+} // namespace
+
+const NumaTopology& NumaTopology::getInstance() {
+    static NumaTopology instance;
+    return instance;
+}
+
+NumaTopology::NumaTopology() {
+    const std::set<uint32_t> allowed = allowedCpus();
+
+    // Nœuds déclarés par le noyau, réduits aux CPU autorisés (nœuds mémoire seule ignorés)
+    std::map<uint32_t, std::vector<uint32_t>> nodes;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 || !std::isdigit(static_cast<unsigned char>(name[4]))) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        if (!file || !std::getline(file, list)) continue;
+
+        std::vector<uint32_t> cpus;
+        for (uint32_t cpu : parseCpuList(list)) {
+            if (allowed.count(cpu)) cpus.push_back(cpu);
+        }
+        if (!cpus.empty()) nodes[static_cast<uint32_t>(std::stoul(name.substr(4)))] = std::move(cpus);
+    }
+    for (auto& [id, cpus] : nodes) m_nodes.push_back(std::move(cpus));
+    if (m_nodes.empty()) m_nodes.emplace_back(allowed.begin(), allowed.end());
+
+    if (const char* emulated = std::getenv("RADIATION_NUMA_NODES")) {
+        size_t count = std::strtoul(emulated, nullptr, 10);
+        std::vector<uint32_t> all(allowed.begin(), allowed.end());
+        if (count > 1) {
+            m_nodes.assign(count, {});
+            for (size_t i = 0; i < all.size(); ++i) m_nodes[i * count / all.size()].push_back(all[i]);
+            // Plus de nœuds que de CPU : CPU partagés
+            for (size_t node = 0; node < count; ++node) {
+                if (m_nodes[node].empty()) m_nodes[node].push_back(all[node % all.size()]);
+            }
+            m_emulated = true;
+        }
+    }
+
+    if (m_nodes.size() > 1) {
+        Log::info("Topologie NUMA : " + std::to_string(m_nodes.size()) + " nœuds" +
+                  (m_emulated ? " (émulés)" : ""));
+    }
+}
+
+std::vector<NumaTopology::Placement> NumaTopology::distributeThreads(uint32_t threadCount) const {
+    size_t totalCpus = 0;
+    for (const auto& cpus : m_nodes) totalCpus += cpus.size();
+
+    std::vector<Placement> placements(threadCount);
+    std::vector<uint32_t> usedPerNode(m_nodes.size(), 0);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        // Position du thread sur l'ensemble des CPU, puis nœud qui la contient
+        size_t position = (2 * static_cast<size_t>(i) + 1) * totalCpus / (2 * static_cast<size_t>(threadCount));
+        uint32_t node = 0;
+        while (node + 1 < m_nodes.size() && position >= m_nodes[node].size()) {
+            position -= m_nodes[node].size();
+            ++node;
+        }
+        const auto& cpus = m_nodes[node];
+        placements[i].node = node;
+        placements[i].cpu = cpus[usedPerNode[node]++ % cpus.size()];
+    }
+    return placements;
+}
+
+bool NumaTopology::pinCurrentThread(uint32_t cpu) {
+    return pinCurrentThread(std::vector<uint32_t>{cpu});
+}
+
+bool NumaTopology::pinCurrentThread(const std::vector<uint32_t>& cpus) {
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (uint32_t cpu : cpus) {
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &mask);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
@@ -0,0 +1,148 @@
+#include "utils/Profiler.h"
+#include <cstdio>
+#include <sstream>
+
+const char* profileStageName(ProfileStage stage) {
+    switch (stage) {
+        case ProfileStage::BATCH: return "batch";
+        case ProfileStage::SOURCE_SAMPLING: return "source_sampling";
+        case ProfileStage::CROSS_SECTION: return "cross_section";
+        case ProfileStage::RAY_CAST: return "ray_cast";
+        case ProfileStage::SENSOR_SCORING: return "sensor_scoring";
+        case ProfileStage::NEXT_EVENT: return "next_event";
+        case ProfileStage::INTERACTION: return "interaction";
+        case ProfileStage::VARIANCE_REDUCTION: return "variance_reduction";
+        case ProfileStage::COUNT: break;
+    }
+    return "?";
+}
+
+const char* profileCounterName(ProfileCounter counter) {
+    switch (counter) {
+        case ProfileCounter::RAYS: return "rays";
+        case ProfileCounter::BVH_NODES: return "bvh_nodes";
+        case ProfileCounter::PRIMITIVE_TESTS: return "primitive_tests";
+        case ProfileCounter::STEPS: return "steps";
+        case ProfileCounter::COUNT: break;
+    }
+    return "?";
+}
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::ThreadProfile* Profiler::registerThread() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto profile = std::make_unique<ThreadProfile>();
+    profile->index = static_cast<uint32_t>(m_threads.size());
+    profile->generation = m_generation.load();
+    m_threads.push_back(std::move(profile));
+    return m_threads.back().get();
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Les profils des générations précédentes restent alloués (un thread encore vivant
+    // détient un pointeur vers le sien jusqu'à son prochain appel) mais sont ignorés
+    for (auto& profile : m_threads) {
+        profile->events = {};
+    }
+    m_generation.fetch_add(1);
+    m_startTicks = now();
+    m_startTime = std::chrono::steady_clock::now();
+}
+
+double Profiler::ticksPerSecond() const {
+#ifdef PROFILER_HAS_TSC
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+    uint64_t ticks = now() - m_startTicks;
+    return seconds > 1e-3 ? ticks / seconds : 1e9;
+#else
+    return 1e9;
+#endif
+}
+
+std::string Profiler::report() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    double tickRate = ticksPerSecond();
+
+    std::array<uint64_t, STAGE_COUNT> ticks{};
+    std::array<uint64_t, STAGE_COUNT> calls{};
+    std::array<uint64_t, COUNTER_COUNT> counters{};
+    size_t threads = 0;
+    for (const auto& profile : m_threads) {
+        if (profile->generation != m_generation.load()) continue;
+        ++threads;
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            ticks[i] += profile->ticks[i];
+            calls[i] += profile->calls[i];
+        }
+        for (size_t i = 0; i < COUNTER_COUNT; ++i) counters[i] += profile->counters[i];
+    }
+
+    std::ostringstream out;
+    out << std::fixed;
+    if (!isCompiledIn()) {
+        out << "Profilage non compilé (option CMake ENABLE_PROFILING)\n";
+        return out.str();
+    }
+
+    double batchTicks = static_cast<double>(ticks[static_cast<size_t>(ProfileStage::BATCH)]);
+    out << "Profil (" << threads << " threads, temps cumulés sur les threads)\n";
+    out << std::left << std::setw(20) << "Étape" << std::right << std::setw(12) << "Total (ms)" << std::setw(14)
+        << "Appels" << std::setw(12) << "ns/appel" << std::setw(9) << "Part" << "\n";
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        if (calls[i] == 0) continue;
+        double seconds = ticks[i] / tickRate;
+        out << std::left << std::setw(20) << profileStageName(static_cast<ProfileStage>(i)) << std::right
+            << std::setw(12) << std::setprecision(1) << seconds * 1e3 << std::setw(14) << calls[i] << std::setw(12)
+            << std::setprecision(1) << seconds * 1e9 / calls[i] << std::setw(8) << std::setprecision(1)
+            << (batchTicks > 0.0 ? 100.0 * ticks[i] / batchTicks : 0.0) << "%\n";
+    }
+
+    uint64_t rays = counters[static_cast<size_t>(ProfileCounter::RAYS)];
+    out << "Compteurs\n";
+    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        out << "  " << std::left << std::setw(18) << profileCounterName(static_cast<ProfileCounter>(i)) << std::right
+            << std::setw(14) << counters[i];
+        if (i != static_cast<size_t>(ProfileCounter::RAYS) && rays > 0) {
+            out << std::setw(12) << std::setprecision(2) << static_cast<double>(counters[i]) / rays << " /rayon";
+        }
+        out << "\n";
+    }
+    return out.str();
+}
+
+void Profiler::writeChromeTrace(const std::string& filename) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier pour écriture: " + filename);
+    }
+
+    double microsecondsPerTick = 1e6 / ticksPerSecond();
+    uint64_t dropped = 0;
+    bool first = true;
+    std::fputs("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n", file);
+    for (const auto& profile : m_threads) {
+        if (profile->generation != m_generation.load()) continue;
+        std::fprintf(file, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, "
+                           "\"args\": {\"name\": \"transport %u\"}}",
+                     first ? "" : ",\n", profile->index, profile->index);
+        first = false;
+        for (const auto& event : profile->events) {
+            double ts = event.start >= m_startTicks ? (event.start - m_startTicks) * microsecondsPerTick : 0.0;
+            std::fprintf(file, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f}",
+                         profileStageName(event.stage), profile->index, ts, event.duration * microsecondsPerTick);
+        }
+        dropped += profile->droppedEvents;
+    }
+    std::fputs("\n]}\n", file);
+    std::fclose(file);
+
+    if (dropped > 0) {
+        Log::warning("Trace de profilage tronquée : " + std::to_string(dropped) + " événements non conservés");
+    }
+}
@@ -6,6 +6,15 @@ thread_local std::mt19937 RandomGenerator::generator{
     static_cast<uint32_t>(
         std::chrono::high_resolution_clock::now().time_since_epoch().count())};
 thread_local std::uniform_real_distribution<float> RandomGenerator::uniform{0.0f, 1.0f};
+thread_local std::uint64_t RandomGenerator::history = RandomGenerator::NO_HISTORY;
+
+void RandomGenerator::seedStream(std::uint64_t seed, std::uint64_t stream)
+{
+    std::seed_seq sequence{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+                           static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)};
+    generator.seed(sequence);
+    uniform.reset();
+}
 
 glm::vec3 RandomGenerator::randomDirection()
 {
@@ -0,0 +1,41 @@
+#include "utils/RegularGrid.h"
+#include <algorithm>
+
+RegularGrid::RegularGrid(const AABB& bounds, uint32_t nx, uint32_t ny, uint32_t nz)
+    : m_bounds(bounds), m_nx(std::max(1u, nx)), m_ny(std::max(1u, ny)), m_nz(std::max(1u, nz)) {
+    glm::vec3 size = m_bounds.size();
+    m_invCellSize = glm::vec3(size.x > 0.0f ? m_nx / size.x : 0.0f,
+                              size.y > 0.0f ? m_ny / size.y : 0.0f,
+                              size.z > 0.0f ? m_nz / size.z : 0.0f);
+}
+
+glm::vec3 RegularGrid::getCellSize() const {
+    glm::vec3 size = m_bounds.size();
+    return glm::vec3(size.x / m_nx, size.y / m_ny, size.z / m_nz);
+}
+
+int RegularGrid::cellIndex(const glm::vec3& position) const {
+    if (!m_bounds.contains(position)) return -1;
+
+    glm::vec3 local = position - m_bounds.min;
+    uint32_t ix = std::min(static_cast<uint32_t>(local.x * m_invCellSize.x), m_nx - 1);
+    uint32_t iy = std::min(static_cast<uint32_t>(local.y * m_invCellSize.y), m_ny - 1);
+    uint32_t iz = std::min(static_cast<uint32_t>(local.z * m_invCellSize.z), m_nz - 1);
+
+    return static_cast<int>(cellIndex(ix, iy, iz));
+}
+
+glm::vec3 RegularGrid::cellCenter(uint32_t cell) const {
+    AABB bounds = cellBounds(cell);
+    return bounds.center();
+}
+
+AABB RegularGrid::cellBounds(uint32_t cell) const {
+    uint32_t ix = cell % m_nx;
+    uint32_t iy = (cell / m_nx) % m_ny;
+    uint32_t iz = cell / (m_nx * m_ny);
+
+    glm::vec3 cellSize = getCellSize();
+    glm::vec3 min = m_bounds.min + glm::vec3(ix * cellSize.x, iy * cellSize.y, iz * cellSize.z);
+    return AABB(min, min + cellSize);
+}
@@ -0,0 +1,203 @@
+#include "utils/Socket.h"
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+struct ParsedAddress {
+    bool isUnix = false;
+    std::string path; // Socket Unix
+    std::string host; // TCP
+    std::string port;
+};
+
+ParsedAddress parseAddress(const std::string& address) {
+    ParsedAddress parsed;
+    if (address.rfind("unix:", 0) == 0) {
+        parsed.isUnix = true;
+        parsed.path = address.substr(5);
+        if (parsed.path.empty() || parsed.path.size() >= sizeof(sockaddr_un::sun_path)) {
+            throw std::runtime_error("Chemin de socket Unix invalide: " + address);
+        }
+        return parsed;
+    }
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos) throw std::runtime_error("Adresse attendue hôte:port ou unix:/chemin: " + address);
+    parsed.host = address.substr(0, colon);
+    parsed.port = address.substr(colon + 1);
+    if (parsed.host.empty()) parsed.host = "0.0.0.0";
+    return parsed;
+}
+
+sockaddr_un unixAddress(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    return addr;
+}
+
+std::runtime_error socketError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// Résolution TCP ; fd ouvert sur la première adresse pour laquelle action() réussit
+template <typename Action>
+int openTcp(const ParsedAddress& parsed, bool passive, Action&& action) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    addrinfo* results = nullptr;
+    int status = getaddrinfo(parsed.host.c_str(), parsed.port.c_str(), &hints, &results);
+    if (status != 0) {
+        throw std::runtime_error("Adresse introuvable " + parsed.host + ":" + parsed.port + ": " + gai_strerror(status));
+    }
+
+    int fd = -1;
+    for (addrinfo* info = results; info; info = info->ai_next) {
+        fd = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+        if (fd < 0) continue;
+        if (action(fd, info->ai_addr, info->ai_addrlen)) break;
+        ::close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(results);
+    return fd;
+}
+
+} // namespace
+
+// SocketConnection
+SocketConnection& SocketConnection::operator=(SocketConnection&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_fd = other.m_fd;
+        other.m_fd = -1;
+    }
+    return *this;
+}
+
+void SocketConnection::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void SocketConnection::sendAll(const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t sent = ::send(m_fd, bytes, size, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            throw socketError("Erreur d'envoi");
+        }
+        bytes += sent;
+        size -= static_cast<size_t>(sent);
+    }
+}
+
+void SocketConnection::receiveAll(void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t received = ::recv(m_fd, bytes, size, 0);
+        if (received == 0) throw std::runtime_error("Connexion fermée par le pair");
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            throw socketError("Erreur de réception");
+        }
+        bytes += received;
+        size -= static_cast<size_t>(received);
+    }
+}
+
+SocketConnection SocketConnection::connect(const std::string& address, uint32_t timeoutMs) {
+    ParsedAddress parsed = parseAddress(address);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (true) {
+        int fd = -1;
+        if (parsed.isUnix) {
+            fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd < 0) throw socketError("Création de socket impossible");
+            sockaddr_un addr = unixAddress(parsed.path);
+            if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        } else {
+            fd = openTcp(parsed, false, [](int candidate, const sockaddr* addr, socklen_t length) {
+                return ::connect(candidate, addr, length) == 0;
+            });
+            if (fd >= 0) {
+                int noDelay = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+            }
+        }
+        if (fd >= 0) return SocketConnection(fd);
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            throw std::runtime_error("Connexion impossible à " + address);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
+
+// SocketListener
+SocketListener::SocketListener(const std::string& address) {
+    ParsedAddress parsed = parseAddress(address);
+    if (parsed.isUnix) {
+        m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (m_fd < 0) throw socketError("Création de socket impossible");
+        ::unlink(parsed.path.c_str()); // Socket laissé par un run interrompu
+        sockaddr_un addr = unixAddress(parsed.path);
+        if (::bind(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(m_fd);
+            throw socketError("Écoute impossible sur " + address);
+        }
+        m_unixPath = parsed.path;
+        m_address = address;
+    } else {
+        m_fd = openTcp(parsed, true, [](int candidate, const sockaddr* addr, socklen_t length) {
+            int reuse = 1;
+            setsockopt(candidate, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            return ::bind(candidate, addr, length) == 0;
+        });
+        if (m_fd < 0) throw socketError("Écoute impossible sur " + address);
+
+        sockaddr_storage bound{};
+        socklen_t length = sizeof(bound);
+        getsockname(m_fd, reinterpret_cast<sockaddr*>(&bound), &length);
+        uint16_t port = bound.ss_family == AF_INET6 ? ntohs(reinterpret_cast<sockaddr_in6*>(&bound)->sin6_port)
+                                                    : ntohs(reinterpret_cast<sockaddr_in*>(&bound)->sin_port);
+        m_address = parsed.host + ":" + std::to_string(port);
+    }
+
+    if (::listen(m_fd, 64) != 0) {
+        ::close(m_fd);
+        throw socketError("Écoute impossible sur " + address);
+    }
+}
+
+SocketListener::~SocketListener() {
+    if (m_fd >= 0) ::close(m_fd);
+    if (!m_unixPath.empty()) ::unlink(m_unixPath.c_str());
+}
+
+SocketConnection SocketListener::accept() {
+    while (true) {
+        int fd = ::accept(m_fd, nullptr, nullptr);
+        if (fd >= 0) {
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)); // Sans effet hors TCP
+            return SocketConnection(fd);
+        }
+        if (errno != EINTR) throw socketError("Erreur d'acceptation de connexion");
+    }
+}
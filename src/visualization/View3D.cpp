@@ -7,6 +7,7 @@
 #include "core/Sensor.h"
 #include "core/Source.h"
 #include "geometry/Object3D.h"
+#include "simulation/TrackRecorder.h"
 
 #include <QMouseEvent>
 #include <QWheelEvent>
@@ -32,6 +33,16 @@ void View3D::setShowSensors(bool enabled) {
     update();
 }
 
+void View3D::setTracks(std::shared_ptr<const TrackData> tracks) {
+    m_tracks = std::move(tracks);
+    update();
+}
+
+void View3D::setShowTracks(bool enabled) {
+    m_showTracks = enabled;
+    update();
+}
+
 void View3D::setShowSources(bool enabled) {
     m_showSources = enabled;
     update();
@@ -198,4 +209,17 @@ void View3D::updateSceneHelpers() {
             m_renderer->drawCross(source->getPosition(), 0.7f, color);
         }
     }
+
+    if (m_showTracks && m_tracks) {
+        // Couleur par type de particule, assombrie avec le poids
+        for (const auto &step : m_tracks->steps) {
+            glm::vec3 rgb(1.0f, 1.0f, 0.3f);
+            if (step.particle == RadiationType::NEUTRON)
+                rgb = glm::vec3(0.3f, 0.6f, 1.0f);
+            else if (step.particle != RadiationType::GAMMA && step.particle != RadiationType::X_RAY)
+                rgb = glm::vec3(1.0f, 0.4f, 0.4f);
+            float alpha = std::clamp(step.weight, 0.2f, 1.0f);
+            m_renderer->drawLine(step.start, step.end, glm::vec4(rgb, alpha));
+        }
+    }
 }
@@ -0,0 +1,90 @@
+#include "common.h"
+#include "core/Material.h"
+#include "core/CrossSectionLibrary.h"
+
+#include <iostream>
+
+// Conversion hors ligne de tables texte (CSV type NIST XCOM) en bibliothèque binaire .rxs
+static void printUsage(const char* program) {
+    std::cout << "Convertisseur de sections efficaces - bibliothèque binaire .rxs" << std::endl;
+    std::cout << "Usage: " << program << " [OPTIONS] <sortie.rxs> [tables.csv ...]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "  --defaults    Inclure les matériaux prédéfinis" << std::endl;
+    std::cout << "  --list        Lister le contenu d'une bibliothèque existante" << std::endl;
+    std::cout << "  --help, -h    Afficher cette aide" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Format CSV : lignes \"# name:\", \"# density:\", \"# element: Z Symbole fraction A\"," << std::endl;
+    std::cout << "\"# radiation: GAMMA|NEUTRON\", \"# units: cm2/g|barns\", puis l'en-tête des colonnes" << std::endl;
+    std::cout << "(Energy (MeV), Incoherent, Photoelectric, Pair..., Elastic, Capture, Total)." << std::endl;
+}
+
+static void listLibrary(const std::string& filename) {
+    auto library = CrossSectionLibrary::open(filename);
+    std::cout << filename << " : " << library->getMaterialCount() << " matériaux" << std::endl;
+    for (uint32_t i = 0; i < library->getMaterialCount(); ++i) {
+        auto material = library->createMaterial(i);
+        std::cout << "  " << material->getName() << " (" << material->getDensity() << " g/cm³)";
+        for (RadiationType type : material->getRadiationTypes()) {
+            std::cout << " [type " << static_cast<int>(type) << " : "
+                      << material->getAttenuationTable(type)->size() << " points]";
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool includeDefaults = false;
+    bool list = false;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--defaults") {
+            includeDefaults = true;
+        } else if (arg == "--list") {
+            list = true;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    if (files.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        if (list) {
+            for (const auto& file : files) {
+                listLibrary(file);
+            }
+            return 0;
+        }
+
+        std::vector<std::shared_ptr<Material>> materials;
+        if (includeDefaults) {
+            materials = {Material::createLead(), Material::createSteel(), Material::createCopper(),
+                         Material::createPolyethylene(), Material::createConcrete(), Material::createWater(),
+                         Material::createAir(), Material::createVacuum()};
+        }
+        for (size_t i = 1; i < files.size(); ++i) {
+            materials.push_back(CrossSectionLibrary::importCsv(files[i]));
+        }
+
+        if (materials.empty()) {
+            Log::error("Aucun matériau à écrire");
+            return 1;
+        }
+
+        CrossSectionLibrary::write(files[0], materials);
+    } catch (const std::exception& e) {
+        Log::error(e.what());
+        return 1;
+    }
+
+    return 0;
+}